@@ -0,0 +1,383 @@
+//=============================================================================================================
+/**
+ * @file     fiffrawblockcache.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    FiffRawBlockCache class definition.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "fiffrawblockcache.h"
+
+#include <fiff/fiff_raw_data.h>
+
+#include <rtprocessing/filter.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtConcurrent/QtConcurrent>
+#include <QMutexLocker>
+#include <QDebug>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace ANSHAREDLIB;
+using namespace FIFFLIB;
+using namespace RTPROCESSINGLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+FiffRawBlockCache::FiffRawBlockCache(QSharedPointer<FiffRawData> pFiffRawData,
+                                     int iSamplesPerBlock,
+                                     int iCapacity)
+: m_pFiffRawData(pFiffRawData)
+, m_iSamplesPerBlock(std::max(1, iSamplesPerBlock))
+, m_iCapacity(std::max(1, iCapacity))
+, m_bFilterActive(false)
+, m_iFilterGeneration(0)
+{
+}
+
+//=============================================================================================================
+
+FiffRawBlockCache::~FiffRawBlockCache()
+{
+    m_prefetchFuture.waitForFinished();
+}
+
+//=============================================================================================================
+
+void FiffRawBlockCache::setCapacity(int iCapacity)
+{
+    QMutexLocker locker(&m_cacheMutex);
+
+    m_iCapacity = std::max(1, iCapacity);
+
+    while(static_cast<int>(m_lLru.size()) > m_iCapacity) {
+        m_hashBlocks.remove(m_lLru.back());
+        m_lLru.pop_back();
+    }
+}
+
+//=============================================================================================================
+
+void FiffRawBlockCache::setFilter(const FilterKernel& filterKernel,
+                                  const RowVectorXi& vecPicks,
+                                  bool bActive)
+{
+    QMutexLocker locker(&m_cacheMutex);
+
+    m_filterKernel = filterKernel;
+    m_vecFilterPicks = vecPicks;
+    m_bFilterActive = bActive && vecPicks.cols() > 0;
+    m_iFilterGeneration++;
+
+    // Drop outdated filtered blocks right away in order to keep the memory bounded
+    for(CacheEntry& entry : m_hashBlocks) {
+        entry.pFiltered.clear();
+    }
+}
+
+//=============================================================================================================
+
+void FiffRawBlockCache::clear()
+{
+    QMutexLocker locker(&m_cacheMutex);
+
+    m_hashBlocks.clear();
+    m_lLru.clear();
+}
+
+//=============================================================================================================
+
+int FiffRawBlockCache::blockCount() const
+{
+    if(!m_pFiffRawData) {
+        return 0;
+    }
+
+    // The last block holds the remaining samples and may be shorter
+    return (m_pFiffRawData->last_samp - m_pFiffRawData->first_samp + m_iSamplesPerBlock) / m_iSamplesPerBlock;
+}
+
+//=============================================================================================================
+
+int FiffRawBlockCache::blockIndex(int iSample) const
+{
+    if(!m_pFiffRawData || iSample <= m_pFiffRawData->first_samp) {
+        return 0;
+    }
+
+    return (iSample - m_pFiffRawData->first_samp) / m_iSamplesPerBlock;
+}
+
+//=============================================================================================================
+
+QSharedPointer<RawDataBlock> FiffRawBlockCache::rawBlock(int iBlock)
+{
+    {
+        QMutexLocker locker(&m_cacheMutex);
+
+        auto it = m_hashBlocks.find(iBlock);
+        if(it != m_hashBlocks.end()) {
+            QSharedPointer<RawDataBlock> pBlock = it->pRaw;
+            touch(iBlock);
+            return pBlock;
+        }
+    }
+
+    // Read outside of the cache lock, so that cached blocks can be accessed meanwhile
+    QSharedPointer<RawDataBlock> pBlock = readBlock(iBlock);
+
+    if(!pBlock) {
+        return pBlock;
+    }
+
+    QMutexLocker locker(&m_cacheMutex);
+
+    auto it = m_hashBlocks.find(iBlock);
+    if(it == m_hashBlocks.end()) {
+        CacheEntry entry;
+        entry.pRaw = pBlock;
+        entry.iFilterGeneration = -1;
+        m_lLru.push_front(iBlock);
+        entry.itLru = m_lLru.begin();
+        m_hashBlocks.insert(iBlock, entry);
+    } else {
+        // Another thread was faster
+        pBlock = it->pRaw;
+    }
+
+    touch(iBlock);
+
+    return pBlock;
+}
+
+//=============================================================================================================
+
+QSharedPointer<RawDataBlock> FiffRawBlockCache::filteredBlock(int iBlock,
+                                                              bool bUseThreads)
+{
+    int iFilterGeneration;
+
+    {
+        QMutexLocker locker(&m_cacheMutex);
+
+        if(!m_bFilterActive) {
+            locker.unlock();
+            return rawBlock(iBlock);
+        }
+
+        iFilterGeneration = m_iFilterGeneration;
+
+        auto it = m_hashBlocks.find(iBlock);
+        if(it != m_hashBlocks.end() && it->pFiltered && it->iFilterGeneration == iFilterGeneration) {
+            QSharedPointer<RawDataBlock> pBlock = it->pFiltered;
+            touch(iBlock);
+            return pBlock;
+        }
+    }
+
+    QSharedPointer<RawDataBlock> pBlock = filterBlock(iBlock, bUseThreads);
+
+    if(!pBlock) {
+        return pBlock;
+    }
+
+    QMutexLocker locker(&m_cacheMutex);
+
+    // Only store the block if the filter did not change in the meantime
+    auto it = m_hashBlocks.find(iBlock);
+    if(it != m_hashBlocks.end() && iFilterGeneration == m_iFilterGeneration) {
+        it->pFiltered = pBlock;
+        it->iFilterGeneration = iFilterGeneration;
+        touch(iBlock);
+    }
+
+    return pBlock;
+}
+
+//=============================================================================================================
+
+void FiffRawBlockCache::prefetch(int iFirstBlock,
+                                 int iNumBlocks)
+{
+    #ifdef WASMBUILD
+    // No background threads available, blocks will be loaded on demand
+    Q_UNUSED(iFirstBlock);
+    Q_UNUSED(iNumBlocks);
+    #else
+    if(m_prefetchFuture.isRunning()) {
+        return;
+    }
+
+    int iLastBlock = std::min(iFirstBlock + iNumBlocks, blockCount()) - 1;
+    iFirstBlock = std::max(0, iFirstBlock);
+
+    if(iLastBlock < iFirstBlock) {
+        return;
+    }
+
+    m_prefetchFuture = QtConcurrent::run(this, &FiffRawBlockCache::loadBlocks, iFirstBlock, iLastBlock - iFirstBlock + 1);
+    #endif
+}
+
+//=============================================================================================================
+
+void FiffRawBlockCache::waitForPrefetch()
+{
+    m_prefetchFuture.waitForFinished();
+}
+
+//=============================================================================================================
+
+void FiffRawBlockCache::loadBlocks(int iFirstBlock,
+                                   int iNumBlocks)
+{
+    for(int iBlock = iFirstBlock; iBlock < iFirstBlock + iNumBlocks; ++iBlock) {
+        // We are already running in a worker thread, do not spawn further threads for filtering
+        if(!filteredBlock(iBlock, false)) {
+            return;
+        }
+    }
+}
+
+//=============================================================================================================
+
+QSharedPointer<RawDataBlock> FiffRawBlockCache::readBlock(int iBlock)
+{
+    if(iBlock < 0 || iBlock >= blockCount()) {
+        return QSharedPointer<RawDataBlock>();
+    }
+
+    int iStart = m_pFiffRawData->first_samp + iBlock * m_iSamplesPerBlock;
+    int iEnd = std::min(iStart + m_iSamplesPerBlock - 1, m_pFiffRawData->last_samp);
+
+    MatrixXd matData, matTimes;
+
+    {
+        QMutexLocker locker(&m_readMutex);
+
+        if(!m_pFiffRawData->read_raw_segment(matData, matTimes, iStart, iEnd)) {
+            qWarning() << "[FiffRawBlockCache::readBlock] Could not read samples " << iStart << " to " << iEnd;
+            return QSharedPointer<RawDataBlock>();
+        }
+    }
+
+    return QSharedPointer<RawDataBlock>::create(matData.cast<float>(), matTimes);
+}
+
+//=============================================================================================================
+
+QSharedPointer<RawDataBlock> FiffRawBlockCache::filterBlock(int iBlock,
+                                                            bool bUseThreads)
+{
+    FilterKernel filterKernel;
+    RowVectorXi vecPicks;
+
+    {
+        QMutexLocker locker(&m_cacheMutex);
+        filterKernel = m_filterKernel;
+        vecPicks = m_vecFilterPicks;
+    }
+
+    // Pad the block with half the filter length on both sides
+    int iNumNeighbors = (filterKernel.getFilterOrder() / 2 + m_iSamplesPerBlock - 1) / m_iSamplesPerBlock;
+    int iFirstBlock = std::max(0, iBlock - iNumNeighbors);
+    int iLastBlock = std::min(blockCount() - 1, iBlock + iNumNeighbors);
+
+    QList<QSharedPointer<RawDataBlock> > lBlocks;
+
+    for(int i = iFirstBlock; i <= iLastBlock; ++i) {
+        QSharedPointer<RawDataBlock> pBlock = rawBlock(i);
+        if(!pBlock) {
+            return pBlock;
+        }
+        lBlocks.append(pBlock);
+    }
+
+    if(lBlocks.isEmpty()) {
+        return QSharedPointer<RawDataBlock>();
+    }
+
+    // Only the last block of the file may be shorter than m_iSamplesPerBlock
+    int iNumSamples = 0;
+    for(int i = 0; i < lBlocks.size(); ++i) {
+        iNumSamples += lBlocks.at(i)->matData.cols();
+    }
+
+    MatrixXd matPadded(lBlocks.first()->matData.rows(), iNumSamples);
+
+    for(int i = 0; i < lBlocks.size(); ++i) {
+        matPadded.middleCols(i * m_iSamplesPerBlock, lBlocks.at(i)->matData.cols()) = lBlocks.at(i)->matData.cast<double>();
+    }
+
+    #ifdef WASMBUILD
+    bUseThreads = false;
+    #endif
+
+    MatrixXd matFiltered = RTPROCESSINGLIB::filterData(matPadded,
+                                                       filterKernel,
+                                                       vecPicks,
+                                                       bUseThreads);
+
+    int iOffset = (iBlock - iFirstBlock) * m_iSamplesPerBlock;
+
+    return QSharedPointer<RawDataBlock>::create(matFiltered.middleCols(iOffset, lBlocks.at(iBlock - iFirstBlock)->matData.cols()).cast<float>(),
+                                                lBlocks.at(iBlock - iFirstBlock)->matTimes);
+}
+
+//=============================================================================================================
+
+void FiffRawBlockCache::touch(int iBlock)
+{
+    auto it = m_hashBlocks.find(iBlock);
+
+    if(it == m_hashBlocks.end()) {
+        return;
+    }
+
+    m_lLru.splice(m_lLru.begin(), m_lLru, it->itLru);
+
+    // Evict least recently used blocks. Blocks which are still displayed stay alive through their shared pointers.
+    while(static_cast<int>(m_lLru.size()) > m_iCapacity) {
+        m_hashBlocks.remove(m_lLru.back());
+        m_lLru.pop_back();
+    }
+}
@@ -0,0 +1,287 @@
+//=============================================================================================================
+/**
+ * @file     fiffrawblockcache.h
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    FiffRawBlockCache class declaration.
+ *
+ */
+
+#ifndef ANSHAREDLIB_FIFFRAWBLOCKCACHE_H
+#define ANSHAREDLIB_FIFFRAWBLOCKCACHE_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "../anshared_global.h"
+
+#include <rtprocessing/helpers/filterkernel.h>
+
+#include <disp/viewers/helpers/minmaxpyramid.h>
+
+#include <list>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QSharedPointer>
+#include <QHash>
+#include <QMutex>
+#include <QFuture>
+
+//=============================================================================================================
+// Eigen INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// FORWARD DECLARATIONS
+//=============================================================================================================
+
+namespace FIFFLIB {
+    class FiffRawData;
+}
+
+//=============================================================================================================
+// DEFINE NAMESPACE ANSHAREDLIB
+//=============================================================================================================
+
+namespace ANSHAREDLIB {
+
+//=============================================================================================================
+// ANSHAREDLIB FORWARD DECLARATIONS
+//=============================================================================================================
+
+/**
+ * One block of raw data together with the min/max envelope used for drawing it at low zoom levels.
+ */
+struct RawDataBlock {
+    RawDataBlock(const Eigen::MatrixXf& matBlockData,
+                 const Eigen::MatrixXd& matBlockTimes)
+    : matData(matBlockData)
+    , matTimes(matBlockTimes)
+    , envelope(matBlockData)
+    {
+    }
+
+    Eigen::MatrixXf             matData;        /**< The data (channels x samples) in single precision. */
+    Eigen::MatrixXd             matTimes;       /**< The times of the samples. */
+    DISPLIB::MinMaxPyramid      envelope;       /**< The min/max envelope of the data. */
+};
+
+//=============================================================================================================
+/**
+ * Fixed size least-recently-used cache of raw data blocks. Blocks are addressed by their index relative to the
+ * first sample of the file, which makes the lookup of any time point O(1). Filtered versions of the blocks are
+ * computed lazily on first access and cached alongside the raw data. Blocks can be prefetched in the background.
+ *
+ * @brief LRU cache of raw data blocks with lazy filtering and background prefetching.
+ */
+class ANSHAREDSHARED_EXPORT FiffRawBlockCache
+{
+
+public:
+    typedef QSharedPointer<FiffRawBlockCache> SPtr;              /**< Shared pointer type for FiffRawBlockCache. */
+    typedef QSharedPointer<const FiffRawBlockCache> ConstSPtr;   /**< Const shared pointer type for FiffRawBlockCache. */
+
+    //=========================================================================================================
+    /**
+     * Constructs a FiffRawBlockCache object.
+     *
+     * @param[in] pFiffRawData          The raw data to read the blocks from.
+     * @param[in] iSamplesPerBlock      The number of samples per block.
+     * @param[in] iCapacity             The maximum number of blocks held by the cache.
+     */
+    FiffRawBlockCache(QSharedPointer<FIFFLIB::FiffRawData> pFiffRawData,
+                      int iSamplesPerBlock,
+                      int iCapacity);
+
+    //=========================================================================================================
+    /**
+     * Destructs a FiffRawBlockCache. Waits for a pending prefetch to finish.
+     */
+    ~FiffRawBlockCache();
+
+    //=========================================================================================================
+    /**
+     * Sets the maximum number of blocks held by the cache. Least recently used blocks are evicted if needed.
+     *
+     * @param[in] iCapacity             The maximum number of blocks.
+     */
+    void setCapacity(int iCapacity);
+
+    //=========================================================================================================
+    /**
+     * Sets the filter which is used to compute the filtered blocks. All cached filtered blocks are discarded.
+     *
+     * @param[in] filterKernel          The filter kernel.
+     * @param[in] vecPicks              The indices of the channels to be filtered.
+     * @param[in] bActive               Whether filtering is active.
+     */
+    void setFilter(const RTPROCESSINGLIB::FilterKernel& filterKernel,
+                   const Eigen::RowVectorXi& vecPicks,
+                   bool bActive);
+
+    //=========================================================================================================
+    /**
+     * Discards all cached blocks.
+     */
+    void clear();
+
+    //=========================================================================================================
+    /**
+     * Returns the number of blocks in the file. The last block may hold less than the samples per block.
+     *
+     * @return The number of blocks.
+     */
+    int blockCount() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the index of the block that contains the given sample.
+     *
+     * @param[in] iSample               The absolute sample.
+     *
+     * @return The block index.
+     */
+    int blockIndex(int iSample) const;
+
+    //=========================================================================================================
+    /**
+     * Returns the raw data block with the given index. The block is read from file if it is not cached.
+     *
+     * @param[in] iBlock                The block index.
+     *
+     * @return The raw data block, a null pointer if the block could not be read.
+     */
+    QSharedPointer<RawDataBlock> rawBlock(int iBlock);
+
+    //=========================================================================================================
+    /**
+     * Returns the filtered data block with the given index. The block is filtered on first access. If filtering
+     * is inactive the raw block is returned.
+     *
+     * @param[in] iBlock                The block index.
+     * @param[in] bUseThreads           Whether to use multiple threads for filtering. Default is true.
+     *
+     * @return The filtered data block, a null pointer if the block could not be read.
+     */
+    QSharedPointer<RawDataBlock> filteredBlock(int iBlock,
+                                               bool bUseThreads = true);
+
+    //=========================================================================================================
+    /**
+     * Loads the given range of blocks in a background thread. If a prefetch is still running the request is
+     * dropped, since the next scroll event will issue a new one.
+     *
+     * @param[in] iFirstBlock           The first block to prefetch.
+     * @param[in] iNumBlocks            The number of blocks to prefetch.
+     */
+    void prefetch(int iFirstBlock,
+                  int iNumBlocks);
+
+    //=========================================================================================================
+    /**
+     * Blocks until a running prefetch has finished. Call this before accessing the underlying file elsewhere.
+     */
+    void waitForPrefetch();
+
+private:
+    //=========================================================================================================
+    /**
+     * Loads and, if filtering is active, filters the given range of blocks. This is run concurrently.
+     *
+     * @param[in] iFirstBlock           The first block to load.
+     * @param[in] iNumBlocks            The number of blocks to load.
+     */
+    void loadBlocks(int iFirstBlock,
+                    int iNumBlocks);
+
+    //=========================================================================================================
+    /**
+     * Reads the block with the given index from file.
+     *
+     * @param[in] iBlock                The block index.
+     *
+     * @return The block, a null pointer if the block could not be read.
+     */
+    QSharedPointer<RawDataBlock> readBlock(int iBlock);
+
+    //=========================================================================================================
+    /**
+     * Filters the block with the given index. The neighboring blocks are used to pad the data by half the filter
+     * length, so that every block can be filtered independently.
+     *
+     * @param[in] iBlock                The block index.
+     * @param[in] bUseThreads           Whether to use multiple threads.
+     *
+     * @return The filtered block, a null pointer if the block could not be read.
+     */
+    QSharedPointer<RawDataBlock> filterBlock(int iBlock,
+                                             bool bUseThreads);
+
+    //=========================================================================================================
+    /**
+     * Moves the given block to the front of the LRU list and evicts blocks exceeding the capacity.
+     * The cache mutex needs to be locked by the caller.
+     *
+     * @param[in] iBlock                The block index.
+     */
+    void touch(int iBlock);
+
+    struct CacheEntry {
+        QSharedPointer<RawDataBlock>    pRaw;                   /**< The raw block. */
+        QSharedPointer<RawDataBlock>    pFiltered;              /**< The filtered block, null if not filtered yet. */
+        int                             iFilterGeneration;      /**< The filter generation pFiltered was computed with. */
+        std::list<int>::iterator        itLru;                  /**< The position in the LRU list. */
+    };
+
+    QSharedPointer<FIFFLIB::FiffRawData>    m_pFiffRawData;         /**< The raw data to read from. */
+    int                                     m_iSamplesPerBlock;     /**< The number of samples per block. */
+    int                                     m_iCapacity;            /**< The maximum number of cached blocks. */
+
+    QHash<int, CacheEntry>                  m_hashBlocks;           /**< The cached blocks, accessed by block index. */
+    std::list<int>                          m_lLru;                 /**< The block indices, most recently used first. */
+
+    RTPROCESSINGLIB::FilterKernel           m_filterKernel;         /**< The filter kernel. */
+    Eigen::RowVectorXi                      m_vecFilterPicks;       /**< The indices of the channels to be filtered. */
+    bool                                    m_bFilterActive;        /**< Whether filtering is active. */
+    int                                     m_iFilterGeneration;    /**< Incremented whenever the filter changes. */
+
+    QFuture<void>                           m_prefetchFuture;       /**< The future of the running prefetch. */
+
+    mutable QMutex                          m_cacheMutex;           /**< Guards the cache and filter members. */
+    QMutex                                  m_readMutex;            /**< Serializes file access. */
+};
+
+} // namespace ANSHAREDLIB
+
+#endif // ANSHAREDLIB_FIFFRAWBLOCKCACHE_H
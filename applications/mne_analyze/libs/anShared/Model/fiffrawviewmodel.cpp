@@ -107,7 +107,6 @@ FiffRawViewModel::FiffRawViewModel(const QString &sFilePath,
 , m_bEndOfFileReached(false)
 , m_blockLoadFutureWatcher()
 , m_bCurrentlyLoading(false)
-, m_pRtFilter(FilterOverlapAdd::SPtr::create())
 , m_bPerformFiltering(false)
 , m_iDistanceTimerSpacer(1000)
 , m_iScroller(0)
@@ -172,6 +171,11 @@ bool FiffRawViewModel::initFiffData(QIODevice& p_IODevice)
     // Fiff file is not empty, set cursor somewhere into Fiff file
     m_iFiffCursorBegin = m_pFiffIO->m_qlistRaw[0]->first_samp;
     m_iSamplesPerBlock = m_pFiffInfo->sfreq;
+
+    // The cache holds the current window, one window of prefetched blocks and one window of recently visited blocks
+    m_pBlockCache = FiffRawBlockCache::SPtr::create(m_pFiffIO->m_qlistRaw[0], m_iSamplesPerBlock, 3 * m_iTotalBlockCount);
+    m_pBlockCache->setFilter(m_filterKernel, m_lFilterChannelList, m_bPerformFiltering);
+
     reloadAllData();
 
     qInfo() << "[FiffRawViewModel::initFiffData] Loaded" << m_lData.size() << "blocks with size"<<data.rows()<<"x"<<m_iSamplesPerBlock;
@@ -247,6 +251,11 @@ QVariant FiffRawViewModel::data(const QModelIndex &index,
 
 bool FiffRawViewModel::saveToFile(const QString& sPath)
 {
+    // The block cache must not read from the file while it is being written
+    if(m_pBlockCache) {
+        m_pBlockCache->waitForPrefetch();
+    }
+
     #ifdef WASMBUILD
     QBuffer* bufferOut = new QBuffer;
 
@@ -407,6 +416,10 @@ void FiffRawViewModel::setWindowSize(int iNumSeconds,
     m_iVisibleWindowSize = iNumSeconds;
     m_iTotalBlockCount = m_iVisibleWindowSize + 2 * m_iPreloadBufferSize;
 
+    if(m_pBlockCache) {
+        m_pBlockCache->setCapacity(3 * m_iTotalBlockCount);
+    }
+
     //reload data to accomodate new size
     reloadAllData();
 
@@ -502,6 +515,8 @@ void FiffRawViewModel::setFilter(const FilterKernel& filterData)
 {
     m_filterKernel = filterData;
 
+    updateBlockCacheFilter();
+
     if(m_bPerformFiltering) {
         reloadAllData();
     }
@@ -519,6 +534,8 @@ void FiffRawViewModel::setFilterActive(bool bState)
 {
     m_bPerformFiltering = bState;
 
+    updateBlockCacheFilter();
+
     if(m_bPerformFiltering) {
         reloadAllData();
     }
@@ -554,6 +571,8 @@ void FiffRawViewModel::setFilterChannelType(const QString& channelType)
         }
     }
 
+    updateBlockCacheFilter();
+
     if(m_bPerformFiltering) {
         reloadAllData();
     }
@@ -618,8 +637,9 @@ void FiffRawViewModel::updateHorizontalScrollPosition(qint32 newScrollPosition)
 
         if (blockDist >= m_iTotalBlockCount) {
             // we must "jump" to the new cursor ...
-            int iResidual = absoluteLastSample() % m_iSamplesPerBlock;
-            m_iFiffCursorBegin = std::min(absoluteLastSample() - (m_iTotalBlockCount * m_iSamplesPerBlock + iResidual), m_iFiffCursorBegin + (blockDist * m_iSamplesPerBlock));
+            int iMaxFirstBlock = std::max(0, m_pBlockCache->blockCount() - m_iTotalBlockCount);
+            int iFirstBlock = std::min(iMaxFirstBlock, m_pBlockCache->blockIndex(m_iFiffCursorBegin) + blockDist);
+            m_iFiffCursorBegin = absoluteFirstSample() + iFirstBlock * m_iSamplesPerBlock;
 
             // and load all the data anew
             reloadAllData();
@@ -634,41 +654,24 @@ void FiffRawViewModel::updateHorizontalScrollPosition(qint32 newScrollPosition)
 
 //=============================================================================================================
 
-bool FiffRawViewModel::filterDataBlock(MatrixXd& matData,
-                                       bool bFilterEnd,
-                                       bool bKeepOverhead)
+void FiffRawViewModel::updateEndStartFlags()
 {
-    if(!m_bPerformFiltering) {
-        return false;
-    }
+    m_bStartOfFileReached = m_iFiffCursorBegin <= absoluteFirstSample();
 
-    if(m_lFilterChannelList.cols() == 0) {
-        qWarning() << "[FiffRawViewModel::filterDataBlock] No channels to filter specified.";
-        return false;
+    if(m_pBlockCache) {
+        m_bEndOfFileReached = m_pBlockCache->blockIndex(m_iFiffCursorBegin) + m_iTotalBlockCount >= m_pBlockCache->blockCount();
+    } else {
+        m_bEndOfFileReached = (m_iFiffCursorBegin + m_iTotalBlockCount * m_iSamplesPerBlock) >= absoluteLastSample();
     }
-
-    // In WASM mode do not use multithreading for filtering
-    bool bUseThread = true;
-    #ifdef WASMBUILD
-    bUseThread = false;
-    #endif
-
-    matData = m_pRtFilter->calculate(matData,
-                                     m_filterKernel,
-                                     m_lFilterChannelList,
-                                     bFilterEnd,
-                                     bUseThread,
-                                     bKeepOverhead);
-
-    return true;
 }
 
 //=============================================================================================================
 
-void FiffRawViewModel::updateEndStartFlags()
+void FiffRawViewModel::updateBlockCacheFilter()
 {
-    m_bStartOfFileReached = m_iFiffCursorBegin <= absoluteFirstSample();
-    m_bEndOfFileReached = (m_iFiffCursorBegin + m_iTotalBlockCount * m_iSamplesPerBlock) >= absoluteLastSample();
+    if(m_pBlockCache) {
+        m_pBlockCache->setFilter(m_filterKernel, m_lFilterChannelList, m_bPerformFiltering);
+    }
 }
 
 //=============================================================================================================
@@ -684,13 +687,13 @@ void FiffRawViewModel::startBackgroundOperation(int (FiffRawViewModel::*loadFunc
 
 int FiffRawViewModel::loadEarlierBlocks(qint32 numBlocks)
 {
-    // check if start of file was reached:
-    int leftSamples = (m_iFiffCursorBegin - numBlocks * m_iSamplesPerBlock) - absoluteFirstSample();
+    int iFirstBlock = m_pBlockCache->blockIndex(m_iFiffCursorBegin);
 
-    if (leftSamples <= 0) {
+    // check if start of file was reached:
+    if (iFirstBlock - numBlocks < 0) {
         qInfo() << "[FiffRawViewModel::loadEarlierBlocks] Reached start of file !";
         // see how many blocks we still can load
-        int maxNumBlocks = (m_iFiffCursorBegin - absoluteFirstSample()) / m_iSamplesPerBlock;
+        int maxNumBlocks = iFirstBlock;
         qInfo() << "[FiffRawViewModel::loadEarlierBlocks] Loading " << maxNumBlocks << " earlier blocks instead of requested " << numBlocks;
         if (maxNumBlocks != 0) {
             numBlocks = maxNumBlocks;
@@ -708,74 +711,23 @@ int FiffRawViewModel::loadEarlierBlocks(qint32 numBlocks)
         return -1;
     }
 
-    // build data structures to be filled from file
-    MatrixXd matData, matTimes;
-
-    // initialize start and end indices
-    int start = m_iFiffCursorBegin - (numBlocks * m_iSamplesPerBlock);
-    int end = m_iFiffCursorBegin - 1;
+    // Get the blocks from the cache. The block closest to the current data needs to end up in front.
+    for(int iBlock = iFirstBlock - numBlocks; iBlock < iFirstBlock; ++iBlock) {
+        QSharedPointer<RawDataBlock> pBlock = m_pBlockCache->rawBlock(iBlock);
+        QSharedPointer<RawDataBlock> pFilteredBlock = m_bPerformFiltering ? m_pBlockCache->filteredBlock(iBlock) : pBlock;
 
-    // Update m_iFiffCursorBegin before we account for the filter delay
-    if(start <= absoluteFirstSample()) {
-        m_iFiffCursorBegin = absoluteFirstSample();
-    } else {
-        m_iFiffCursorBegin = start;
-    }
-
-    // When filtering load more data than we need in order to allow arbiritary filter lengths
-    int iFilterDelay = 0;
-    bool bBeforeStartReached = false;
-
-    if(m_bPerformFiltering) {
-        iFilterDelay = m_filterKernel.getFilterOrder()/2;
-        end += m_filterKernel.getFilterOrder()/2;
-
-        // Check if we have reached the beginning/end of the file
-        if(start-iFilterDelay >= absoluteFirstSample()) {
-            start -= m_filterKernel.getFilterOrder()/2;
-        } else {
-            // Add another filter delay because we need enough data to sucessfully filter with arbiritary filter lengths
-            end += m_filterKernel.getFilterOrder()/2;
-            iFilterDelay = 0;
-            bBeforeStartReached = true;
+        if(!pBlock || !pFilteredBlock) {
+            qWarning() << "[FiffRawViewModel::loadEarlierBlocks] Could not read block ";
+            m_lNewData.clear();
+            m_lFilteredNewData.clear();
+            return -1;
         }
-    }
 
-    // Read the raw data
-    if(m_pFiffIO->m_qlistRaw[0]->read_raw_segment(matData, matTimes, start, end)) {
-        // qDebug() << "[FiffRawViewModel::loadFiffData] Successfully read a block ";
-    } else {
-        qWarning() << "[FiffRawViewModel::loadEarlierBlocks] Could not read block ";
-        return -1;
+        m_lNewData.push_front(pBlock);
+        m_lFilteredNewData.push_front(pFilteredBlock);
     }
 
-    for(int i = 0; i < numBlocks; ++i) {
-        m_lNewData.push_front(QSharedPointer<QPair<MatrixXd, MatrixXd> >::create(qMakePair(matData.block(0, i*m_iSamplesPerBlock+iFilterDelay, matData.rows(), m_iSamplesPerBlock),
-                                                                                           matTimes.block(0, i*m_iSamplesPerBlock+iFilterDelay, matTimes.rows(), m_iSamplesPerBlock))));
-    }
-
-    // Filter data if activated, otherwise set to raw data
-    if(m_bPerformFiltering) {
-        bool bFilterSuccess = false;
-        if(bBeforeStartReached) {
-            iFilterDelay = m_filterKernel.getFilterOrder()/4;
-            bFilterSuccess = filterDataBlock(matData, true, true);
-        } else {
-            bFilterSuccess = filterDataBlock(matData, true);
-        }
-
-        if(!bFilterSuccess) {
-            m_lFilteredNewData = m_lNewData;
-            return 0;
-        }
-
-        for(int i = 0; i < numBlocks; ++i) {
-            m_lFilteredNewData.push_front(QSharedPointer<QPair<MatrixXd, MatrixXd> >::create(qMakePair(matData.block(0, (i*m_iSamplesPerBlock)+(2*iFilterDelay), matData.rows(), m_iSamplesPerBlock),
-                                                                                                       matTimes.block(0, (i*m_iSamplesPerBlock)+(2*iFilterDelay), matTimes.rows(), m_iSamplesPerBlock))));
-        }
-    } else {
-        m_lFilteredNewData = m_lNewData;
-    }
+    m_iFiffCursorBegin -= numBlocks * m_iSamplesPerBlock;
 
     // return 0, meaning that this was a loading of earlier blocks
     return 0;
@@ -785,14 +737,14 @@ int FiffRawViewModel::loadEarlierBlocks(qint32 numBlocks)
 
 int FiffRawViewModel::loadLaterBlocks(qint32 numBlocks)
 {
+    int iLastBlock = m_pBlockCache->blockIndex(m_iFiffCursorBegin) + m_iTotalBlockCount - 1;
+
     // check if end of file is reached:
-    int leftSamples = absoluteLastSample() - (m_iFiffCursorBegin + (m_iTotalBlockCount + numBlocks) * m_iSamplesPerBlock);
-    if (leftSamples < 0) {
+    if (iLastBlock + numBlocks >= m_pBlockCache->blockCount()) {
         qInfo() << "[FiffRawViewModel::loadLaterBlocks] Reached end of file !";
         // see how many blocks we still can load
-        int maxNumBlocks = (absoluteLastSample() - (m_iFiffCursorBegin + m_iTotalBlockCount * m_iSamplesPerBlock)) / m_iSamplesPerBlock;
-        //qInfo() << "[FiffRawViewModel::loadLaterBlocks] Loading " << maxNumBlocks << " later blocks instead of requested " << numBlocks;
-        if (maxNumBlocks != 0) {
+        int maxNumBlocks = m_pBlockCache->blockCount() - 1 - iLastBlock;
+        if (maxNumBlocks > 0) {
             numBlocks = maxNumBlocks;
         } else {
             // nothing to be done, cant load any more blocks
@@ -804,67 +756,28 @@ int FiffRawViewModel::loadLaterBlocks(qint32 numBlocks)
     // we expect m_lNewData and m_lFilteredNewData to be empty:
     if (m_lNewData.empty() == false ||
         m_lFilteredNewData.empty() == false) {
-        qWarning() << "[FiffRawViewModel::loadEarlierBlocks] Warning! Temporary data storage non empty !";
+        qWarning() << "[FiffRawViewModel::loadLaterBlocks] Warning! Temporary data storage non empty !";
         return -1;
     }
 
-    // build data structures to be filled from file
-    MatrixXd matData, matTimes;
-
-    // initialize start and end indices
-    int start = m_iFiffCursorBegin + (m_iTotalBlockCount * m_iSamplesPerBlock);
-    int end = start + (m_iSamplesPerBlock * numBlocks) - 1;
-
-    // adjust fiff cursor
-    m_iFiffCursorBegin += numBlocks * m_iSamplesPerBlock;
-
-    // Account for filter delay of current filter kernel
-    int iFilterDelay = 0;
+    // Get the blocks from the cache
+    for(int iBlock = iLastBlock + 1; iBlock <= iLastBlock + numBlocks; ++iBlock) {
+        QSharedPointer<RawDataBlock> pBlock = m_pBlockCache->rawBlock(iBlock);
+        QSharedPointer<RawDataBlock> pFilteredBlock = m_bPerformFiltering ? m_pBlockCache->filteredBlock(iBlock) : pBlock;
 
-    if(m_bPerformFiltering) {
-        iFilterDelay = m_filterKernel.getFilterOrder()/2;
-
-        // Check if we have reached the beginning/end of the file
-        if(start-iFilterDelay > absoluteFirstSample()) {
-            start -= m_filterKernel.getFilterOrder()/2;
-        } else {
-            iFilterDelay = 0;
+        if(!pBlock || !pFilteredBlock) {
+            qWarning() << "[FiffRawViewModel::loadLaterBlocks] Could not read block ";
+            m_lNewData.clear();
+            m_lFilteredNewData.clear();
+            return -1;
         }
 
-        if(end+iFilterDelay < m_pFiffIO->m_qlistRaw[0]->last_samp) {
-            end += m_filterKernel.getFilterOrder()/2;
-        } else {
-            iFilterDelay = 0;
-        }
+        m_lNewData.push_back(pBlock);
+        m_lFilteredNewData.push_back(pFilteredBlock);
     }
 
-    // read data
-    if(m_pFiffIO->m_qlistRaw[0]->read_raw_segment(matData, matTimes, start, end)) {
-        // qDebug() << "[FiffRawViewModel::loadFiffData] Successfully read a block ";
-    } else {
-        qWarning() << "[FiffRawViewModel::loadLaterBlocks] Could not read block ";
-        return -1;
-    }
-
-    for(int i = 0; i < numBlocks; ++i) {
-        m_lNewData.push_back(QSharedPointer<QPair<MatrixXd, MatrixXd> >::create(qMakePair(matData.block(0, i*m_iSamplesPerBlock+iFilterDelay, matData.rows(), m_iSamplesPerBlock),
-                                                                                          matTimes.block(0, i*m_iSamplesPerBlock+iFilterDelay, matTimes.rows(), m_iSamplesPerBlock))));
-    }
-
-    // Filter data if activated, otherwise set to raw data
-    if(m_bPerformFiltering) {
-        if(!filterDataBlock(matData, true)) {
-            m_lFilteredNewData = m_lNewData;
-            return 1;
-        }
-
-        for(int i = 0; i < numBlocks; ++i) {
-            m_lFilteredNewData.push_back(QSharedPointer<QPair<MatrixXd, MatrixXd> >::create(qMakePair(matData.block(0, i*m_iSamplesPerBlock+(2*iFilterDelay), matData.rows(), m_iSamplesPerBlock),
-                                                                                                      matTimes.block(0, i*m_iSamplesPerBlock+(2*iFilterDelay), matTimes.rows(), m_iSamplesPerBlock))));
-        }
-    } else {
-        m_lFilteredNewData = m_lNewData;
-    }
+    // adjust fiff cursor
+    m_iFiffCursorBegin += numBlocks * m_iSamplesPerBlock;
 
     // return 1, meaning that this was a loading of later blocks
     return 1;
@@ -899,6 +812,9 @@ void FiffRawViewModel::postBlockLoad(int result)
             }
             m_dataMutex.unlock();
 
+            // prefetch in scrolling direction
+            m_pBlockCache->prefetch(m_pBlockCache->blockIndex(m_iFiffCursorBegin) - m_iTotalBlockCount, m_iTotalBlockCount);
+
             emit newBlocksLoaded();
 
             break;
@@ -924,6 +840,9 @@ void FiffRawViewModel::postBlockLoad(int result)
             }
             m_dataMutex.unlock();
 
+            // prefetch in scrolling direction
+            m_pBlockCache->prefetch(m_pBlockCache->blockIndex(m_iFiffCursorBegin) + m_iTotalBlockCount, m_iTotalBlockCount);
+
             emit newBlocksLoaded();
 
             break;
@@ -942,76 +861,33 @@ void FiffRawViewModel::postBlockLoad(int result)
 
 void FiffRawViewModel::reloadAllData()
 {
-    if(!m_pFiffInfo){
+    if(!m_pFiffInfo || !m_pBlockCache){
         return;
     }
 
     m_lData.clear();
     m_lFilteredData.clear();
 
-    MatrixXd matData, matTimes;
+    int iFirstBlock = m_pBlockCache->blockIndex(m_iFiffCursorBegin);
+    int iLastBlock = std::min(iFirstBlock + m_iTotalBlockCount, m_pBlockCache->blockCount()) - 1;
 
-    int start = m_iFiffCursorBegin;
+    // Get all blocks from the cache. Blocks which are not cached yet are read and filtered on demand.
+    for(int iBlock = iFirstBlock; iBlock <= iLastBlock; ++iBlock) {
+        QSharedPointer<RawDataBlock> pBlock = m_pBlockCache->rawBlock(iBlock);
+        QSharedPointer<RawDataBlock> pFilteredBlock = m_bPerformFiltering ? m_pBlockCache->filteredBlock(iBlock) : pBlock;
 
-    // for some reason the read_raw_segment function works with inclusive upper bound
-    int end = start + (m_iSamplesPerBlock * m_iTotalBlockCount) - 1;
-
-    // When filtering load more data than we need in order to allow arbiritary filter lengths
-    int iFilterDelay = 0;
-    bool bBeforeStartReached = false;
-
-    if(m_bPerformFiltering) {
-        iFilterDelay = m_filterKernel.getFilterOrder()/2;
-        end += m_filterKernel.getFilterOrder()/2;
-
-        // Check if we have reached the beginning of the file
-        if(start-iFilterDelay >= m_pFiffIO->m_qlistRaw[0]->first_samp) {
-            start -= m_filterKernel.getFilterOrder()/2;
-        } else {
-            // Add another filter delay because we need enough data to sucessfully filter with arbiritary filter lengths
-            end += m_filterKernel.getFilterOrder()/2;
-            iFilterDelay = 0;
-            bBeforeStartReached = true;
-        }
-    }
-
-    // read in all blocks
-    if(m_pFiffIO->m_qlistRaw[0]->read_raw_segment(matData, matTimes, start, end)) {
-        // qDebug() << "[FiffRawmodel::loadFiffData] Successfully read a block ";
-    } else {
-        qWarning() << "[FiffRawViewModel::loadFiffData] Could not read samples " << start << " to " << end;
-        return;
-    }
-
-    // append a matrix pair for each block
-    for(int i = 0; i < m_iTotalBlockCount; ++i) {
-        m_lData.push_back(QSharedPointer<QPair<MatrixXd, MatrixXd> >::create(qMakePair(matData.block(0, i*m_iSamplesPerBlock+iFilterDelay, matData.rows(), m_iSamplesPerBlock),
-                                                                                       matTimes.block(0, i*m_iSamplesPerBlock+iFilterDelay, matTimes.rows(), m_iSamplesPerBlock))));
-    }
-
-    // Filter data if activated, otherwise set to raw data
-    if(m_bPerformFiltering) {
-        bool bFilterSuccess = false;
-        if(bBeforeStartReached) {
-            iFilterDelay = m_filterKernel.getFilterOrder()/4;
-            bFilterSuccess = filterDataBlock(matData, true, true);
-        } else {
-            bFilterSuccess = filterDataBlock(matData, true);
-        }
-
-        if(!bFilterSuccess) {
-            m_lFilteredData = m_lData;
+        if(!pBlock || !pFilteredBlock) {
+            qWarning() << "[FiffRawViewModel::reloadAllData] Could not read block " << iBlock;
             return;
         }
 
-        for(int i = 0; i < m_iTotalBlockCount; ++i) {
-            m_lFilteredData.push_back(QSharedPointer<QPair<MatrixXd, MatrixXd> >::create(qMakePair(matData.block(0, (i*m_iSamplesPerBlock)+(2*iFilterDelay), matData.rows(), m_iSamplesPerBlock),
-                                                                                                   matTimes.block(0, (i*m_iSamplesPerBlock)+(2*iFilterDelay), matTimes.rows(), m_iSamplesPerBlock))));
-        }
-    } else {
-        m_lFilteredData = m_lData;
+        m_lData.push_back(pBlock);
+        m_lFilteredData.push_back(pFilteredBlock);
     }
 
+    // prefetch the following window, since scrolling forward is most likely
+    m_pBlockCache->prefetch(iLastBlock + 1, m_iTotalBlockCount);
+
     emit dataChanged(createIndex(0,0), createIndex(rowCount(), columnCount()));
 }
 
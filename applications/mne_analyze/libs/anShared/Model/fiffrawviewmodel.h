@@ -45,6 +45,7 @@
 #include "../anshared_global.h"
 #include "../Utils/types.h"
 #include "abstractmodel.h"
+#include "fiffrawblockcache.h"
 
 #include <fiff/fiff_io.h>
 #include <fiff/fifffilesharer.h>
@@ -76,10 +77,6 @@ namespace FIFFLIB {
     class FiffChInfo;
 }
 
-namespace RTPROCESSINGLIB {
-    class FilterOverlapAdd;
-}
-
 //=============================================================================================================
 // DEFINE NAMESPACE ANSHAREDLIB
 //=============================================================================================================
@@ -510,11 +507,7 @@ public:
     /**
      * Returns whether the model has an associated EventModel
      *
-<<<<<<< HEAD
-     * @return true if there is an AnnotationModel, false if not.
-=======
-     * @return true if there is an EventModel, false if not
->>>>>>> MAINT: renaming and cleaning up
+     * @return true if there is an EventModel, false if not.
      */
     bool hasSavedEvents();
 
@@ -522,11 +515,7 @@ public:
     /**
      * Sets the associated EventModel to pModel
      *
-<<<<<<< HEAD
-     * @param[in] pModel   associated annotation model.
-=======
-     * @param [in] pModel   associated event model
->>>>>>> MAINT: renaming and cleaning up
+     * @param[in] pModel   associated event model.
      */
     void setEventModel(QSharedPointer<ANSHAREDLIB::EventModel> pModel);
 
@@ -543,23 +532,15 @@ public:
 private:
     //=========================================================================================================
     /**
-     * Calculates the filtered version of one single datablock
-     *
-     * @param[in]   matData         The data block to be filtered.
-     * @param[in]   bFilterEnd      Whether to perform the overlap add in the beginning or end of the data.
-     * @param[in]   bKeepOverhead   Whether to keep the overhead.
-     *
-     * @return Returns true if filtering was performed, otherwise returns false.
+     * This is a helper method thats is meant to correctly set the endOfFile / startOfFile flags whenever needed
      */
-    bool filterDataBlock(MatrixXd& matData,
-                         bool bFilterEnd,
-                         bool bKeepOverhead = false);
+    void updateEndStartFlags();
 
     //=========================================================================================================
     /**
-     * This is a helper method thats is meant to correctly set the endOfFile / startOfFile flags whenever needed
+     * Passes the current filter settings to the block cache
      */
-    void updateEndStartFlags();
+    void updateBlockCacheFilter();
 
     //=========================================================================================================
     /**
@@ -608,10 +589,10 @@ private:
      */
     void readFromRealtimeFile(const QString &path);
 
-    std::list<QSharedPointer<QPair<MatrixXd, MatrixXd> > > m_lData;             /**< Data. */
-    std::list<QSharedPointer<QPair<MatrixXd, MatrixXd> > > m_lNewData;          /**< Data that is to be appended or prepended. */
-    std::list<QSharedPointer<QPair<MatrixXd, MatrixXd> > > m_lFilteredData;     /**< Filtered data. */
-    std::list<QSharedPointer<QPair<MatrixXd, MatrixXd> > > m_lFilteredNewData;  /**< Filtered data that is to be appended or prepended. */
+    std::list<QSharedPointer<RawDataBlock> > m_lData;             /**< Data. */
+    std::list<QSharedPointer<RawDataBlock> > m_lNewData;          /**< Data that is to be appended or prepended. */
+    std::list<QSharedPointer<RawDataBlock> > m_lFilteredData;     /**< Filtered data. */
+    std::list<QSharedPointer<RawDataBlock> > m_lFilteredNewData;  /**< Filtered data that is to be appended or prepended. */
 
     // Display stuff
     double      m_dDx;              /**< pixel difference to the next sample. */
@@ -632,6 +613,9 @@ private:
     bool m_bCurrentlyLoading;                       /**< Flag to indicate whether or not a background operation is going on. */
     mutable QMutex m_dataMutex;                     /**< Using mutable is not a pretty solution. */
 
+    // block cache
+    FiffRawBlockCache::SPtr m_pBlockCache;          /**< LRU cache holding the raw and filtered blocks. */
+
     // data stuff
     QFile m_file;
     QByteArray m_byteLoadedData;
@@ -640,7 +624,6 @@ private:
     // Filter stuff
     qint32                                      m_iMaxFilterLength;                         /**< Max order of the current filters. */
     QString                                     m_sFilterChannelType;                       /**< Kind of channel which is to be filtered. */
-    QSharedPointer<RTPROCESSINGLIB::FilterOverlapAdd>     m_pRtFilter;                                /**< The filter object. */
     Eigen::RowVectorXi                          m_lFilterChannelList;                       /**< The indices of the channels to be filtered.*/
     bool                                        m_bPerformFiltering;                        /**< Flag whether to activate/deactivate filtering. */
     RTPROCESSINGLIB::FilterKernel               m_filterKernel;                             /**< List of currently active filters. */
@@ -802,7 +785,7 @@ public:
         qint32 currentIndex;
 
         // Remember which block we are currently in
-        std::list<QSharedPointer<QPair<MatrixXd, MatrixXd> > >::const_iterator currentBlockToAccess;
+        std::list<QSharedPointer<RawDataBlock> >::const_iterator currentBlockToAccess;
         qint32 currentRelativeIndex; /**< Remember the relative sample in the current block. */
 
     public:
@@ -817,8 +800,8 @@ public:
             qint32 temp = currentIndex;
 
             // comparing temp against 0 to avoid index-out-of bound scenario for ChannelData::end()
-            while (temp > 0 && temp >= (*currentBlockToAccess)->first.cols()) {
-                temp -= (*currentBlockToAccess)->first.cols();
+            while (temp > 0 && temp >= (*currentBlockToAccess)->matData.cols()) {
+                temp -= (*currentBlockToAccess)->matData.cols();
                 currentBlockToAccess++;
             }
 
@@ -834,8 +817,8 @@ public:
         {
             currentIndex++;
             currentRelativeIndex++;
-            if (currentRelativeIndex >= (*currentBlockToAccess)->first.cols()) {
-                currentRelativeIndex -= (*currentBlockToAccess)->first.cols();
+            if (currentRelativeIndex >= (*currentBlockToAccess)->matData.cols()) {
+                currentRelativeIndex -= (*currentBlockToAccess)->matData.cols();
                 currentBlockToAccess++;
             }
 
@@ -846,8 +829,8 @@ public:
         {
             currentIndex++;
             currentRelativeIndex++;
-            if (currentRelativeIndex >= (*currentBlockToAccess)->first.cols()) {
-                currentRelativeIndex -= (*currentBlockToAccess)->first.cols();
+            if (currentRelativeIndex >= (*currentBlockToAccess)->matData.cols()) {
+                currentRelativeIndex -= (*currentBlockToAccess)->matData.cols();
                 currentBlockToAccess++;
             }
 
@@ -861,19 +844,19 @@ public:
 
         double operator * ()
         {
-            const double* pointerToMatrix = (*currentBlockToAccess)->first.data();
+            const float* pointerToMatrix = (*currentBlockToAccess)->matData.data();
 
-            // go to row
-            pointerToMatrix += cd->m_iRowNumber * (*currentBlockToAccess)->first.cols();
+            // go to sample (the matrices are stored in column major order)
+            pointerToMatrix += currentRelativeIndex * (*currentBlockToAccess)->matData.rows();
 
-            // go to sample
-            pointerToMatrix += currentRelativeIndex;
+            // go to row
+            pointerToMatrix += cd->m_iRowNumber;
 
             return *pointerToMatrix;
         }
     };
 
-    ChannelData(std::list<QSharedPointer<QPair<MatrixXd, MatrixXd>>>::const_iterator it,
+    ChannelData(std::list<QSharedPointer<RawDataBlock>>::const_iterator it,
                 qint32 numBlocks,
                 quint32 rowNumber)
     : m_lData()
@@ -886,11 +869,11 @@ public:
         }
 
         for (const auto &a : m_lData) {
-            m_iNumSamples += a->first.cols();
+            m_iNumSamples += a->matData.cols();
         }
     }
 
-    ChannelData(const std::list<QSharedPointer<QPair<MatrixXd, MatrixXd>>> data,
+    ChannelData(const std::list<QSharedPointer<RawDataBlock>> data,
                 unsigned long rowNumber)
     : ChannelData(data.begin(), static_cast<qint32>(data.size()), rowNumber)
     {
@@ -920,18 +903,18 @@ public:
     double operator [] (unsigned long i)
     {
         // see which block we have to access
-        std::list<QSharedPointer<QPair<MatrixXd, MatrixXd>>>::const_iterator blockToAccess = m_lData.begin();
-        while (i >= (unsigned long)(*blockToAccess)->first.cols())
+        std::list<QSharedPointer<RawDataBlock>>::const_iterator blockToAccess = m_lData.begin();
+        while (i >= (unsigned long)(*blockToAccess)->matData.cols())
         {
-            i -= (*blockToAccess)->first.cols();
+            i -= (*blockToAccess)->matData.cols();
             blockToAccess++;
         }
 
         // set the pointer to the start of matrix
-        const double* pointerToMatrix = (*blockToAccess)->first.data();
+        const float* pointerToMatrix = (*blockToAccess)->matData.data();
 
         // go to row
-        pointerToMatrix += i * (*blockToAccess)->first.rows();
+        pointerToMatrix += i * (*blockToAccess)->matData.rows();
 
         // go to sample
         pointerToMatrix += m_iRowNumber;
@@ -939,6 +922,19 @@ public:
         return *(pointerToMatrix);
     }
 
+    // accumulates the min/max envelope of the channel into bins, see DISPLIB::MinMaxPyramid::envelope
+    void envelope(double dBinsPerSample,
+                  Eigen::VectorXf& vecMin,
+                  Eigen::VectorXf& vecMax) const
+    {
+        qint64 iOffset = 0;
+
+        for (const auto &a : m_lData) {
+            a->envelope.envelope(m_iRowNumber, 0, a->matData.cols(), iOffset * dBinsPerSample, dBinsPerSample, vecMin, vecMax);
+            iOffset += a->matData.cols();
+        }
+    }
+
     unsigned long size() const
     {
         return m_iNumSamples;
@@ -964,7 +960,7 @@ public:
 private:
     // hold a list of smartpointers to the data that was in the model when the respective instance of ChannelData was created.
     // This prevents that pointers into the Eigen-matrices will become invalid when the background thread returns and changes the matrices.
-    std::list<QSharedPointer<QPair<MatrixXd, MatrixXd> > > m_lData;
+    std::list<QSharedPointer<RawDataBlock> > m_lData;
     quint32 m_iRowNumber;
     qint64 m_iNumSamples;
 };
@@ -94,6 +94,7 @@ SOURCES += \
     Model/bemdatamodel.cpp \
     Model/dipolefitmodel.cpp \
     Model/fiffrawviewmodel.cpp \
+    Model/fiffrawblockcache.cpp \
     Model/eventmodel.cpp \
     Model/averagingdatamodel.cpp \
     Model/mricoordmodel.cpp \
@@ -117,6 +118,7 @@ HEADERS += \
     Utils/types.h \
     Model/bemdatamodel.h \
     Model/fiffrawviewmodel.h \
+    Model/fiffrawblockcache.h \
     Model/eventmodel.h \
     Model/averagingdatamodel.h \
 
@@ -49,6 +49,9 @@
 
 #include <rtprocessing/helpers/filterkernel.h>
 
+#include <cmath>
+#include <limits>
+
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
@@ -67,6 +70,7 @@
 
 using namespace RAWDATAVIEWERPLUGIN;
 using namespace ANSHAREDLIB;
+using namespace Eigen;
 
 //=============================================================================================================
 // DEFINE MEMBER METHODS
@@ -244,6 +248,28 @@ void FiffRawViewDelegate::createPlotPath(const QStyleOptionViewItem &option,
 
     QPointF qSamplePosition;
 
+    //With two or more samples per pixel draw the min/max envelope per pixel column instead of every sample
+    if(dDx <= 0.5 && data.size() > 0) {
+        int iNumBins = static_cast<int>(std::ceil(data.size() * dDx)) + 1;
+        VectorXf vecMin = VectorXf::Constant(iNumBins, std::numeric_limits<float>::max());
+        VectorXf vecMax = VectorXf::Constant(iNumBins, std::numeric_limits<float>::lowest());
+
+        data.envelope(dDx, vecMin, vecMax);
+
+        double dX = path.currentPosition().x();
+
+        for(int i = 0; i < iNumBins; ++i) {
+            if(vecMin[i] > vecMax[i]) {
+                continue;
+            }
+
+            path.lineTo(QPointF(dX + i, y_base - vecMax[i] * dScaleY));
+            path.lineTo(QPointF(dX + i, y_base - vecMin[i] * dScaleY));
+        }
+
+        return;
+    }
+
     int iPaintStep = 1;
 
     for(unsigned int j = 0; j < data.size(); j = j + iPaintStep) {
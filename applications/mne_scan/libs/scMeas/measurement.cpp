@@ -39,11 +39,14 @@
 
 #include "measurement.h"
 
+#include <utils/mnetracer.h>
+
 //=============================================================================================================
 // USED NAMESPACES
 //=============================================================================================================
 
 using namespace SCMEASLIB;
+using namespace UTILSLIB;
 
 //=============================================================================================================
 // DEFINE MEMBER METHODS
@@ -54,6 +57,9 @@ Measurement::Measurement(int type,
 : QObject(parent)
 , m_iMetaTypeId(type)
 , m_bVisibility(true)
+, m_iAcquisitionTime(0)
+, m_iSequenceId(0)
+, m_bAcquisitionTimeSet(false)
 {
 //    qWarning() << "QMetaType" << type;
 }
@@ -63,3 +69,46 @@ Measurement::Measurement(int type,
 Measurement::~Measurement()
 {
 }
+
+//=============================================================================================================
+
+void Measurement::stamp()
+{
+    QMutexLocker locker(&m_qMutex);
+    ++m_iSequenceId;
+
+    if(!m_bAcquisitionTimeSet) {
+        m_iAcquisitionTime = MNETracer::getTimeNow();
+    }
+    m_bAcquisitionTimeSet = false;
+}
+
+//=============================================================================================================
+
+Measurement::SPtr Measurement::snapshot() const
+{
+    return Measurement::SPtr();
+}
+
+//=============================================================================================================
+
+void Measurement::copyStamp(const Measurement& other)
+{
+    qint64 iAcquisitionTime = other.getAcquisitionTime();
+    quint64 iSequenceId = other.getSequenceId();
+
+    QMutexLocker locker(&m_qMutex);
+    m_iAcquisitionTime = iAcquisitionTime;
+    m_iSequenceId = iSequenceId;
+}
+
+//=============================================================================================================
+
+void Measurement::stampAcquisitionTime()
+{
+    QMutexLocker locker(&m_qMutex);
+    if(!m_bAcquisitionTimeSet) {
+        m_iAcquisitionTime = MNETracer::getTimeNow();
+        m_bAcquisitionTimeSet = true;
+    }
+}
@@ -122,6 +122,48 @@ public:
      */
     inline int type() const;
 
+    //=========================================================================================================
+    /**
+     * Sets the acquisition time of the data which is sent next, e.g. to pass on the acquisition time of the input
+     * data of an algorithm. If not set, the data is stamped with the time it is sent.
+     *
+     * @param[in] iTime   the acquisition time in microseconds, see UTILSLIB::MNETracer::getTimeNow.
+     */
+    inline void setAcquisitionTime(qint64 iTime);
+
+    //=========================================================================================================
+    /**
+     * Returns the acquisition time of the data which was sent last.
+     *
+     * @return the acquisition time in microseconds, see UTILSLIB::MNETracer::getTimeNow.
+     */
+    inline qint64 getAcquisitionTime() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the sequence id of the data which was sent last. The id is incremented with every sent data block.
+     *
+     * @return the sequence id.
+     */
+    inline quint64 getSequenceId() const;
+
+    //=========================================================================================================
+    /**
+     * Stamps the data which is about to be sent with the next sequence id and its acquisition time. Called by the
+     * output connector before the receivers are notified.
+     */
+    void stamp();
+
+    //=========================================================================================================
+    /**
+     * Creates a copy of the data which was sent last. The copy stays valid while this measurement is refilled by the
+     * sender and can therefore be handed to receivers asynchronously. Measurements which cannot be copied return a
+     * null pointer and have to be delivered while the sender waits.
+     *
+     * @return the copy, or a null pointer if this measurement cannot be copied.
+     */
+    virtual Measurement::SPtr snapshot() const;
+
 signals:
     void notify();
 
@@ -134,11 +176,29 @@ protected:
      */
     inline void setType(int type);
 
+    //=========================================================================================================
+    /**
+     * Copies the acquisition time and sequence id, e.g. to a snapshot of this measurement.
+     *
+     * @param[in] other   the measurement to copy the stamp from.
+     */
+    void copyStamp(const Measurement& other);
+
+    //=========================================================================================================
+    /**
+     * Sets the acquisition time of the data which is sent next to now, unless it was already set. Measurements which
+     * gather data over several calls use this when the first data arrives.
+     */
+    void stampAcquisitionTime();
+
 private:
     mutable QMutex                      m_qMutex;           /**< Mutex to ensure thread safety. */
     int                                 m_iMetaTypeId;      /**< QMetaType id of the Measurement. */
     QString                             m_qString_Name;     /**< Name of the Measurement. */
     bool                                m_bVisibility;      /**< Visibility status. */
+    qint64                              m_iAcquisitionTime; /**< Acquisition time of the last sent data in microseconds. */
+    quint64                             m_iSequenceId;      /**< Sequence id of the last sent data. */
+    bool                                m_bAcquisitionTimeSet;  /**< Whether the acquisition time was set for the next data. */
 };
 
 //=============================================================================================================
@@ -191,6 +251,31 @@ inline int Measurement::type() const
     return m_iMetaTypeId;
 }
 
+//=============================================================================================================
+
+inline void Measurement::setAcquisitionTime(qint64 iTime)
+{
+    QMutexLocker locker(&m_qMutex);
+    m_iAcquisitionTime = iTime;
+    m_bAcquisitionTimeSet = true;
+}
+
+//=============================================================================================================
+
+inline qint64 Measurement::getAcquisitionTime() const
+{
+    QMutexLocker locker(&m_qMutex);
+    return m_iAcquisitionTime;
+}
+
+//=============================================================================================================
+
+inline quint64 Measurement::getSequenceId() const
+{
+    QMutexLocker locker(&m_qMutex);
+    return m_iSequenceId;
+}
+
 } //NAMESPACE
 
 Q_DECLARE_METATYPE(SCMEASLIB::Measurement::SPtr)
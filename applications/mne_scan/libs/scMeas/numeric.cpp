@@ -79,3 +79,19 @@ double Numeric::getValue() const
     QMutexLocker locker(&m_qMutex);
     return m_dValue;
 }
+
+//=============================================================================================================
+
+Measurement::SPtr Numeric::snapshot() const
+{
+    Numeric::SPtr pCopy = Numeric::SPtr(new Numeric());
+    pCopy->setName(getName());
+    pCopy->setVisibility(isVisible());
+    pCopy->copyStamp(*this);
+
+    QMutexLocker locker(&m_qMutex);
+    pCopy->m_qString_Unit = m_qString_Unit;
+    pCopy->m_dValue = m_dValue;
+
+    return pCopy;
+}
@@ -118,6 +118,14 @@ public:
      */
     virtual double getValue() const;
 
+    //=========================================================================================================
+    /**
+     * Creates a copy of the value which was sent last. The copy stays valid while new values are set.
+     *
+     * @return the copy.
+     */
+    virtual Measurement::SPtr snapshot() const;
+
 private:
     mutable QMutex  m_qMutex;   /**< Mutex to ensure thread safety. */
 
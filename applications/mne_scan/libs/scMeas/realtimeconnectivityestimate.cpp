@@ -104,3 +104,23 @@ void RealTimeConnectivityEstimate::setValue(const Network& v)
     emit notify();
 }
 
+//=============================================================================================================
+
+Measurement::SPtr RealTimeConnectivityEstimate::snapshot() const
+{
+    RealTimeConnectivityEstimate::SPtr pCopy = RealTimeConnectivityEstimate::SPtr(new RealTimeConnectivityEstimate());
+    pCopy->setName(getName());
+    pCopy->setVisibility(isVisible());
+    pCopy->copyStamp(*this);
+
+    QMutexLocker locker(&m_qMutex);
+    pCopy->m_pFiffInfo = m_pFiffInfo;
+    pCopy->m_pAnnotSet = m_pAnnotSet;
+    pCopy->m_pSurfSet = m_pSurfSet;
+    pCopy->m_pFwdSolution = m_pFwdSolution;
+    pCopy->m_pSensorSurface = m_pSensorSurface;
+    *pCopy->m_pNetwork = *m_pNetwork;
+    pCopy->m_bInitialized = m_bInitialized;
+
+    return pCopy;
+}
@@ -211,6 +211,15 @@ public:
      */
     QSharedPointer<FIFFLIB::FiffInfo> getFiffInfo();
 
+    //=========================================================================================================
+    /**
+     * Creates a copy of the network which was sent last. The network is copied, since it is overwritten by the next
+     * setValue() call.
+     *
+     * @return the copy.
+     */
+    virtual Measurement::SPtr snapshot() const;
+
 private:
     mutable QMutex                              m_qMutex;           /**< Mutex to ensure thread safety. */
 
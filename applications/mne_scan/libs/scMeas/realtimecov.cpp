@@ -105,3 +105,19 @@ void RealTimeCov::setValue(const FiffCov& v)
     emit notify();
 }
 
+//=============================================================================================================
+
+Measurement::SPtr RealTimeCov::snapshot() const
+{
+    RealTimeCov::SPtr pCopy = RealTimeCov::SPtr(new RealTimeCov());
+    pCopy->setName(getName());
+    pCopy->setVisibility(isVisible());
+    pCopy->copyStamp(*this);
+
+    QMutexLocker locker(&m_qMutex);
+    *pCopy->m_pFiffCov = *m_pFiffCov;
+    pCopy->m_pFiffInfo = m_pFiffInfo;
+    pCopy->m_bInitialized = m_bInitialized;
+
+    return pCopy;
+}
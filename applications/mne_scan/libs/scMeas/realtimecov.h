@@ -131,6 +131,15 @@ public:
      */
     inline bool isInitialized() const;
 
+    //=========================================================================================================
+    /**
+     * Creates a copy of the covariance which was sent last. The covariance is copied, since it is overwritten by the
+     * next setValue() call.
+     *
+     * @return the copy.
+     */
+    virtual Measurement::SPtr snapshot() const;
+
 private:
     mutable QMutex          m_qMutex;       /**< Mutex to ensure thread safety. */
 
@@ -163,3 +163,24 @@ void RealTimeEvokedSet::setValue(const FiffEvokedSet &v,
 }
 
 //=============================================================================================================
+
+Measurement::SPtr RealTimeEvokedSet::snapshot() const
+{
+    RealTimeEvokedSet::SPtr pCopy = RealTimeEvokedSet::SPtr(new RealTimeEvokedSet());
+    pCopy->setName(getName());
+    pCopy->setVisibility(isVisible());
+    pCopy->copyStamp(*this);
+
+    QMutexLocker locker(&m_qMutex);
+    *pCopy->m_pFiffEvokedSet = *m_pFiffEvokedSet;
+    pCopy->m_lResponsibleTriggerTypes = m_lResponsibleTriggerTypes;
+    pCopy->m_pFiffInfo = m_pFiffInfo;
+    pCopy->m_sXMLLayoutFile = m_sXMLLayoutFile;
+    pCopy->m_iPreStimSamples = m_iPreStimSamples;
+    pCopy->m_qListChColors = m_qListChColors;
+    pCopy->m_qListChInfo = m_qListChInfo;
+    pCopy->m_bInitialized = m_bInitialized;
+    pCopy->m_pairBaseline = m_pairBaseline;
+
+    return pCopy;
+}
@@ -223,6 +223,15 @@ public:
      */
     inline QPair<qint32,qint32> getBaselineInfo();
 
+    //=========================================================================================================
+    /**
+     * Creates a copy of the evoked set which was sent last. The evoked set is copied, since it is overwritten by the
+     * next setValue() call.
+     *
+     * @return the copy.
+     */
+    virtual Measurement::SPtr snapshot() const;
+
 private:
     //=========================================================================================================
     /**
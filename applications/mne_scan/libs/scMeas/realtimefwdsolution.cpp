@@ -145,3 +145,23 @@ void RealTimeFwdSolution::setSolGrad(const FiffNamedMatrix::SDPtr& pNamedMatSolG
 
     emit notify();
 }
+
+//=============================================================================================================
+
+Measurement::SPtr RealTimeFwdSolution::snapshot() const
+{
+    RealTimeFwdSolution::SPtr pCopy = RealTimeFwdSolution::SPtr(new RealTimeFwdSolution());
+    pCopy->setName(getName());
+    pCopy->setVisibility(isVisible());
+    pCopy->copyStamp(*this);
+
+    QMutexLocker locker(&m_qMutex);
+    pCopy->m_bInitialized = m_bInitialized;
+    pCopy->m_bClustered = m_bClustered;
+    pCopy->m_pFwdSolution = m_pFwdSolution;
+    pCopy->m_pFiffInfo = m_pFiffInfo;
+    pCopy->m_pNamedMatSol = m_pNamedMatSol;
+    pCopy->m_pNamedMatSolGrad = m_pNamedMatSolGrad;
+
+    return pCopy;
+}
@@ -181,6 +181,15 @@ public:
      */
     inline bool isInitialized() const;
 
+    //=========================================================================================================
+    /**
+     * Creates a copy of the forward solution which was sent last. The forward solution is shared, since setValue()
+     * replaces it instead of changing it.
+     *
+     * @return the copy.
+     */
+    virtual Measurement::SPtr snapshot() const;
+
 private:
     mutable QMutex          m_qMutex;                                       /**< Mutex to ensure thread safety. */
     bool                    m_bInitialized;                                 /**< If values are stored.*/
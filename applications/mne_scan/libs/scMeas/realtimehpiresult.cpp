@@ -112,3 +112,21 @@ void RealTimeHpiResult::setDigitizerData(QSharedPointer<FIFFLIB::FiffDigitizerDa
     QMutexLocker lock(&m_qMutex);
     m_pFiffDigData = digData;
 }
+
+//=============================================================================================================
+
+Measurement::SPtr RealTimeHpiResult::snapshot() const
+{
+    RealTimeHpiResult::SPtr pCopy = RealTimeHpiResult::SPtr(new RealTimeHpiResult());
+    pCopy->setName(getName());
+    pCopy->setVisibility(isVisible());
+    pCopy->copyStamp(*this);
+
+    QMutexLocker locker(&m_qMutex);
+    pCopy->m_bInitialized = m_bInitialized;
+    *pCopy->m_pHpiFitResult = *m_pHpiFitResult;
+    pCopy->m_pFiffInfo = m_pFiffInfo;
+    pCopy->m_pFiffDigData = m_pFiffDigData;
+
+    return pCopy;
+}
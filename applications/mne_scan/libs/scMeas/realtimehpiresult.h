@@ -154,6 +154,15 @@ public:
      */
     void setDigitizerData(QSharedPointer<FIFFLIB::FiffDigitizerData> digData);
 
+    //=========================================================================================================
+    /**
+     * Creates a copy of the HPI fit result which was sent last. The fit result is copied, since it is overwritten by
+     * the next setValue() call.
+     *
+     * @return the copy.
+     */
+    virtual Measurement::SPtr snapshot() const;
+
 private:
     mutable QMutex          m_qMutex;                               /**< Mutex to ensure thread safety. */
     bool                    m_bInitialized;                         /**< If values are stored.*/
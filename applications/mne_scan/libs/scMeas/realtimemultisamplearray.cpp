@@ -158,7 +158,9 @@ void RealTimeMultiSampleArray::setValue(const MatrixXd& mat)
 //        else if(v[i] > m_qListChInfo[i].getMaxValue()) v[i] = m_qListChInfo[i].getMaxValue();
 //    }
 
-    //Store
+    //Store, the first block determines the acquisition time of the multi sample array
+    if(m_matSamples.isEmpty())
+        stampAcquisitionTime();
     m_matSamples.push_back(mat);
 
     m_qMutex.unlock();
@@ -178,3 +180,25 @@ void RealTimeMultiSampleArray::setDigitizerData(QSharedPointer<FIFFLIB::FiffDigi
     QMutexLocker locker(&m_qMutex);
     m_pFiffDigitizerData_orig = digData;
 }
+
+//=============================================================================================================
+
+Measurement::SPtr RealTimeMultiSampleArray::snapshot() const
+{
+    RealTimeMultiSampleArray::SPtr pCopy = RealTimeMultiSampleArray::SPtr(new RealTimeMultiSampleArray());
+    pCopy->setName(getName());
+    pCopy->setVisibility(isVisible());
+    pCopy->copyStamp(*this);
+
+    QMutexLocker locker(&m_qMutex);
+    pCopy->m_pFiffInfo_orig = m_pFiffInfo_orig;
+    pCopy->m_pFiffDigitizerData_orig = m_pFiffDigitizerData_orig;
+    pCopy->m_sXMLLayoutFile = m_sXMLLayoutFile;
+    pCopy->m_fSamplingRate = m_fSamplingRate;
+    pCopy->m_iMultiArraySize = m_iMultiArraySize;
+    pCopy->m_matSamples = m_matSamples;
+    pCopy->m_bChInfoIsInit = m_bChInfoIsInit;
+    pCopy->m_qListChInfo = m_qListChInfo;
+
+    return pCopy;
+}
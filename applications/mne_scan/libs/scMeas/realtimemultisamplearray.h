@@ -230,6 +230,16 @@ public:
      */
     void setDigitizerData(QSharedPointer<FIFFLIB::FiffDigitizerData> digData);
 
+    //=========================================================================================================
+    /**
+     * Creates a detached copy which holds the currently gathered multi sample array. The sample list is implicitly
+     * shared, so this is cheap. The copy stays valid after this measurement cleared its samples and can therefore be
+     * handed to receivers asynchronously.
+     *
+     * @return the copy.
+     */
+    virtual Measurement::SPtr snapshot() const;
+
 private:
     mutable QMutex              m_qMutex;           /**< Mutex to ensure thread safety. */
 
@@ -102,3 +102,24 @@ void RealTimeSourceEstimate::setValue(MNESourceEstimate& v)
     }
 }
 
+//=============================================================================================================
+
+Measurement::SPtr RealTimeSourceEstimate::snapshot() const
+{
+    RealTimeSourceEstimate::SPtr pCopy = RealTimeSourceEstimate::SPtr(new RealTimeSourceEstimate());
+    pCopy->setName(getName());
+    pCopy->setVisibility(isVisible());
+    pCopy->copyStamp(*this);
+
+    QMutexLocker locker(&m_qMutex);
+    pCopy->m_pFiffInfo = m_pFiffInfo;
+    pCopy->m_mriHeadTrans = m_mriHeadTrans;
+    pCopy->m_pAnnotSet = m_pAnnotSet;
+    pCopy->m_pSurfSet = m_pSurfSet;
+    pCopy->m_pFwdSolution = m_pFwdSolution;
+    pCopy->m_iSourceEstimateSize = m_iSourceEstimateSize;
+    pCopy->m_pMNEStc = m_pMNEStc;
+    pCopy->m_bInitialized = m_bInitialized;
+
+    return pCopy;
+}
@@ -219,6 +219,15 @@ public:
      */
     inline qint32 getSourceEstimateSize() const;
 
+    //=========================================================================================================
+    /**
+     * Creates a copy of the gathered source estimates which were sent last. The copy stays valid after this measurement
+     * cleared its list of source estimates.
+     *
+     * @return the copy.
+     */
+    virtual Measurement::SPtr snapshot() const;
+
 private:
     mutable QMutex                          m_qMutex;               /**< Mutex to ensure thread safety. */
 
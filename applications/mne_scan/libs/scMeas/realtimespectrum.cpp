@@ -106,3 +106,20 @@ void RealTimeSpectrum::setValue(MatrixXd& v)
         m_bContainsValues = true;
 }
 
+//=============================================================================================================
+
+Measurement::SPtr RealTimeSpectrum::snapshot() const
+{
+    RealTimeSpectrum::SPtr pCopy = RealTimeSpectrum::SPtr(new RealTimeSpectrum());
+    pCopy->setName(getName());
+    pCopy->setVisibility(isVisible());
+    pCopy->copyStamp(*this);
+
+    pCopy->m_pFiffInfo = m_pFiffInfo;
+    pCopy->m_matValue = m_matValue;
+    pCopy->m_bIsInit = m_bIsInit;
+    pCopy->m_bContainsValues = m_bContainsValues;
+    pCopy->m_xScaleType = m_xScaleType;
+
+    return pCopy;
+}
@@ -153,6 +153,14 @@ public:
      */
     inline bool containsValues() const;
 
+    //=========================================================================================================
+    /**
+     * Creates a copy of the spectrum which was sent last. The copy stays valid while new values are set.
+     *
+     * @return the copy.
+     */
+    virtual Measurement::SPtr snapshot() const;
+
 private:
     FIFFLIB::FiffInfo::SPtr         m_pFiffInfo;    /**< Original Fiff Info if initialized by fiff info. */
 
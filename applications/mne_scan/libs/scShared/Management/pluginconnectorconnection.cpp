@@ -78,10 +78,7 @@ PluginConnectorConnection::~PluginConnectorConnection()
 
 void PluginConnectorConnection::clearConnection()
 {
-    QHash<QPair<QString, QString>, QMetaObject::Connection>::iterator it;
-    for (it = m_qHashConnections.begin(); it != m_qHashConnections.end(); ++it)
-        disconnect(it.value());
-
+    // The edges disconnect from their senders when they are destroyed
     m_qHashConnections.clear();
 }
 
@@ -108,11 +105,7 @@ bool PluginConnectorConnection::createConnection()
             QSharedPointer< PluginInputData<RealTimeMultiSampleArray> > receiverRTMSA = m_pReceiver->getInputConnectors()[j].dynamicCast< PluginInputData<RealTimeMultiSampleArray> >();
             if(senderRTMSA && receiverRTMSA)
             {
-                // We need to use BlockingQueuedConnection here because the FiffSimulator is still dispatching its data from a different thread via the direct connect signal method
-                m_qHashConnections.insert(QPair<QString,QString>(m_pSender->getOutputConnectors()[i]->getName(),
-                                                                 m_pReceiver->getInputConnectors()[j]->getName()),
-                                          connect(m_pSender->getOutputConnectors()[i].data(), &PluginOutputConnector::notify,
-                                                  m_pReceiver->getInputConnectors()[j].data(), &PluginInputConnector::update, Qt::BlockingQueuedConnection));
+                connectConnectors(m_pSender->getOutputConnectors()[i], m_pReceiver->getInputConnectors()[j]);
                 bConnected = true;
                 break;
             }
@@ -122,11 +115,7 @@ bool PluginConnectorConnection::createConnection()
             QSharedPointer< PluginInputData<RealTimeEvokedSet> > receiverRTESet = m_pReceiver->getInputConnectors()[j].dynamicCast< PluginInputData<RealTimeEvokedSet> >();
             if(senderRTESet && receiverRTESet)
             {
-                // We cannot use BlockingQueuedConnection here because Averaging is dispatching its data from the main thread via the onNewEvokedSet method
-                m_qHashConnections.insert(QPair<QString,QString>(m_pSender->getOutputConnectors()[i]->getName(),
-                                                                 m_pReceiver->getInputConnectors()[j]->getName()),
-                                          connect(m_pSender->getOutputConnectors()[i].data(), &PluginOutputConnector::notify,
-                                                  m_pReceiver->getInputConnectors()[j].data(), &PluginInputConnector::update, Qt::BlockingQueuedConnection));
+                connectConnectors(m_pSender->getOutputConnectors()[i], m_pReceiver->getInputConnectors()[j]);
                 bConnected = true;
                 break;
             }
@@ -136,10 +125,7 @@ bool PluginConnectorConnection::createConnection()
             QSharedPointer< PluginInputData<RealTimeCov> > receiverRTC = m_pReceiver->getInputConnectors()[j].dynamicCast< PluginInputData<RealTimeCov> >();
             if(senderRTC && receiverRTC)
             {
-                m_qHashConnections.insert(QPair<QString,QString>(m_pSender->getOutputConnectors()[i]->getName(),
-                                                                 m_pReceiver->getInputConnectors()[j]->getName()),
-                                          connect(m_pSender->getOutputConnectors()[i].data(), &PluginOutputConnector::notify,
-                                                  m_pReceiver->getInputConnectors()[j].data(), &PluginInputConnector::update, Qt::BlockingQueuedConnection));
+                connectConnectors(m_pSender->getOutputConnectors()[i], m_pReceiver->getInputConnectors()[j]);
                 bConnected = true;
                 break;
             }
@@ -149,10 +135,7 @@ bool PluginConnectorConnection::createConnection()
             QSharedPointer< PluginInputData<RealTimeSourceEstimate> > receiverRTSE = m_pReceiver->getInputConnectors()[j].dynamicCast< PluginInputData<RealTimeSourceEstimate> >();
             if(senderRTSE && receiverRTSE)
             {
-                m_qHashConnections.insert(QPair<QString,QString>(m_pSender->getOutputConnectors()[i]->getName(),
-                                                                 m_pReceiver->getInputConnectors()[j]->getName()),
-                                          connect(m_pSender->getOutputConnectors()[i].data(), &PluginOutputConnector::notify,
-                                                  m_pReceiver->getInputConnectors()[j].data(), &PluginInputConnector::update, Qt::BlockingQueuedConnection));
+                connectConnectors(m_pSender->getOutputConnectors()[i], m_pReceiver->getInputConnectors()[j]);
                 bConnected = true;
                 break;
             }
@@ -162,10 +145,7 @@ bool PluginConnectorConnection::createConnection()
             QSharedPointer< PluginInputData<RealTimeHpiResult> > receiverRTHR = m_pReceiver->getInputConnectors()[j].dynamicCast< PluginInputData<RealTimeHpiResult> >();
             if(senderRTHR && receiverRTHR)
             {
-                m_qHashConnections.insert(QPair<QString,QString>(m_pSender->getOutputConnectors()[i]->getName(),
-                                                                  m_pReceiver->getInputConnectors()[j]->getName()),
-                                          connect(m_pSender->getOutputConnectors()[i].data(), &PluginOutputConnector::notify,
-                                                  m_pReceiver->getInputConnectors()[j].data(), &PluginInputConnector::update, Qt::BlockingQueuedConnection));
+                connectConnectors(m_pSender->getOutputConnectors()[i], m_pReceiver->getInputConnectors()[j]);
                 bConnected = true;
                 break;
             }
@@ -175,10 +155,7 @@ bool PluginConnectorConnection::createConnection()
             QSharedPointer< PluginInputData<RealTimeFwdSolution> > receiverRTFS = m_pReceiver->getInputConnectors()[j].dynamicCast< PluginInputData<RealTimeFwdSolution> >();
             if(senderRTFS && receiverRTFS)
             {
-                m_qHashConnections.insert(QPair<QString,QString>(m_pSender->getOutputConnectors()[i]->getName(),
-                                                                  m_pReceiver->getInputConnectors()[j]->getName()),
-                                          connect(m_pSender->getOutputConnectors()[i].data(), &PluginOutputConnector::notify,
-                                                  m_pReceiver->getInputConnectors()[j].data(), &PluginInputConnector::update, Qt::BlockingQueuedConnection));
+                connectConnectors(m_pSender->getOutputConnectors()[i], m_pReceiver->getInputConnectors()[j]);
                 bConnected = true;
                 break;
             }
@@ -190,7 +167,7 @@ bool PluginConnectorConnection::createConnection()
     }
 
     //DEBUG
-    QHash<QPair<QString, QString>, QMetaObject::Connection>::iterator it;
+    QHash<QPair<QString, QString>, PluginConnectorEdge::SPtr>::iterator it;
     for (it = m_qHashConnections.begin(); it != m_qHashConnections.end(); ++it)
         qDebug() << "Connected: " << it.key().first << it.key().second;
     //DEBUG
@@ -200,6 +177,33 @@ bool PluginConnectorConnection::createConnection()
 
 //=============================================================================================================
 
+void PluginConnectorConnection::connectConnectors(PluginOutputConnector::SPtr pOutput,
+                                                  PluginInputConnector::SPtr pInput)
+{
+    PluginConnectorEdge::SPtr pEdge;
+
+    switch(getDataType(pOutput)) {
+        case ConnectorDataType::_RTC:
+        case ConnectorDataType::_RTHR:
+        case ConnectorDataType::_RTFS:
+            // Only the latest state is of interest
+            pEdge = PluginConnectorEdge::SPtr(new PluginConnectorEdge(pOutput, pInput, PluginConnectorEdge::Coalesce, 1));
+            break;
+
+        default:
+            // No data is lost, the sender waits if the receiver does not keep up
+            pEdge = PluginConnectorEdge::SPtr(new PluginConnectorEdge(pOutput, pInput, PluginConnectorEdge::Block, 64));
+            break;
+    }
+
+    // Name of the edge in latency traces
+    pEdge->setObjectName(QString("%1 -> %2/%3").arg(m_pSender->getName()).arg(m_pReceiver->getName()).arg(pInput->getName()));
+
+    m_qHashConnections.insert(QPair<QString,QString>(pOutput->getName(), pInput->getName()), pEdge);
+}
+
+//=============================================================================================================
+
 ConnectorDataType PluginConnectorConnection::getDataType(QSharedPointer<PluginConnector> pPluginConnector)
 {
     QSharedPointer< PluginOutputData<SCMEASLIB::RealTimeEvokedSet> > RTES_Out = pPluginConnector.dynamicCast< PluginOutputData<SCMEASLIB::RealTimeEvokedSet> >();
@@ -229,7 +233,7 @@ ConnectorDataType PluginConnectorConnection::getDataType(QSharedPointer<PluginCo
 
     QSharedPointer< PluginOutputData<SCMEASLIB::RealTimeFwdSolution> > RTFS_Out = pPluginConnector.dynamicCast< PluginOutputData<SCMEASLIB::RealTimeFwdSolution> >();
     QSharedPointer< PluginInputData<SCMEASLIB::RealTimeFwdSolution> > RTFS_In = pPluginConnector.dynamicCast< PluginInputData<SCMEASLIB::RealTimeFwdSolution> >();
-    if(RTHR_Out || RTHR_In)
+    if(RTFS_Out || RTFS_In)
         return ConnectorDataType::_RTFS;
 
     QSharedPointer< PluginOutputData<SCMEASLIB::Numeric> > Num_Out = pPluginConnector.dynamicCast< PluginOutputData<SCMEASLIB::Numeric> >();
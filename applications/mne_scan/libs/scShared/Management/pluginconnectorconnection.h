@@ -44,14 +44,16 @@
 
 #include "plugininputconnector.h"
 #include "pluginoutputconnector.h"
+#include "pluginconnectoredge.h"
 
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
 
 #include <QObject>
-#include <QMetaObject>
 #include <QSharedPointer>
+#include <QHash>
+#include <QPair>
 
 //=============================================================================================================
 // DEFINE NAMESPACE SCSHAREDLIB
@@ -120,6 +122,14 @@ public:
 
     inline bool isConnected();
 
+    //=========================================================================================================
+    /**
+     * Returns the edges between the connected output and input connectors, e.g. to read their counters.
+     *
+     * @return the edges.
+     */
+    inline QList<PluginConnectorEdge::SPtr> getEdges() const;
+
     //=========================================================================================================
     /**
      * The connector connection setup widget
@@ -137,10 +147,22 @@ private:
      */
     bool createConnection();
 
+    //=========================================================================================================
+    /**
+     * Connects an output connector of the sender to an input connector of the receiver. State like measurements
+     * (covariance, forward solution, HPI result) are coalesced, all others are queued and the oldest is dropped
+     * if the receiver cannot keep up.
+     *
+     * @param[in] pOutput    the output connector.
+     * @param[in] pInput     the input connector.
+     */
+    void connectConnectors(PluginOutputConnector::SPtr pOutput,
+                           PluginInputConnector::SPtr pInput);
+
     AbstractPlugin::SPtr m_pSender;
     AbstractPlugin::SPtr m_pReceiver;
 
-    QHash<QPair<QString, QString>, QMetaObject::Connection> m_qHashConnections; /**< QHash which holds the connections between sender and receiver QHash<QPair<Sender,Receiver>, Connection>. */
+    QHash<QPair<QString, QString>, PluginConnectorEdge::SPtr> m_qHashConnections; /**< QHash which holds the edges between sender and receiver QHash<QPair<Sender,Receiver>, Edge>. */
 };
 
 //=============================================================================================================
@@ -173,6 +195,13 @@ inline bool PluginConnectorConnection::isConnected()
 {
     return m_qHashConnections.size() > 0 ? true : false;
 }
+
+//=============================================================================================================
+
+inline QList<PluginConnectorEdge::SPtr> PluginConnectorConnection::getEdges() const
+{
+    return m_qHashConnections.values();
+}
 } // NAMESPACE
 
 #endif // PLUGINCONNECTORCONNECTION_H
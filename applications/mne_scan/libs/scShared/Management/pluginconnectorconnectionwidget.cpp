@@ -101,11 +101,15 @@ PluginConnectorConnectionWidget::PluginConnectorConnectionWidget(PluginConnector
         }
 
         layout->addWidget(m_pComboBox,curRow,1);
+
+        QLabel* pLabelStatistics = new QLabel(this);
+        m_qMapSenderToStatistics.insert(t_sSenderName,pLabelStatistics);
+        layout->addWidget(pLabelStatistics,curRow,2);
         ++curRow;
     }
 
     //Look for existing connections
-    QHash<QPair<QString, QString>, QMetaObject::Connection>::iterator it;
+    QHash<QPair<QString, QString>, PluginConnectorEdge::SPtr>::iterator it;
     for (it = pPluginConnectorConnection->m_qHashConnections.begin(); it != pPluginConnectorConnection->m_qHashConnections.end(); ++it)
     {
         QComboBox* m_pComboBox = m_qMapSenderToReceiverConnections[it.key().first];
@@ -128,6 +132,11 @@ PluginConnectorConnectionWidget::PluginConnectorConnectionWidget(PluginConnector
     layout->addWidget(rightFiller,1,3,curRow-1,1);
 
     this->setLayout(layout);
+
+    connect(&m_qTimerStatistics, &QTimer::timeout,
+            this, &PluginConnectorConnectionWidget::updateStatistics);
+    m_qTimerStatistics.start(500);
+    updateStatistics();
 }
 
 //=============================================================================================================
@@ -166,10 +175,8 @@ void PluginConnectorConnectionWidget::updateReceiver(const QString &p_sCurrentRe
                 if(m_pPluginConnectorConnection->m_pReceiver->getInputConnectors()[j]->getName() == p_sCurrentReceiver)
                     break;
 
-            m_pPluginConnectorConnection->m_qHashConnections.insert(QPair<QString,QString>(m_pPluginConnectorConnection->m_pSender->getOutputConnectors()[i]->getName(),
-                                                                                           m_pPluginConnectorConnection->m_pReceiver->getInputConnectors()[j]->getName()),
-                                                                    connect(m_pPluginConnectorConnection->m_pSender->getOutputConnectors()[i].data(), &PluginOutputConnector::notify,
-                                                                            m_pPluginConnectorConnection->m_pReceiver->getInputConnectors()[j].data(), &PluginInputConnector::update, Qt::BlockingQueuedConnection));
+            m_pPluginConnectorConnection->connectConnectors(m_pPluginConnectorConnection->m_pSender->getOutputConnectors()[i],
+                                                            m_pPluginConnectorConnection->m_pReceiver->getInputConnectors()[j]);
         }
     }
 
@@ -179,9 +186,35 @@ void PluginConnectorConnectionWidget::updateReceiver(const QString &p_sCurrentRe
         if(it.value() != t_qComboBox && it.value()->currentText() == p_sCurrentReceiver)
         {
             QPair<QString, QString> t_qPair(it.key(),it.value()->currentText());
-            disconnect(m_pPluginConnectorConnection->m_qHashConnections[t_qPair]);
             m_pPluginConnectorConnection->m_qHashConnections.remove(t_qPair);
             it.value()->setCurrentIndex(0);
         }
     }
 }
+
+//=============================================================================================================
+
+void PluginConnectorConnectionWidget::updateStatistics()
+{
+    QMap<QString, QLabel*>::iterator itLabel;
+    for (itLabel = m_qMapSenderToStatistics.begin(); itLabel != m_qMapSenderToStatistics.end(); ++itLabel)
+        itLabel.value()->clear();
+
+    QHash<QPair<QString, QString>, PluginConnectorEdge::SPtr>::iterator it;
+    for (it = m_pPluginConnectorConnection->m_qHashConnections.begin(); it != m_pPluginConnectorConnection->m_qHashConnections.end(); ++it)
+    {
+        QLabel* pLabel = m_qMapSenderToStatistics.value(it.key().first, Q_NULLPTR);
+        if(!pLabel)
+            continue;
+
+        PluginConnectorEdge::Statistics statistics = it.value()->statistics();
+        pLabel->setText(tr("Queue %1/%2 (max %3), replaced %4, latency %5 ms (mean %6, max %7)")
+                        .arg(statistics.iQueueDepth)
+                        .arg(it.value()->getCapacity())
+                        .arg(statistics.iMaxQueueDepth)
+                        .arg(statistics.iCoalesced)
+                        .arg(statistics.dLatencyMs, 0, 'f', 1)
+                        .arg(statistics.dMeanLatencyMs, 0, 'f', 1)
+                        .arg(statistics.dMaxLatencyMs, 0, 'f', 1));
+    }
+}
@@ -47,6 +47,7 @@
 #include <QLabel>
 #include <QWidget>
 #include <QComboBox>
+#include <QTimer>
 
 //=============================================================================================================
 // DEFINE NAMESPACE SCSHAREDLIB
@@ -97,6 +98,12 @@ public:
      */
     void updateReceiver(const QString &p_sCurrentReceiver);
 
+    //=========================================================================================================
+    /**
+     * Shows the current queue depth, drops and latency of each connected output.
+     */
+    void updateStatistics();
+
 signals:
 
 public slots:
@@ -107,6 +114,9 @@ private:
     PluginConnectorConnection*  m_pPluginConnectorConnection;   /**< a pointer to corresponding PluginConnectorConnection.*/
 
     QMap<QString, QComboBox*> m_qMapSenderToReceiverConnections;/**< To each output a possible list of inputs. */
+    QMap<QString, QLabel*> m_qMapSenderToStatistics;            /**< To each output the counters of its edge. */
+
+    QTimer m_qTimerStatistics;                                  /**< Refreshes the counters. */
 };
 } // NAMESPACE
 
@@ -0,0 +1,309 @@
+//=============================================================================================================
+/**
+ * @file     pluginconnectoredge.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Contains the definition of the PluginConnectorEdge class.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "pluginconnectoredge.h"
+
+#include <utils/mnetracer.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QThread>
+#include <QMutexLocker>
+#include <QSemaphore>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace SCSHAREDLIB;
+using namespace SCMEASLIB;
+using namespace UTILSLIB;
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+PluginConnectorEdge::PluginConnectorEdge(PluginOutputConnector::SPtr pSender,
+                                         PluginInputConnector::SPtr pReceiver,
+                                         OverflowPolicy policy,
+                                         int iCapacity,
+                                         QObject *parent)
+: QObject(parent)
+, m_pSender(pSender)
+, m_pReceiver(pReceiver)
+, m_pState(QSharedPointer<State>::create())
+{
+    m_pState->pEdge = this;
+    m_pState->pReceiver = pReceiver;
+    m_pState->policy = policy;
+    m_pState->iCapacity = qMax(iCapacity, 1);
+    m_pState->bDrainScheduled = false;
+    m_pState->bStopped = false;
+    m_pState->timer.start();
+    resetStatistics();
+
+    // The sender only enqueues, hence a direct connection which runs in the thread of the sender. The connection
+    // holds the state, not the edge, because disconnecting does not wait for a push() which is already running.
+    QSharedPointer<State> pState = m_pState;
+    m_connection = connect(m_pSender.data(), &PluginOutputConnector::notify,
+                           [pState](Measurement::SPtr pMeasurement) { push(pState, pMeasurement); });
+}
+
+//=============================================================================================================
+
+PluginConnectorEdge::~PluginConnectorEdge()
+{
+    disconnect(m_connection);
+
+    // Senders which are still inside push() see the stopped state and return. Pending drain() calls are discarded
+    // together with this object.
+    QMutexLocker locker(&m_pState->qMutex);
+    m_pState->bStopped = true;
+    m_pState->pEdge = Q_NULLPTR;
+    m_pState->queue.clear();
+    m_pState->qWaitNotFull.wakeAll();
+}
+
+//=============================================================================================================
+
+void PluginConnectorEdge::push(Measurement::SPtr pMeasurement)
+{
+    push(m_pState, pMeasurement);
+}
+
+//=============================================================================================================
+
+PluginConnectorEdge::Statistics PluginConnectorEdge::statistics() const
+{
+    QMutexLocker locker(&m_pState->qMutex);
+    return m_pState->statistics;
+}
+
+//=============================================================================================================
+
+void PluginConnectorEdge::resetStatistics()
+{
+    QMutexLocker locker(&m_pState->qMutex);
+    Statistics& statistics = m_pState->statistics;
+    statistics.iReceived = 0;
+    statistics.iDelivered = 0;
+    statistics.iCoalesced = 0;
+    statistics.iQueueDepth = m_pState->queue.size();
+    statistics.iMaxQueueDepth = m_pState->queue.size();
+    statistics.dLatencyMs = 0.0;
+    statistics.dMeanLatencyMs = 0.0;
+    statistics.dMaxLatencyMs = 0.0;
+}
+
+//=============================================================================================================
+
+void PluginConnectorEdge::push(const QSharedPointer<State>& pState,
+                               Measurement::SPtr pMeasurement)
+{
+    // Senders refill or clear their measurement right after notifying, so queue a copy of the sent data
+    Measurement::SPtr pSnapshot = pMeasurement->snapshot();
+
+    if(!pSnapshot) {
+        // Measurements which cannot be copied are delivered while the sender waits
+        deliverDirectly(pState, pMeasurement);
+        return;
+    }
+
+    QueueItem item;
+    item.pMeasurement = pSnapshot;
+    item.iAcquisitionTime = pMeasurement->getAcquisitionTime();
+    item.iSequenceId = pMeasurement->getSequenceId();
+
+    QMutexLocker locker(&pState->qMutex);
+
+    if(pState->bStopped) {
+        return;
+    }
+
+    ++pState->statistics.iReceived;
+
+    if(pState->queue.size() >= pState->iCapacity) {
+        switch(pState->policy) {
+            case Block:
+                if(QThread::currentThread() == pState->pEdge->thread()) {
+                    // Waiting would dead lock the event loop which drains the queue, deliver in place instead
+                    locker.unlock();
+                    drain(pState);
+                    locker.relock();
+                } else {
+                    while(pState->queue.size() >= pState->iCapacity && !pState->bStopped) {
+                        pState->qWaitNotFull.wait(&pState->qMutex);
+                    }
+                }
+
+                if(pState->bStopped) {
+                    return;
+                }
+                break;
+
+            case Coalesce:
+                // A drain is already pending for the queued measurement
+                item.iSendTime = pState->timer.nsecsElapsed();
+                pState->queue.last() = item;
+                ++pState->statistics.iCoalesced;
+                return;
+        }
+    }
+
+    item.iSendTime = pState->timer.nsecsElapsed();
+    pState->queue.enqueue(item);
+
+    pState->statistics.iQueueDepth = pState->queue.size();
+    pState->statistics.iMaxQueueDepth = qMax(pState->statistics.iMaxQueueDepth, pState->statistics.iQueueDepth);
+
+    scheduleDrain(pState);
+}
+
+//=============================================================================================================
+
+void PluginConnectorEdge::drain(const QSharedPointer<State>& pState)
+{
+    for(int i = 0; i < pState->iCapacity; ++i) {
+        pState->qMutex.lock();
+        if(pState->queue.isEmpty() || pState->bStopped) {
+            pState->bDrainScheduled = false;
+            pState->qMutex.unlock();
+            return;
+        }
+
+        QueueItem item = pState->queue.dequeue();
+        pState->statistics.iQueueDepth = pState->queue.size();
+        QString sName = pState->pEdge->objectName();
+        pState->qWaitNotFull.wakeAll();
+        pState->qMutex.unlock();
+
+        long long iEnterTime = MNETracer::isEnabled() ? MNETracer::getTimeNow() : 0;
+
+        pState->pReceiver->update(item.pMeasurement);
+
+        double dLatencyMs = (pState->timer.nsecsElapsed() - item.iSendTime) / 1.0e6;
+
+        if(MNETracer::isEnabled()) {
+            MNETracer::traceStage(sName.toStdString(),
+                                  iEnterTime,
+                                  MNETracer::getTimeNow(),
+                                  item.iAcquisitionTime,
+                                  item.iSequenceId);
+        }
+
+        pState->qMutex.lock();
+        Statistics& statistics = pState->statistics;
+        ++statistics.iDelivered;
+        statistics.dLatencyMs = dLatencyMs;
+        statistics.dMeanLatencyMs += (dLatencyMs - statistics.dMeanLatencyMs) / statistics.iDelivered;
+        statistics.dMaxLatencyMs = qMax(statistics.dMaxLatencyMs, dLatencyMs);
+        pState->qMutex.unlock();
+    }
+
+    // Give the event loop a chance before delivering the rest
+    QMutexLocker locker(&pState->qMutex);
+    pState->bDrainScheduled = false;
+    if(!pState->queue.isEmpty() && !pState->bStopped) {
+        scheduleDrain(pState);
+    }
+}
+
+//=============================================================================================================
+
+void PluginConnectorEdge::deliverDirectly(const QSharedPointer<State>& pState,
+                                          Measurement::SPtr pMeasurement)
+{
+    qint64 iAcquisitionTime = pMeasurement->getAcquisitionTime();
+    quint64 iSequenceId = pMeasurement->getSequenceId();
+    long long iEnterTime = MNETracer::isEnabled() ? MNETracer::getTimeNow() : 0;
+    QString sName;
+    bool bInPlace = false;
+
+    QSharedPointer<QSemaphore> pDelivered = QSharedPointer<QSemaphore>::create();
+
+    {
+        QMutexLocker locker(&pState->qMutex);
+        if(pState->bStopped) {
+            return;
+        }
+        ++pState->statistics.iReceived;
+        sName = pState->pEdge->objectName();
+
+        if(QThread::currentThread() == pState->pEdge->thread()) {
+            bInPlace = true;
+        } else {
+            // The call is posted while the edge is known to be alive. Its copy of pRelease releases the sender when
+            // the call ran or when it was discarded together with the edge.
+            QSharedPointer<QSemaphore> pRelease(pDelivered.data(), [pDelivered](QSemaphore* pSemaphore) { pSemaphore->release(); });
+            QMetaObject::invokeMethod(pState->pEdge,
+                                      [pState, pMeasurement, pRelease]() { pState->pReceiver->update(pMeasurement); },
+                                      Qt::QueuedConnection);
+        }
+    }
+
+    if(bInPlace) {
+        pState->pReceiver->update(pMeasurement);
+    } else {
+        pDelivered->acquire();
+    }
+
+    if(MNETracer::isEnabled()) {
+        MNETracer::traceStage(sName.toStdString(),
+                              iEnterTime,
+                              MNETracer::getTimeNow(),
+                              iAcquisitionTime,
+                              iSequenceId);
+    }
+
+    QMutexLocker locker(&pState->qMutex);
+    ++pState->statistics.iDelivered;
+}
+
+//=============================================================================================================
+
+void PluginConnectorEdge::scheduleDrain(const QSharedPointer<State>& pState)
+{
+    if(pState->bDrainScheduled) {
+        return;
+    }
+
+    pState->bDrainScheduled = true;
+    QMetaObject::invokeMethod(pState->pEdge, [pState]() { drain(pState); }, Qt::QueuedConnection);
+}
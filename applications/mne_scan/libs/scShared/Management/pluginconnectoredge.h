@@ -0,0 +1,296 @@
+//=============================================================================================================
+/**
+ * @file     pluginconnectoredge.h
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Contains the declaration of the PluginConnectorEdge class.
+ *
+ */
+#ifndef PLUGINCONNECTOREDGE_H
+#define PLUGINCONNECTOREDGE_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "../scshared_global.h"
+
+#include "plugininputconnector.h"
+#include "pluginoutputconnector.h"
+
+#include <scMeas/measurement.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QObject>
+#include <QMetaObject>
+#include <QSharedPointer>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QQueue>
+#include <QElapsedTimer>
+
+//=============================================================================================================
+// DEFINE NAMESPACE SCSHAREDLIB
+//=============================================================================================================
+
+namespace SCSHAREDLIB
+{
+
+//=============================================================================================================
+/**
+ * A PluginConnectorEdge forwards the measurements of one output connector to one input connector through a bounded
+ * queue. The sender only enqueues the measurement and returns, the receiver is updated from the event loop of the
+ * thread the edge lives in. What happens when the queue is full is decided by the overflow policy. Queue depth,
+ * replacements and latencies are counted per edge.
+ *
+ * @brief The PluginConnectorEdge class decouples the sender and receiver of a connector connection
+ */
+class SCSHAREDSHARED_EXPORT PluginConnectorEdge : public QObject
+{
+    Q_OBJECT
+
+public:
+    typedef QSharedPointer<PluginConnectorEdge> SPtr;             /**< Shared pointer type for PluginConnectorEdge. */
+    typedef QSharedPointer<const PluginConnectorEdge> ConstSPtr;  /**< Const shared pointer type for PluginConnectorEdge. */
+
+    //=========================================================================================================
+    /**
+     * What happens to a new measurement if the queue is full.
+     */
+    enum OverflowPolicy
+    {
+        Block,          /**< The sender waits until the receiver took a measurement. */
+        Coalesce        /**< The newest queued measurement is replaced, i.e. only the latest state is delivered. */
+    };
+
+    //=========================================================================================================
+    /**
+     * Counters of an edge.
+     */
+    struct Statistics
+    {
+        qint64  iReceived;          /**< Number of measurements sent. */
+        qint64  iDelivered;         /**< Number of measurements delivered to the receiver. */
+        qint64  iCoalesced;         /**< Number of measurements replaced by the Coalesce policy. */
+        int     iQueueDepth;        /**< Current number of queued measurements. */
+        int     iMaxQueueDepth;     /**< Maximal number of queued measurements. */
+        double  dLatencyMs;         /**< Time from sending until the receiver returned, last measurement. */
+        double  dMeanLatencyMs;     /**< Time from sending until the receiver returned, mean. */
+        double  dMaxLatencyMs;      /**< Time from sending until the receiver returned, maximum. */
+    };
+
+    //=========================================================================================================
+    /**
+     * Constructs a PluginConnectorEdge and connects it to the sender.
+     *
+     * @param[in] pSender        The output connector.
+     * @param[in] pReceiver      The input connector.
+     * @param[in] policy         The overflow policy.
+     * @param[in] iCapacity      The maximal number of queued measurements.
+     * @param[in] parent         The parent.
+     */
+    explicit PluginConnectorEdge(PluginOutputConnector::SPtr pSender,
+                                 PluginInputConnector::SPtr pReceiver,
+                                 OverflowPolicy policy = Block,
+                                 int iCapacity = 64,
+                                 QObject *parent = 0);
+
+    //=========================================================================================================
+    /**
+     * Destructor. Disconnects from the sender and discards all queued measurements.
+     */
+    virtual ~PluginConnectorEdge();
+
+    //=========================================================================================================
+    /**
+     * Enqueues a measurement. Called in the thread of the sender.
+     *
+     * @param[in] pMeasurement   The measurement.
+     */
+    void push(SCMEASLIB::Measurement::SPtr pMeasurement);
+
+    //=========================================================================================================
+    /**
+     * Returns the counters of this edge.
+     *
+     * @return The counters.
+     */
+    Statistics statistics() const;
+
+    //=========================================================================================================
+    /**
+     * Resets the counters of this edge.
+     */
+    void resetStatistics();
+
+    //=========================================================================================================
+    /**
+     * Returns the overflow policy.
+     *
+     * @return The overflow policy.
+     */
+    inline OverflowPolicy getOverflowPolicy() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the maximal number of queued measurements.
+     *
+     * @return The capacity.
+     */
+    inline int getCapacity() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the sender.
+     *
+     * @return The output connector.
+     */
+    inline PluginOutputConnector::SPtr getSender() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the receiver.
+     *
+     * @return The input connector.
+     */
+    inline PluginInputConnector::SPtr getReceiver() const;
+
+private:
+    //=========================================================================================================
+    /**
+     * A queued measurement. The stamp of the measurement is captured when it is sent.
+     */
+    struct QueueItem
+    {
+        SCMEASLIB::Measurement::SPtr    pMeasurement;       /**< The measurement. */
+        qint64                          iSendTime;          /**< The time it was sent, see State::timer. */
+        qint64                          iAcquisitionTime;   /**< The acquisition time of its data. */
+        quint64                         iSequenceId;        /**< Its sequence id. */
+    };
+
+    //=========================================================================================================
+    /**
+     * The queue and the counters of an edge. Senders keep a reference while they push, hence a sender which is still
+     * inside push() when the edge is destroyed does not touch freed memory.
+     */
+    struct State
+    {
+        PluginConnectorEdge*            pEdge;              /**< The edge, only valid while bStopped is false. */
+        PluginInputConnector::SPtr      pReceiver;          /**< The input connector. */
+        OverflowPolicy                  policy;             /**< The overflow policy. */
+        int                             iCapacity;          /**< The maximal number of queued measurements. */
+
+        QMutex                          qMutex;             /**< Guards the queue, the flags and the counters. */
+        QWaitCondition                  qWaitNotFull;       /**< Wakes blocked senders. */
+        QQueue<QueueItem>               queue;              /**< The queued measurements. */
+        bool                            bDrainScheduled;    /**< Whether a drain() call is pending. */
+        bool                            bStopped;           /**< Whether the edge was destroyed. */
+
+        QElapsedTimer                   timer;              /**< The clock for the latencies. */
+        Statistics                      statistics;         /**< The counters. */
+    };
+
+    //=========================================================================================================
+    /**
+     * Enqueues a measurement. Called in the thread of the sender.
+     *
+     * @param[in] pState         The state of the edge.
+     * @param[in] pMeasurement   The measurement.
+     */
+    static void push(const QSharedPointer<State>& pState,
+                     SCMEASLIB::Measurement::SPtr pMeasurement);
+
+    //=========================================================================================================
+    /**
+     * Delivers queued measurements to the receiver. At most one capacity worth of measurements is delivered per
+     * call, afterwards the next call is scheduled, so a busy edge does not starve the event loop.
+     *
+     * @param[in] pState         The state of the edge.
+     */
+    static void drain(const QSharedPointer<State>& pState);
+
+    //=========================================================================================================
+    /**
+     * Delivers a measurement which cannot be copied in the thread of the edge, while the sender waits.
+     *
+     * @param[in] pState         The state of the edge.
+     * @param[in] pMeasurement   The measurement.
+     */
+    static void deliverDirectly(const QSharedPointer<State>& pState,
+                                SCMEASLIB::Measurement::SPtr pMeasurement);
+
+    //=========================================================================================================
+    /**
+     * Schedules drain() in the event loop of the thread of the edge. Has to be called with locked mutex while the
+     * edge is not stopped.
+     *
+     * @param[in] pState         The state of the edge.
+     */
+    static void scheduleDrain(const QSharedPointer<State>& pState);
+
+    PluginOutputConnector::SPtr     m_pSender;              /**< The output connector. */
+    PluginInputConnector::SPtr      m_pReceiver;            /**< The input connector. */
+    QMetaObject::Connection         m_connection;           /**< The connection to the sender. */
+    QSharedPointer<State>           m_pState;               /**< The queue and the counters, shared with the senders. */
+};
+
+//=============================================================================================================
+// INLINE DEFINITIONS
+//=============================================================================================================
+
+inline PluginConnectorEdge::OverflowPolicy PluginConnectorEdge::getOverflowPolicy() const
+{
+    return m_pState->policy;
+}
+
+//=============================================================================================================
+
+inline int PluginConnectorEdge::getCapacity() const
+{
+    return m_pState->iCapacity;
+}
+
+//=============================================================================================================
+
+inline PluginOutputConnector::SPtr PluginConnectorEdge::getSender() const
+{
+    return m_pSender;
+}
+
+//=============================================================================================================
+
+inline PluginInputConnector::SPtr PluginConnectorEdge::getReceiver() const
+{
+    return m_pReceiver;
+}
+} // NAMESPACE
+
+#endif // PLUGINCONNECTOREDGE_H
@@ -84,7 +84,10 @@ PluginOutputData<T>::PluginOutputData(AbstractPlugin *parent,
 template <class T>
 void PluginOutputData<T>::update()
 {
-    emit notify(qSharedPointerDynamicCast<SCMEASLIB::Measurement>(m_pMeasurement));
+    QSharedPointer<SCMEASLIB::Measurement> t_measurement = qSharedPointerDynamicCast<SCMEASLIB::Measurement>(m_pMeasurement);
+    t_measurement->stamp();
+
+    emit notify(t_measurement);
 }
 }//Namespace
 
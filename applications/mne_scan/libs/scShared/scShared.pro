@@ -98,6 +98,7 @@ SOURCES += \
     Management/plugininputdata.cpp \
     Management/pluginoutputdata.cpp \
     Management/pluginconnectorconnection.cpp \
+    Management/pluginconnectoredge.cpp \
     Management/pluginconnectorconnectionwidget.cpp \
     Management/pluginscenemanager.cpp \
     Management/displaymanager.cpp
@@ -114,6 +115,7 @@ HEADERS += \
     Management/plugininputdata.h \
     Management/pluginoutputdata.h \
     Management/pluginconnectorconnection.h \
+    Management/pluginconnectoredge.h \
     Management/pluginconnectorconnectionwidget.h \
     Management/pluginscenemanager.h \
     Management/displaymanager.h
@@ -50,6 +50,7 @@
 #include <scShared/Plugins/abstractplugin.h>
 
 #include <utils/generics/applicationlogger.h>
+#include <utils/mnetracer.h>
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -165,6 +166,9 @@ int main(int argc, char *argv[])
 
     SCMEASLIB::MeasurementTypes::registerTypes();
 
+    // Records the latency of every plugin connection when built with MNECPP_CONFIG+=trace
+    MNE_TRACER_ENABLE(mne_scan_trace.json)
+
     MainWindow mainWin;
 
     QSurfaceFormat fmt;
@@ -173,5 +177,7 @@ int main(int argc, char *argv[])
 
     int returnValue(app.exec());
 
+    MNE_TRACER_DISABLE
+
     return returnValue;
 }
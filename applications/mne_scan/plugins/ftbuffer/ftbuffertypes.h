@@ -33,6 +33,18 @@
 #define PUT_DAT_NORESPONSE static_cast<qint16>(0x0502) /* decimal 1282 */
 #define PUT_EVT_NORESPONSE static_cast<qint16>(0x0503) /* decimal 1283 */
 
+#define DATATYPE_CHAR    static_cast<qint32>(0)
+#define DATATYPE_UINT8   static_cast<qint32>(1)
+#define DATATYPE_UINT16  static_cast<qint32>(2)
+#define DATATYPE_UINT32  static_cast<qint32>(3)
+#define DATATYPE_UINT64  static_cast<qint32>(4)
+#define DATATYPE_INT8    static_cast<qint32>(5)
+#define DATATYPE_INT16   static_cast<qint32>(6)
+#define DATATYPE_INT32   static_cast<qint32>(7)
+#define DATATYPE_INT64   static_cast<qint32>(8)
+#define DATATYPE_FLOAT32 static_cast<qint32>(9)
+#define DATATYPE_FLOAT64 static_cast<qint32>(10)
+
 //=============================================================================================================
 // STRUCT DEFINITIONS
 //=============================================================================================================
@@ -67,6 +67,7 @@ FtConnector::FtConnector()
 , m_iNumChannels(0)
 , m_iDataType(0)
 , m_iExtendedHeaderSize(0)
+, m_iWaitTimeout(500)
 , m_iPort(1972)
 , m_bNewData(false)
 , m_fSampleFreq(0)
@@ -213,7 +214,7 @@ bool FtConnector::parseHeaderDef(QBuffer &readBuffer)
 
     qInfo() << "[FtConnector::parseHeaderDef] Got header parameters.";
 
-    if (m_iDataType != 9) {
+    if (m_iDataType < DATATYPE_UINT8 || m_iDataType > DATATYPE_FLOAT64) {
         qCritical() << "Data type not supported. Plugin will not behave correctly.";
     }
 
@@ -259,16 +260,21 @@ void FtConnector::sendRequest(messagedef_t &messagedef)
 
 bool FtConnector::getData()
 {
-    m_iNumNewSamples = totalBuffSamples();
+    // Let the buffer block until enough new samples arrived
+    int iNumSamples = waitForSamples(m_iNumSamples + m_iMinSampleRead - 1, m_iWaitTimeout);
 
-    if (m_iNumNewSamples <= (m_iNumSamples + m_iMinSampleRead)) {
-        // no new unread data in buffer
+    if (iNumSamples < 0) {
         return false;
     }
 
-    m_pSocket->readAll(); //Ensure receiving buffer is empty
+    m_iNumNewSamples = iNumSamples;
 
-    // Get data message + data selection params
+    if (m_iNumNewSamples < (m_iNumSamples + m_iMinSampleRead)) {
+        // no new unread data in buffer
+        return false;
+    }
+
+    // Get data message + data selection params, requesting all unread samples at once
     messagedef_t messagedef;
     messagedef.bufsize = sizeof (datasel_t);
     messagedef.command = GET_DAT;
@@ -280,30 +286,39 @@ bool FtConnector::getData()
     sendRequest(messagedef);
     sendDataSel(datasel);
 
-    //Waiting for response.
-    while(static_cast<unsigned long>(m_pSocket->bytesAvailable()) < sizeof (messagedef_t)) {
-        m_pSocket->waitForReadyRead(10);
-    }
-
     //Parse return message from buffer
-    QBuffer msgBuffer;
-    prepBuffer(msgBuffer, sizeof (messagedef_t));
-    int bufsize = parseMessageDef(msgBuffer);
+    messagedef_t response;
+    if (!readBytes(reinterpret_cast<char*>(&response), sizeof (messagedef_t), m_iWaitTimeout)) {
+        return false;
+    }
 
-    //Waiting for response.
-    while(m_pSocket->bytesAvailable() < bufsize) {
-        m_pSocket->waitForReadyRead(10);
+    if (response.command != GET_OK || response.bufsize < static_cast<qint32>(sizeof (datadef_t))) {
+        qWarning() << "[FtConnector::getData] Buffer did not return data.";
+        m_baData.resize(qMax(response.bufsize, 0));
+        readBytes(m_baData.data(), m_baData.size(), m_iWaitTimeout);
+        return false;
     }
 
     //Parse return data def from buffer
-    QBuffer datadefBuffer;
-    prepBuffer(datadefBuffer, sizeof (datadef_t));
-    bufsize = parseDataDef(datadefBuffer);
+    datadef_t datadef;
+    if (!readBytes(reinterpret_cast<char*>(&datadef), sizeof (datadef_t), m_iWaitTimeout)) {
+        return false;
+    }
+
+    m_iMsgSamples = datadef.nsamples;
+
+    //Receive actual data from buffer straight into the reused receive buffer
+    if (m_baData.size() < datadef.bufsize) {
+        m_baData.resize(datadef.bufsize);
+    }
 
-    //Parse actual data from buffer
-    QBuffer datasampBuffer;
-    prepBuffer(datasampBuffer, bufsize);
-    parseData(datasampBuffer, bufsize);
+    if (!readBytes(m_baData.data(), datadef.bufsize, m_iWaitTimeout)) {
+        return false;
+    }
+
+    if (!parseData(m_baData.constData(), datadef.data_type, datadef.nchans, datadef.nsamples)) {
+        return false;
+    }
 
     //update sample tracking
     m_iNumSamples = m_iNumNewSamples;
@@ -405,49 +420,77 @@ void FtConnector::echoStatus()
 
 int FtConnector::totalBuffSamples()
 {
-    m_pSocket->readAll(); //Ensure receiving buffer is empty
+    //Respond immediately with the current number of samples
+    return waitForSamples(0, 0);
+}
+
+//=============================================================================================================
 
+int FtConnector::waitForSamples(int iThreshold,
+                                int iTimeoutMs)
+{
     messagedef_t messagedef;
     messagedef.bufsize = sizeof(samples_events_t) + sizeof (qint32);
     messagedef.command = WAIT_DAT;
 
     //Set threshold to return more than number samples read.
     samples_events_t threshold;
-    threshold.nsamples = m_iNumSamples;
+    threshold.nsamples = qMax(iThreshold, 0);
     threshold.nevents = static_cast<qint32>(0xFFFFFFFF);
 
     // timeout for waiting in milliseconds
-    qint32 timeout = 20;
+    qint32 timeout = iTimeoutMs;
 
     sendRequest(messagedef);
     sendSampleEvents(threshold);
     m_pSocket->write(reinterpret_cast<char*>(&timeout), sizeof (qint32));
 
-    //Waiting for response.
-    while(static_cast<quint64>(m_pSocket->bytesAvailable()) < sizeof (messagedef_t)) {
-        m_pSocket->waitForReadyRead(10);
+    //Wait for the buffer to respond, which takes up to the timeout
+    messagedef_t response;
+    if (!readBytes(reinterpret_cast<char*>(&response), sizeof (messagedef_t), iTimeoutMs + m_iWaitTimeout)) {
+        return -1;
     }
 
-    //Parse return message from buffer
-    QBuffer msgBuffer;
-    prepBuffer(msgBuffer, sizeof (messagedef_t));
-    parseMessageDef(msgBuffer);
+    if (response.command != WAIT_OK || response.bufsize < static_cast<qint32>(sizeof (samples_events_t))) {
+        qWarning() << "[FtConnector::waitForSamples] Buffer did not return the number of samples.";
+        m_baData.resize(qMax(response.bufsize, 0));
+        readBytes(m_baData.data(), m_baData.size(), m_iWaitTimeout);
+        return -1;
+    }
 
-    //Waiting for response.
-    while(static_cast<quint64>(m_pSocket->bytesAvailable()) < sizeof (samples_events_t)) {
-        m_pSocket->waitForReadyRead(10);
+    samples_events_t sampevents;
+    if (!readBytes(reinterpret_cast<char*>(&sampevents), sizeof (samples_events_t), m_iWaitTimeout)) {
+        return -1;
     }
 
-    qint32 iNumSamp;
+    return sampevents.nsamples;
+}
+
+//=============================================================================================================
+
+bool FtConnector::readBytes(char* pData,
+                            qint64 numBytes,
+                            int iTimeoutMs)
+{
+    qint64 iNumRead = 0;
+
+    while (iNumRead < numBytes) {
+        if (m_pSocket->bytesAvailable() == 0 && !m_pSocket->waitForReadyRead(iTimeoutMs)) {
+            qWarning() << "[FtConnector::readBytes] No response from buffer:" << m_pSocket->errorString();
+            return false;
+        }
+
+        qint64 iRead = m_pSocket->read(pData + iNumRead, numBytes - iNumRead);
 
-    QBuffer sampeventsBuffer;
-    prepBuffer(sampeventsBuffer, sizeof(samples_events_t));
+        if (iRead < 0) {
+            qWarning() << "[FtConnector::readBytes] Could not read from buffer:" << m_pSocket->errorString();
+            return false;
+        }
 
-    char cSamps[sizeof(iNumSamp)];
-    sampeventsBuffer.read(cSamps, sizeof(iNumSamp));
-    std::memcpy(&iNumSamp, cSamps, sizeof(iNumSamp));
+        iNumRead += iRead;
+    }
 
-    return iNumSamp;
+    return true;
 }
 
 //=============================================================================================================
@@ -460,41 +503,51 @@ void FtConnector::sendSampleEvents(samples_events_t &threshold)
 
 //=============================================================================================================
 
-bool FtConnector::parseData(QBuffer &datasampBuffer,
-                            int bufsize)
+bool FtConnector::parseData(const char* pData,
+                            int iDataType,
+                            int iNumChannels,
+                            int iNumSamples)
 {
-    Q_UNUSED(bufsize)
-    //start interpreting data as float instead of char
-    QByteArray dataArray = datasampBuffer.readAll();
-    float* fdata = reinterpret_cast<float*> (dataArray.data());
-
-//TODO: Implement receiving other types of data
-//    switch (m_iDataType) {
-//        case DATATYPE_FLOAT32:
-//            auto data = reinterpret_cast<float*>(dataArray.data(), bufsize);
-//            qDebug() << "*** Would you look at that, we're all the way here ***";
-//            qDebug() << "Data sample:";
-
-//            for (int i = 0; i < 10 ; i++) {
-//                qDebug() << data[i];
-//            }
-//            break;
-//    }
-
-    //format data into eigen matrix to pass up
-    Eigen::MatrixXf matData;
-    matData.resize(m_iNumChannels, m_iMsgSamples);
-
-    int count = 0;
-    for (int i = 0; i < int (m_iMsgSamples); i++) {
-        for (int j = 0; j < int (m_iNumChannels); j++) {
-            matData(j,i) = fdata[count];
-            count++;
-        }
+    //The samples are sent with interleaved channels, which is the column major layout of a channels x samples matrix.
+    //Assigning a block of the same size as the last one reuses the memory of m_matEmit.
+    switch (iDataType) {
+        case DATATYPE_UINT8:
+            m_matEmit = Eigen::Map<const Eigen::Matrix<quint8, Eigen::Dynamic, Eigen::Dynamic> >(reinterpret_cast<const quint8*>(pData), iNumChannels, iNumSamples).cast<double>();
+            break;
+        case DATATYPE_UINT16:
+            m_matEmit = Eigen::Map<const Eigen::Matrix<quint16, Eigen::Dynamic, Eigen::Dynamic> >(reinterpret_cast<const quint16*>(pData), iNumChannels, iNumSamples).cast<double>();
+            break;
+        case DATATYPE_UINT32:
+            m_matEmit = Eigen::Map<const Eigen::Matrix<quint32, Eigen::Dynamic, Eigen::Dynamic> >(reinterpret_cast<const quint32*>(pData), iNumChannels, iNumSamples).cast<double>();
+            break;
+        case DATATYPE_UINT64:
+            m_matEmit = Eigen::Map<const Eigen::Matrix<quint64, Eigen::Dynamic, Eigen::Dynamic> >(reinterpret_cast<const quint64*>(pData), iNumChannels, iNumSamples).cast<double>();
+            break;
+        case DATATYPE_INT8:
+            m_matEmit = Eigen::Map<const Eigen::Matrix<qint8, Eigen::Dynamic, Eigen::Dynamic> >(reinterpret_cast<const qint8*>(pData), iNumChannels, iNumSamples).cast<double>();
+            break;
+        case DATATYPE_INT16:
+            m_matEmit = Eigen::Map<const Eigen::Matrix<qint16, Eigen::Dynamic, Eigen::Dynamic> >(reinterpret_cast<const qint16*>(pData), iNumChannels, iNumSamples).cast<double>();
+            break;
+        case DATATYPE_INT32:
+            m_matEmit = Eigen::Map<const Eigen::Matrix<qint32, Eigen::Dynamic, Eigen::Dynamic> >(reinterpret_cast<const qint32*>(pData), iNumChannels, iNumSamples).cast<double>();
+            break;
+        case DATATYPE_INT64:
+            m_matEmit = Eigen::Map<const Eigen::Matrix<qint64, Eigen::Dynamic, Eigen::Dynamic> >(reinterpret_cast<const qint64*>(pData), iNumChannels, iNumSamples).cast<double>();
+            break;
+        case DATATYPE_FLOAT32:
+            m_matEmit = Eigen::Map<const Eigen::MatrixXf>(reinterpret_cast<const float*>(pData), iNumChannels, iNumSamples).cast<double>();
+            break;
+        case DATATYPE_FLOAT64:
+            m_matEmit = Eigen::Map<const Eigen::MatrixXd>(reinterpret_cast<const double*>(pData), iNumChannels, iNumSamples);
+            break;
+        default:
+            qWarning() << "[FtConnector::parseData] Data type" << iDataType << "not supported.";
+            m_bNewData = false;
+            return false;
     }
 
-    //store and flag new data
-    m_pMatEmit = new Eigen::MatrixXd(matData.cast<double>());
+    //flag new data
     m_bNewData = true;
 
     return m_bNewData;
@@ -505,8 +558,6 @@ bool FtConnector::parseData(QBuffer &datasampBuffer,
 void FtConnector::resetEmitData()
 {
     m_bNewData = false;
-    delete m_pMatEmit;
-    m_pMatEmit = Q_NULLPTR;
 }
 
 //=============================================================================================================
@@ -521,9 +572,9 @@ bool FtConnector::disconnect()
 
 //=============================================================================================================
 
-Eigen::MatrixXd FtConnector::getMatrix()
+const Eigen::MatrixXd& FtConnector::getMatrix() const
 {
-    return *m_pMatEmit;
+    return m_matEmit;
 }
 
 //=============================================================================================================
@@ -133,9 +133,10 @@ public:
 
     //=========================================================================================================
     /**
-     * equests and receives data from buffer, parses it, and stores it in m_pMatEmit
+     * Blocks on a WAIT_DAT request until at least m_iMinSampleRead unread samples are in the buffer or m_iWaitTimeout
+     * passed. All unread samples are then requested with one GET_DAT and decoded into m_matEmit.
      *
-     * @return true if successful, false if unsuccessful.
+     * @return true if new data was read, false if there was none or the request failed.
      */
     bool getData();
 
@@ -183,11 +184,11 @@ public:
 
     //=========================================================================================================
     /**
-     * Returns member m_pMatEmit, newest buffer data formatted as an Eigen MatrixXd
+     * Returns member m_matEmit, newest buffer data formatted as an Eigen MatrixXd
      *
-     * @return returns m_pMatEmit.
+     * @return returns m_matEmit.
      */
-    Eigen::MatrixXd getMatrix();
+    const Eigen::MatrixXd& getMatrix() const;
 
     //=========================================================================================================
     /**
@@ -199,7 +200,7 @@ public:
 
     //=========================================================================================================
     /**
-     * Sets m_bNewData to false, deletes m_pMatEmit
+     * Sets m_bNewData to false. m_matEmit keeps its memory for the next block.
      */
     void resetEmitData();
 
@@ -276,15 +277,47 @@ private:
 
     //=========================================================================================================
     /**
-     * Parses sample data received from buffer, formates it and saves it to m_pMatEmit;
+     * Decodes sample data received from buffer (channels interleaved per sample) into m_matEmit. m_matEmit is only
+     * reallocated if the number of channels or samples changes.
      *
-     * @param[in] datasampBuffer    QBuffer with return data from buffer.
-     * @param[in] bufsize           Buffer size of sample data.
+     * @param[in] pData         The sample data.
+     * @param[in] iDataType     The FieldTrip data type of the samples, see DATATYPE_xxx.
+     * @param[in] iNumChannels  The number of channels.
+     * @param[in] iNumSamples   The number of samples.
      *
-     * @return true if successful, false if unsuccessful.
+     * @return true if successful, false if the data type is not supported.
+     */
+    bool parseData(const char* pData,
+                   int iDataType,
+                   int iNumChannels,
+                   int iNumSamples);
+
+    //=========================================================================================================
+    /**
+     * Reads exactly numBytes from the socket into pData, waiting for them to arrive.
+     *
+     * @param[out] pData        Where to write the data.
+     * @param[in] numBytes      How many bytes to read from socket.
+     * @param[in] iTimeoutMs    How long to wait for new bytes to arrive in milliseconds.
+     *
+     * @return true if successful, false if the socket timed out or disconnected.
+     */
+    bool readBytes(char* pData,
+                   qint64 numBytes,
+                   int iTimeoutMs);
+
+    //=========================================================================================================
+    /**
+     * Sends a WAIT_DAT request. The buffer responds as soon as it holds more than iThreshold samples or the timeout
+     * passed, so no round trips are spent on polling.
+     *
+     * @param[in] iThreshold    The buffer responds once it holds more samples than this.
+     * @param[in] iTimeoutMs    How long the buffer waits before responding anyway in milliseconds.
+     *
+     * @return The total number of samples written to buffer, -1 if the request failed.
      */
-    bool parseData(QBuffer &datasampBuffer,
-                   int bufsize);
+    int waitForSamples(int iThreshold,
+                       int iTimeoutMs);
 
     //=========================================================================================================
     /**
@@ -319,6 +352,7 @@ private:
     int                                     m_iNumChannels;                         /**< Number of channels in the buffer data. */
     int                                     m_iDataType;                            /**< Type of data in the buffer. */
     int                                     m_iExtendedHeaderSize;                  /**< Size of extended header chunks. */
+    int                                     m_iWaitTimeout;                         /**< How long the buffer may block a WAIT_DAT request in milliseconds. */
     quint16                                 m_iPort;                                /**< Port where the ft bufferis found. */
 
     bool                                    m_bNewData;                             /**< Indicate whether we've received new data. */
@@ -329,7 +363,9 @@ private:
 
     QTcpSocket*                             m_pSocket;                              /**< Socket that manages the connection to the ft buffer. */
 
-    Eigen::MatrixXd*                        m_pMatEmit;                             /**< Container to format data to tansmit to FtBuffProducer. */
+    QByteArray                              m_baData;                               /**< Receive buffer for sample data, reused between requests. */
+
+    Eigen::MatrixXd                         m_matEmit;                              /**< Container to format data to tansmit to FtBuffProducer. */
 };
 
 }//namespace end bracket
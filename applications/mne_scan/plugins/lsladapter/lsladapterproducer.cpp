@@ -38,6 +38,10 @@
 
 #include "lsladapterproducer.h"
 
+#include <utils/mnetracer.h>
+
+#include <algorithm>
+
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
@@ -56,6 +60,7 @@
 using namespace LSLADAPTERPLUGIN;
 using namespace SCSHAREDLIB;
 using namespace SCMEASLIB;
+using namespace UTILSLIB;
 
 //=============================================================================================================
 // DEFINE MEMBER METHODS
@@ -70,7 +75,7 @@ LSLAdapterProducer::LSLAdapterProducer(QSharedPointer<PluginOutputData<RealTimeM
 , m_bHasStreamInfo(false)
 , m_bIsRunning(false)
 , m_iOutputBlockSize(iOutputBlockSize)
-, m_vBufferedSamples()
+, m_iNumBufferedSamples(0)
 , m_pRTMSA(pRTMSA)
 {
 }
@@ -95,43 +100,68 @@ void LSLAdapterProducer::readStream()
     // start to stream: build a stream inlet
     try {
         m_StreamInlet = new lsl::stream_inlet(m_StreamInfo);
+        m_StreamInlet->set_postprocessing(lsl::post_clocksync);
         m_StreamInlet->open_stream();
     }
     catch (std::exception& e) {
         qDebug() << "[LSLAdapterProducer::readStream] Something went wrong when trying to open LSL stream inlet: " << e.what();
     }
 
+    const int iNumChannels = m_StreamInfo.channel_count();
+    m_iNumBufferedSamples = 0;
+
+    if (iNumChannels <= 0) {
+        qDebug() << "[LSLAdapterProducer::readStream] The stream has no channels !";
+        emit finished();
+        return;
+    }
+
     m_bIsRunning = true;
     while(m_bIsRunning) {
         try {
-            if(m_StreamInlet->samples_available() == false) {
+            // room for one output block plus one more, so that shifting never overlaps
+            const int iBlockSize = m_iOutputBlockSize;
+            if(m_matBufferedSamples.rows() != iNumChannels || m_matBufferedSamples.cols() < 2 * iBlockSize) {
+                m_matBufferedSamples.conservativeResize(iNumChannels, 2 * iBlockSize);
+                m_vecTimestamps.conservativeResize(2 * iBlockSize);
+            }
+
+            // pull multiplexed samples straight behind the buffered ones, interleaved channels are the column major
+            // layout of a channels x samples matrix
+            const int iFreeSamples = m_matBufferedSamples.cols() - m_iNumBufferedSamples;
+            std::size_t iNumElements = m_StreamInlet->pull_chunk_multiplexed(m_matBufferedSamples.data() + static_cast<std::size_t>(m_iNumBufferedSamples) * iNumChannels,
+                                                                             m_vecTimestamps.data() + m_iNumBufferedSamples,
+                                                                             static_cast<std::size_t>(iFreeSamples) * iNumChannels,
+                                                                             iFreeSamples,
+                                                                             0.0);
+
+            if(iNumElements == 0) {
                 // save CPU time, then check again
                 QThread::msleep(5);
                 continue;
             }
-            std::vector<std::vector<float>> chunk = m_StreamInlet->pull_chunk<float>();
-
-            // append chunk to buffer
-            m_vBufferedSamples.insert(std::end(m_vBufferedSamples), std::begin(chunk), std::end(chunk));
-
-            // check if we can output another block
-            if(m_vBufferedSamples.size() >= m_iOutputBlockSize) {
-                Eigen::MatrixXd matOutput(m_StreamInfo.channel_count(), m_iOutputBlockSize);
-
-                // copy samples
-                for(int iSampleIdx = 0; iSampleIdx < m_iOutputBlockSize; ++iSampleIdx) {
-                    for(int iChannelIdx = 0; iChannelIdx < m_StreamInfo.channel_count(); ++iChannelIdx) {
-                        matOutput(iChannelIdx, iSampleIdx) = static_cast<double>(m_vBufferedSamples[iSampleIdx][iChannelIdx]);
-                    }
-                }
-
-                // remove copied samples
-                for(int i = 0; i < m_iOutputBlockSize; ++i) {
-                    m_vBufferedSamples.erase(m_vBufferedSamples.begin());
-                }
 
-                // publish new block
-                m_pRTMSA->measurementData()->setValue(matOutput);
+            m_iNumBufferedSamples += static_cast<int>(iNumElements / iNumChannels);
+
+            // output all complete blocks
+            while(m_iNumBufferedSamples >= iBlockSize) {
+                m_matOutput = m_matBufferedSamples.leftCols(iBlockSize).cast<double>();
+                const double dBlockTimestamp = m_vecTimestamps[0];
+
+                // move the remaining samples to the front
+                m_iNumBufferedSamples -= iBlockSize;
+                std::copy(m_matBufferedSamples.data() + static_cast<std::size_t>(iBlockSize) * iNumChannels,
+                          m_matBufferedSamples.data() + static_cast<std::size_t>(iBlockSize + m_iNumBufferedSamples) * iNumChannels,
+                          m_matBufferedSamples.data());
+                std::copy(m_vecTimestamps.data() + iBlockSize,
+                          m_vecTimestamps.data() + iBlockSize + m_iNumBufferedSamples,
+                          m_vecTimestamps.data());
+
+                // publish new block, stamped with the time its first sample was taken. The timestamps are already
+                // synchronized to the local LSL clock, so only the age of the sample has to be mapped to the tracer clock.
+                const double dAgeSec = lsl::local_clock() - dBlockTimestamp;
+                m_pRTMSA->measurementData()->setAcquisitionTime(MNETracer::getTimeNow() - static_cast<qint64>(dAgeSec * 1.0e6));
+                m_pRTMSA->measurementData()->setValue(m_matOutput);
             }
         }
         catch (std::exception& e) {
@@ -174,7 +204,7 @@ void LSLAdapterProducer::reset()
     m_bIsRunning = false;
     m_bHasStreamInfo = false;
     // clear buffer
-    m_vBufferedSamples.clear();
+    m_iNumBufferedSamples = 0;
     // reset lsl members
     m_StreamInfo = lsl::stream_info();
     delete m_StreamInlet;
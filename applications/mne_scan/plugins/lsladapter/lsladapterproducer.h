@@ -42,8 +42,6 @@
 
 #include "lsladapter_global.h"
 
-#include <vector>
-
 #include <scMeas/realtimemultisamplearray.h>
 #include <scShared/Management/pluginoutputdata.h>
 
@@ -150,7 +148,10 @@ private:
 
     // buffering and output parameters
     int                             m_iOutputBlockSize;
-    std::vector<std::vector<float>> m_vBufferedSamples;
+    int                             m_iNumBufferedSamples;      /**< The number of samples in m_matBufferedSamples. */
+    Eigen::MatrixXf                 m_matBufferedSamples;       /**< Pulled samples (channels x samples), filled by multiplexed pulls. */
+    Eigen::VectorXd                 m_vecTimestamps;            /**< The LSL timestamps of the buffered samples. */
+    Eigen::MatrixXd                 m_matOutput;                /**< The output block, reused between blocks. */
     QSharedPointer<SCSHAREDLIB::PluginOutputData<SCMEASLIB::RealTimeMultiSampleArray> > m_pRTMSA;
 
 signals:
@@ -169,6 +170,7 @@ inline bool LSLAdapterProducer::isRunning() const
 {
     return m_bIsRunning;
 }
+
 } // NAMESPACE
 
 #endif // LSLADAPTERPRODUCER_H
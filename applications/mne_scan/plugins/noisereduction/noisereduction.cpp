@@ -201,17 +201,10 @@ void NoiseReduction::update(SCMEASLIB::Measurement::SPtr pMeasurement)
             m_pFiffInfo = pRTMSA->info();
 
             //Init the multiplication matrices
-            m_matSparseProjMult = SparseMatrix<double>(m_pFiffInfo->chs.size(),m_pFiffInfo->chs.size());
-            m_matSparseCompMult = SparseMatrix<double>(m_pFiffInfo->chs.size(),m_pFiffInfo->chs.size());
             m_matSparseSpharaMult = SparseMatrix<double>(m_pFiffInfo->chs.size(),m_pFiffInfo->chs.size());
-            m_matSparseProjCompMult = SparseMatrix<double>(m_pFiffInfo->chs.size(),m_pFiffInfo->chs.size());
-            m_matSparseFull = SparseMatrix<double>(m_pFiffInfo->chs.size(),m_pFiffInfo->chs.size());
-
-            m_matSparseProjMult.setIdentity();
-            m_matSparseCompMult.setIdentity();
             m_matSparseSpharaMult.setIdentity();
-            m_matSparseProjCompMult.setIdentity();
-            m_matSparseFull.setIdentity();
+
+            m_projOperator.clear();
 
             //Init output
             m_pNoiseReductionOutput->measurementData()->initFromFiffInfo(m_pFiffInfo);
@@ -350,22 +343,7 @@ void NoiseReduction::run()
         if(m_pCircularBuffer->pop(matData)) {
             m_mutex.lock();
             //Do SSP's and compensators here
-            if(m_bCompActivated) {
-                if(m_bProjActivated) {
-                    //Comp + Proj
-                    matData = m_matSparseProjCompMult * matData;
-                } else {
-                    //Comp
-                    matData = m_matSparseCompMult * matData;
-                }
-            } else {
-                if(m_bProjActivated) {
-                    //Proj
-                    matData = m_matSparseProjMult * matData;
-                } else {
-                    //None - Raw
-                }
-            }
+            m_projOperator.applyInPlace(matData, m_bProjActivated, m_bCompActivated);
 
             //Do temporal filtering here
             if(m_bFilterActivated) {
@@ -424,51 +402,8 @@ void NoiseReduction::updateProjection(const QList<FIFFLIB::FiffProj>& projs)
     if(m_pFiffInfo) {
         m_mutex.lock();
         //If a minimum of one projector is active set m_bProjActivated to true so that this model applies the ssp to the incoming data
-        m_bProjActivated = false;
-        for(qint32 i = 0; i < projs.size(); ++i) {
-            if(projs[i].active) {
-                m_bProjActivated = true;
-                break;
-            }
-        }
-
-        MatrixXd matProj;
-        FiffProj::make_projector(projs, m_pFiffInfo->ch_names, matProj, m_pFiffInfo->bads);
-
-        //set columns of matrix to zero depending on bad channels indexes
-        for(qint32 j = 0; j < m_pFiffInfo->bads.size(); ++j) {
-            int index = m_pFiffInfo->ch_names.indexOf(m_pFiffInfo->bads.at(j));
-            if(index >= 0 && index<m_pFiffInfo->ch_names.size()) {
-                matProj.col(index).setZero();
-            }
-        }
-
-        // Make proj sparse
-        qint32 nchan = this->m_pFiffInfo->nchan;
-        qint32 i, k;
-
-        typedef Eigen::Triplet<double> T;
-        std::vector<T> tripletList;
-        tripletList.reserve(nchan);
-
-        tripletList.clear();
-        tripletList.reserve(matProj.rows()*matProj.cols());
-        for(i = 0; i < matProj.rows(); ++i) {
-            for(k = 0; k < matProj.cols(); ++k) {
-                if(matProj(i,k) != 0) {
-                    tripletList.push_back(T(i, k, matProj(i,k)));
-                }
-            }
-        }
-
-        m_matSparseProjMult = SparseMatrix<double>(matProj.rows(),matProj.cols());
-        if(tripletList.size() > 0)
-            m_matSparseProjMult.setFromTriplets(tripletList.begin(), tripletList.end());
-
-        //Create full multiplication matrix
-        m_matSparseProjCompMult = m_matSparseProjMult * m_matSparseCompMult;
-
-        m_matSparseFull = m_matSparseProjMult * m_matSparseCompMult;
+        m_projOperator.setProjection(projs, m_pFiffInfo->ch_names, m_pFiffInfo->bads);
+        m_bProjActivated = m_projOperator.isProjActive();
         m_mutex.unlock();
     }
 }
@@ -493,37 +428,9 @@ void NoiseReduction::updateCompensator(int to)
         this->m_pFiffInfo->make_compensator(0, to, newComp);//Do this always from 0 since we always read new raw data, we never actually perform a multiplication on already existing data
 
         //this->m_pFiffInfo->set_current_comp(to);
-        MatrixXd matComp = newComp.data->data;
-
-        //
-        // Make proj sparse
-        //
-        qint32 nchan = this->m_pFiffInfo->nchan;
-        qint32 i, k;
-
-        typedef Eigen::Triplet<double> T;
-        std::vector<T> tripletList;
-        tripletList.reserve(nchan);
-
-        tripletList.clear();
-        tripletList.reserve(matComp.rows()*matComp.cols());
-        for(i = 0; i < matComp.rows(); ++i) {
-            for(k = 0; k < matComp.cols(); ++k) {
-                if(matComp(i,k) != 0) {
-                    tripletList.push_back(T(i, k, matComp(i,k)));
-                }
-            }
-        }
-
-        m_matSparseCompMult = SparseMatrix<double>(matComp.rows(),matComp.cols());
-        if(tripletList.size() > 0) {
-            m_matSparseCompMult.setFromTriplets(tripletList.begin(), tripletList.end());
-        }
-
-        //Create full multiplication matrix
-        m_matSparseProjCompMult = m_matSparseProjMult * m_matSparseCompMult;
-
-        m_matSparseFull = m_matSparseProjMult * m_matSparseCompMult;
+        m_mutex.lock();
+        m_projOperator.setCompensator(newComp.data->data);
+        m_mutex.unlock();
     }
 }
 
@@ -709,8 +616,6 @@ void NoiseReduction::createSpharaOperator()
     //Create full multiplication matrix
     m_matSparseSpharaMult = matSparseSpharaMultFirst * matSparseSpharaMultSecond;
 
-    m_matSparseFull = m_matSparseProjMult * m_matSparseCompMult;
-
     m_mutex.unlock();
 }
 
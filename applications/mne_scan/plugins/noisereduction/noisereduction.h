@@ -45,6 +45,7 @@
 #include <utils/generics/circularbuffer.h>
 
 #include <fiff/fiff_proj.h>
+#include <fiff/fiff_proj_operator.h>
 
 #include <rtprocessing/helpers/filterkernel.h>
 
@@ -243,10 +244,8 @@ private:
     Eigen::VectorXi                 m_vecIndicesFirstEEG;                       /**< The indices of the channels to pick for the second SPHARA operator in case of an EEG system.*/
 
     Eigen::SparseMatrix<double>     m_matSparseSpharaMult;                      /**< The final sparse SPHARA operator .*/
-    Eigen::SparseMatrix<double>     m_matSparseProjCompMult;                    /**< The final sparse projection + compensator operator.*/
-    Eigen::SparseMatrix<double>     m_matSparseProjMult;                        /**< The final sparse SSP projector. */
-    Eigen::SparseMatrix<double>     m_matSparseCompMult;                        /**< The final sparse compensator matrix. */
-    Eigen::SparseMatrix<double>     m_matSparseFull;                            /**< The final sparse full multiplication matrix . */
+
+    FIFFLIB::FiffProjOperator       m_projOperator;                             /**< The low-rank SSP projector and compensator. */
 
     Eigen::MatrixXd                 m_matSpharaVVGradLoaded;                    /**< The loaded VectorView gradiometer basis functions.*/
     Eigen::MatrixXd                 m_matSpharaVVMagLoaded;                     /**< The loaded VectorView magnetometer basis functions.*/
@@ -44,6 +44,7 @@
 #include <disp/viewers/projectsettingsview.h>
 #include <scMeas/realtimemultisamplearray.h>
 #include <fiff/fiff_stream.h>
+#include <fiff/fiff_raw_writer.h>
 #include <utils/file.h>
 
 //=============================================================================================================
@@ -308,8 +309,8 @@ void WriteToFile::run()
                         this->splitRecordingFile();
                     }
 
-                    if(m_pOutfid) {
-                        m_pOutfid->write_raw_buffer(matData, m_mCals);
+                    if(m_pRawWriter) {
+                        m_pRawWriter->write(matData);
                     }
                 } else {
                     size = 0;
@@ -359,6 +360,7 @@ void WriteToFile::toggleRecordingFile()
     //Setup writing to file
     if(m_bWriteToFile) {
         m_mutex.lock();
+        m_pRawWriter.reset();
         m_pOutfid->finish_writing_raw();
         m_mutex.unlock();
 
@@ -411,6 +413,7 @@ void WriteToFile::toggleRecordingFile()
 
         fiff_int_t first = 0;
         m_pOutfid->write_int(FIFF_FIRST_SAMPLE, &first);
+        m_pRawWriter = FiffRawWriter::SPtr(new FiffRawWriter(m_pOutfid, m_mCals));
         m_mutex.unlock();
 
         m_bWriteToFile = true;
@@ -437,6 +440,9 @@ void WriteToFile::splitRecordingFile()
     QString nextFileName = m_sRecordFileName.remove("_raw.fif");
     nextFileName += QString("-%1_raw.fif").arg(m_iSplitCount);
 
+    //Write all pending buffers before the link to the next file
+    m_pRawWriter.reset();
+
     //Write the link to the next file
     qint32 data;
     m_pOutfid->start_block(FIFFB_REF);
@@ -462,6 +468,7 @@ void WriteToFile::splitRecordingFile()
 
     fiff_int_t first = 0;
     m_pOutfid->write_int(FIFF_FIRST_SAMPLE, &first);
+    m_pRawWriter = FiffRawWriter::SPtr(new FiffRawWriter(m_pOutfid, m_mCals));
 
     m_lFileNames.append(QFileInfo(m_qFileOut).fileName());
 }
@@ -487,6 +494,10 @@ void WriteToFile::clipRecording(bool bChecked)
 
     QMutexLocker locker(&m_mutex);
 
+    if(m_pRawWriter) {
+        m_pRawWriter->flush();
+    }
+
     m_qFileOut.close();
     m_FileSharer.copyRealtimeFile(m_qFileOut.fileName());
     m_qFileOut.open(QIODevice::ReadWrite);
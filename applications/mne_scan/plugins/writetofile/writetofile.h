@@ -68,6 +68,7 @@
 namespace FIFFLIB{
     class FiffInfo;
     class FiffStream;
+    class FiffRawWriter;
 }
 
 namespace SCMEASLIB{
@@ -289,6 +290,7 @@ private:
 
     QSharedPointer<FIFFLIB::FiffInfo>       m_pFiffInfo;                    /**< Fiff measurement info.*/
     QSharedPointer<FIFFLIB::FiffStream>     m_pOutfid;                      /**< FiffStream to write to.*/
+    QSharedPointer<FIFFLIB::FiffRawWriter>  m_pRawWriter;                   /**< Converts and writes the raw data buffers to m_pOutfid in a background thread.*/
 
     QSharedPointer<QTimer>                  m_pUpdateTimeInfoTimer;         /**< timer to control remaining time. */
     QSharedPointer<QTimer>                  m_pBlinkingRecordButtonTimer;   /**< timer to control blinking recording button. */
@@ -286,8 +286,6 @@ int main(int argc, char *argv[])
         t_Fwd = MNEForwardSolution(t_fileFwd, false, true);
 
         // Load data
-        MNESourceEstimate sourceEstimate;
-
         double lambda2 = 1.0 / pow(dSnr, 2);
         QString method(sSourceLocMethod);
 
@@ -317,16 +315,22 @@ int main(int argc, char *argv[])
 
         picks = raw.info.pick_types(QString("all"),true,false,QStringList(),exclude);
         data.pick_channels(picks);
+        // Apply the kernel to all epochs at once
+        QList<MatrixXd> lEpochs;
         for(int i = 0; i < data.size(); i++) {
-            sourceEstimate = minimumNorm.calculateInverse(data.at(i)->epoch,
-                                                          0.0f,
-                                                          1.0/raw.info.sfreq,
-                                                          true);
+            lEpochs << data.at(i)->epoch;
+        }
+
+        QList<MNESourceEstimate> lSourceEstimates = minimumNorm.calculateInverse(lEpochs,
+                                                                                 0.0f,
+                                                                                 1.0/raw.info.sfreq,
+                                                                                 true);
 
-            if(sourceEstimate.isEmpty()) {
+        for(int i = 0; i < lSourceEstimates.size(); i++) {
+            if(lSourceEstimates.at(i).isEmpty()) {
                 printf("Source estimate is empty");
             } else {
-                matDataList << sourceEstimate.data;
+                matDataList << lSourceEstimates.at(i).data;
             }
         }
 
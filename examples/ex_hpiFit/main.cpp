@@ -108,6 +108,7 @@ int main(int argc, char *argv[])
     QCommandLineOption inVerbose("verbose", "Print to command line [0,1].", "in","0");
     QCommandLineOption inDebug("debug", "Save debug info during HPI fit [0,1].", "in","0");
     QCommandLineOption inFast("fast", "Do fast fits [0,1].", "in","0");
+    QCommandLineOption inGradient("gradient", "Use the gradient based dipole fit instead of the simplex [0,1].", "in","0");
     QCommandLineOption outName("fileOut", "The output file name for movement data.", "out","position.txt");
 
     parser.addOption(inFile);
@@ -118,6 +119,7 @@ int main(int argc, char *argv[])
     parser.addOption(inVerbose);
     parser.addOption(inDebug);
     parser.addOption(inFast);
+    parser.addOption(inGradient);
     parser.addOption(outName);
 
     parser.process(a);
@@ -140,6 +142,7 @@ int main(int argc, char *argv[])
     bool bVerbose = parser.value(inVerbose).toInt();
     bool bDoDebug = parser.value(inDebug).toInt();
     bool bFast = parser.value(inFast).toInt();
+    bool bGradient = parser.value(inGradient).toInt();
     QString sNameOut(parser.value(outName));
 
     // Init data loading and writing
@@ -202,7 +205,7 @@ int main(int argc, char *argv[])
     // if debugging files are necessary set bDoDebug = true;
     QString sHPIResourceDir = QCoreApplication::applicationDirPath() + "/HPIFittingDebug";
 
-    HPIFit HPI = HPIFit(pFiffInfo,bFast);
+    HPIFit HPI = HPIFit(pFiffInfo,bFast,bGradient);
 
     // ordering of frequencies
     from = first + vecTime(0);
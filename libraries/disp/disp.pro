@@ -150,6 +150,7 @@ SOURCES += \
     viewers/helpers/frequencyspectrumdelegate.cpp \
     viewers/helpers/frequencyspectrummodel.cpp \
     viewers/helpers/bidsviewmodel.cpp \
+    viewers/helpers/minmaxpyramid.cpp \
 
 HEADERS += \
     disp_global.h \
@@ -209,6 +210,7 @@ HEADERS += \
     viewers/helpers/frequencyspectrumdelegate.h \
     viewers/helpers/frequencyspectrummodel.h \
     viewers/helpers/bidsviewmodel.h \
+    viewers/helpers/minmaxpyramid.h \
 
 qtHaveModule(charts) {
     SOURCES += \
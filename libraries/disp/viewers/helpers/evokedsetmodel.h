@@ -43,6 +43,7 @@
 
 #include <rtprocessing/helpers/filterkernel.h>
 #include <fiff/fiff_types.h>
+#include <fiff/fiff_proj_operator.h>
 
 //=============================================================================================================
 // QT INCLUDES
@@ -57,7 +58,6 @@
 //=============================================================================================================
 
 #include <Eigen/Core>
-#include <Eigen/SparseCore>
 
 //=============================================================================================================
 // FORWARD DECLARATIONS
@@ -394,13 +394,7 @@ private:
     QList<Eigen::MatrixXd>                  m_matDataFreeze;                /**< List that holds the data when freezed*/
     QStringList                             m_lAvrTypes;                    /**< The average types. */
 
-    Eigen::MatrixXd                         m_matProj;                      /**< SSP projector. */
-    Eigen::MatrixXd                         m_matComp;                      /**< Compensator. */
-    Eigen::SparseMatrix<double>             m_matSparseProjCompMult;        /**< The final sparse projection + compensator operator.*/
-    Eigen::SparseMatrix<double>             m_matSparseProjMult;            /**< The final sparse SSP projector. */
-    Eigen::SparseMatrix<double>             m_matSparseCompMult;            /**< The final sparse compensator matrix. */
-
-    Eigen::RowVectorXi                      m_vecBadIdcs;                   /**< Idcs of bad channels. */
+    FIFFLIB::FiffProjOperator               m_projOperator;                 /**< The low-rank SSP projector and compensator. */
 
     QPair<QVariant,QVariant>                m_pairBaseline;                 /**< Baseline information. */
 
@@ -0,0 +1,134 @@
+//=============================================================================================================
+/**
+ * @file     minmaxpyramid.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Definition of the MinMaxPyramid Class.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "minmaxpyramid.h"
+
+#include <cmath>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace DISPLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+MinMaxPyramid::MinMaxPyramid()
+: m_iNumSamples(0)
+{
+}
+
+//=============================================================================================================
+
+void MinMaxPyramid::clear()
+{
+    m_lMin.clear();
+    m_lMax.clear();
+    m_iNumSamples = 0;
+}
+
+//=============================================================================================================
+
+int MinMaxPyramid::rows() const
+{
+    return m_lMin.isEmpty() ? 0 : m_lMin.first().rows();
+}
+
+//=============================================================================================================
+
+int MinMaxPyramid::cols() const
+{
+    return m_iNumSamples;
+}
+
+//=============================================================================================================
+
+bool MinMaxPyramid::isEmpty() const
+{
+    return m_lMin.isEmpty();
+}
+
+//=============================================================================================================
+
+void MinMaxPyramid::envelope(int iRow,
+                             int iFrom,
+                             int iTo,
+                             double dFirstBin,
+                             double dBinsPerSample,
+                             VectorXf& vecMin,
+                             VectorXf& vecMax) const
+{
+    if(m_lMin.isEmpty() || iRow < 0 || iRow >= rows() || dBinsPerSample <= 0.0) {
+        return;
+    }
+
+    iFrom = std::max(iFrom, 0);
+    iTo = std::min(iTo, m_iNumSamples);
+
+    if(iFrom >= iTo) {
+        return;
+    }
+
+    // Pick the coarsest level whose buckets (2^(l+1) samples) still fit into one bin
+    double dSamplesPerBin = 1.0 / dBinsPerSample;
+    int iLevel = 0;
+
+    while(iLevel + 1 < m_lMin.size() && double(2 << (iLevel + 1)) <= dSamplesPerBin) {
+        ++iLevel;
+    }
+
+    const int iShift = iLevel + 1;
+    const float* pMin = m_lMin[iLevel].data() + iRow * m_lMin[iLevel].cols();
+    const float* pMax = m_lMax[iLevel].data() + iRow * m_lMax[iLevel].cols();
+    const int iNumBins = std::min(vecMin.size(), vecMax.size());
+
+    for(int b = iFrom >> iShift; b <= (iTo - 1) >> iShift; ++b) {
+        int iSample = std::max(b << iShift, iFrom);
+        int iBin = static_cast<int>(std::floor(dFirstBin + (iSample - iFrom) * dBinsPerSample));
+
+        if(iBin < 0 || iBin >= iNumBins) {
+            continue;
+        }
+
+        vecMin[iBin] = std::min(vecMin[iBin], pMin[b]);
+        vecMax[iBin] = std::max(vecMax[iBin], pMax[b]);
+    }
+}
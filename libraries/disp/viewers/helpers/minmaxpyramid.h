@@ -0,0 +1,261 @@
+//=============================================================================================================
+/**
+ * @file     minmaxpyramid.h
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Declaration of the MinMaxPyramid Class.
+ *
+ */
+
+#ifndef MINMAXPYRAMID_H
+#define MINMAXPYRAMID_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "../../disp_global.h"
+
+#include <algorithm>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QVector>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// DEFINE NAMESPACE DISPLIB
+//=============================================================================================================
+
+namespace DISPLIB
+{
+
+//=============================================================================================================
+/**
+ * Multi resolution min/max envelope of a channels x samples data matrix. Level l holds the minimum and maximum of
+ * consecutive buckets of 2^(l+1) samples per channel. Drawing a channel with more than one sample per pixel then
+ * only needs to visit about one bucket per pixel instead of every sample. Ranges of samples can be updated
+ * incrementally, e.g. when new data is written into a ring buffer.
+ *
+ * @brief Min/max decimation pyramid for raw data rendering.
+ */
+class DISPSHARED_EXPORT MinMaxPyramid
+{
+
+public:
+    typedef Eigen::Matrix<float,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor> MatrixXfR;
+
+    //=========================================================================================================
+    /**
+     * Constructs an empty MinMaxPyramid.
+     */
+    MinMaxPyramid();
+
+    //=========================================================================================================
+    /**
+     * Constructs a MinMaxPyramid for the given data.
+     *
+     * @param[in] matData    The data (channels x samples).
+     */
+    template<typename Derived>
+    explicit MinMaxPyramid(const Eigen::MatrixBase<Derived>& matData);
+
+    //=========================================================================================================
+    /**
+     * Allocates all levels for the dimensions of the given data and computes them.
+     *
+     * @param[in] matData    The data (channels x samples).
+     */
+    template<typename Derived>
+    void build(const Eigen::MatrixBase<Derived>& matData);
+
+    //=========================================================================================================
+    /**
+     * Recomputes all buckets which are affected by a change of the samples [iFrom, iTo). The pyramid is rebuilt
+     * completely if the dimensions of the data changed.
+     *
+     * @param[in] matData    The complete data (channels x samples) after the change.
+     * @param[in] iFrom      The first changed sample.
+     * @param[in] iTo        One past the last changed sample.
+     */
+    template<typename Derived>
+    void update(const Eigen::MatrixBase<Derived>& matData,
+                int iFrom,
+                int iTo);
+
+    //=========================================================================================================
+    /**
+     * Releases all levels.
+     */
+    void clear();
+
+    //=========================================================================================================
+    /**
+     * Returns the number of channels.
+     *
+     * @return The number of channels.
+     */
+    int rows() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the number of samples the pyramid was built for.
+     *
+     * @return The number of samples.
+     */
+    int cols() const;
+
+    //=========================================================================================================
+    /**
+     * Returns whether the pyramid holds any data.
+     *
+     * @return True if empty.
+     */
+    bool isEmpty() const;
+
+    //=========================================================================================================
+    /**
+     * Accumulates the envelope of the samples [iFrom, iTo) of one channel into bins, e.g. pixel columns. Sample s
+     * falls into bin floor(dFirstBin + (s - iFrom) * dBinsPerSample). The coarsest level whose buckets are not
+     * wider than one bin is used, so the result is exact up to one bucket at the bin borders. vecMin and vecMax
+     * are only lowered and raised respectively, they need to be initialized by the caller. Bins outside of the
+     * vectors are skipped.
+     *
+     * @param[in] iRow              The channel.
+     * @param[in] iFrom             The first sample.
+     * @param[in] iTo               One past the last sample.
+     * @param[in] dFirstBin         The bin of sample iFrom.
+     * @param[in] dBinsPerSample    The number of bins per sample. Should be at most 0.5.
+     * @param[in, out] vecMin       The minimum per bin.
+     * @param[in, out] vecMax       The maximum per bin.
+     */
+    void envelope(int iRow,
+                  int iFrom,
+                  int iTo,
+                  double dFirstBin,
+                  double dBinsPerSample,
+                  Eigen::VectorXf& vecMin,
+                  Eigen::VectorXf& vecMax) const;
+
+private:
+    QVector<MatrixXfR>  m_lMin;         /**< The bucket minima per level (channels x buckets). */
+    QVector<MatrixXfR>  m_lMax;         /**< The bucket maxima per level (channels x buckets). */
+    int                 m_iNumSamples;  /**< The number of samples the pyramid was built for. */
+};
+
+//=============================================================================================================
+// INLINE & TEMPLATE DEFINITIONS
+//=============================================================================================================
+
+template<typename Derived>
+MinMaxPyramid::MinMaxPyramid(const Eigen::MatrixBase<Derived>& matData)
+: m_iNumSamples(0)
+{
+    build(matData);
+}
+
+//=============================================================================================================
+
+template<typename Derived>
+void MinMaxPyramid::build(const Eigen::MatrixBase<Derived>& matData)
+{
+    clear();
+
+    if(matData.rows() == 0 || matData.cols() == 0) {
+        return;
+    }
+
+    m_iNumSamples = matData.cols();
+
+    int iNumBuckets = m_iNumSamples;
+    do {
+        iNumBuckets = (iNumBuckets + 1) / 2;
+        m_lMin.append(MatrixXfR(matData.rows(), iNumBuckets));
+        m_lMax.append(MatrixXfR(matData.rows(), iNumBuckets));
+    } while(iNumBuckets > 1);
+
+    update(matData, 0, m_iNumSamples);
+}
+
+//=============================================================================================================
+
+template<typename Derived>
+void MinMaxPyramid::update(const Eigen::MatrixBase<Derived>& matData,
+                           int iFrom,
+                           int iTo)
+{
+    if(matData.rows() != rows() || matData.cols() != m_iNumSamples) {
+        build(matData);
+        return;
+    }
+
+    iFrom = std::max(iFrom, 0);
+    iTo = std::min(iTo, m_iNumSamples);
+
+    if(iFrom >= iTo) {
+        return;
+    }
+
+    // Finest level: buckets of two samples, computed from the data
+    int iFirst = iFrom / 2;
+    int iLast = (iTo - 1) / 2;
+
+    for(int b = iFirst; b <= iLast; ++b) {
+        int iWidth = std::min(2, m_iNumSamples - 2 * b);
+        m_lMin[0].col(b) = matData.middleCols(2 * b, iWidth).rowwise().minCoeff().template cast<float>();
+        m_lMax[0].col(b) = matData.middleCols(2 * b, iWidth).rowwise().maxCoeff().template cast<float>();
+    }
+
+    // Coarser levels: merge two buckets of the level below
+    for(int l = 1; l < m_lMin.size(); ++l) {
+        iFirst /= 2;
+        iLast /= 2;
+        int iNumChildren = m_lMin[l-1].cols();
+
+        for(int b = iFirst; b <= iLast; ++b) {
+            if(2 * b + 1 < iNumChildren) {
+                m_lMin[l].col(b) = m_lMin[l-1].col(2 * b).cwiseMin(m_lMin[l-1].col(2 * b + 1));
+                m_lMax[l].col(b) = m_lMax[l-1].col(2 * b).cwiseMax(m_lMax[l-1].col(2 * b + 1));
+            } else {
+                m_lMin[l].col(b) = m_lMin[l-1].col(2 * b);
+                m_lMax[l].col(b) = m_lMax[l-1].col(2 * b);
+            }
+        }
+    }
+}
+
+} // NAMESPACE DISPLIB
+
+#endif // MINMAXPYRAMID_H
@@ -45,6 +45,8 @@
 
 #include "../scalingview.h"
 
+#include <limits>
+
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
@@ -62,6 +64,7 @@
 //=============================================================================================================
 
 using namespace DISPLIB;
+using namespace Eigen;
 
 //=============================================================================================================
 // DEFINE MEMBER METHODS
@@ -457,6 +460,43 @@ void RtFiffRawViewDelegate::createPlotPath(const QModelIndex &index,
     path.moveTo(calcPoint(path, 0., 0., dChannelOffset, dScaleY));
     double dY(0);
 
+    //With two or more samples per pixel draw the min/max envelope per pixel column instead of every sample
+    if(dPixelsPerSample <= 0.5 && data.second > 0) {
+        int iNumBins = iPlotSizePx + 1;
+        VectorXf vecMinA = VectorXf::Constant(iNumBins, std::numeric_limits<float>::max());
+        VectorXf vecMaxA = VectorXf::Constant(iNumBins, std::numeric_limits<float>::lowest());
+        VectorXf vecMinB = vecMinA;
+        VectorXf vecMaxB = vecMaxA;
+
+        if(t_pModel->getEnvelope(index.row(), 0, iTimeCursorSample, 0., dPixelsPerSample, vecMinA, vecMaxA)
+           && t_pModel->getEnvelope(index.row(), iTimeCursorSample, data.second, iTimeCursorSample * dPixelsPerSample, dPixelsPerSample, vecMinB, vecMaxB)) {
+            double dX = path.currentPosition().x();
+
+            for(int i = 0; i < iNumBins; ++i) {
+                //A part and B part are drawn relative to different first values, see below
+                double dMin = std::numeric_limits<double>::max();
+                double dMax = std::numeric_limits<double>::lowest();
+
+                if(vecMinA[i] <= vecMaxA[i]) {
+                    dMin = vecMinA[i] - data.first[0];
+                    dMax = vecMaxA[i] - data.first[0];
+                }
+                if(vecMinB[i] <= vecMaxB[i]) {
+                    dMin = std::min(dMin, vecMinB[i] - firstValuePreviousPlot);
+                    dMax = std::max(dMax, vecMaxB[i] - firstValuePreviousPlot);
+                }
+                if(dMin > dMax) {
+                    continue;
+                }
+
+                path.lineTo(QPointF(dX + i, -((dScaleY * dMax) - dChannelOffset)));
+                path.lineTo(QPointF(dX + i, -((dScaleY * dMin) - dChannelOffset)));
+            }
+
+            return;
+        }
+    }
+
     //The plot works as a rolling time-cursor, ploting data on top of previous runs.
     //You always plot one whole window of data, between first sample and numSamplesToPlot (or data.second)
     //Even if the only change is a new block of samples to the left of the time-cursor.
@@ -663,9 +703,7 @@ void RtFiffRawViewDelegate::createMarkerPath(const QModelIndex &index,
     int iEarliestDrawnSample = iOffset - iMaxSample + iTimeCursorSample;
     int iLatestDrawnSample = iOffset + iTimeCursorSample;
 
-    auto events = t_pModel->getEventsToDisplay(iEarliestDrawnSample, iLatestDrawnSample);
-
-    for(auto& e : *events)
+    t_pModel->forEachEventToDisplay(iEarliestDrawnSample, iLatestDrawnSample, [&](const EVENTSLIB::Event& e)
     {
         int iEventSample = e.sample;
         int iLastStartingSample = iOffset - iMaxSample;
@@ -675,7 +713,7 @@ void RtFiffRawViewDelegate::createMarkerPath(const QModelIndex &index,
 
         path.moveTo(iPositionInPixels,yStart);
         path.lineTo(iPositionInPixels,yEnd);
-    }
+    });
 }
 
 //=============================================================================================================
@@ -58,6 +58,7 @@
 #include <QCoreApplication>
 #include <QtConcurrent>
 #include <QFuture>
+#include <QThread>
 #include <QDebug>
 
 //=============================================================================================================
@@ -74,6 +75,51 @@ using namespace FIFFLIB;
 using namespace Eigen;
 using namespace RTPROCESSINGLIB;
 
+//=============================================================================================================
+// DEFINE LOCAL FUNCTIONS
+//=============================================================================================================
+
+namespace
+{
+
+//=============================================================================================================
+/**
+ * Splits the channels into groups of consecutive rows (first row, number of rows). A group holds at most about
+ * 256 kB of samples, so it stays in cache while being filtered, but there are at least as many groups as threads.
+ */
+QVector<QPair<int,int> > channelGroups(int iNumRows,
+                                       int iNumCols)
+{
+    const int iNumThreads = std::max(QThread::idealThreadCount(), 1);
+    const int iCacheRows = (256 * 1024) / int(sizeof(double) * std::max(iNumCols, 1));
+    const int iGroupSize = std::max(1, std::min(iCacheRows, (iNumRows + iNumThreads - 1) / iNumThreads));
+
+    QVector<QPair<int,int> > lGroups;
+    for(int i = 0; i < iNumRows; i += iGroupSize) {
+        lGroups.append(QPair<int,int>(i, std::min(iGroupSize, iNumRows - i)));
+    }
+
+    return lGroups;
+}
+
+//=============================================================================================================
+/**
+ * Runs the function on all channel groups. The groups are spread over the threads of the global thread pool, which
+ * stay alive between blocks.
+ */
+template<typename Function>
+void forEachChannelGroup(QVector<QPair<int,int> >& lGroups,
+                         Function function)
+{
+    if(lGroups.size() > 1) {
+        QtConcurrent::blockingMap(lGroups, function);
+    } else if(!lGroups.isEmpty()) {
+        function(lGroups.first());
+    }
+}
+
+}
+
 //=============================================================================================================
 // DEFINE MEMBER METHODS
 //=============================================================================================================
@@ -98,6 +144,7 @@ RtFiffRawViewModel::RtFiffRawViewModel(QObject *parent)
 , m_iCurrentStartingSample(0)
 , m_iCurrentSampleFreeze(0)
 , m_iMaxFilterLength(128)
+, m_iFilterKernelDataSize(-1)
 , m_iCurrentBlockSize(1024)
 , m_iResidual(0)
 , m_iCurrentTriggerChIndex(0)
@@ -298,15 +345,6 @@ void RtFiffRawViewModel::initSphara()
 void RtFiffRawViewModel::setFiffInfo(QSharedPointer<FIFFLIB::FiffInfo> &p_pFiffInfo)
 {
     if(p_pFiffInfo) {
-        RowVectorXi sel;// = RowVectorXi(0,0);
-        QStringList emptyExclude;
-
-        if(p_pFiffInfo->bads.size() > 0) {
-            sel = FiffInfoBase::pick_channels(p_pFiffInfo->ch_names, p_pFiffInfo->bads, emptyExclude);
-        }
-
-        m_vecBadIdcs = sel;
-
         m_pFiffInfo = p_pFiffInfo;
 
         resetSelection();
@@ -318,6 +356,9 @@ void RtFiffRawViewModel::setFiffInfo(QSharedPointer<FIFFLIB::FiffInfo> &p_pFiffI
         m_matDataFiltered.conservativeResize(m_pFiffInfo->chs.size(), m_iMaxSamples);
         m_matDataFiltered.setZero();
 
+        m_envelopeRaw.build(m_matDataRaw);
+        m_envelopeFiltered.build(m_matDataFiltered);
+
         m_vecLastBlockFirstValuesFiltered.conservativeResize(m_pFiffInfo->chs.size());
         m_vecLastBlockFirstValuesFiltered.setZero();
 
@@ -326,15 +367,12 @@ void RtFiffRawViewModel::setFiffInfo(QSharedPointer<FIFFLIB::FiffInfo> &p_pFiffI
 
         m_matOverlap.conservativeResize(m_pFiffInfo->chs.size(), m_iMaxFilterLength);
 
-        m_matSparseProjMult = SparseMatrix<double>(m_pFiffInfo->chs.size(),m_pFiffInfo->chs.size());
-        m_matSparseCompMult = SparseMatrix<double>(m_pFiffInfo->chs.size(),m_pFiffInfo->chs.size());
-        m_matSparseSpharaMult = SparseMatrix<double>(m_pFiffInfo->chs.size(),m_pFiffInfo->chs.size());
-        m_matSparseProjCompMult = SparseMatrix<double>(m_pFiffInfo->chs.size(),m_pFiffInfo->chs.size());
+        updateFilterChannelFlags();
 
-        m_matSparseProjMult.setIdentity();
-        m_matSparseCompMult.setIdentity();
+        m_matSparseSpharaMult = SparseMatrix<double>(m_pFiffInfo->chs.size(),m_pFiffInfo->chs.size());
         m_matSparseSpharaMult.setIdentity();
-        m_matSparseProjCompMult.setIdentity();
+
+        m_projOperator.clear();
 
         //Create the initial Compensator projector
         updateCompensator(0);
@@ -364,9 +402,7 @@ void RtFiffRawViewModel::setFiffInfo(QSharedPointer<FIFFLIB::FiffInfo> &p_pFiffI
         //Init the sphara operators
         initSphara();
     } else {
-        m_vecBadIdcs = RowVectorXi(0,0);
-        m_matProj = MatrixXd(0,0);
-        m_matComp = MatrixXd(0,0);
+        m_projOperator.clear();
     }
 }
 
@@ -393,6 +429,9 @@ void RtFiffRawViewModel::setSamplingInfo(float sps, int T, bool bSetZero)
         m_vecLastBlockFirstValuesFiltered.setZero();
     }
 
+    m_envelopeRaw.build(m_matDataRaw);
+    m_envelopeFiltered.build(m_matDataFiltered);
+
     if(m_iCurrentSample>m_iMaxSamples) {
         m_iCurrentStartingSample += m_iCurrentSample;
         m_iCurrentSample = 0;
@@ -417,10 +456,10 @@ MatrixXd RtFiffRawViewModel::getLastBlock()
 void RtFiffRawViewModel::addData(const QList<MatrixXd> &data)
 {
     //SSP
-    bool doProj = m_bProjActivated && m_matDataRaw.cols() > 0 && m_matDataRaw.rows() == m_matProj.cols() ? true : false;
+    bool doProj = m_bProjActivated && m_matDataRaw.cols() > 0 && m_matDataRaw.rows() == m_projOperator.nchan() ? true : false;
 
     //Compensator
-    bool doComp = m_bCompActivated && m_matDataRaw.cols() > 0 && m_matDataRaw.rows() == m_matComp.cols() ? true : false;
+    bool doComp = m_bCompActivated && m_matDataRaw.cols() > 0 && m_matDataRaw.rows() == m_projOperator.nchan() ? true : false;
 
     //SPHARA
     bool doSphara = m_bSpharaActivated && m_matSparseSpharaMult.cols() > 0 && m_matDataRaw.rows() == m_matSparseSpharaMult.cols() ? true : false;
@@ -448,24 +487,11 @@ void RtFiffRawViewModel::addData(const QList<MatrixXd> &data)
 //            std::cout<<"m_matDataRaw.cols(): "<<m_matDataRaw.cols()<<std::endl;
 //            std::cout<<"nCol-m_iResidual: "<<nCol-m_iResidual<<std::endl<<std::endl;
 
-            if(doComp) {
-                if(doProj) {
-                    //Comp + Proj
-                    m_matDataRaw.block(0, m_iCurrentSample, nRow, m_iResidual) = m_matSparseProjCompMult * data.at(b).block(0,0,nRow,m_iResidual);
-                } else {
-                    //Comp
-                    m_matDataRaw.block(0, m_iCurrentSample, nRow, m_iResidual) = m_matSparseCompMult * data.at(b).block(0,0,nRow,m_iResidual);
-                }
-            } else {
-                if(doProj)
-                {
-                    //Proj
-                    m_matDataRaw.block(0, m_iCurrentSample, nRow, m_iResidual) = m_matSparseProjMult * data.at(b).block(0,0,nRow,m_iResidual);
-                } else {
-                    //None - Raw
-                    m_matDataRaw.block(0, m_iCurrentSample, nRow, m_iResidual) = data.at(b).block(0,0,nRow,m_iResidual);
-                }
-            }
+            //Comp and/or Proj, the operator copies the data as is if neither is active
+            m_projOperator.apply(data.at(b).block(0,0,nRow,m_iResidual),
+                                 m_matDataRaw.block(0, m_iCurrentSample, nRow, m_iResidual),
+                                 doProj,
+                                 doComp);
 
             m_iCurrentStartingSample += m_iCurrentSample;
             m_iCurrentStartingSample += m_iResidual;
@@ -494,23 +520,11 @@ void RtFiffRawViewModel::addData(const QList<MatrixXd> &data)
 
         //std::cout<<"incoming data is ok"<<std::endl;
 
-        if(doComp) {
-            if(doProj) {
-                //Comp + Proj
-                m_matDataRaw.block(0, m_iCurrentSample, nRow, nCol) = m_matSparseProjCompMult * data.at(b);
-            } else {
-                //Comp
-                m_matDataRaw.block(0, m_iCurrentSample, nRow, nCol) = m_matSparseCompMult * data.at(b);
-            }
-        } else {
-            if(doProj) {
-                //Proj
-                m_matDataRaw.block(0, m_iCurrentSample, nRow, nCol) = m_matSparseProjMult * data.at(b);
-            } else {
-                //None - Raw
-                m_matDataRaw.block(0, m_iCurrentSample, nRow, nCol) = data.at(b);
-            }
-        }
+        //Comp and/or Proj, the operator copies the data as is if neither is active
+        m_projOperator.apply(data.at(b),
+                             m_matDataRaw.block(0, m_iCurrentSample, nRow, nCol),
+                             doProj,
+                             doComp);
 
         //Filter if neccessary else set filtered data matrix to zero
         if(!m_filterKernel.isEmpty() && m_bPerformFiltering) {
@@ -541,6 +555,16 @@ void RtFiffRawViewModel::addData(const QList<MatrixXd> &data)
         m_iCurrentSample += nCol;
         m_iCurrentBlockSize = nCol;
 
+        //Update the min/max envelopes. The residual was written to the end of the buffer and the filter overlap
+        //reaches up to one filter length around the current block.
+        updateEnvelope(m_envelopeRaw, m_matDataRaw, m_iCurrentSample-nCol-m_iResidual, m_iCurrentSample);
+
+        if(!m_filterKernel.isEmpty() && m_bPerformFiltering) {
+            updateEnvelope(m_envelopeFiltered, m_matDataFiltered, m_iCurrentSample-nCol-m_iResidual-m_iMaxFilterLength, m_iCurrentSample+m_iMaxFilterLength);
+        } else {
+            updateEnvelope(m_envelopeFiltered, m_matDataFiltered, m_iCurrentSample-nCol-m_iResidual, m_iCurrentSample);
+        }
+
         //detect the trigger flanks in the trigger channels
         if(m_bTriggerDetectionActive) {
             int iOldDetectedTriggers = m_qMapDetectedTrigger[m_iCurrentTriggerChIndex].size();
@@ -667,6 +691,8 @@ void RtFiffRawViewModel::toggleFreeze(const QModelIndex &)
     if(m_bIsFreezed) {
         m_matDataRawFreeze = m_matDataRaw;
         m_matDataFilteredFreeze = m_matDataFiltered;
+        m_envelopeRawFreeze = m_envelopeRaw;
+        m_envelopeFilteredFreeze = m_envelopeFiltered;
         m_qMapDetectedTriggerFreeze = m_qMapDetectedTrigger;
         m_qMapDetectedTriggerOldFreeze = m_qMapDetectedTriggerOld;
 
@@ -696,57 +722,13 @@ void RtFiffRawViewModel::updateProjection(const QList<FIFFLIB::FiffProj>& projs)
 {
     //  Update the SSP projector
     if(m_pFiffInfo) {
-        //If a minimum of one projector is active set m_bProjActivated to true so that this model applies the ssp to the incoming data
-        m_bProjActivated = false;
         m_pFiffInfo->projs = projs;
 
-        for(qint32 i = 0; i < this->m_pFiffInfo->projs.size(); ++i) {
-            if(this->m_pFiffInfo->projs[i].active) {
-                m_bProjActivated = true;
-                break;
-            }
-        }
-
-        this->m_pFiffInfo->make_projector(m_matProj);
+        //If a minimum of one projector is active set m_bProjActivated to true so that this model applies the ssp to the incoming data
+        m_projOperator.setProjection(m_pFiffInfo->projs, m_pFiffInfo->ch_names, m_pFiffInfo->bads);
+        m_bProjActivated = m_projOperator.isProjActive();
 
         qDebug() << "RtFiffRawViewModel::updateProjection - New projection calculated.";
-
-        //set columns of matrix to zero depending on bad channels indexes
-        for(qint32 j = 0; j < m_vecBadIdcs.cols(); ++j) {
-            m_matProj.col(m_vecBadIdcs[j]).setZero();
-        }
-
-//        std::cout << "Bads\n" << m_vecBadIdcs << std::endl;
-//        std::cout << "Proj\n";
-//        std::cout << m_matProj.block(0,0,10,10) << std::endl;
-
-        //
-        // Make proj sparse
-        //
-        qint32 nchan = this->m_pFiffInfo->nchan;
-        qint32 i, k;
-
-        typedef Eigen::Triplet<double> T;
-        std::vector<T> tripletList;
-        tripletList.reserve(nchan);
-
-        tripletList.clear();
-        tripletList.reserve(m_matProj.rows()*m_matProj.cols());
-        for(i = 0; i < m_matProj.rows(); ++i) {
-            for(k = 0; k < m_matProj.cols(); ++k) {
-                if(m_matProj(i,k) != 0) {
-                    tripletList.push_back(T(i, k, m_matProj(i,k)));
-                }
-            }
-        }
-
-        m_matSparseProjMult = SparseMatrix<double>(m_matProj.rows(),m_matProj.cols());
-        if(tripletList.size() > 0) {
-            m_matSparseProjMult.setFromTriplets(tripletList.begin(), tripletList.end());
-        }
-
-        //Create full multiplication matrix
-        m_matSparseProjCompMult = m_matSparseProjMult * m_matSparseCompMult;
     }
 }
 
@@ -772,35 +754,7 @@ void RtFiffRawViewModel::updateCompensator(int to)
         //We do not need to call this->m_pFiffInfo->set_current_comp(to);
         //Because we will set the compensators to the coil in the same FiffInfo which is already used to write to file.
         //Note that the data is written in raw form not in compensated form.
-        m_matComp = newComp.data->data;
-
-        //
-        // Make proj sparse
-        //
-        qint32 nchan = this->m_pFiffInfo->nchan;
-        qint32 i, k;
-
-        typedef Eigen::Triplet<double> T;
-        std::vector<T> tripletList;
-        tripletList.reserve(nchan);
-
-        tripletList.clear();
-        tripletList.reserve(m_matComp.rows()*m_matComp.cols());
-        for(i = 0; i < m_matComp.rows(); ++i) {
-            for(k = 0; k < m_matComp.cols(); ++k) {
-                if(m_matComp(i,k) != 0) {
-                    tripletList.push_back(T(i, k, m_matComp(i,k)));
-                }
-            }
-        }
-
-        m_matSparseCompMult = SparseMatrix<double>(m_matComp.rows(),m_matComp.cols());
-        if(tripletList.size() > 0) {
-            m_matSparseCompMult.setFromTriplets(tripletList.begin(), tripletList.end());
-        }
-
-        //Create full multiplication matrix
-        m_matSparseProjCompMult = m_matSparseProjMult * m_matSparseCompMult;
+        m_projOperator.setCompensator(newComp.data->data);
     }
 }
 
@@ -906,6 +860,8 @@ void RtFiffRawViewModel::setFilter(QList<FilterKernel> filterData)
     m_matOverlap.conservativeResize(m_pFiffInfo->chs.size(), m_iMaxFilterLength);
     m_matOverlap.setZero();
 
+    m_iFilterKernelDataSize = -1;
+
     m_bDrawFilterFront = false;
 
     //Filter all visible data channels at once
@@ -959,6 +915,8 @@ void RtFiffRawViewModel::setFilterChannelType(const QString &channelType)
 //        }
 //    }
 
+    updateFilterChannelFlags();
+
 //    m_bDrawFilterFront = false;
 
     //Filter all visible data channels at once
@@ -997,6 +955,8 @@ void RtFiffRawViewModel::createFilterChannelList(QStringList channelNames)
         }
     }
 
+    updateFilterChannelFlags();
+
 //    m_bDrawFilterFront = false;
 
 //    for(int i = 0; i<m_filterChannelList.size(); ++i)
@@ -1026,10 +986,6 @@ void RtFiffRawViewModel::markChBad(QModelIndex ch, bool status)
     QStringList channelNames;
     createFilterChannelList(channelNames);
 
-    //Update indeices of bad channels (this vector is needed when creating new ssp operators)
-    QStringList emptyExclude;
-    m_vecBadIdcs = FiffInfoBase::pick_channels(m_pFiffInfo->ch_names, m_pFiffInfo->bads, emptyExclude);
-
     emit dataChanged(ch,ch);
 }
 
@@ -1097,19 +1053,33 @@ void RtFiffRawViewModel::markChBad(QModelIndexList chlist, bool status)
 
         emit dataChanged(chlist[i],chlist[i]);
     }
+}
+
+//=============================================================================================================
 
-    //Update indeices of bad channels (this vector is needed when creating new ssp operators)
-    QStringList emptyExclude;
-    m_vecBadIdcs = FiffInfoBase::pick_channels(m_pFiffInfo->ch_names, m_pFiffInfo->bads, emptyExclude);
+void RtFiffRawViewModel::updateFilterChannelFlags()
+{
+    m_vecFilterChannel.fill(false, m_pFiffInfo->chs.size());
+
+    for(int i = 0; i < m_pFiffInfo->chs.size(); ++i) {
+        m_vecFilterChannel[i] = m_filterChannelList.contains(m_pFiffInfo->chs.at(i).ch_name);
+    }
 }
 
 //=============================================================================================================
 
-void RtFiffRawViewModel::doFilterPerChannelRTMSA(QPair<QList<FilterKernel>,QPair<int,RowVectorXd> > &channelDataTime)
+void RtFiffRawViewModel::prepareFilterKernels(int iDataSize)
 {
-    for(int i = 0; i < channelDataTime.first.size(); ++i) {
-        //channelDataTime.second.second = channelDataTime.first.at(i).applyConvFilter(channelDataTime.second.second, true);
-        channelDataTime.first[i].applyFftFilter(channelDataTime.second.second, true); //FFT Convolution for rt is not suitable. FFT make the signal filtering non causal.
+    if(m_iFilterKernelDataSize == iDataSize) {
+        return;
+    }
+
+    m_iFilterKernelDataSize = iDataSize;
+
+    //The filtered data keeps its overhead, so every filter sees the data grown by the taps of the filters before it
+    for(int i = 0; i < m_filterKernel.size(); ++i) {
+        m_filterKernel[i].prepareFilter(iDataSize);
+        iDataSize += m_filterKernel.at(i).getCoefficients().cols();
     }
 }
 
@@ -1130,6 +1100,9 @@ void RtFiffRawViewModel::filterDataBlock()
     int exp = ceil(MNEMath::log2(fftLength));
     fftLength = pow(2, exp) < 512 ? 512 : pow(2, exp);
 
+    //Also append mirrored data in front and back to get rid of edge effects
+    int iDataSize = m_matDataRaw.cols() + 2 * m_iMaxFilterLength;
+
     for(int i = 0; i<m_filterKernel.size(); ++i) {
         FilterKernel tempFilter(m_filterKernel.at(i).getName(),
                                 FilterKernel::m_filterTypes.indexOf(m_filterKernel.at(i).getFilterType()),
@@ -1140,41 +1113,40 @@ void RtFiffRawViewModel::filterDataBlock()
                                 m_filterKernel.at(i).getSamplingFrequency(),
                                 FilterKernel::m_designMethods.indexOf(m_filterKernel.at(i).getDesignMethod()));
 
+        //Transform the coefficients once here instead of once per channel
+        tempFilter.prepareFilter(iDataSize);
+        iDataSize += tempFilter.getCoefficients().cols();
+
         tempFilterList.append(tempFilter);
     }
 
-    //Generate QList structure which can be handled by the QConcurrent framework
-    QList<QPair<QList<FilterKernel>,QPair<int,RowVectorXd> > > timeData;
-    QList<int> notFilterChannelIndex;
+    //Filter the channels in groups, each group copying its rows into one reused buffer
+    QVector<QPair<int,int> > lGroups = channelGroups(m_matDataRaw.rows(), m_matDataRaw.cols());
 
-    //Also append mirrored data in front and back to get rid of edge effects
-    for(qint32 i=0; i<m_matDataRaw.rows(); ++i) {
-        if(m_filterChannelList.contains(m_pFiffInfo->chs.at(i).ch_name)) {
-            RowVectorXd datTemp(m_matDataRaw.row(i).cols() + 2 * m_iMaxFilterLength);
-            datTemp << m_matDataRaw.row(i).head(m_iMaxFilterLength).reverse(), m_matDataRaw.row(i), m_matDataRaw.row(i).tail(m_iMaxFilterLength).reverse();
-            timeData.append(QPair<QList<FilterKernel>,QPair<int,RowVectorXd> >(tempFilterList,QPair<int,RowVectorXd>(i,datTemp)));
-        } else {
-            notFilterChannelIndex.append(i);
-        }
-    }
+    forEachChannelGroup(lGroups, [&](const QPair<int,int>& group) {
+        QList<FilterKernel> lFilters = tempFilterList;
+        RowVectorXd vecData;
 
-    //Do the concurrent filtering
-    if(!timeData.isEmpty()) {
-        QFuture<void> future = QtConcurrent::map(timeData,
-                                             doFilterPerChannelRTMSA);
+        for(int i = group.first; i < group.first + group.second; ++i) {
+            if(i >= m_vecFilterChannel.size() || !m_vecFilterChannel.at(i)) {
+                //Fill filtered data with raw data if the channel is not filtered
+                m_matDataFiltered.row(i) = m_matDataRaw.row(i);
+                continue;
+            }
+
+            vecData.resize(m_matDataRaw.cols() + 2 * m_iMaxFilterLength);
+            vecData << m_matDataRaw.row(i).head(m_iMaxFilterLength).reverse(), m_matDataRaw.row(i), m_matDataRaw.row(i).tail(m_iMaxFilterLength).reverse();
 
-        future.waitForFinished();
+            for(int k = 0; k < lFilters.size(); ++k) {
+                lFilters[k].applyFftFilter(vecData, true);
+            }
 
-        for(int r = 0; r < timeData.size(); ++r) {
-            m_matDataFiltered.row(timeData.at(r).second.first) = timeData.at(r).second.second.segment(m_iMaxFilterLength+m_iMaxFilterLength/2, m_matDataRaw.cols());
-            m_matOverlap.row(timeData.at(r).second.first) = timeData.at(r).second.second.tail(m_iMaxFilterLength);
+            m_matDataFiltered.row(i) = vecData.segment(m_iMaxFilterLength+m_iMaxFilterLength/2, m_matDataRaw.cols());
+            m_matOverlap.row(i) = vecData.tail(m_iMaxFilterLength);
         }
-    }
+    });
 
-    //Fill filtered data with raw data if the channel was not filtered
-    for(int i = 0; i < notFilterChannelIndex.size(); ++i) {
-        m_matDataFiltered.row(notFilterChannelIndex.at(i)) = m_matDataRaw.row(notFilterChannelIndex.at(i));
-    }
+    m_envelopeFiltered.build(m_matDataFiltered);
 
     if(!m_bIsFreezed) {
         m_vecLastBlockFirstValuesFiltered = m_matDataFiltered.col(0);
@@ -1185,7 +1157,7 @@ void RtFiffRawViewModel::filterDataBlock()
 
 //=============================================================================================================
 
-void RtFiffRawViewModel::filterDataBlock(const MatrixXd &data, int iDataIndex)
+void RtFiffRawViewModel::filterDataBlock(const Ref<const MatrixXdR> &data, int iDataIndex)
 {
     //std::cout<<"START RtFiffRawViewModel::filterDataBlock"<<std::endl;
 
@@ -1193,110 +1165,106 @@ void RtFiffRawViewModel::filterDataBlock(const MatrixXd &data, int iDataIndex)
         return;
     }
 
-    //Generate QList structure which can be handled by the QConcurrent framework
-    QList<QPair<QList<FilterKernel>,QPair<int,RowVectorXd> > > timeData;
-    QList<int> notFilterChannelIndex;
+    prepareFilterKernels(data.cols());
 
-    for(qint32 i = 0; i < data.rows(); ++i) {
-        if(m_filterChannelList.contains(m_pFiffInfo->chs.at(i).ch_name)) {
-            timeData.append(QPair<QList<FilterKernel>,QPair<int,RowVectorXd> >(m_filterKernel,QPair<int,RowVectorXd>(i,data.row(i))));
-        } else {
-            notFilterChannelIndex.append(i);
+    //Do the overlap add method and store in m_matDataFiltered
+    const int iFilterDelay = m_iMaxFilterLength/2;
+    const bool bLastBlock = iDataIndex+2*data.cols() > m_matDataRaw.cols();
+
+    //Filter the channels in groups. Every group works on its own copy of the prepared filters and one reused buffer.
+    QVector<QPair<int,int> > lGroups = channelGroups(data.rows(), data.cols());
+
+    forEachChannelGroup(lGroups, [&](const QPair<int,int>& group) {
+        QList<FilterKernel> lFilters = m_filterKernel;
+        RowVectorXd vecData;
+        RowVectorXd vecTail;
+
+        for(int i = group.first; i < group.first + group.second; ++i) {
+            if(i >= m_vecFilterChannel.size() || !m_vecFilterChannel.at(i)) {
+                //Fill filtered data with raw data if the channel is not filtered
+                m_matDataFiltered.row(i).segment(iDataIndex,data.cols()) = data.row(i);
+                continue;
             }
-    }
 
-    //Do the concurrent filtering
-    if(!timeData.isEmpty()) {
-        QFuture<void> future = QtConcurrent::map(timeData,
-                                             doFilterPerChannelRTMSA);
+            vecData = data.row(i);
 
-        future.waitForFinished();
+            for(int k = 0; k < lFilters.size(); ++k) {
+                lFilters[k].applyFftFilter(vecData, true); //FFT Convolution for rt is not suitable. FFT make the signal filtering non causal.
+            }
 
-        //Do the overlap add method and store in m_matDataFiltered
-        int iFilterDelay = m_iMaxFilterLength/2;
-        int iFilteredNumberCols = timeData.at(0).second.second.cols();
+            //The filtered data has a delay of filterLength/2 in front and back. Keep the tail for the next block before the head is overlap added, since both overlap for short blocks.
+            int iFilteredNumberCols = vecData.cols();
+            vecTail = vecData.tail(m_iMaxFilterLength);
 
-        for(int r = 0; r<timeData.size(); ++r) {
-            if(iDataIndex+2*data.cols() > m_matDataRaw.cols()) {
+            if(bLastBlock) {
                 //Handle last data block
-                //std::cout<<"Handle last data block"<<std::endl;
-
                 if(m_bDrawFilterFront) {
-                    //Get the currently filtered data. This data has a delay of filterLength/2 in front and back.
-                    RowVectorXd tempData = timeData.at(r).second.second;
-
                     //Perform the actual overlap add by adding the last filterlength data to the newly filtered one
-                    tempData.head(m_iMaxFilterLength) += m_matOverlap.row(timeData.at(r).second.first);
+                    vecData.head(m_iMaxFilterLength) += m_matOverlap.row(i);
 
                     //Write the newly calulated filtered data to the filter data matrix. Keep in mind that the current block also effect last part of the last block (begin at dataIndex-iFilterDelay).
                     int start = iDataIndex-iFilterDelay < 0 ? 0 : iDataIndex-iFilterDelay;
-                    m_matDataFiltered.row(timeData.at(r).second.first).segment(start,iFilteredNumberCols-m_iMaxFilterLength) = tempData.head(iFilteredNumberCols-m_iMaxFilterLength);
+                    m_matDataFiltered.row(i).segment(start,iFilteredNumberCols-m_iMaxFilterLength) = vecData.head(iFilteredNumberCols-m_iMaxFilterLength);
                 } else {
                     //Perform this else case everytime the filter was changed. Do not begin to plot from dataIndex-iFilterDelay because the impsulse response and m_matOverlap do not match with the new filter anymore.
-                    m_matDataFiltered.row(timeData.at(r).second.first).segment(iDataIndex-iFilterDelay,m_iMaxFilterLength) = timeData.at(r).second.second.segment(m_iMaxFilterLength,m_iMaxFilterLength);
-                    m_matDataFiltered.row(timeData.at(r).second.first).segment(iDataIndex+iFilterDelay,iFilteredNumberCols-2*m_iMaxFilterLength) = timeData.at(r).second.second.segment(m_iMaxFilterLength,iFilteredNumberCols-2*m_iMaxFilterLength);
+                    m_matDataFiltered.row(i).segment(iDataIndex-iFilterDelay,m_iMaxFilterLength) = vecData.segment(m_iMaxFilterLength,m_iMaxFilterLength);
+                    m_matDataFiltered.row(i).segment(iDataIndex+iFilterDelay,iFilteredNumberCols-2*m_iMaxFilterLength) = vecData.segment(m_iMaxFilterLength,iFilteredNumberCols-2*m_iMaxFilterLength);
                 }
-
-                //Refresh the m_matOverlap with the new calculated filtered data.
-                m_matOverlap.row(timeData.at(r).second.first) = timeData.at(r).second.second.tail(m_iMaxFilterLength);
             } else if(iDataIndex == 0) {
                 //Handle first data block
-                //std::cout<<"Handle first data block"<<std::endl;
-
                 if(m_bDrawFilterFront) {
-                    //Get the currently filtered data. This data has a delay of filterLength/2 in front and back.
-                    RowVectorXd tempData = timeData.at(r).second.second;
+                    //Perform the actual overlap add by adding the last filterlength data to the newly filtered one
+                    vecData.head(m_iMaxFilterLength) += m_matOverlap.row(i);
 
                     //Add newly calculate data to the tail of the current filter data matrix
-                    m_matDataFiltered.row(timeData.at(r).second.first).segment(m_matDataFiltered.cols()-iFilterDelay-m_iResidual, iFilterDelay) = tempData.head(iFilterDelay) + m_matOverlap.row(timeData.at(r).second.first).head(iFilterDelay);
-
-                    //Perform the actual overlap add by adding the last filterlength data to the newly filtered one
-                    tempData.head(m_iMaxFilterLength) += m_matOverlap.row(timeData.at(r).second.first);
-                    m_matDataFiltered.row(timeData.at(r).second.first).head(iFilteredNumberCols-m_iMaxFilterLength-iFilterDelay) = tempData.segment(iFilterDelay,iFilteredNumberCols-m_iMaxFilterLength-iFilterDelay);
+                    m_matDataFiltered.row(i).segment(m_matDataFiltered.cols()-iFilterDelay-m_iResidual, iFilterDelay) = vecData.head(iFilterDelay);
+                    m_matDataFiltered.row(i).head(iFilteredNumberCols-m_iMaxFilterLength-iFilterDelay) = vecData.segment(iFilterDelay,iFilteredNumberCols-m_iMaxFilterLength-iFilterDelay);
 
                     //Copy residual data from the front to the back. The residual is != 0 if the chosen block size cannot be evenly fit into the matrix size
-                    m_matDataFiltered.row(timeData.at(r).second.first).tail(m_iResidual) = m_matDataFiltered.row(timeData.at(r).second.first).head(m_iResidual);
+                    m_matDataFiltered.row(i).tail(m_iResidual) = m_matDataFiltered.row(i).head(m_iResidual);
                 } else {
                     //Perform this else case everytime the filter was changed. Do not begin to plot from dataIndex-iFilterDelay because the impsulse response and m_matOverlap do not match with the new filter anymore.
-                    m_matDataFiltered.row(timeData.at(r).second.first).head(m_iMaxFilterLength) = timeData.at(r).second.second.segment(m_iMaxFilterLength,m_iMaxFilterLength);
-                    m_matDataFiltered.row(timeData.at(r).second.first).segment(iFilterDelay,iFilteredNumberCols-2*m_iMaxFilterLength) = timeData.at(r).second.second.segment(m_iMaxFilterLength,iFilteredNumberCols-2*m_iMaxFilterLength);
+                    m_matDataFiltered.row(i).head(m_iMaxFilterLength) = vecData.segment(m_iMaxFilterLength,m_iMaxFilterLength);
+                    m_matDataFiltered.row(i).segment(iFilterDelay,iFilteredNumberCols-2*m_iMaxFilterLength) = vecData.segment(m_iMaxFilterLength,iFilteredNumberCols-2*m_iMaxFilterLength);
                 }
-
-                //Refresh the m_matOverlap with the new calculated filtered data.
-                m_matOverlap.row(timeData.at(r).second.first) = timeData.at(r).second.second.tail(m_iMaxFilterLength);
             } else {
                 //Handle middle data blocks
-                //std::cout<<"Handle middle data block"<<std::endl;
-
                 if(m_bDrawFilterFront) {
-                    //Get the currently filtered data. This data has a delay of filterLength/2 in front and back.
-                    RowVectorXd tempData = timeData.at(r).second.second;
-
                     //Perform the actual overlap add by adding the last filterlength data to the newly filtered one
-                    tempData.head(m_iMaxFilterLength) += m_matOverlap.row(timeData.at(r).second.first);
+                    vecData.head(m_iMaxFilterLength) += m_matOverlap.row(i);
 
                     //Write the newly calulated filtered data to the filter data matrix. Keep in mind that the current block also effect last part of the last block (begin at dataIndex-iFilterDelay).
-                    m_matDataFiltered.row(timeData.at(r).second.first).segment(iDataIndex-iFilterDelay,iFilteredNumberCols-m_iMaxFilterLength) = tempData.head(iFilteredNumberCols-m_iMaxFilterLength);
+                    m_matDataFiltered.row(i).segment(iDataIndex-iFilterDelay,iFilteredNumberCols-m_iMaxFilterLength) = vecData.head(iFilteredNumberCols-m_iMaxFilterLength);
                 } else {
                     //Perform this else case everytime the filter was changed. Do not begin to plot from dataIndex-iFilterDelay because the impsulse response and m_matOverlap do not match with the new filter anymore.
-                    m_matDataFiltered.row(timeData.at(r).second.first).segment(iDataIndex-iFilterDelay,m_iMaxFilterLength).setZero();// = timeData.at(r).second.second.segment(m_iMaxFilterLength,m_iMaxFilterLength);
-                    m_matDataFiltered.row(timeData.at(r).second.first).segment(iDataIndex+iFilterDelay,iFilteredNumberCols-2*m_iMaxFilterLength) = timeData.at(r).second.second.segment(m_iMaxFilterLength,iFilteredNumberCols-2*m_iMaxFilterLength);
+                    m_matDataFiltered.row(i).segment(iDataIndex-iFilterDelay,m_iMaxFilterLength).setZero();
+                    m_matDataFiltered.row(i).segment(iDataIndex+iFilterDelay,iFilteredNumberCols-2*m_iMaxFilterLength) = vecData.segment(m_iMaxFilterLength,iFilteredNumberCols-2*m_iMaxFilterLength);
                 }
-
-                //Refresh the m_matOverlap with the new calculated filtered data.
-                m_matOverlap.row(timeData.at(r).second.first) = timeData.at(r).second.second.tail(m_iMaxFilterLength);
             }
+
+            //Refresh the m_matOverlap with the new calculated filtered data
+            m_matOverlap.row(i) = vecTail;
         }
-    }
+    });
 
     m_bDrawFilterFront = true;
 
-    //Fill filtered data with raw data if the channel was not filtered
-    for(int i = 0; i < notFilterChannelIndex.size(); ++i) {
-        m_matDataFiltered.row(notFilterChannelIndex.at(i)).segment(iDataIndex,data.row(notFilterChannelIndex.at(i)).cols()) = data.row(notFilterChannelIndex.at(i));
+    //std::cout<<"END RtFiffRawViewModel::filterDataBlock"<<std::endl;
+}
+
+//=============================================================================================================
+
+void RtFiffRawViewModel::updateEnvelope(MinMaxPyramid& envelope,
+                                        const MatrixXdR& matData,
+                                        int iFrom,
+                                        int iTo)
+{
+    if(iFrom < 0) {
+        envelope.update(matData, matData.cols() + iFrom, matData.cols());
+        iFrom = 0;
     }
 
-    //std::cout<<"END RtFiffRawViewModel::filterDataBlock"<<std::endl;
+    envelope.update(matData, iFrom, iTo);
 }
 
 //=============================================================================================================
@@ -1313,6 +1281,11 @@ void RtFiffRawViewModel::clearModel()
     m_vecLastBlockFirstValuesRaw.setZero();
     m_matOverlap.setZero();
 
+    m_envelopeRaw.build(m_matDataRaw);
+    m_envelopeFiltered.build(m_matDataFiltered);
+    m_envelopeRawFreeze.build(m_matDataRawFreeze);
+    m_envelopeFilteredFreeze.build(m_matDataFilteredFreeze);
+
     endResetModel();
 }
 
@@ -1381,6 +1354,35 @@ double RtFiffRawViewModel::getMaxValueFromRawViewModel(int row) const
 
 //=============================================================================================================
 
+bool RtFiffRawViewModel::getEnvelope(int row,
+                                     int iFrom,
+                                     int iTo,
+                                     double dFirstBin,
+                                     double dBinsPerSample,
+                                     VectorXf& vecMin,
+                                     VectorXf& vecMax) const
+{
+    const MinMaxPyramid* pEnvelope;
+
+    if(m_bIsFreezed) {
+        pEnvelope = !m_filterKernel.isEmpty() && m_bPerformFiltering ? &m_envelopeFilteredFreeze : &m_envelopeRawFreeze;
+    } else {
+        pEnvelope = !m_filterKernel.isEmpty() && m_bPerformFiltering ? &m_envelopeFiltered : &m_envelopeRaw;
+    }
+
+    qint32 chRow = m_qMapIdxRowSelection.value(row,0);
+
+    if(pEnvelope->isEmpty() || chRow >= pEnvelope->rows()) {
+        return false;
+    }
+
+    pEnvelope->envelope(chRow, iFrom, iTo, dFirstBin, dBinsPerSample, vecMin, vecMax);
+
+    return true;
+}
+
+//=============================================================================================================
+
 void RtFiffRawViewModel::addEvent(int iSample)
 {
     auto pGroups = m_EventManager.getAllGroups();
@@ -43,9 +43,11 @@
 //=============================================================================================================
 
 #include "../../disp_global.h"
+#include "minmaxpyramid.h"
 
 #include <fiff/fiff_types.h>
 #include <fiff/fiff_proj.h>
+#include <fiff/fiff_proj_operator.h>
 
 #include <rtprocessing/helpers/filterkernel.h>
 
@@ -58,6 +60,7 @@
 #include <QAbstractTableModel>
 #include <QSharedPointer>
 #include <QColor>
+#include <QVector>
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -530,6 +533,29 @@ public:
      */
     double getMaxValueFromRawViewModel(int row) const;
 
+    //=========================================================================================================
+    /**
+     * Accumulates the min/max envelope of the currently displayed data (raw or filtered, frozen or streamed) of a
+     * channel into bins. See MinMaxPyramid::envelope.
+     *
+     * @param[in] row               Row of the model.
+     * @param[in] iFrom             The first sample.
+     * @param[in] iTo               One past the last sample.
+     * @param[in] dFirstBin         The bin of sample iFrom.
+     * @param[in] dBinsPerSample    The number of bins per sample.
+     * @param[in, out] vecMin       The minimum per bin.
+     * @param[in, out] vecMax       The maximum per bin.
+     *
+     * @return Whether an envelope is available for the displayed data.
+     */
+    bool getEnvelope(int row,
+                     int iFrom,
+                     int iTo,
+                     double dFirstBin,
+                     double dBinsPerSample,
+                     Eigen::VectorXf& vecMin,
+                     Eigen::VectorXf& vecMax) const;
+
     //=========================================================================================================
     /**
      * Adds event based on input parameters
@@ -549,6 +575,17 @@ public:
      */
     std::unique_ptr<std::vector<EVENTSLIB::Event> > getEventsToDisplay(int iBegin, int iEnd) const;
 
+    //=========================================================================================================
+    /**
+     * Calls a visitor for every event between two samples without allocating a result list.
+     *
+     * @param[in] iBegin    Lower bound for sample (inclusive).
+     * @param[in] iEnd      Upper bound for sample (inclusive).
+     * @param[in] visitor   Callable taking a const EVENTSLIB::Event&.
+     */
+    template<typename Visitor>
+    inline void forEachEventToDisplay(int iBegin, int iEnd, Visitor&& visitor) const;
+
 private:
     //=========================================================================================================
     /**
@@ -556,7 +593,21 @@ private:
      */
     void initSphara();
 
-    static void doFilterPerChannelRTMSA(QPair<QList<RTPROCESSINGLIB::FilterKernel>,QPair<int,Eigen::RowVectorXd> > &channelDataTime);
+    //=========================================================================================================
+    /**
+     * Updates the per channel flags whether a channel is to be filtered from m_filterChannelList.
+     */
+    void updateFilterChannelFlags();
+
+    //=========================================================================================================
+    /**
+     * Transforms the coefficients of the current filters for blocks of iDataSize samples, unless this was already
+     * done for the current filters. The filters can then be applied from several threads at once without
+     * modifying them.
+     *
+     * @param[in] iDataSize     The number of samples per channel of the blocks to be filtered.
+     */
+    void prepareFilterKernels(int iDataSize);
 
     //=========================================================================================================
     /**
@@ -566,12 +617,28 @@ private:
 
     //=========================================================================================================
     /**
-     * Calculates the filtered version of the raw input data
+     * Calculates the filtered version of the raw input data. The channels are filtered in groups of consecutive
+     * rows, read directly from data and written directly to m_matDataFiltered and m_matOverlap.
      *
      * @param[in] data          data which is to be filtered.
      * @param[in] iDataIndex    current position in the global data matrix.
      */
-    void filterDataBlock(const Eigen::MatrixXd &data, int iDataIndex);
+    void filterDataBlock(const Eigen::Ref<const MatrixXdR> &data, int iDataIndex);
+
+    //=========================================================================================================
+    /**
+     * Updates a min/max envelope after the samples [iFrom, iTo) of the ring buffer changed. Negative sample
+     * indices refer to the end of the ring buffer.
+     *
+     * @param[in, out] envelope     The envelope to update.
+     * @param[in] matData           The data the envelope belongs to.
+     * @param[in] iFrom             The first changed sample.
+     * @param[in] iTo               One past the last changed sample.
+     */
+    static void updateEnvelope(MinMaxPyramid& envelope,
+                               const MatrixXdR& matData,
+                               int iFrom,
+                               int iTo);
 
     //=========================================================================================================
     /**
@@ -595,6 +662,7 @@ private:
     qint32                              m_iCurrentStartingSample;                   /**< Accumulates cumulative starting sample position when m_iCurrentSample resets to 0 */
     qint32                              m_iCurrentSampleFreeze;                     /**< Current sample which holds the current position in the data matrix when freezing tool is active. */
     qint32                              m_iMaxFilterLength;                         /**< Max order of the current filters. */
+    qint32                              m_iFilterKernelDataSize;                    /**< Block size the current filters were prepared for, -1 if not prepared. */
     qint32                              m_iCurrentBlockSize;                        /**< Current block size. */
     qint32                              m_iResidual;                                /**< Current amount of samples which were to size. */
     int                                 m_iCurrentTriggerChIndex;                   /**< The index of the current trigger channel. */
@@ -606,7 +674,6 @@ private:
 
     QSharedPointer<FIFFLIB::FiffInfo>   m_pFiffInfo;                                /**< Fiff info. */
 
-    Eigen::RowVectorXi                  m_vecBadIdcs;                               /**< Idcs of bad channels. */
     Eigen::VectorXd                     m_vecLastBlockFirstValuesFiltered;          /**< The first value of the last complete filtered data display block. */
     Eigen::VectorXd                     m_vecLastBlockFirstValuesRaw;               /**< The first value of the last complete raw data display block. */
 
@@ -614,7 +681,12 @@ private:
     MatrixXdR                           m_matDataFiltered;                          /**< The filtered data. */
     MatrixXdR                           m_matDataRawFreeze;                         /**< The raw data in freeze mode. */
     MatrixXdR                           m_matDataFilteredFreeze;                    /**< The raw filtered data in freeze mode. */
-    Eigen::MatrixXd                     m_matOverlap;                               /**< Last overlap block for the back. */
+    MatrixXdR                           m_matOverlap;                               /**< Last overlap block for the back. */
+
+    MinMaxPyramid                       m_envelopeRaw;                              /**< The min/max envelope of the raw data. */
+    MinMaxPyramid                       m_envelopeFiltered;                         /**< The min/max envelope of the filtered data. */
+    MinMaxPyramid                       m_envelopeRawFreeze;                        /**< The min/max envelope of the raw data in freeze mode. */
+    MinMaxPyramid                       m_envelopeFilteredFreeze;                   /**< The min/max envelope of the filtered data in freeze mode. */
 
     Eigen::VectorXi                     m_vecIndicesFirstVV;                        /**< The indices of the channels to pick for the first SPHARA operator in case of a VectorView system.*/
     Eigen::VectorXi                     m_vecIndicesSecondVV;                       /**< The indices of the channels to pick for the second SPHARA operator in case of a VectorView system.*/
@@ -623,12 +695,8 @@ private:
     Eigen::VectorXi                     m_vecIndicesFirstEEG;                       /**< The indices of the channels to pick for the second SPHARA operator in case of an EEG system.*/
 
     Eigen::SparseMatrix<double>         m_matSparseSpharaMult;                      /**< The final sparse SPHARA operator .*/
-    Eigen::SparseMatrix<double>         m_matSparseProjCompMult;                    /**< The final sparse projection + compensator operator.*/
-    Eigen::SparseMatrix<double>         m_matSparseProjMult;                        /**< The final sparse SSP projector. */
-    Eigen::SparseMatrix<double>         m_matSparseCompMult;                        /**< The final sparse compensator matrix. */
 
-    Eigen::MatrixXd                     m_matProj;                                  /**< SSP projector. */
-    Eigen::MatrixXd                     m_matComp;                                  /**< Compensator. */
+    FIFFLIB::FiffProjOperator           m_projOperator;                             /**< The low-rank SSP projector and compensator. */
 
     Eigen::MatrixXd                     m_matSpharaVVGradLoaded;                    /**< The loaded VectorView gradiometer basis functions.*/
     Eigen::MatrixXd                     m_matSpharaVVMagLoaded;                     /**< The loaded VectorView magnetometer basis functions.*/
@@ -645,6 +713,7 @@ private:
     QMap<qint32,float>                  m_qMapChScaling;                            /**< Channel scaling map. */
     QList<RTPROCESSINGLIB::FilterKernel>m_filterKernel;                             /**< List of currently active filters. */
     QStringList                         m_filterChannelList;                        /**< List of channels which are to be filtered.*/
+    QVector<bool>                       m_vecFilterChannel;                         /**< Whether the channel of the row is to be filtered.*/
     QStringList                         m_visibleChannelList;                       /**< List of currently visible channels in the view.*/
     QMap<qint32,qint32>                 m_qMapIdxRowSelection;                      /**< Selection mapping.*/
 
@@ -755,6 +824,14 @@ inline QMap<double, QColor> RtFiffRawViewModel::getTriggerColor() const
 
 //=============================================================================================================
 
+template<typename Visitor>
+inline void RtFiffRawViewModel::forEachEventToDisplay(int iBegin, int iEnd, Visitor&& visitor) const
+{
+    m_EventManager.forEachEventBetween(iBegin, iEnd, std::forward<Visitor>(visitor));
+}
+
+//=============================================================================================================
+
 inline QList<QPair<int,double> >  RtFiffRawViewModel::getDetectedTriggers() const
 {
     QList<QPair<int,double> > triggerIndices;
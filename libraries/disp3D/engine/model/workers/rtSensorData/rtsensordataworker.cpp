@@ -38,7 +38,6 @@
 //=============================================================================================================
 
 #include "rtsensordataworker.h"
-#include "../../../../helpers/interpolation/interpolation.h"
 #include "../../items/common/abstractmeshtreeitem.h"
 
 //=============================================================================================================
@@ -48,6 +47,8 @@
 #include <QVector3D>
 #include <QDebug>
 #include <QElapsedTimer>
+#include <QMutexLocker>
+#include <QtConcurrent>
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -74,7 +75,6 @@ RtSensorDataWorker::RtSensorDataWorker()
 , m_dSFreq(1000.0)
 , m_bStreamSmoothedData(true)
 , m_iCurrentSample(0)
-, m_pMatInterpolationMatrix(QSharedPointer<SparseMatrix<float> >(new SparseMatrix<float>()))
 {
 }
 
@@ -156,7 +156,16 @@ void RtSensorDataWorker::setSFreq(const double dSFreq)
 //=============================================================================================================
 
 void RtSensorDataWorker::setInterpolationMatrix(QSharedPointer<SparseMatrix<float> > pMatInterpolationMatrix) {
-    m_pMatInterpolationMatrix = pMatInterpolationMatrix;
+    //This is called from other threads. Convert outside the lock and only swap while streamData() cannot use the matrix.
+    SparseMatrix<float, RowMajor> matInterpolationMatrix;
+
+    if(pMatInterpolationMatrix) {
+        matInterpolationMatrix = *pMatInterpolationMatrix;
+        matInterpolationMatrix.makeCompressed();
+    }
+
+    QMutexLocker locker(&m_qMutexInterpolationMatrix);
+    m_matInterpolationMatrix.swap(matInterpolationMatrix);
 }
 
 //=============================================================================================================
@@ -232,25 +241,51 @@ void RtSensorDataWorker::streamData()
 
 MatrixX4f RtSensorDataWorker::generateColorsFromSensorValues(const VectorXd& vecSensorValues)
 {
-    if(vecSensorValues.rows() != m_pMatInterpolationMatrix->cols()) {
-        qDebug() << "RtSensorDataWorker::generateColorsFromSensorValues - Number of new vertex colors (" << vecSensorValues.rows() << ") do not match with previously set number of sensors (" << m_pMatInterpolationMatrix->cols() << "). Returning...";
+    QMutexLocker locker(&m_qMutexInterpolationMatrix);
+
+    if(vecSensorValues.rows() != m_matInterpolationMatrix.cols()) {
+        qDebug() << "RtSensorDataWorker::generateColorsFromSensorValues - Number of new vertex colors (" << vecSensorValues.rows() << ") do not match with previously set number of sensors (" << m_matInterpolationMatrix.cols() << "). Returning...";
+        MatrixX4f matColor = m_lVisualizationInfo.matOriginalVertColor;
+        return matColor;
+    }
+
+    if(m_matInterpolationMatrix.rows() != m_lVisualizationInfo.matOriginalVertColor.rows()) {
+        qDebug() << "RtSensorDataWorker::generateColorsFromSensorValues - Number of interpolated vertices (" << m_matInterpolationMatrix.rows() << ") do not match with the number of vertices (" << m_lVisualizationInfo.matOriginalVertColor.rows() << "). Returning...";
         MatrixX4f matColor = m_lVisualizationInfo.matOriginalVertColor;
         return matColor;
     }
 
-    // interpolate sensor signals
-    VectorXf vecIntrpltdVals = Interpolation::interpolateSignal(*m_pMatInterpolationMatrix, vecSensorValues.cast<float>());
+    const VectorXf vecSensorValuesFloat = vecSensorValues.cast<float>();
 
     // Reset to original color as default
     m_lVisualizationInfo.matFinalVertColor = m_lVisualizationInfo.matOriginalVertColor;
 
-    //Generate color data for vertices
-    normalizeAndTransformToColor(vecIntrpltdVals,
-                                 m_lVisualizationInfo.matFinalVertColor,
-                                 m_lVisualizationInfo.dThresholdX,
-                                 m_lVisualizationInfo.dThresholdZ,
-                                 m_lVisualizationInfo.functionHandlerColorMap,
-                                 m_lVisualizationInfo.sColormapType);
+    // Split the vertices into chunks of rows. Each chunk is interpolated and transformed to color in one pass, so
+    // that the interpolated values stay in cache.
+    const int iChunkSize = 4096;
+    QVector<QPair<int,int> > lChunks;
+
+    for(int i = 0; i < m_matInterpolationMatrix.rows(); i += iChunkSize) {
+        lChunks.append(QPair<int,int>(i, std::min(iChunkSize, int(m_matInterpolationMatrix.rows()) - i)));
+    }
+
+    auto processChunk = [&](const QPair<int,int>& chunk) {
+        VectorXf vecIntrpltdVals = m_matInterpolationMatrix.middleRows(chunk.first, chunk.second) * vecSensorValuesFloat;
+
+        //Generate color data for vertices
+        normalizeAndTransformToColor(vecIntrpltdVals,
+                                     m_lVisualizationInfo.matFinalVertColor.middleRows(chunk.first, chunk.second),
+                                     m_lVisualizationInfo.dThresholdX,
+                                     m_lVisualizationInfo.dThresholdZ,
+                                     m_lVisualizationInfo.functionHandlerColorMap,
+                                     m_lVisualizationInfo.sColormapType);
+    };
+
+    if(lChunks.size() > 1) {
+        QtConcurrent::blockingMap(lChunks, processChunk);
+    } else if(!lChunks.isEmpty()) {
+        processChunk(lChunks.first());
+    }
 
     return m_lVisualizationInfo.matFinalVertColor;
 }
@@ -258,7 +293,7 @@ MatrixX4f RtSensorDataWorker::generateColorsFromSensorValues(const VectorXd& vec
 //=============================================================================================================
 
 void RtSensorDataWorker::normalizeAndTransformToColor(const VectorXf& vecData,
-                                                      MatrixX4f& matFinalVertColor,
+                                                      Ref<MatrixX4f> matFinalVertColor,
                                                       double dThresholdX,
                                                       double dThreholdZ,
                                                       QRgb (*functionHandlerColorMap)(double v, const QString& sColorMap),
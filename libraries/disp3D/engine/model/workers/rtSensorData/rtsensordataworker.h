@@ -51,6 +51,7 @@
 #include <QRgb>
 #include <QSharedPointer>
 #include <QLinkedList>
+#include <QMutex>
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -165,7 +166,8 @@ public:
 
     //=========================================================================================================
     /**
-     * Set the interpolation matrix.
+     * Set the interpolation matrix. The matrix is copied to row-major storage, so that the vertices can be
+     * interpolated in independent chunks.
      *
      * @param[in] pMatInterpolationMatrix                 The new interpolation matrix.
      */
@@ -183,7 +185,7 @@ protected:
      * @brief normalizeAndTransformToColor  This method normalizes final values for all vertices of the mesh and converts them to rgb using the specified color converter
      *
      * @param[in] vecData                       The final values for each vertex of the surface.
-     * @param[in, out] matFinalVertColor         The color matrix which the results are to be written to.
+     * @param[in, out] matFinalVertColor         The color matrix (or a block of consecutive rows of it) which the results are to be written to.
      * @param[in] dThresholdX                   Lower threshold for normalizing.
      * @param[in] dThreholdZ                    Upper threshold for normalizing.
      * @param[in] functionHandlerColorMap       The pointer to the function which converts scalar values to rgb.
@@ -191,7 +193,7 @@ protected:
      *
      */
     void normalizeAndTransformToColor(const Eigen::VectorXf& vecData,
-                                      Eigen::MatrixX4f &matFinalVertColor,
+                                      Eigen::Ref<Eigen::MatrixX4f> matFinalVertColor,
                                       double dThresholdX,
                                       double dThreholdZ,
                                       QRgb (*functionHandlerColorMap)(double v, const QString& sColorMap),
@@ -199,7 +201,10 @@ protected:
 
     //=========================================================================================================
     /**
-     * @brief generateColorsFromSensorValues        Produces the final color matrix that is to be emitted
+     * @brief generateColorsFromSensorValues        Produces the final color matrix that is to be emitted. The vertices
+     *                                              are processed in chunks of rows, interpolation and color
+     *                                              transformation are done in one pass per chunk and the chunks are
+     *                                              distributed over multiple threads.
      *
      * @param[in] vecSensorValues                   A vector of sensor signals.
      *
@@ -211,7 +216,8 @@ protected:
     QList<Eigen::VectorXd>                              m_lDataLoopQ;                       /**< List that holds the matrix data <n_channels x n_samples> for looping. */
 
     Eigen::VectorXd                                     m_vecAverage;                       /**< The averaged data to be streamed. */
-    QSharedPointer<Eigen::SparseMatrix<float> >         m_pMatInterpolationMatrix;          /**< The interpolation matrix. */
+    Eigen::SparseMatrix<float, Eigen::RowMajor>         m_matInterpolationMatrix;           /**< The interpolation matrix in row-major (CSR) storage. */
+    QMutex                                              m_qMutexInterpolationMatrix;        /**< Guards the interpolation matrix, which is set from other threads. */
 
     bool                                                m_bIsLooping;                       /**< Flag if this thread should repeat sending the same data over and over again. */
     bool                                                m_bStreamSmoothedData;              /**< Flag if this thread's streams the raw or already smoothed data. Latter are produced by multiplying the smoothing operator here in this thread. */
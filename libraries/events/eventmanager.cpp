@@ -75,28 +75,49 @@ EventManager::EventManager()
 
 Event EventManager::getEvent(idNum eventId) const
 {
-    auto eventInt = findEventINT(eventId);
-    if(eventInt != m_EventsListBySample.end())
+    int index = findEventIndex(eventId);
+    if(index >= 0)
     {
-        return Event(eventInt->second);
+        return Event(m_vecEventIds[index], m_vecSamples[index], m_vecGroupIds[index]);
     }
     return {};
 }
 
 //=============================================================================================================
 
-std::multimap<int, EVENTSINTERNAL::EventINT>::const_iterator EventManager::findEventINT(idNum eventId) const
+int EventManager::findEventIndex(idNum eventId) const
 {
-    int sample = m_MapIdToSample.at(eventId);
-    auto eventsRange = m_EventsListBySample.equal_range(sample);
+    auto sample = m_MapIdToSample.find(eventId);
+    if(sample == m_MapIdToSample.end())
+    {
+        return -1;
+    }
+
+    auto eventsRange = std::equal_range(m_vecSamples.begin(), m_vecSamples.end(), sample->second);
     for(auto e = eventsRange.first; e != eventsRange.second; ++e)
     {
-        if( e->second.getId() == eventId)
+        int index = static_cast<int>(e - m_vecSamples.begin());
+        if(m_vecEventIds[index] == eventId)
         {
-            return e;
+            return index;
         }
     }
-    return m_EventsListBySample.end();
+    return -1;
+}
+
+//=============================================================================================================
+
+std::pair<size_t, size_t> EventManager::findSampleRange(int sampleStart, int sampleEnd) const
+{
+    if(sampleEnd < sampleStart)
+    {
+        return {0, 0};
+    }
+
+    auto eventStart = std::lower_bound(m_vecSamples.begin(), m_vecSamples.end(), sampleStart);
+    auto eventEnd = std::upper_bound(eventStart, m_vecSamples.end(), sampleEnd);
+
+    return {static_cast<size_t>(eventStart - m_vecSamples.begin()), static_cast<size_t>(eventEnd - m_vecSamples.begin())};
 }
 
 //=============================================================================================================
@@ -121,9 +142,9 @@ EventManager::getEvents(const std::vector<idNum> eventIds) const
 std::unique_ptr<std::vector<Event> > EventManager::getAllEvents() const
 {
     auto pEventsList(allocateOutputContainer<Event>(getNumEvents()));
-    for(auto& e: m_EventsListBySample)
+    for(size_t i = 0; i < m_vecSamples.size(); ++i)
     {
-        pEventsList->emplace_back(Event(e.second));
+        pEventsList->emplace_back(m_vecEventIds[i], m_vecSamples[i], m_vecGroupIds[i]);
     }
     return pEventsList;
 }
@@ -132,15 +153,7 @@ std::unique_ptr<std::vector<Event> > EventManager::getAllEvents() const
 
 std::unique_ptr<std::vector<Event> > EventManager::getEventsInSample(int sample) const
 {
-    size_t numEventsInSample = m_EventsListBySample.count(sample);
-    auto pEventsList(allocateOutputContainer<Event>(numEventsInSample));
-
-    auto eventsRange = m_EventsListBySample.equal_range(sample);
-    for(auto e = eventsRange.first; e != eventsRange.second; e++)
-    {
-        pEventsList->emplace_back(Event(e->second));
-    }
-    return pEventsList;
+    return getEventsBetween(sample, sample);
 }
 
 //=============================================================================================================
@@ -148,16 +161,8 @@ std::unique_ptr<std::vector<Event> > EventManager::getEventsInSample(int sample)
 std::unique_ptr<std::vector<Event> >
 EventManager::getEventsBetween(int sampleStart, int sampleEnd) const
 {
-    int memoryHint = ((sampleEnd-sampleStart)/1000)+2;
-    auto pEventsList(allocateOutputContainer<Event>(memoryHint));
-
-    auto eventStart = m_EventsListBySample.lower_bound(sampleStart);
-    auto eventEnd = m_EventsListBySample.upper_bound(sampleEnd);
-
-    for(auto e = eventStart; e != eventEnd; e++)
-    {
-        pEventsList->emplace_back(Event(e->second));
-    }
+    auto pEventsList(allocateOutputContainer<Event>(getNumEventsBetween(sampleStart, sampleEnd)));
+    forEachEventBetween(sampleStart, sampleEnd, [&pEventsList](const Event& e){ pEventsList->push_back(e); });
     return pEventsList;
 }
 
@@ -166,20 +171,7 @@ EventManager::getEventsBetween(int sampleStart, int sampleEnd) const
 std::unique_ptr<std::vector<Event> >
 EventManager::getEventsBetween(int sampleStart, int sampleEnd, idNum groupId) const
 {
-    int memoryHint = ((sampleEnd-sampleStart)/1000)+2;
-    auto pEventsList(allocateOutputContainer<Event>(memoryHint));
-
-    auto eventStart = m_EventsListBySample.lower_bound(sampleStart);
-    auto eventEnd = m_EventsListBySample.upper_bound(sampleEnd);
-
-    for(auto e = eventStart; e != eventEnd; e++)
-    {
-        if(e->second.getGroupId() == groupId)
-        {
-            pEventsList->emplace_back(Event(e->second));
-        }
-    }
-    return pEventsList;
+    return getEventsBetween(sampleStart, sampleEnd, std::vector<idNum>{groupId});
 }
 
 //=============================================================================================================
@@ -187,23 +179,8 @@ EventManager::getEventsBetween(int sampleStart, int sampleEnd, idNum groupId) co
 std::unique_ptr<std::vector<Event> >
 EventManager::getEventsBetween(int sampleStart, int sampleEnd, const std::vector<idNum>& groupIdsList) const
 {
-    int memoryHint = (sampleEnd-sampleStart)/200;
-    auto pEventsList(allocateOutputContainer<Event>(memoryHint));
-
-
-    auto eventStart = m_EventsListBySample.lower_bound(sampleStart);
-    auto eventEnd = m_EventsListBySample.upper_bound(sampleEnd);
-
-    for(auto e = eventStart; e != eventEnd; e++)
-    {
-        for(auto& groupId: groupIdsList)
-        {
-            if(e->second.getGroupId() == groupId)
-            {
-                pEventsList->emplace_back(Event(e->second));
-            }
-        }
-    }
+    auto pEventsList(allocateOutputContainer<Event>());
+    forEachEventBetween(sampleStart, sampleEnd, groupIdsList, [&pEventsList](const Event& e){ pEventsList->push_back(e); });
     return pEventsList;
 }
 
@@ -212,37 +189,33 @@ EventManager::getEventsBetween(int sampleStart, int sampleEnd, const std::vector
 std::unique_ptr<std::vector<Event> >
 EventManager::getEventsInGroup(const idNum groupId) const
 {
-    auto pEventsList(allocateOutputContainer<Event>());
+    return getEventsInGroups(std::vector<idNum>{groupId});
+}
 
-    for(const auto& e: m_EventsListBySample)
-    {
-        if(e.second.getGroupId() == groupId)
-        {
-            pEventsList->emplace_back(Event(e.second));
-        }
-    }
+//=============================================================================================================
+
+std::unique_ptr<std::vector<Event> > EventManager::getEventsInGroups(const std::vector<idNum>& groupIdsList) const
+{
+    auto pEventsList(allocateOutputContainer<Event>(getNumEventsInGroups(groupIdsList)));
+    forEachEventInGroups(groupIdsList, [&pEventsList](const Event& e){ pEventsList->push_back(e); });
     return pEventsList;
 }
 
 //=============================================================================================================
 
-std::unique_ptr<std::vector<Event> > EventManager::getEventsInGroups(const std::vector<idNum>& groupIdsList) const
+size_t EventManager::getNumEventsBetween(int sampleStart, int sampleEnd) const
 {
-    auto pEventsList(allocateOutputContainer<Event>());
+    auto range = findSampleRange(sampleStart, sampleEnd);
+    return range.second - range.first;
+}
 
-    for(const auto& e: m_EventsListBySample)
-    {
-        for (const auto groupId : groupIdsList)
-        {
-            if(e.second.getGroupId() == groupId)
-            {
-                pEventsList->emplace_back(Event(e.second));
-                break;
-            }
-        }
-    }
+//=============================================================================================================
 
-    return pEventsList;
+size_t EventManager::getNumEventsInGroups(const std::vector<idNum>& groupIdsList) const
+{
+    EVENTSINTERNAL::EventGroupMask mask(groupIdsList);
+    return static_cast<size_t>(std::count_if(m_vecGroupIds.begin(), m_vecGroupIds.end(),
+                                             [&mask](idNum groupId){ return mask.contains(groupId); }));
 }
 
 //=============================================================================================================
@@ -263,23 +236,80 @@ idNum EventManager::generateNewGroupId()
 
 size_t EventManager::getNumEvents() const
 {
-    return m_EventsListBySample.size();
+    return m_vecSamples.size();
 }
 
 //=============================================================================================================
 
 Event EventManager::addEvent(int sample, idNum groupId)
 {
-    EVENTSINTERNAL::EventINT newEvent(generateNewEventId(), sample, groupId);
-    insertEvent(newEvent);
+    idNum newId = generateNewEventId();
+    insertEvent(newId, sample, groupId);
 
     if(m_pSharedMemManager->isInit())
     {
         qDebug() << "Sending event to SM: Sample: " << sample;
-        m_pSharedMemManager->addEvent(newEvent.getSample());
+        m_pSharedMemManager->addEvent(sample);
+    }
+
+    return Event(newId, sample, groupId);
+}
+
+//=============================================================================================================
+
+std::unique_ptr<std::vector<Event> > EventManager::addEvents(const std::vector<int>& samples, idNum groupId)
+{
+    auto pEventsList(allocateOutputContainer<Event>(samples.size()));
+    for(int sample : samples)
+    {
+        pEventsList->emplace_back(generateNewEventId(), sample, groupId);
+        m_MapIdToSample[pEventsList->back().id] = sample;
+    }
+
+    // Merge the new events, sorted by sample, behind existing events of the same sample
+    std::vector<size_t> order(samples.size());
+    for(size_t i = 0; i < order.size(); ++i)
+    {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&samples](size_t a, size_t b){ return samples[a] < samples[b]; });
+
+    std::vector<int> vecSamples;
+    std::vector<idNum> vecEventIds, vecGroupIds;
+    vecSamples.reserve(m_vecSamples.size() + samples.size());
+    vecEventIds.reserve(m_vecSamples.size() + samples.size());
+    vecGroupIds.reserve(m_vecSamples.size() + samples.size());
+
+    size_t iOld = 0;
+    for(size_t iNew : order)
+    {
+        for(; iOld < m_vecSamples.size() && m_vecSamples[iOld] <= samples[iNew]; ++iOld)
+        {
+            vecSamples.push_back(m_vecSamples[iOld]);
+            vecEventIds.push_back(m_vecEventIds[iOld]);
+            vecGroupIds.push_back(m_vecGroupIds[iOld]);
+        }
+        vecSamples.push_back(samples[iNew]);
+        vecEventIds.push_back((*pEventsList)[iNew].id);
+        vecGroupIds.push_back(groupId);
     }
+    vecSamples.insert(vecSamples.end(), m_vecSamples.begin() + iOld, m_vecSamples.end());
+    vecEventIds.insert(vecEventIds.end(), m_vecEventIds.begin() + iOld, m_vecEventIds.end());
+    vecGroupIds.insert(vecGroupIds.end(), m_vecGroupIds.begin() + iOld, m_vecGroupIds.end());
+
+    m_vecSamples.swap(vecSamples);
+    m_vecEventIds.swap(vecEventIds);
+    m_vecGroupIds.swap(vecGroupIds);
 
-    return Event(newEvent);
+    if(m_pSharedMemManager->isInit())
+    {
+        for(int sample : samples)
+        {
+            m_pSharedMemManager->addEvent(sample);
+        }
+    }
+
+    return pEventsList;
 }
 
 //=============================================================================================================
@@ -295,13 +325,12 @@ Event EventManager::addEvent(int sample)
 bool EventManager::moveEvent(idNum eventId, int newSample)
 {
     bool status(false);
-    auto event = findEventINT(eventId);
-    if(event != m_EventsListBySample.end())
+    int index = findEventIndex(eventId);
+    if(index >= 0)
     {
-        EVENTSINTERNAL::EventINT newEvent(event->second);
-        newEvent.setSample(newSample);
+        idNum groupId = m_vecGroupIds[index];
         deleteEvent(eventId);
-        insertEvent(newEvent);
+        insertEvent(eventId, newSample, groupId);
         status = true;
     }
     return status;
@@ -311,23 +340,31 @@ bool EventManager::moveEvent(idNum eventId, int newSample)
 
 bool EventManager::deleteEvent(idNum eventId) noexcept
 {
-    bool eventFound(false);
-    eventFound = eraseEvent(eventId);
-    if(eventFound && m_pSharedMemManager->isInit())
+    int index = findEventIndex(eventId);
+    if(index < 0)
     {
-        m_pSharedMemManager->deleteEvent(m_MapIdToSample.at(eventId));
+        return false;
     }
-    return eventFound;
+
+    int sample = m_vecSamples[index];
+    eraseEvent(eventId);
+    if(m_pSharedMemManager->isInit())
+    {
+        m_pSharedMemManager->deleteEvent(sample);
+    }
+    return true;
 }
 
 //=============================================================================================================
 
 bool EventManager::eraseEvent(idNum eventId)
 {
-    auto event = findEventINT(eventId);
-    if(event != m_EventsListBySample.end())
+    int index = findEventIndex(eventId);
+    if(index >= 0)
     {
-        m_EventsListBySample.erase(event);
+        m_vecSamples.erase(m_vecSamples.begin() + index);
+        m_vecEventIds.erase(m_vecEventIds.begin() + index);
+        m_vecGroupIds.erase(m_vecGroupIds.begin() + index);
         m_MapIdToSample.erase(eventId);
         return true;
     }
@@ -336,13 +373,51 @@ bool EventManager::eraseEvent(idNum eventId)
 
 //=============================================================================================================
 
+size_t EventManager::eraseFlaggedEvents(const std::vector<char>& toErase)
+{
+    size_t iKept = 0;
+    for(size_t i = 0; i < m_vecSamples.size(); ++i)
+    {
+        if(toErase[i])
+        {
+            m_MapIdToSample.erase(m_vecEventIds[i]);
+            if(m_pSharedMemManager->isInit())
+            {
+                m_pSharedMemManager->deleteEvent(m_vecSamples[i]);
+            }
+            continue;
+        }
+        m_vecSamples[iKept] = m_vecSamples[i];
+        m_vecEventIds[iKept] = m_vecEventIds[i];
+        m_vecGroupIds[iKept] = m_vecGroupIds[i];
+        ++iKept;
+    }
+
+    size_t iNumErased = m_vecSamples.size() - iKept;
+    m_vecSamples.resize(iKept);
+    m_vecEventIds.resize(iKept);
+    m_vecGroupIds.resize(iKept);
+    return iNumErased;
+}
+
+//=============================================================================================================
+
 bool EventManager::deleteEvents(const std::vector<idNum>& eventIds)
 {
     bool status(eventIds.size());
+    std::vector<char> toErase(m_vecSamples.size(), 0);
     for(const auto& id: eventIds)
     {
-        status = status && deleteEvent(id);
+        int index = findEventIndex(id);
+        if(index >= 0 && !toErase[index])
+        {
+            toErase[index] = 1;
+        } else
+        {
+            status = false;
+        }
     }
+    eraseFlaggedEvents(toErase);
     return status;
 }
 
@@ -350,34 +425,35 @@ bool EventManager::deleteEvents(const std::vector<idNum>& eventIds)
 
 bool EventManager::deleteEvents(std::unique_ptr<std::vector<Event> > eventIds)
 {
-    bool status(eventIds->size());
-    for(auto e: *eventIds){
-        status = status && deleteEvent(e.id);
+    std::vector<idNum> idList;
+    idList.reserve(eventIds->size());
+    for(const auto& e: *eventIds){
+        idList.push_back(e.id);
     }
-    return status;
+    return deleteEvents(idList);
 }
 
 //=============================================================================================================
 
 bool EventManager::deleteEventsInGroup(idNum groupId)
 {
-    std::vector<idNum> idList;
-    for(auto& e: m_EventsListBySample)
+    std::vector<char> toErase(m_vecGroupIds.size(), 0);
+    for(size_t i = 0; i < m_vecGroupIds.size(); ++i)
     {
-        if(e.second.getGroupId() == groupId)
-        {
-            idList.emplace_back(e.second.getId());
-        }
+        toErase[i] = (m_vecGroupIds[i] == groupId);
     }
-    return deleteEvents(idList);
+    return eraseFlaggedEvents(toErase) > 0;
 }
 
 //=============================================================================================================
 
-void EventManager::insertEvent(const EVENTSINTERNAL::EventINT& e)
+void EventManager::insertEvent(idNum id, int sample, idNum groupId)
 {
-    m_EventsListBySample.emplace(std::make_pair(e.getSample(),e));
-    m_MapIdToSample[e.getId()] = e.getSample();
+    auto index = std::upper_bound(m_vecSamples.begin(), m_vecSamples.end(), sample) - m_vecSamples.begin();
+    m_vecSamples.insert(m_vecSamples.begin() + index, sample);
+    m_vecEventIds.insert(m_vecEventIds.begin() + index, id);
+    m_vecGroupIds.insert(m_vecGroupIds.begin() + index, groupId);
+    m_MapIdToSample[id] = sample;
 }
 
 //=============================================================================================================
@@ -454,8 +530,7 @@ EventGroup EventManager::addGroup(const std::string& sGroupName, const RgbColor&
 bool EventManager::deleteGroup(const idNum groupId)
 {
     bool out(false);
-    auto events = getEventsInGroup(groupId);
-    if(events->empty())
+    if(std::find(m_vecGroupIds.begin(), m_vecGroupIds.end(), groupId) == m_vecGroupIds.end())
     {
         auto groupToDeleteIter = m_GroupsList.find(groupId);
         if(groupToDeleteIter != m_GroupsList.end())
@@ -511,16 +586,12 @@ void EventManager::setGroupColor(const idNum groupId, const RgbColor& color)
 EventGroup EventManager::mergeGroups(const std::vector<idNum>& groupIds, const std::string& newName)
 {
     EVENTSLIB::EventGroup newGroup = addGroup(newName);
-    auto eventsAll = getAllEvents();
-    bool state(true);
-    for(const auto& ev: *eventsAll)
+    EVENTSINTERNAL::EventGroupMask mask(groupIds);
+    for(auto& groupId: m_vecGroupIds)
     {
-        for(auto g: groupIds)
+        if(mask.contains(groupId))
         {
-            if(ev.groupId == g)
-            {
-                state = state && addEventToGroup(ev.id, newGroup.id);
-            }
+            groupId = newGroup.id;
         }
     }
     deleteGroups(groupIds);
@@ -532,11 +603,15 @@ EventGroup EventManager::mergeGroups(const std::vector<idNum>& groupIds, const s
 EventGroup EventManager::duplicateGroup(const idNum groupId, const std::string& newName)
 {
     EVENTSLIB::EventGroup newGroup = addGroup(newName);
-    auto eventsToDuplicate = getEventsInGroup(groupId);
-    for( const auto& e: *eventsToDuplicate)
+    std::vector<int> samples;
+    for(size_t i = 0; i < m_vecSamples.size(); ++i)
     {
-        addEvent(e.sample, newGroup.id);
+        if(m_vecGroupIds[i] == groupId)
+        {
+            samples.push_back(m_vecSamples[i]);
+        }
     }
+    addEvents(samples, newGroup.id);
     return newGroup;
 }
 
@@ -544,24 +619,13 @@ EventGroup EventManager::duplicateGroup(const idNum groupId, const std::string&
 
 bool EventManager::addEventToGroup(const idNum eventId, const idNum groupId)
 {
-    bool state(false);
-    int sample(0);
-    if(m_MapIdToSample.count(eventId))
+    int index = findEventIndex(eventId);
+    if(index >= 0)
     {
-        sample = m_MapIdToSample.at(eventId);
-        auto eventsRange = m_EventsListBySample.equal_range(sample);
-        std::multimap<int, EVENTSINTERNAL::EventINT>::iterator e = eventsRange.first;
-        for(; e != eventsRange.second; ++e)
-        {
-            if( e->second.getId() == eventId)
-            {
-                e->second.setGroupId(groupId);
-                state = true;
-                break;
-            }
-        }
+        m_vecGroupIds[index] = groupId;
+        return true;
     }
-    return state;
+    return false;
 }
 
 //=============================================================================================================
@@ -54,6 +54,9 @@
 #include <unordered_map>
 #include <vector>
 #include <memory>
+#include <bitset>
+#include <algorithm>
+#include <utility>
 
 //=============================================================================================================
 // NAMESPACE EVENTSLIB
@@ -67,6 +70,50 @@ namespace EVENTSLIB {
 
 namespace EVENTSINTERNAL {
     class EventSharedMemManager;
+
+//=============================================================================================================
+/**
+ * Set of event group ids with constant time membership tests. Ids below 256 are kept in a bitmask, larger ids
+ * in a sorted list.
+ */
+class EventGroupMask
+{
+public:
+    //=========================================================================================================
+    /**
+     * Constructs the mask of the given groups.
+     * @param[in] groupIds The group ids.
+     */
+    explicit EventGroupMask(const std::vector<idNum>& groupIds)
+    {
+        for(idNum groupId : groupIds)
+        {
+            if(groupId < m_Small.size())
+            {
+                m_Small.set(groupId);
+            } else
+            {
+                m_Large.push_back(groupId);
+            }
+        }
+        std::sort(m_Large.begin(), m_Large.end());
+    }
+
+    //=========================================================================================================
+    /**
+     * Check whether a group is part of the mask.
+     * @param[in] groupId The group id.
+     * @return True if the group is part of the mask.
+     */
+    bool contains(idNum groupId) const
+    {
+        return groupId < m_Small.size() ? m_Small.test(groupId) : std::binary_search(m_Large.begin(), m_Large.end(), groupId);
+    }
+
+private:
+    std::bitset<256>    m_Small;    /**< Bitmask of the group ids below 256.*/
+    std::vector<idNum>  m_Large;    /**< Sorted list of the remaining group ids.*/
+};
 }
 
 //=============================================================================================================
@@ -75,6 +122,10 @@ namespace EVENTSINTERNAL {
  *
  * This class can be understood as an API, for the whole Event system, which is the Events library (EVENTSLIB
  * namespace).
+ *
+ * Events are stored in sample order in parallel arrays of samples, ids and group ids. Range queries are two binary
+ * searches followed by a linear walk over contiguous memory. The forEach* methods hand every event to a visitor
+ * and do not allocate, which makes them the preferred way to query events while painting.
  */
 class EVENTS_EXPORT EventManager
 {
@@ -170,6 +221,54 @@ public:
      */
     std::unique_ptr<std::vector<Event> > getEventsInGroups(const std::vector<idNum>& groupIdsList) const;
 
+    //=========================================================================================================
+    /**
+     * Count the events ocurring between (inclusive) two given samples.
+     * @param[in] sampleStart First sample to look for events.
+     * @param[in] sampleEnd Last sample to look for events.
+     * @return The number of events.
+     */
+    size_t getNumEventsBetween(int sampleStart, int sampleEnd) const;
+
+    //=========================================================================================================
+    /**
+     * Count the events belonging to one of a given list of groups.
+     * @param[in] groupIdsList The list of groups.
+     * @return The number of events.
+     */
+    size_t getNumEventsInGroups(const std::vector<idNum>& groupIdsList) const;
+
+    //=========================================================================================================
+    /**
+     * Call a visitor for every event ocurring between (inclusive) two samples, in sample order.
+     * @param[in] sampleStart First sample to look for events.
+     * @param[in] sampleEnd Last sample to look for events.
+     * @param[in] visitor Callable taking a const Event&.
+     */
+    template<typename Visitor>
+    void forEachEventBetween(int sampleStart, int sampleEnd, Visitor&& visitor) const;
+
+    //=========================================================================================================
+    /**
+     * Call a visitor for every event ocurring between (inclusive) two samples which belongs to one of the given
+     * groups, in sample order.
+     * @param[in] sampleStart First sample to look for events.
+     * @param[in] sampleEnd Last sample to look for events.
+     * @param[in] groupIdsList The list of groups to which the events have to belong.
+     * @param[in] visitor Callable taking a const Event&.
+     */
+    template<typename Visitor>
+    void forEachEventBetween(int sampleStart, int sampleEnd, const std::vector<idNum>& groupIdsList, Visitor&& visitor) const;
+
+    //=========================================================================================================
+    /**
+     * Call a visitor for every event which belongs to one of the given groups, in sample order.
+     * @param[in] groupIdsList The list of groups to which the events have to belong.
+     * @param[in] visitor Callable taking a const Event&.
+     */
+    template<typename Visitor>
+    void forEachEventInGroups(const std::vector<idNum>& groupIdsList, Visitor&& visitor) const;
+
     //=========================================================================================================
     /**
      * Add an event at a specific sample. The event will be added to a "Default" group.
@@ -187,6 +286,15 @@ public:
      */
     Event addEvent(int sample, idNum groupId);
 
+    //=========================================================================================================
+    /**
+     * Add a set of events at once. The events are merged into the storage in a single pass.
+     * @param[in] samples The samples at which the events should be created.
+     * @param[in] groupId The id of the event group to which the events belong to.
+     * @return A pointer to a vector with the newly created events, in the order of samples.
+     */
+    std::unique_ptr<std::vector<Event> > addEvents(const std::vector<int>& samples, idNum groupId);
+
     //=========================================================================================================
     /**
      * Move an event to a new sample. All other fields of the event will remain unaltered.
@@ -387,10 +495,12 @@ private:
 
     //=========================================================================================================
     /**
-     * Insert an event in the internal storage list of events.
-     * @param e The event to be inserted.
+     * Insert an event in the internal storage list of events, after all events at the same sample.
+     * @param id The id of the event.
+     * @param sample The sample of the event.
+     * @param groupId The group of the event.
      */
-    void insertEvent(const EVENTSINTERNAL::EventINT& e);
+    void insertEvent(idNum id, int sample, idNum groupId);
 
     //=========================================================================================================
     /**
@@ -400,13 +510,30 @@ private:
      */
     bool eraseEvent(idNum eventId);
 
+    //=========================================================================================================
+    /**
+     * Delete all events whose flag is set in a single pass and notify the shared memory.
+     * @param toErase One flag per stored event.
+     * @return The number of deleted events.
+     */
+    size_t eraseFlaggedEvents(const std::vector<char>& toErase);
+
     //=========================================================================================================
     /**
      * Find and event in the system, given it's id.
      * @param id The id of the event to find.
-     * @return
+     * @return The storage index of the event or -1 if it does not exist.
+     */
+    int findEventIndex(idNum id) const;
+
+    //=========================================================================================================
+    /**
+     * Find the storage indices of the events between (inclusive) two samples.
+     * @param sampleStart First sample.
+     * @param sampleEnd Last sample.
+     * @return The first index and one past the last index.
      */
-    std::multimap<int, EVENTSINTERNAL::EventINT>::const_iterator findEventINT(idNum id) const;
+    std::pair<size_t, size_t> findSampleRange(int sampleStart, int sampleEnd) const;
 
     //=========================================================================================================
     /**
@@ -415,7 +542,9 @@ private:
     void createDefaultGroupIfNeeded();
 
 
-    std::multimap<int, EVENTSINTERNAL::EventINT>    m_EventsListBySample;           /**< List of events organized by sample.*/
+    std::vector<int>                                m_vecSamples;                   /**< Event samples, sorted ascending.*/
+    std::vector<idNum>                              m_vecEventIds;                  /**< Event ids, parallel to m_vecSamples.*/
+    std::vector<idNum>                              m_vecGroupIds;                  /**< Event group ids, parallel to m_vecSamples.*/
     std::unordered_map<idNum, int>                  m_MapIdToSample;                /**< EventId to sample relationship table.*/
     std::map<idNum, EVENTSINTERNAL::EventGroupINT>  m_GroupsList;                   /**< Storage of eventgroups.*/
 
@@ -455,5 +584,50 @@ inline std::unique_ptr<std::vector<T> > allocateOutputContainer(size_t size) noe
     return v;
 };
 
+//=============================================================================================================
+// INLINE & TEMPLATE DEFINITIONS
+//=============================================================================================================
+
+template<typename Visitor>
+void EventManager::forEachEventBetween(int sampleStart, int sampleEnd, Visitor&& visitor) const
+{
+    auto range = findSampleRange(sampleStart, sampleEnd);
+    for(size_t i = range.first; i < range.second; ++i)
+    {
+        visitor(Event(m_vecEventIds[i], m_vecSamples[i], m_vecGroupIds[i]));
+    }
+}
+
+//=============================================================================================================
+
+template<typename Visitor>
+void EventManager::forEachEventBetween(int sampleStart, int sampleEnd, const std::vector<idNum>& groupIdsList, Visitor&& visitor) const
+{
+    EVENTSINTERNAL::EventGroupMask mask(groupIdsList);
+    auto range = findSampleRange(sampleStart, sampleEnd);
+    for(size_t i = range.first; i < range.second; ++i)
+    {
+        if(mask.contains(m_vecGroupIds[i]))
+        {
+            visitor(Event(m_vecEventIds[i], m_vecSamples[i], m_vecGroupIds[i]));
+        }
+    }
+}
+
+//=============================================================================================================
+
+template<typename Visitor>
+void EventManager::forEachEventInGroups(const std::vector<idNum>& groupIdsList, Visitor&& visitor) const
+{
+    EVENTSINTERNAL::EventGroupMask mask(groupIdsList);
+    for(size_t i = 0; i < m_vecSamples.size(); ++i)
+    {
+        if(mask.contains(m_vecGroupIds[i]))
+        {
+            visitor(Event(m_vecEventIds[i], m_vecSamples[i], m_vecGroupIds[i]));
+        }
+    }
+}
+
 }//namespace EVENTSLIB
 #endif // EVENTS_H
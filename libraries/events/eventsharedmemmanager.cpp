@@ -416,9 +416,7 @@ void EVENTSINTERNAL::EventSharedMemManager::processEvent(const EventUpdate& ne)
 
 void EVENTSINTERNAL::EventSharedMemManager::processNewEvent(const EventUpdate& ne)
 {
-    EVENTSINTERNAL::EventINT newEvent(
-                m_pEventManager->generateNewEventId(), ne.getSample(), m_GroupId);
-    m_pEventManager->insertEvent(newEvent);
+    m_pEventManager->insertEvent(m_pEventManager->generateNewEventId(), ne.getSample(), m_GroupId);
 }
 
 //=============================================================================================================
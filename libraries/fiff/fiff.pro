@@ -78,6 +78,7 @@ SOURCES += fiff.cpp \
     fiff_coord_trans.cpp \
     fiff_ch_info.cpp \
     fiff_proj.cpp \
+    fiff_proj_operator.cpp \
     fiff_named_matrix.cpp \
     fiff_raw_data.cpp \
     fiff_ctf_comp.cpp \
@@ -95,6 +96,7 @@ SOURCES += fiff.cpp \
     fiff_io.cpp \
     fiff_dig_point_set.cpp \
     fiff_dir_node.cpp \
+    fiff_raw_writer.cpp \
     c/fiff_coord_trans_old.cpp \
     c/fiff_sparse_matrix.cpp \
     c/fiff_digitizer_data.cpp \
@@ -112,6 +114,7 @@ HEADERS += fiff.h \
     fiff_coord_trans.h \
     fiff_ch_info.h \
     fiff_proj.h \
+    fiff_proj_operator.h \
     fiff_named_matrix.h \
     fiff_ctf_comp.h \
     fiff_info.h \
@@ -128,6 +131,7 @@ HEADERS += fiff.h \
     fiff_io.h \
     fiff_dig_point_set.h \
     fiff_dir_node.h \
+    fiff_raw_writer.h \
     c/fiff_coord_trans_old.h \
     c/fiff_sparse_matrix.h \
     c/fiff_types_mne-c.h \
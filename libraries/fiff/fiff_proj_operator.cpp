@@ -0,0 +1,215 @@
+//=============================================================================================================
+/**
+ * @file     fiff_proj_operator.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Definition of the FiffProjOperator Class.
+ *
+ */
+
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "fiff_proj_operator.h"
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FIFFLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+FiffProjOperator::FiffProjOperator()
+: m_iNumChannels(-1)
+, m_bProjActive(false)
+, m_bCompActive(false)
+{
+}
+
+//=============================================================================================================
+
+int FiffProjOperator::setProjection(const QList<FiffProj>& projs,
+                                    const QStringList& chNames,
+                                    const QStringList& bads)
+{
+    m_bProjActive = false;
+    m_matU.resize(0,0);
+    m_vecBadIdcs.resize(0);
+
+    for(int i = 0; i < projs.size(); ++i) {
+        if(projs[i].active) {
+            m_bProjActive = true;
+            break;
+        }
+    }
+
+    if(!m_bProjActive || chNames.isEmpty()) {
+        m_bProjActive = false;
+        return 0;
+    }
+
+    MatrixXd matProj;
+    FiffProj::make_projector(projs, chNames, matProj, bads, m_matU);
+
+    m_vecBadIdcs.resize(bads.size());
+    int iNumBads = 0;
+    for(int i = 0; i < bads.size(); ++i) {
+        int iIdx = chNames.indexOf(bads.at(i));
+        if(iIdx >= 0) {
+            m_vecBadIdcs[iNumBads++] = iIdx;
+        }
+    }
+    m_vecBadIdcs.conservativeResize(iNumBads);
+
+    if(m_matU.rows() != chNames.size()) {
+        m_matU.resize(chNames.size(), 0);
+    }
+
+    m_iNumChannels = chNames.size();
+
+    return m_matU.cols();
+}
+
+//=============================================================================================================
+
+void FiffProjOperator::setCompensator(const MatrixXd& matComp)
+{
+    m_bCompActive = false;
+    m_matCompCols.resize(0,0);
+    m_vecCompIdcs.resize(0);
+
+    if(matComp.rows() == 0 || matComp.rows() != matComp.cols()) {
+        return;
+    }
+
+    // Keep only the columns in which C differs from the identity, i.e. the reference channels
+    m_vecCompIdcs.resize(matComp.cols());
+    int iNumCols = 0;
+    for(int k = 0; k < matComp.cols(); ++k) {
+        for(int i = 0; i < matComp.rows(); ++i) {
+            if(matComp(i,k) != (i == k ? 1.0 : 0.0)) {
+                m_vecCompIdcs[iNumCols++] = k;
+                break;
+            }
+        }
+    }
+    m_vecCompIdcs.conservativeResize(iNumCols);
+
+    m_matCompCols.resize(matComp.rows(), iNumCols);
+    for(int j = 0; j < iNumCols; ++j) {
+        m_matCompCols.col(j) = matComp.col(m_vecCompIdcs[j]);
+        m_matCompCols(m_vecCompIdcs[j],j) -= 1.0;
+    }
+
+    m_bCompActive = iNumCols > 0;
+    m_iNumChannels = matComp.rows();
+}
+
+//=============================================================================================================
+
+void FiffProjOperator::clear()
+{
+    m_matU.resize(0,0);
+    m_vecBadIdcs.resize(0);
+    m_matCompCols.resize(0,0);
+    m_vecCompIdcs.resize(0);
+    m_iNumChannels = -1;
+    m_bProjActive = false;
+    m_bCompActive = false;
+}
+
+//=============================================================================================================
+
+int FiffProjOperator::nchan() const
+{
+    return m_bProjActive || m_bCompActive ? m_iNumChannels : -1;
+}
+
+//=============================================================================================================
+
+void FiffProjOperator::apply(const Ref<const MatrixXd>& in,
+                             Ref<MatrixXd> out,
+                             bool bDoProj,
+                             bool bDoComp) const
+{
+    if(in.data() != out.data()) {
+        out = in;
+    }
+
+    applyInPlace(out, bDoProj, bDoComp);
+}
+
+//=============================================================================================================
+
+void FiffProjOperator::applyInPlace(Ref<MatrixXd> data,
+                                    bool bDoProj,
+                                    bool bDoComp) const
+{
+    bDoComp = bDoComp && m_bCompActive && data.rows() == m_matCompCols.rows();
+    bDoProj = bDoProj && m_bProjActive && data.rows() == m_matU.rows();
+
+    if(data.cols() == 0) {
+        return;
+    }
+
+    if(bDoComp) {
+        // The reference rows need to be gathered first since the compensated rows are written in place
+        MatrixXd matRef(m_vecCompIdcs.size(), data.cols());
+        for(int j = 0; j < m_vecCompIdcs.size(); ++j) {
+            matRef.row(j) = data.row(m_vecCompIdcs[j]);
+        }
+        data.noalias() += m_matCompCols * matRef;
+    }
+
+    if(bDoProj) {
+        for(int j = 0; j < m_vecBadIdcs.size(); ++j) {
+            data.row(m_vecBadIdcs[j]).setZero();
+        }
+
+        if(m_matU.cols() > 0) {
+            MatrixXd matCoeffs = m_matU.transpose() * data;
+            data.noalias() -= m_matU * matCoeffs;
+        }
+    }
+}
+
+//=============================================================================================================
+
+MatrixXd FiffProjOperator::toDense(int iNumChannels) const
+{
+    int n = nchan() > 0 ? nchan() : iNumChannels;
+    MatrixXd matOp = MatrixXd::Identity(n, n);
+    applyInPlace(matOp);
+    return matOp;
+}
@@ -0,0 +1,206 @@
+//=============================================================================================================
+/**
+ * @file     fiff_proj_operator.h
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Declaration of the FiffProjOperator Class.
+ *
+ */
+
+
+#ifndef FIFF_PROJ_OPERATOR_H
+#define FIFF_PROJ_OPERATOR_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "fiff_global.h"
+#include "fiff_proj.h"
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QList>
+#include <QStringList>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// DEFINE NAMESPACE FIFFLIB
+//=============================================================================================================
+
+namespace FIFFLIB
+{
+
+//=============================================================================================================
+/**
+ * Applies SSP projectors, bad channel zeroing and CTF compensation to channels x samples data without forming
+ * the n x n operator. The SSP part is kept as the orthonormal basis U (n x k) of the projection vectors and applied
+ * as x - U (U^T x) in O(n k) per sample. The compensator only mixes a few reference channels into the MEG
+ * channels, so only its off-identity columns are stored. The result equals P_bad * C * x, where P_bad is the SSP
+ * projector with the columns of the bad channels set to zero. Both parts are only rebuilt when the projectors, the
+ * bad channels or the compensation grade change.
+ *
+ * @brief Low-rank SSP and compensation operator.
+ */
+class FIFFSHARED_EXPORT FiffProjOperator
+{
+
+public:
+    //=========================================================================================================
+    /**
+     * Constructs an identity operator.
+     */
+    FiffProjOperator();
+
+    //=========================================================================================================
+    /**
+     * Sets the SSP part from the active projectors. The bad channels are excluded from the projection vectors
+     * and zeroed in the output.
+     *
+     * @param[in] projs      The projectors. Only active ones are applied.
+     * @param[in] chNames    The channel names, i.e. the rows of the data.
+     * @param[in] bads       The bad channels.
+     *
+     * @return The number of vectors in the projector.
+     */
+    int setProjection(const QList<FiffProj>& projs,
+                      const QStringList& chNames,
+                      const QStringList& bads = QStringList());
+
+    //=========================================================================================================
+    /**
+     * Sets the compensation part from a dense compensation matrix, e.g. as returned by
+     * FiffInfo::make_compensator. Pass an empty matrix to disable compensation.
+     *
+     * @param[in] matComp    The compensation matrix (n x n).
+     */
+    void setCompensator(const Eigen::MatrixXd& matComp);
+
+    //=========================================================================================================
+    /**
+     * Resets the operator to the identity.
+     */
+    void clear();
+
+    //=========================================================================================================
+    /**
+     * Returns whether the SSP part is active, i.e. whether at least one active projector was set.
+     *
+     * @return True if the SSP part is active.
+     */
+    inline bool isProjActive() const;
+
+    //=========================================================================================================
+    /**
+     * Returns whether the compensation part is active, i.e. whether the compensator differs from the identity.
+     *
+     * @return True if the compensation part is active.
+     */
+    inline bool isCompActive() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the number of channels the active parts were built for, -1 if the operator is the identity.
+     *
+     * @return The number of channels.
+     */
+    int nchan() const;
+
+    //=========================================================================================================
+    /**
+     * Applies the operator: out = P_bad * C * in. Proj and comp can be switched off per call, e.g. if the user
+     * deactivated them in the GUI. in and out may be the same matrix.
+     *
+     * @param[in] in         The data (channels x samples).
+     * @param[out] out       The result. Must have the same size as in.
+     * @param[in] bDoProj    Whether to apply the SSP part.
+     * @param[in] bDoComp    Whether to apply the compensation part.
+     */
+    void apply(const Eigen::Ref<const Eigen::MatrixXd>& in,
+               Eigen::Ref<Eigen::MatrixXd> out,
+               bool bDoProj = true,
+               bool bDoComp = true) const;
+
+    //=========================================================================================================
+    /**
+     * Applies the operator in place.
+     *
+     * @param[in, out] data  The data (channels x samples).
+     * @param[in] bDoProj    Whether to apply the SSP part.
+     * @param[in] bDoComp    Whether to apply the compensation part.
+     */
+    void applyInPlace(Eigen::Ref<Eigen::MatrixXd> data,
+                      bool bDoProj = true,
+                      bool bDoComp = true) const;
+
+    //=========================================================================================================
+    /**
+     * Returns the operator as dense matrix, e.g. to compose it with a selection or calibration.
+     *
+     * @param[in] iNumChannels   The number of channels, used if the operator is the identity.
+     *
+     * @return The dense operator (n x n).
+     */
+    Eigen::MatrixXd toDense(int iNumChannels) const;
+
+private:
+    Eigen::MatrixXd     m_matU;             /**< Orthonormal basis of the SSP vectors (n x k). */
+    Eigen::VectorXi     m_vecBadIdcs;       /**< The indices of the bad channels, zeroed before projecting. */
+    Eigen::MatrixXd     m_matCompCols;      /**< The non-zero columns of C - I (n x r). */
+    Eigen::VectorXi     m_vecCompIdcs;      /**< The channel indices of the columns in m_matCompCols. */
+    int                 m_iNumChannels;     /**< The number of channels, -1 if not set. */
+    bool                m_bProjActive;      /**< Whether the SSP part is active. */
+    bool                m_bCompActive;      /**< Whether the compensation part is active. */
+};
+
+//=============================================================================================================
+// INLINE DEFINITIONS
+//=============================================================================================================
+
+inline bool FiffProjOperator::isProjActive() const
+{
+    return m_bProjActive;
+}
+
+//=============================================================================================================
+
+inline bool FiffProjOperator::isCompActive() const
+{
+    return m_bCompActive;
+}
+
+} // NAMESPACE FIFFLIB
+
+#endif // FIFF_PROJ_OPERATOR_H
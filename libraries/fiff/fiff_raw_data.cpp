@@ -267,7 +267,7 @@ bool FiffRawData::read_raw_segment(MatrixXd& data,
 
     MatrixXd one, newData, tmp_data;
     FiffRawDir thisRawDir;
-    FiffTag::SPtr t_pTag;
+    FiffTag::SPtr t_pTag(new FiffTag()); // Reused for all buffers
     fiff_int_t first_pick, last_pick, picksamp;
     for(k = 0; k < this->rawdir.size(); ++k)
     {
@@ -293,7 +293,7 @@ bool FiffRawData::read_raw_segment(MatrixXd& data,
             }
             else
             {
-                fid->read_tag(t_pTag, thisRawDir.ent->pos);
+                fid->read_tag(*t_pTag, thisRawDir.ent->pos);
                 //
                 //   Depending on the state of the projection and selection
                 //   we proceed a little bit differently
@@ -601,6 +601,7 @@ bool FiffRawData::read_raw_segment(MatrixXd& data,
     }
 
     MatrixXd one;
+    FiffTag::SPtr t_pTag(new FiffTag()); // Reused for all buffers
     fiff_int_t first_pick, last_pick, picksamp;
     for(k = 0; k < this->rawdir.size(); ++k)
     {
@@ -626,8 +627,7 @@ bool FiffRawData::read_raw_segment(MatrixXd& data,
             }
             else
             {
-                FiffTag::SPtr t_pTag;
-                fid->read_tag(t_pTag, thisRawDir.ent->pos);
+                fid->read_tag(*t_pTag, thisRawDir.ent->pos);
                 //
                 //   Depending on the state of the projection and selection
                 //   we proceed a little bit differently
@@ -0,0 +1,357 @@
+//=============================================================================================================
+/**
+ * @file     fiff_raw_writer.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Definition of the FiffRawWriter Class.
+ *
+ */
+
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "fiff_raw_writer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QMutexLocker>
+#include <QtEndian>
+#include <QDebug>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FIFFLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+namespace
+{
+
+/**
+ * Rounds a value to the nearest integer of type T, saturating at the limits of T.
+ */
+template<typename T>
+inline T saturate(double dValue)
+{
+    dValue = std::round(dValue);
+
+    if(dValue <= static_cast<double>(std::numeric_limits<T>::min())) {
+        return std::numeric_limits<T>::min();
+    }
+    if(dValue >= static_cast<double>(std::numeric_limits<T>::max())) {
+        return std::numeric_limits<T>::max();
+    }
+
+    return static_cast<T>(dValue);
+}
+
+inline quint32 toWord(double dValue, float*)
+{
+    float fValue = static_cast<float>(dValue);
+    quint32 iWord;
+    std::memcpy(&iWord, &fValue, sizeof(iWord));
+    return iWord;
+}
+
+inline quint32 toWord(double dValue, qint32*)
+{
+    return static_cast<quint32>(saturate<qint32>(dValue));
+}
+
+inline quint16 toWord(double dValue, qint16*)
+{
+    return static_cast<quint16>(saturate<qint16>(dValue));
+}
+
+/**
+ * Scales, converts and byte swaps a column major block in one pass over the samples.
+ */
+template<typename T, bool bBigEndian>
+void encodeBlock(const MatrixXd& matData,
+                 const VectorXd& vecScale,
+                 uchar* pDest)
+{
+    const double* pData = matData.data();
+    const double* pScale = vecScale.data();
+    const Index iRows = matData.rows();
+    const Index iCols = matData.cols();
+
+    for(Index c = 0; c < iCols; ++c, pData += iRows) {
+        for(Index r = 0; r < iRows; ++r) {
+            const auto iWord = toWord(pData[r] * pScale[r], static_cast<T*>(Q_NULLPTR));
+
+            if(bBigEndian) {
+                qToBigEndian(iWord, pDest);
+            } else {
+                qToLittleEndian(iWord, pDest);
+            }
+
+            pDest += sizeof(iWord);
+        }
+    }
+}
+
+template<typename T>
+void encodeBlock(const MatrixXd& matData,
+                 const VectorXd& vecScale,
+                 QDataStream::ByteOrder byteOrder,
+                 uchar* pDest)
+{
+    if(byteOrder == QDataStream::BigEndian) {
+        encodeBlock<T, true>(matData, vecScale, pDest);
+    } else {
+        encodeBlock<T, false>(matData, vecScale, pDest);
+    }
+}
+
+} // anonymous namespace
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+FiffRawWriter::FiffRawWriter(FiffStream::SPtr pStream,
+                             const RowVectorXd& vecCals,
+                             fiff_int_t iDataType,
+                             int iQueueDepth,
+                             QObject* parent)
+: QThread(parent)
+, m_pStream(pStream)
+, m_vecInvCals(vecCals.transpose().cwiseInverse())
+, m_iDataType(iDataType)
+, m_iQueueDepth(std::max(iQueueDepth, 1))
+, m_iBusy(0)
+, m_iBytesWritten(0)
+, m_bStop(false)
+, m_bError(false)
+{
+    start();
+}
+
+//=============================================================================================================
+
+FiffRawWriter::~FiffRawWriter()
+{
+    stop();
+}
+
+//=============================================================================================================
+
+bool FiffRawWriter::write(const MatrixXd& matData)
+{
+    QByteArray baTag;
+
+    {
+        QMutexLocker locker(&m_mutex);
+
+        if(m_bStop || m_bError) {
+            return false;
+        }
+
+        if(!m_lFree.isEmpty()) {
+            baTag = m_lFree.takeLast();
+        }
+    }
+
+    // Convert outside of the lock while the writer thread is busy with the previous block
+    if(!encode(matData, m_vecInvCals, m_iDataType, m_pStream->byteOrder(), baTag)) {
+        return false;
+    }
+
+    QMutexLocker locker(&m_mutex);
+
+    while(m_lQueue.size() >= m_iQueueDepth && !m_bStop) {
+        m_condNotFull.wait(&m_mutex);
+    }
+
+    if(m_bStop) {
+        return false;
+    }
+
+    m_lQueue.append(baTag);
+    m_condNotEmpty.wakeOne();
+
+    return !m_bError;
+}
+
+//=============================================================================================================
+
+bool FiffRawWriter::flush()
+{
+    QMutexLocker locker(&m_mutex);
+
+    while(!m_lQueue.isEmpty() || m_iBusy > 0) {
+        m_condNotFull.wait(&m_mutex);
+    }
+
+    return !m_bError;
+}
+
+//=============================================================================================================
+
+void FiffRawWriter::stop()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_bStop = true;
+        m_condNotEmpty.wakeAll();
+        m_condNotFull.wakeAll();
+    }
+
+    wait();
+}
+
+//=============================================================================================================
+
+qint64 FiffRawWriter::bytesWritten() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_iBytesWritten;
+}
+
+//=============================================================================================================
+
+bool FiffRawWriter::encode(const MatrixXd& matData,
+                           const VectorXd& vecScale,
+                           fiff_int_t iDataType,
+                           QDataStream::ByteOrder byteOrder,
+                           QByteArray& baTag)
+{
+    if(matData.rows() != vecScale.size()) {
+        qWarning() << "[FiffRawWriter::encode] Buffer and calibration sizes do not match.";
+        return false;
+    }
+
+    qint64 iBytesPerValue;
+
+    switch(iDataType) {
+        case FIFFT_FLOAT:
+        case FIFFT_INT:
+            iBytesPerValue = 4;
+            break;
+        case FIFFT_SHORT:
+        case FIFFT_DAU_PACK16:
+            iBytesPerValue = 2;
+            break;
+        default:
+            qWarning() << "[FiffRawWriter::encode] Data type" << iDataType << "is not supported.";
+            return false;
+    }
+
+    const qint64 iDataSize = iBytesPerValue * matData.size();
+
+    if(iDataSize > std::numeric_limits<qint32>::max() - 16) {
+        qWarning() << "[FiffRawWriter::encode] Buffer is too large for a single tag.";
+        return false;
+    }
+
+    baTag.resize(16 + static_cast<int>(iDataSize));
+    uchar* pDest = reinterpret_cast<uchar*>(baTag.data());
+
+    // Tag header: kind, type, size, next
+    const qint32 header[4] = { FIFF_DATA_BUFFER, iDataType, static_cast<qint32>(iDataSize), FIFFV_NEXT_SEQ };
+
+    for(int i = 0; i < 4; ++i, pDest += 4) {
+        if(byteOrder == QDataStream::BigEndian) {
+            qToBigEndian(header[i], pDest);
+        } else {
+            qToLittleEndian(header[i], pDest);
+        }
+    }
+
+    switch(iDataType) {
+        case FIFFT_FLOAT:
+            encodeBlock<float>(matData, vecScale, byteOrder, pDest);
+            break;
+        case FIFFT_INT:
+            encodeBlock<qint32>(matData, vecScale, byteOrder, pDest);
+            break;
+        default:
+            encodeBlock<qint16>(matData, vecScale, byteOrder, pDest);
+            break;
+    }
+
+    return true;
+}
+
+//=============================================================================================================
+
+void FiffRawWriter::run()
+{
+    QMutexLocker locker(&m_mutex);
+
+    forever {
+        while(m_lQueue.isEmpty() && !m_bStop) {
+            m_condNotEmpty.wait(&m_mutex);
+        }
+
+        // Pending blocks are written before stopping
+        if(m_lQueue.isEmpty()) {
+            break;
+        }
+
+        QByteArray baTag = m_lQueue.takeFirst();
+
+        if(!m_bError) {
+            ++m_iBusy;
+            locker.unlock();
+
+            int iWritten = m_pStream->writeRawData(baTag.constData(), baTag.size());
+
+            locker.relock();
+            --m_iBusy;
+
+            if(iWritten == baTag.size()) {
+                m_iBytesWritten += iWritten;
+            } else {
+                qWarning() << "[FiffRawWriter::run] Failed to write raw data buffer. Dropping all further buffers.";
+                m_bError = true;
+            }
+        }
+
+        // Hand the buffer back without keeping a second reference, so that it is reused without detaching
+        m_lFree.append(baTag);
+        baTag = QByteArray();
+
+        m_condNotFull.wakeAll();
+    }
+}
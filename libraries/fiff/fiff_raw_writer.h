@@ -0,0 +1,193 @@
+//=============================================================================================================
+/**
+ * @file     fiff_raw_writer.h
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Declaration of the FiffRawWriter Class.
+ *
+ */
+
+
+#ifndef FIFF_RAW_WRITER_H
+#define FIFF_RAW_WRITER_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "fiff_global.h"
+#include "fiff_types.h"
+#include "fiff_file.h"
+#include "fiff_stream.h"
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QByteArray>
+#include <QList>
+#include <QSharedPointer>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// DEFINE NAMESPACE FIFFLIB
+//=============================================================================================================
+
+namespace FIFFLIB
+{
+
+//=============================================================================================================
+/**
+ * Asynchronous writer for the FIFF_DATA_BUFFER tags of a raw data file. The inverse calibrations are computed once,
+ * each block is scaled, converted to the requested data type and byte swapped as a whole into a reusable buffer by
+ * the calling thread and then written to the device by a background thread. The number of blocks waiting for the
+ * device is bounded: write() blocks as soon as the queue is full, which gives double buffering for the default depth
+ * of two.
+ *
+ * The stream must not be used by anybody else while blocks are pending. Call flush() before writing other tags,
+ * e.g. file references or finish_writing_raw().
+ *
+ * @brief Asynchronous double buffered raw data writer.
+ */
+class FIFFSHARED_EXPORT FiffRawWriter : public QThread
+{
+    Q_OBJECT
+
+public:
+    typedef QSharedPointer<FiffRawWriter> SPtr;             /**< Shared pointer type for FiffRawWriter. */
+    typedef QSharedPointer<const FiffRawWriter> ConstSPtr;  /**< Const shared pointer type for FiffRawWriter. */
+
+    //=========================================================================================================
+    /**
+     * Constructs a FiffRawWriter and starts its writer thread.
+     *
+     * @param[in] pStream        The stream to write to, e.g. as returned by FiffStream::start_writing_raw.
+     * @param[in] vecCals        The calibration factors as returned by FiffStream::start_writing_raw.
+     * @param[in] iDataType      The data type of the buffers: FIFFT_FLOAT, FIFFT_INT, FIFFT_SHORT or FIFFT_DAU_PACK16.
+     *                           Must match the data type passed to FiffStream::start_writing_raw.
+     * @param[in] iQueueDepth    The maximum number of blocks waiting to be written. Default is 2.
+     * @param[in] parent         The parent object.
+     */
+    FiffRawWriter(FiffStream::SPtr pStream,
+                  const Eigen::RowVectorXd& vecCals,
+                  fiff_int_t iDataType = FIFFT_FLOAT,
+                  int iQueueDepth = 2,
+                  QObject* parent = Q_NULLPTR);
+
+    //=========================================================================================================
+    /**
+     * Writes all pending blocks and stops the writer thread.
+     */
+    ~FiffRawWriter();
+
+    //=========================================================================================================
+    /**
+     * Converts a block of raw data and queues it for writing. Blocks while the queue is full.
+     *
+     * @param[in] matData    The data to write (channels x samples) in physical units.
+     *
+     * @return true if succeeded, false if the sizes do not match or a previous write failed.
+     */
+    bool write(const Eigen::MatrixXd& matData);
+
+    //=========================================================================================================
+    /**
+     * Waits until all queued blocks were written to the device.
+     *
+     * @return true if all blocks were written successfully, false otherwise.
+     */
+    bool flush();
+
+    //=========================================================================================================
+    /**
+     * Writes all pending blocks and stops the writer thread. Further calls to write() fail.
+     */
+    void stop();
+
+    //=========================================================================================================
+    /**
+     * Returns the number of bytes written to the device so far.
+     *
+     * @return The number of written bytes.
+     */
+    qint64 bytesWritten() const;
+
+    //=========================================================================================================
+    /**
+     * Converts a block of raw data into a complete FIFF_DATA_BUFFER tag, including the tag header. Each channel is
+     * multiplied by its scale, rounded and saturated for the integer types and stored in the given byte order.
+     * baTag is resized to fit the tag, its capacity is reused between calls.
+     *
+     * @param[in] matData       The data to convert (channels x samples).
+     * @param[in] vecScale      The scale per channel, i.e. the inverse calibrations.
+     * @param[in] iDataType     The data type: FIFFT_FLOAT, FIFFT_INT, FIFFT_SHORT or FIFFT_DAU_PACK16.
+     * @param[in] byteOrder     The byte order of the stream.
+     * @param[out] baTag        The encoded tag.
+     *
+     * @return true if succeeded, false if the sizes do not match or the data type is not supported.
+     */
+    static bool encode(const Eigen::MatrixXd& matData,
+                       const Eigen::VectorXd& vecScale,
+                       fiff_int_t iDataType,
+                       QDataStream::ByteOrder byteOrder,
+                       QByteArray& baTag);
+
+protected:
+    //=========================================================================================================
+    /**
+     * Writes the queued blocks to the device until stop() is called.
+     */
+    virtual void run() override;
+
+private:
+    FiffStream::SPtr        m_pStream;          /**< The stream to write to. */
+    Eigen::VectorXd         m_vecInvCals;       /**< The inverse calibration per channel. */
+    fiff_int_t              m_iDataType;        /**< The data type of the written buffers. */
+    int                     m_iQueueDepth;      /**< The maximum number of queued blocks. */
+
+    mutable QMutex          m_mutex;            /**< Guards the queues and flags below. */
+    QWaitCondition          m_condNotEmpty;     /**< Signaled when a block was queued or the writer is stopped. */
+    QWaitCondition          m_condNotFull;      /**< Signaled when a block was written. */
+    QList<QByteArray>       m_lQueue;           /**< The blocks waiting to be written. */
+    QList<QByteArray>       m_lFree;            /**< Written blocks whose buffers are reused. */
+    int                     m_iBusy;            /**< The number of blocks currently written by the writer thread. */
+    qint64                  m_iBytesWritten;    /**< The number of bytes written so far. */
+    bool                    m_bStop;            /**< Whether the writer thread should stop. */
+    bool                    m_bError;           /**< Whether a write to the device failed. */
+};
+} // NAMESPACE FIFFLIB
+
+#endif // FIFF_RAW_WRITER_H
@@ -54,6 +54,7 @@
 #include "fiff_id.h"
 #include "c/fiff_digitizer_data.h"
 #include "fiff_dig_point.h"
+#include "fiff_raw_writer.h"
 
 #include <utils/mnemath.h>
 #include <utils/ioutils.h>
@@ -69,6 +70,7 @@
 #endif
 
 #include <iostream>
+#include <cstring>
 #include <time.h>
 
 //=============================================================================================================
@@ -84,6 +86,7 @@
 
 #include <QFile>
 #include <QTcpSocket>
+#include <QtEndian>
 
 //=============================================================================================================
 // USED NAMESPACES
@@ -93,6 +96,44 @@ using namespace FIFFLIB;
 using namespace UTILSLIB;
 using namespace Eigen;
 
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+namespace
+{
+
+/**
+ * Writes nel 32 bit words in the byte order of the stream with a single device write instead of one
+ * QDataStream::operator<< call per element.
+ */
+void writeWords(QDataStream& stream, const void* data, fiff_int_t nel)
+{
+    if(nel <= 0) {
+        return;
+    }
+
+    QByteArray baBuffer(nel * 4, Qt::Uninitialized);
+    const char* pSrc = static_cast<const char*>(data);
+    uchar* pDest = reinterpret_cast<uchar*>(baBuffer.data());
+    const bool bBigEndian = stream.byteOrder() == QDataStream::BigEndian;
+
+    for(fiff_int_t i = 0; i < nel; ++i, pSrc += 4, pDest += 4) {
+        quint32 iWord;
+        std::memcpy(&iWord, pSrc, 4);
+
+        if(bBigEndian) {
+            qToBigEndian(iWord, pDest);
+        } else {
+            qToLittleEndian(iWord, pDest);
+        }
+    }
+
+    stream.writeRawData(baBuffer.constData(), baBuffer.size());
+}
+
+} // anonymous namespace
+
 //=============================================================================================================
 // DEFINE MEMBER METHODS
 //=============================================================================================================
@@ -608,7 +649,7 @@ bool FiffStream::read_cov(const FiffDirNode::SPtr& p_Node, fiff_int_t cov_kind,
             if (current->find_tag(this, FIFF_MNE_COV_EIGENVALUES, tag1) && current->find_tag(this, FIFF_MNE_COV_EIGENVECTORS, tag2))
             {
                 eig = VectorXd(Map<VectorXd>(tag1->toDouble(),dim));
-                eigvec = tag2->toFloatMatrix().cast<double>();
+                eigvec = tag2->toFloatMatrixView().cast<double>();
                 eigvec.transposeInPlace();
             }
             //
@@ -1362,7 +1403,7 @@ bool FiffStream::read_named_matrix(const FiffDirNode::SPtr& p_Node, fiff_int_t m
     else
     {
         //qDebug() << "Is Matrix" << t_pTag->isMatrix() << "Special Type:" << t_pTag->getType();
-        mat.data = t_pTag->toFloatMatrix().cast<double>();
+        mat.data = t_pTag->toFloatMatrixView().cast<double>();
         mat.data.transposeInPlace();
     }
 
@@ -1510,7 +1551,7 @@ QList<FiffProj> FiffStream::read_proj(const FiffDirNode::SPtr& p_Node)
         MatrixXd data;// = NULL;
         if (t_pTag)
         {
-            data = t_pTag->toFloatMatrix().cast<double>();
+            data = t_pTag->toFloatMatrixView().cast<double>();
             data.transposeInPlace();
         }
         else
@@ -1662,24 +1703,30 @@ bool FiffStream::read_rt_tag(FiffTag::SPtr &p_pTag)
 
 bool FiffStream::read_tag(FiffTag::SPtr &p_pTag,
                           fiff_long_t pos)
+{
+    p_pTag = FiffTag::SPtr(new FiffTag());
+
+    return read_tag(*p_pTag, pos);
+}
+
+//=============================================================================================================
+
+bool FiffStream::read_tag(FiffTag& p_Tag,
+                          fiff_long_t pos)
 {
     if (pos >= 0) {
         this->device()->seek(pos);
     }
 
-    p_pTag = FiffTag::SPtr(new FiffTag());
-
     //
     // Read fiff tag header from stream
     //
-     *this  >> p_pTag->kind;
-     *this  >> p_pTag->type;
+     *this  >> p_Tag.kind;
+     *this  >> p_Tag.type;
     qint32 size;
      *this  >> size;
-    p_pTag->resize(size);
-     *this  >> p_pTag->next;
-
-//    qDebug() << "read_tag" << "  Kind:" << p_pTag->kind << "  Type:" << p_pTag->type << "  Size:" << p_pTag->size() << "  Next:" << p_pTag->next;
+    p_Tag.resize(size);
+     *this  >> p_Tag.next;
 
     //
     // Read data when available
@@ -1687,21 +1734,18 @@ bool FiffStream::read_tag(FiffTag::SPtr &p_pTag,
     int endian;
     if (this->byteOrder() == QDataStream::LittleEndian){
         endian = FIFFV_LITTLE_ENDIAN;
-        //printf("Endian: Little\n");
     } else {
         endian = FIFFV_BIG_ENDIAN;
-        //printf("Endian: Big\n");
     }
 
-    if (p_pTag->size() > 0)
+    if (p_Tag.size() > 0)
     {
-        this->readRawData(p_pTag->data(), p_pTag->size());
-        //FiffTag::convert_tag_data(p_pTag,FIFFV_BIG_ENDIAN,FIFFV_NATIVE_ENDIAN);
-        FiffTag::convert_tag_data(p_pTag,endian,FIFFV_NATIVE_ENDIAN);
+        this->readRawData(p_Tag.data(), p_Tag.size());
+        FiffTag::convert_tag_data(p_Tag,endian,FIFFV_NATIVE_ENDIAN);
     }
 
-    if (p_pTag->next != FIFFV_NEXT_SEQ)
-        this->device()->seek(p_pTag->next);//fseek(fid,tag.next,'bof');
+    if (p_Tag.next != FIFFV_NEXT_SEQ)
+        this->device()->seek(p_Tag.next);//fseek(fid,tag.next,'bof');
 
     return true;
 }
@@ -2022,12 +2066,17 @@ FiffStream::SPtr FiffStream::start_writing_raw(QIODevice &p_IODevice,
                                                const FiffInfo& info,
                                                RowVectorXd& cals,
                                                MatrixXi sel,
-                                               bool bResetRange)
+                                               bool bResetRange,
+                                               fiff_int_t data_type)
 {
     //
-    //   We will always write floats
+    //   The raw data buffers are written as floats unless an integer type is requested
     //
-    fiff_int_t data_type = 4;
+    if(data_type != FIFFT_FLOAT && data_type != FIFFT_INT && data_type != FIFFT_SHORT && data_type != FIFFT_DAU_PACK16)
+    {
+        qWarning("FiffStream::start_writing_raw - Data type %d is not supported, writing floats instead.\n", data_type);
+        data_type = FIFFT_FLOAT;
+    }
     qint32 k;
 
     if(sel.cols() == 0)
@@ -2178,9 +2227,9 @@ FiffStream::SPtr FiffStream::start_writing_raw(QIODevice &p_IODevice,
         //
         chs[k].scanNo = k+1;
         if(bResetRange) {
-            chs[k].range = 1.0; // Reset to 1.0 because we always write floats.
+            chs[k].range = 1.0; // Reset to 1.0 because the buffers are scaled by the calibrations only.
         }
-        cals[k] = chs[k].cal;
+        cals[k] = chs[k].cal * chs[k].range;
         t_pStream->write_ch_info(chs[k]);
     }
     //
@@ -2636,8 +2685,7 @@ fiff_long_t FiffStream::write_float(fiff_int_t kind, const float* data, fiff_int
     *this << (qint32)datasize;
     *this << (qint32)FIFFV_NEXT_SEQ;
 
-    for(qint32 i = 0; i < nel; ++i)
-        *this << data[i];
+    writeWords(*this, data, nel);
 
     return pos;
 }
@@ -2985,8 +3033,7 @@ fiff_long_t FiffStream::write_int(fiff_int_t kind, const fiff_int_t* data, fiff_
      *this << (qint32)datasize;
      *this << (qint32)next;
 
-    for(qint32 i = 0; i < nel; ++i)
-        *this << data[i];
+    writeWords(*this, data, nel);
 
     return pos;
 }
@@ -3099,18 +3146,11 @@ bool FiffStream::write_raw_buffer(const MatrixXd& buf,
         return false;
     }
 
-    typedef Eigen::Triplet<double> T;
-    std::vector<T> tripletList;
-    tripletList.reserve(cals.cols());
-    for(qint32 i = 0; i < cals.cols(); ++i)
-        tripletList.push_back(T(i, i, 1.0/cals[i]));
-
-    SparseMatrix<double> inv_calsMat(cals.cols(), cals.cols());
-    inv_calsMat.setFromTriplets(tripletList.begin(), tripletList.end());
+    QByteArray baTag;
+    if(!FiffRawWriter::encode(buf, cals.transpose().cwiseInverse(), FIFFT_FLOAT, this->byteOrder(), baTag))
+        return false;
 
-    MatrixXf tmp = (inv_calsMat*buf).cast<float>();
-    this->write_float(FIFF_DATA_BUFFER,tmp.data(),tmp.rows()*tmp.cols());
-    return true;
+    return this->writeRawData(baTag.constData(), baTag.size()) == baTag.size();
 }
 
 //=============================================================================================================
@@ -3123,6 +3163,28 @@ bool FiffStream::write_raw_buffer(const MatrixXd& buf,
         return false;
     }
 
+    //
+    //   A diagonal mult, i.e. plain calibrations, is applied as a per channel scale
+    //
+    bool bDiagonal = mult.rows() == mult.cols();
+    VectorXd vecScale = VectorXd::Zero(mult.cols());
+    for (int k=0; k<mult.outerSize() && bDiagonal; ++k)
+      for (SparseMatrix<double>::InnerIterator it(mult,k); it; ++it) {
+        if(it.row() != it.col()) {
+            bDiagonal = false;
+            break;
+        }
+        vecScale[it.row()] = 1/it.value();
+      }
+
+    if(bDiagonal) {
+        QByteArray baTag;
+        if(!FiffRawWriter::encode(buf, vecScale, FIFFT_FLOAT, this->byteOrder(), baTag))
+            return false;
+
+        return this->writeRawData(baTag.constData(), baTag.size()) == baTag.size();
+    }
+
     SparseMatrix<double> inv_mult(mult.rows(), mult.cols());
     for (int k=0; k<inv_mult.outerSize(); ++k)
       for (SparseMatrix<double>::InnerIterator it(mult,k); it; ++it)
@@ -3137,9 +3199,11 @@ bool FiffStream::write_raw_buffer(const MatrixXd& buf,
 
 bool FiffStream::write_raw_buffer(const MatrixXd& buf)
 {
-    MatrixXf tmp = buf.cast<float>();
-    this->write_float(FIFF_DATA_BUFFER,tmp.data(),tmp.rows()*tmp.cols());
-    return true;
+    QByteArray baTag;
+    if(!FiffRawWriter::encode(buf, VectorXd::Ones(buf.rows()), FIFFT_FLOAT, this->byteOrder(), baTag))
+        return false;
+
+    return this->writeRawData(baTag.constData(), baTag.size()) == baTag.size();
 }
 
 //=============================================================================================================
@@ -3178,35 +3242,53 @@ void FiffStream::write_rt_command(fiff_int_t command, const QString& data)
 
 QList<FiffDirEntry::SPtr> FiffStream::make_dir(bool *ok)
 {
-    FiffTag::SPtr t_pTag;
     QList<FiffDirEntry::SPtr> dir;
     FiffDirEntry::SPtr t_pFiffDirEntry;
     fiff_long_t pos;
+    fiff_int_t kind, type, size, next;
     if(ok) *ok = false;
     /*
      * Start from the very beginning...
      */
     if(!this->device()->seek(SEEK_SET))
         return dir;
-    while ((pos = this->read_tag_info(t_pTag)) != -1) {
+    /*
+     * Only the tag headers are needed, skip the data without allocating a tag for it
+     */
+    this->resetStatus();
+    while (true) {
+        pos = this->device()->pos();
+        *this >> kind >> type >> size >> next;
+        if (this->status() != QDataStream::Ok)
+            break;
+        if (next > 0) {
+            if(!this->device()->seek(next)) {
+                qCritical("fseek"); //fseek(fid,tag.next,'bof');
+                break;
+            }
+        }
+        else if (size > 0 && next == FIFFV_NEXT_SEQ) {
+            if(!this->device()->seek(this->device()->pos()+size)) {
+                qCritical("fseek"); //fseek(fid,tag.size,'cof');
+                break;
+            }
+        }
         /*
         * Check that we haven't run into the directory
         */
-        if (t_pTag->kind == FIFF_DIR)
+        if (kind == FIFF_DIR)
             break;
         /*
         * Put in the new entry
         */
         t_pFiffDirEntry = FiffDirEntry::SPtr(new FiffDirEntry);
-        t_pFiffDirEntry->kind = t_pTag->kind;
-        t_pFiffDirEntry->type = t_pTag->type;
-        t_pFiffDirEntry->size = t_pTag->size();
+        t_pFiffDirEntry->kind = kind;
+        t_pFiffDirEntry->type = type;
+        t_pFiffDirEntry->size = size;
         t_pFiffDirEntry->pos = (fiff_long_t)pos;
 
-        //qDebug() << "Kind: " << t_pTag->kind << "| Type:" << t_pTag->type << "| Size" << t_pTag->size() << "| Next:" << t_pTag->next;
-
         dir.append(t_pFiffDirEntry);
-        if (t_pTag->next < 0)
+        if (next < 0)
             break;
     }
     /*
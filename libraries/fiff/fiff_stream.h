@@ -427,6 +427,21 @@ public:
     bool read_tag(QSharedPointer<FiffTag>& p_pTag,
                   fiff_long_t pos = -1);
 
+    //=========================================================================================================
+    /**
+     * Read one tag from a fif file into an existing tag.
+     * if pos is not provided, reading starts from the current file position
+     * The storage of the tag is reused if it is large enough and not shared, which avoids an allocation per tag
+     * when many tags, e.g. raw data buffers, are read one after another.
+     *
+     * @param[out] p_Tag the read tag.
+     * @param[in] pos position of the tag inside the fif file.
+     *
+     * @return true if succeeded, false otherwise.
+     */
+    bool read_tag(FiffTag& p_Tag,
+                  fiff_long_t pos = -1);
+
     //=========================================================================================================
     /**
      * fiff_setup_read_raw
@@ -503,9 +518,12 @@ public:
      *
      * @param[in] p_IODevice     A fiff IO device like a fiff QFile or QTCPSocket.
      * @param[in] info           The measurement info block of the source file.
-     * @param[out] cals          A copy of the calibration values.
+     * @param[out] cals          A copy of the calibration values, including the channel ranges.
      * @param[in] sel            Which channels will be included in the output file (optional).
      * @param[in] bResetRange    Flag whether to reset the channel range to 1.0. Default is true.
+     * @param[in] data_type      The data type of the raw data buffers: FIFFT_FLOAT (default), FIFFT_INT, FIFFT_SHORT or
+     *                           FIFFT_DAU_PACK16. For the integer types the range should not be reset, so that the
+     *                           buffers keep the resolution of the acquisition.
      *
      * @return the started fiff file.
      */
@@ -513,7 +531,8 @@ public:
                                               const FiffInfo& info,
                                               Eigen::RowVectorXd& cals,
                                               Eigen::MatrixXi sel = defaultMatrixXi,
-                                              bool bResetRange = true);
+                                              bool bResetRange = true,
+                                              fiff_int_t data_type = FIFFT_FLOAT);
 
     //=========================================================================================================
     /**
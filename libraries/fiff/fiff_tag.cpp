@@ -316,28 +316,34 @@ void FiffTag::convert_ch_pos(FiffChPos* pos)
 //=============================================================================================================
 
 void FiffTag::convert_matrix_from_file_data(FiffTag::SPtr tag)
+{
+    if (tag)
+        convert_matrix_from_file_data(*tag);
+}
+
+//=============================================================================================================
+
+void FiffTag::convert_matrix_from_file_data(FiffTag& tag)
 /*
  * Assumes that the input is in the non-native byte order and needs to be swapped to the other one
  */
 {
     int ndim;
     int k;
-    int *dimp,*data,kind,np,nz;
-    float *fdata;
-    double *ddata;
-    unsigned int tsize = tag->size();
+    int *dimp,kind,np,nz;
+    unsigned int tsize = tag.size();
 
-    if (fiff_type_fundamental(tag->type) != FIFFTS_FS_MATRIX)
+    if (fiff_type_fundamental(tag.type) != FIFFTS_FS_MATRIX)
         return;
-    if (tag->data() == NULL)
+    if (tag.data() == NULL)
         return;
     if (tsize < sizeof(fiff_int_t))
         return;
 
-    dimp = ((fiff_int_t *)((tag->data())+tag->size()-sizeof(fiff_int_t)));
+    dimp = ((fiff_int_t *)((tag.data())+tag.size()-sizeof(fiff_int_t)));
     IOUtils::swap_intp(dimp);
     ndim = *dimp;
-    if (fiff_type_matrix_coding(tag->type) == FIFFTS_MC_DENSE) {
+    if (fiff_type_matrix_coding(tag.type) == FIFFTS_MC_DENSE) {
         if (tsize < (ndim+1)*sizeof(fiff_int_t))
             return;
         dimp = dimp - ndim;
@@ -352,67 +358,65 @@ void FiffTag::convert_matrix_from_file_data(FiffTag::SPtr tag)
         if (ndim > 2)       /* Not quite sure what to do */
             return;
         dimp = dimp - ndim - 1;
-        for (k = 0; k < ndim+1; k++)
-            IOUtils::swap_intp(dimp+k);
+        IOUtils::swap_array(dimp, ndim+1);
         nz = dimp[0];
-        if (fiff_type_matrix_coding(tag->type) == FIFFTS_MC_CCS)
+        if (fiff_type_matrix_coding(tag.type) == FIFFTS_MC_CCS)
             np = nz + dimp[2] + 1; /* nz + n + 1 */
-        else if (fiff_type_matrix_coding(tag->type) == FIFFTS_MC_RCS)
+        else if (fiff_type_matrix_coding(tag.type) == FIFFTS_MC_RCS)
             np = nz + dimp[1] + 1; /* nz + m + 1 */
         else
             return;     /* Don't know what to do */
         /*
          * Take care of the indices
         */
-        for (data = (int *)(tag->data())+nz, k = 0; k < np; k++)
-            IOUtils::swap_intp(data+k);
+        IOUtils::swap_array((int *)(tag.data())+nz, np);
         np = nz;
     }
     /*
      * Now convert data...
      */
-    kind = fiff_type_base(tag->type);
-    if (kind == FIFFT_INT) {
-        for (data = (int *)(tag->data()), k = 0; k < np; k++)
-            IOUtils::swap_intp(data+k);
-    }
-    else if (kind == FIFFT_FLOAT) {
-        for (fdata = (float *)(tag->data()), k = 0; k < np; k++)
-            IOUtils::swap_floatp(fdata+k);
-    }
-    else if (kind == FIFFT_DOUBLE) {
-        for (ddata = (double *)(tag->data()), k = 0; k < np; k++)
-            IOUtils::swap_doublep(ddata+k);
-    }
+    kind = fiff_type_base(tag.type);
+    if (kind == FIFFT_INT)
+        IOUtils::swap_array((int *)(tag.data()), np);
+    else if (kind == FIFFT_FLOAT)
+        IOUtils::swap_array((float *)(tag.data()), np);
+    else if (kind == FIFFT_DOUBLE)
+        IOUtils::swap_array((double *)(tag.data()), np);
     return;
 }
 
 //=============================================================================================================
 
 void FiffTag::convert_matrix_to_file_data(FiffTag::SPtr tag)
+{
+    if (tag)
+        convert_matrix_to_file_data(*tag);
+}
+
+//=============================================================================================================
+
+void FiffTag::convert_matrix_to_file_data(FiffTag& tag)
 /*
  * Assumes that the input is in the NATIVE_ENDIAN byte order and needs to be swapped to the other one
  */
 {
     int ndim;
     int k;
-    int *dimp,*data,kind,np;
-    float *fdata;
-    double *ddata;
-    unsigned int tsize = tag->size();
+    int *dimp,kind,np;
+    unsigned int tsize = tag.size();
 
-    if (fiff_type_fundamental(tag->type) != FIFFTS_FS_MATRIX)
+    if (fiff_type_fundamental(tag.type) != FIFFTS_FS_MATRIX)
         return;
-    if (tag->data() == NULL)
+    if (tag.data() == NULL)
         return;
     if (tsize < sizeof(fiff_int_t))
         return;
 
-    dimp = ((fiff_int_t *)(((char *)tag->data())+tag->size()-sizeof(fiff_int_t)));
+    dimp = ((fiff_int_t *)(((char *)tag.data())+tag.size()-sizeof(fiff_int_t)));
     ndim = *dimp;
     IOUtils::swap_intp(dimp);
 
-    if (fiff_type_matrix_coding(tag->type) == FIFFTS_MC_DENSE) {
+    if (fiff_type_matrix_coding(tag.type) == FIFFTS_MC_DENSE) {
         if (tsize < (ndim+1)*sizeof(fiff_int_t))
             return;
         dimp = dimp - ndim;
@@ -427,54 +431,49 @@ void FiffTag::convert_matrix_to_file_data(FiffTag::SPtr tag)
         if (ndim > 2)		/* Not quite sure what to do */
             return;
         dimp = dimp - ndim - 1;
-        if (fiff_type_matrix_coding(tag->type) == FIFFTS_MC_CCS)
+        if (fiff_type_matrix_coding(tag.type) == FIFFTS_MC_CCS)
             np = dimp[0] + dimp[2] + 1; /* nz + n + 1 */
-        else if (fiff_type_matrix_coding(tag->type) == FIFFTS_MC_RCS)
+        else if (fiff_type_matrix_coding(tag.type) == FIFFTS_MC_RCS)
             np = dimp[0] + dimp[1] + 1; /* nz + m + 1 */
         else
             return;			/* Don't know what to do */
-        for (k = 0; k < ndim+1; k++)
-            IOUtils::swap_intp(dimp+k);
+        IOUtils::swap_array(dimp, ndim+1);
     }
     /*
      * Now convert data...
      */
-    kind = fiff_type_base(tag->type);
-    if (kind == FIFFT_INT) {
-        for (data = (int *)(tag->data()), k = 0; k < np; k++)
-            IOUtils::swap_intp(data+k);
-    }
-    else if (kind == FIFFT_FLOAT) {
-        for (fdata = (float *)(tag->data()), k = 0; k < np; k++)
-            IOUtils::swap_floatp(fdata+k);
-    }
-    else if (kind == FIFFT_DOUBLE) {
-        for (ddata = (double *)(tag->data()), k = 0; k < np; k++)
-            IOUtils::swap_doublep(ddata+k);
-    }
-    else if (kind == FIFFT_COMPLEX_FLOAT) {
-        for (fdata = (float *)(tag->data()), k = 0; k < 2*np; k++)
-            IOUtils::swap_floatp(fdata+k);
-    }
-    else if (kind == FIFFT_COMPLEX_DOUBLE) {
-        for (ddata = (double *)(tag->data()), k = 0; k < 2*np; k++)
-            IOUtils::swap_doublep(ddata+k);
-    }
+    kind = fiff_type_base(tag.type);
+    if (kind == FIFFT_INT)
+        IOUtils::swap_array((int *)(tag.data()), np);
+    else if (kind == FIFFT_FLOAT)
+        IOUtils::swap_array((float *)(tag.data()), np);
+    else if (kind == FIFFT_DOUBLE)
+        IOUtils::swap_array((double *)(tag.data()), np);
+    else if (kind == FIFFT_COMPLEX_FLOAT)
+        IOUtils::swap_array((float *)(tag.data()), 2*np);
+    else if (kind == FIFFT_COMPLEX_DOUBLE)
+        IOUtils::swap_array((double *)(tag.data()), 2*np);
     return;
 }
 
 //=============================================================================================================
 //ToDo remove this function by swapping -> define little endian big endian, QByteArray
 void FiffTag::convert_tag_data(FiffTag::SPtr tag, int from_endian, int to_endian)
+{
+    if (tag)
+        convert_tag_data(*tag, from_endian, to_endian);
+}
+
+//=============================================================================================================
+
+void FiffTag::convert_tag_data(FiffTag& tag, int from_endian, int to_endian)
 {
     int            np;
-    int            k,r;//,c;
+    int            k;//,r,c;
     char           *offset;
     fiff_int_t     *ithis;
     fiff_short_t   *sthis;
-    fiff_long_t    *lthis;
     float          *fthis;
-    double         *dthis;
 //    fiffDirEntry   dethis;
 //    fiffId         idthis;
 //    fiffChInfoRec* chthis;//FiffChInfo*     chthis;//ToDo adapt parsing to the new class
@@ -483,7 +482,7 @@ void FiffTag::convert_tag_data(FiffTag::SPtr tag, int from_endian, int to_endian
 //    fiffDigPoint   dpthis;
     fiffDataRef    drthis;
 
-    if (tag->data() == NULL || tag->size() == 0)
+    if (tag.data() == NULL || tag.size() == 0)
         return;
 
     if (from_endian == FIFFV_NATIVE_ENDIAN)
@@ -494,7 +493,7 @@ void FiffTag::convert_tag_data(FiffTag::SPtr tag, int from_endian, int to_endian
     if (from_endian == to_endian)
         return;
 
-    if (fiff_type_fundamental(tag->type) == FIFFTS_FS_MATRIX) {
+    if (fiff_type_fundamental(tag.type) == FIFFTS_FS_MATRIX) {
         if (from_endian == NATIVE_ENDIAN)
             convert_matrix_to_file_data(tag);
         else
@@ -502,56 +501,50 @@ void FiffTag::convert_tag_data(FiffTag::SPtr tag, int from_endian, int to_endian
         return;
     }
 
-    switch (tag->type) {
+    switch (tag.type) {
 
     case FIFFT_INT :
     case FIFFT_UINT :
     case FIFFT_JULIAN :
-        np = tag->size()/sizeof(fiff_int_t);
-        for (ithis = (fiff_int_t *)tag->data(), k = 0; k < np; k++, ithis++)
-            IOUtils::swap_intp(ithis);
+        np = tag.size()/sizeof(fiff_int_t);
+        IOUtils::swap_array((fiff_int_t *)tag.data(), np);
         break;
 
     case FIFFT_LONG :
     case FIFFT_ULONG :
-        np = tag->size()/sizeof(fiff_long_t);
-        for (lthis = (fiff_long_t *)tag->data(), k = 0; k < np; k++, lthis++)
-            IOUtils::swap_longp(lthis);
+        np = tag.size()/sizeof(fiff_long_t);
+        IOUtils::swap_array((fiff_long_t *)tag.data(), np);
         break;
 
     case FIFFT_SHORT :
     case FIFFT_DAU_PACK16 :
     case FIFFT_USHORT :
-        np = tag->size()/sizeof(fiff_short_t);
-        for (sthis = (fiff_short_t *)tag->data(), k = 0; k < np; k++, sthis++)
-            *sthis = IOUtils::swap_short(*sthis);
+        np = tag.size()/sizeof(fiff_short_t);
+        IOUtils::swap_array((fiff_short_t *)tag.data(), np);
         break;
 
     case FIFFT_FLOAT :
     case FIFFT_COMPLEX_FLOAT :
-        np = tag->size()/sizeof(fiff_float_t);
-        for (fthis = (fiff_float_t *)tag->data(), k = 0; k < np; k++, fthis++)
-            IOUtils::swap_floatp(fthis);
+        np = tag.size()/sizeof(fiff_float_t);
+        IOUtils::swap_array((fiff_float_t *)tag.data(), np);
         break;
 
     case FIFFT_DOUBLE :
     case FIFFT_COMPLEX_DOUBLE :
-        np = tag->size()/sizeof(fiff_double_t);
-        for (dthis = (fiff_double_t *)tag->data(), k = 0; k < np; k++, dthis++)
-            IOUtils::swap_doublep(dthis);
+        np = tag.size()/sizeof(fiff_double_t);
+        IOUtils::swap_array((fiff_double_t *)tag.data(), np);
         break;
 
     case FIFFT_OLD_PACK :
-        fthis = (float *)tag->data();
+        fthis = (float *)tag.data();
     /*
      * Offset and scale...
      */
         IOUtils::swap_floatp(fthis+0);
         IOUtils::swap_floatp(fthis+1);
         sthis = (short *)(fthis+2);
-        np = (tag->size() - 2*sizeof(float))/sizeof(short);
-        for (k = 0; k < np; k++,sthis++)
-            *sthis = IOUtils::swap_short(*sthis);
+        np = (tag.size() - 2*sizeof(float))/sizeof(short);
+        IOUtils::swap_array(sthis, np);
         break;
 
     case FIFFT_DIR_ENTRY_STRUCT :
@@ -562,15 +555,11 @@ void FiffTag::convert_tag_data(FiffTag::SPtr tag, int from_endian, int to_endian
 //            dethis->size = swap_int(dethis->size);
 //            dethis->pos  = swap_int(dethis->pos);
 //        }
-        np = tag->size()/FiffDirEntry::storageSize();
-        for (k = 0; k < np; k++) {
-            offset = (char*)tag->data() + k*FiffDirEntry::storageSize();
-            ithis = (fiff_int_t*) offset;
-            ithis[0] = IOUtils::swap_int(ithis[0]);//kind
-            ithis[1] = IOUtils::swap_int(ithis[1]);//type
-            ithis[2] = IOUtils::swap_int(ithis[2]);//size
-            ithis[3] = IOUtils::swap_int(ithis[3]);//pos
-        }
+        //
+        // kind, type, size and pos are all 32 bit words, swap the whole directory at once
+        //
+        np = tag.size()/FiffDirEntry::storageSize();
+        IOUtils::swap_array((fiff_int_t*)tag.data(), np*FiffDirEntry::storageSize()/sizeof(fiff_int_t));
         break;
 
     case FIFFT_ID_STRUCT :
@@ -582,16 +571,11 @@ void FiffTag::convert_tag_data(FiffTag::SPtr tag, int from_endian, int to_endian
 //            idthis->time.secs  = swap_int(idthis->time.secs);
 //            idthis->time.usecs = swap_int(idthis->time.usecs);
 //        }
-        np = tag->size()/FiffId::storageSize();
-        for (k = 0; k < np; k++) {
-            offset = (char*)tag->data() + k*FiffId::storageSize();
-            ithis = (fiff_int_t*) offset;
-            ithis[0] = IOUtils::swap_int(ithis[0]);//version
-            ithis[1] = IOUtils::swap_int(ithis[1]);//machid[0]
-            ithis[2] = IOUtils::swap_int(ithis[2]);//machid[1]
-            ithis[3] = IOUtils::swap_int(ithis[3]);//time.secs
-            ithis[4] = IOUtils::swap_int(ithis[4]);//time.usecs
-        }
+        //
+        // version, machid[0], machid[1], time.secs and time.usecs
+        //
+        np = tag.size()/FiffId::storageSize();
+        IOUtils::swap_array((fiff_int_t*)tag.data(), np*FiffId::storageSize()/sizeof(fiff_int_t));
         break;
 
     case FIFFT_CH_INFO_STRUCT :
@@ -607,22 +591,15 @@ void FiffTag::convert_tag_data(FiffTag::SPtr tag, int from_endian, int to_endian
 //            convert_ch_pos(&(chthis->chpos));
 //        }
 
-        np = tag->size()/FiffChInfo::storageSize();
+        np = tag.size()/FiffChInfo::storageSize();
         for (k = 0; k < np; k++) {
-            offset = (char*)tag->data() + k*FiffChInfo::storageSize();
+            offset = (char*)tag.data() + k*FiffChInfo::storageSize();
             ithis = (fiff_int_t*) offset;
-            fthis = (float*) offset;
-
-            ithis[0] = IOUtils::swap_int(ithis[0]);  //scanno
-            ithis[1] = IOUtils::swap_int(ithis[1]);  //logno
-            ithis[2] = IOUtils::swap_int(ithis[2]);  //kind
-            IOUtils::swap_floatp(&fthis[3]);         //range
-            IOUtils::swap_floatp(&fthis[4]);         //cal
-            ithis[5] = IOUtils::swap_int(ithis[5]);  //coil_type
-            for (r = 0; r < 12; ++r)
-                IOUtils::swap_floatp(&fthis[6+r]);   //loc
-            ithis[18] = IOUtils::swap_int(ithis[18]);//unit
-            ithis[19] = IOUtils::swap_int(ithis[19]);//unit_mul
+
+            //
+            // scanno, logno, kind, range, cal, coil_type, loc[12], unit and unit_mul. The name is not swapped.
+            //
+            IOUtils::swap_array(ithis, 20);
         }
 
         break;
@@ -632,18 +609,11 @@ void FiffTag::convert_tag_data(FiffTag::SPtr tag, int from_endian, int to_endian
 //        for (cpthis = (fiffChPos)tag->data->data(), k = 0; k < np; k++, cpthis++)
 //            convert_ch_pos(cpthis);
 
-        np = tag->size()/FiffChPos::storageSize();
-        for (k = 0; k < np; ++k)
-        {
-            offset = (char*)tag->data() + k*FiffChPos::storageSize();
-            ithis = (fiff_int_t*) offset;
-            fthis = (float*) offset;
-
-            ithis[0] = IOUtils::swap_int(ithis[0]);    //coil_type
-            for (r = 0; r < 12; r++)
-                IOUtils::swap_floatp(&fthis[1+r]);    //r0, ex, ey, ez
-        }
-
+        //
+        // coil_type followed by r0, ex, ey and ez
+        //
+        np = tag.size()/FiffChPos::storageSize();
+        IOUtils::swap_array((fiff_int_t*)tag.data(), np*FiffChPos::storageSize()/sizeof(fiff_int_t));
         break;
 
     case FIFFT_DIG_POINT_STRUCT :
@@ -655,19 +625,11 @@ void FiffTag::convert_tag_data(FiffTag::SPtr tag, int from_endian, int to_endian
 //                swap_floatp(&dpthis->r[r]);
 //        }
 
-        np = tag->size()/FiffDigPoint::storageSize();
-
-        for (k = 0; k < np; k++) {
-            offset = tag->data() + k*FiffDigPoint::storageSize();
-            ithis = (fiff_int_t*) offset;
-            fthis = (float*) offset;
-
-            ithis[0] = IOUtils::swap_int(ithis[0]);//kind
-            ithis[1] = IOUtils::swap_int(ithis[1]);//ident
-
-            for (r = 0; r < 3; ++r)
-                IOUtils::swap_floatp(&fthis[2+r]);        //r
-        }
+        //
+        // kind, ident and r
+        //
+        np = tag.size()/FiffDigPoint::storageSize();
+        IOUtils::swap_array((fiff_int_t*)tag.data(), np*FiffDigPoint::storageSize()/sizeof(fiff_int_t));
         break;
 
     case FIFFT_COORD_TRANS_STRUCT :
@@ -685,25 +647,16 @@ void FiffTag::convert_tag_data(FiffTag::SPtr tag, int from_endian, int to_endian
 //        }
 //    }
 
-        np = tag->size()/FiffCoordTrans::storageSize();
-
-        for( k = 0; k < np; ++k)
-        {
-            offset = tag->data() + k*FiffCoordTrans::storageSize();
-            ithis = (fiff_int_t*)offset;
-            fthis = (float*)offset;
-
-            ithis[0] = IOUtils::swap_int(ithis[0]);
-            ithis[1] = IOUtils::swap_int(ithis[1]);
-
-            for (r = 0; r < 24; ++r)
-                IOUtils::swap_floatp(&fthis[2+r]);
-        }
+        //
+        // from, to and the 24 floats of rot, move, invrot and invmove
+        //
+        np = tag.size()/FiffCoordTrans::storageSize();
+        IOUtils::swap_array((fiff_int_t*)tag.data(), np*FiffCoordTrans::storageSize()/sizeof(fiff_int_t));
         break;
 
     case FIFFT_DATA_REF_STRUCT :
-        np = tag->size()/sizeof(fiffDataRefRec);
-        for (drthis = (fiffDataRef)tag->data(), k = 0; k < np; k++, drthis++) {
+        np = tag.size()/sizeof(fiffDataRefRec);
+        for (drthis = (fiffDataRef)tag.data(), k = 0; k < np; k++, drthis++) {
             drthis->type   = IOUtils::swap_int(drthis->type);
             drthis->endian = IOUtils::swap_int(drthis->endian);
             drthis->size   = IOUtils::swap_long(drthis->size);
@@ -394,6 +394,28 @@ public:
      */
     inline Eigen::MatrixXf toFloatMatrix() const;
 
+    //=========================================================================================================
+    /**
+     * to fiff FIFFT INT MATRIX without copying
+     *
+     * Returns a view on the dense integer matrix stored in the tag. The view is valid as long as the tag exists and
+     * its data is not modified. Use it instead of toIntMatrix when the matrix is converted or transposed anyway.
+     *
+     * @return View on the integer matrix, empty if the tag is no dense two-dimensional integer matrix.
+     */
+    inline Eigen::Map<const Eigen::MatrixXi> toIntMatrixView() const;
+
+    //=========================================================================================================
+    /**
+     * to fiff FIFFT FLOAT MATRIX without copying
+     *
+     * Returns a view on the dense float matrix stored in the tag. The view is valid as long as the tag exists and
+     * its data is not modified. Use it instead of toFloatMatrix when the matrix is converted or transposed anyway.
+     *
+     * @return View on the float matrix, empty if the tag is no dense two-dimensional float matrix.
+     */
+    inline Eigen::Map<const Eigen::MatrixXf> toFloatMatrixView() const;
+
     //=========================================================================================================
     /**
      * to sparse fiff FIFFT FLOAT MATRIX
@@ -441,6 +463,14 @@ public:
      */
     static void convert_matrix_from_file_data(FiffTag::SPtr tag);
 
+    //=========================================================================================================
+    /**
+     * Convert matrix data read from a file inside a fiff tag
+     *
+     * @param[in, out] tag    matrix data to convert.
+     */
+    static void convert_matrix_from_file_data(FiffTag& tag);
+
     //=========================================================================================================
     /**
      * Convert matrix data before writing to a file inside a fiff tag
@@ -449,6 +479,14 @@ public:
      */
     static void convert_matrix_to_file_data(FiffTag::SPtr tag);
 
+    //=========================================================================================================
+    /**
+     * Convert matrix data before writing to a file inside a fiff tag
+     *
+     * @param[in, out] tag    matrix data to convert.
+     */
+    static void convert_matrix_to_file_data(FiffTag& tag);
+
     //
     // Data type conversions for the little endian systems.
     //
@@ -468,6 +506,17 @@ public:
      */
     static void convert_tag_data(FiffTag::SPtr tag, int from_endian, int to_endian);
 
+    //=========================================================================================================
+    /**
+     * Machine dependent data type conversions (tag info only). Arrays of one fundamental type, directories and
+     * most structures are swapped in bulk.
+     *
+     * @param[in, out] tag       matrix data to convert.
+     * @param[in] from_endian    from endian encoding.
+     * @param[in] to_endian      to endian encoding.
+     */
+    static void convert_tag_data(FiffTag& tag, int from_endian, int to_endian);
+
     //
     // from fiff_type_spec.c
     //
@@ -892,9 +941,25 @@ inline QList< QSharedPointer<FiffDirEntry> > FiffTag::toDirEntry() const
 //=============================================================================================================
 
 inline Eigen::MatrixXi FiffTag::toIntMatrix() const
+{
+    // --> Use copy constructor instead --> slower performance but higher memory management reliability
+    return Eigen::MatrixXi(toIntMatrixView());
+}
+
+//=============================================================================================================
+
+inline Eigen::MatrixXf FiffTag::toFloatMatrix() const
+{
+    // --> Use copy constructor instead --> slower performance but higher memory management reliability
+    return Eigen::MatrixXf(toFloatMatrixView());
+}
+
+//=============================================================================================================
+
+inline Eigen::Map<const Eigen::MatrixXi> FiffTag::toIntMatrixView() const
 {
     if(!this->isMatrix() || this->getType() != FIFFT_INT || this->data() == NULL)
-        return Eigen::MatrixXi();
+        return Eigen::Map<const Eigen::MatrixXi>(NULL, 0, 0);
 
     qint32 ndim;
     QVector<qint32> dims;
@@ -903,27 +968,23 @@ inline Eigen::MatrixXi FiffTag::toIntMatrix() const
     if (ndim != 2)
     {
         printf("Only two-dimensional matrices are supported at this time");
-        return Eigen::MatrixXi();
+        return Eigen::Map<const Eigen::MatrixXi>(NULL, 0, 0);
     }
 
-    //MatrixXd p_Matrix = Map<MatrixXd>( (float*)this->data,p_dims[0], p_dims[1]);
-    // --> Use copy constructor instead --> slower performance but higher memory management reliability
-    Eigen::MatrixXi p_Matrix(Eigen::Map<Eigen::MatrixXi>( (int*)this->data(),dims[0], dims[1]));
-
-    return p_Matrix;
+    return Eigen::Map<const Eigen::MatrixXi>((const int*)this->constData(), dims[0], dims[1]);
 }
 
 //=============================================================================================================
 
-inline Eigen::MatrixXf FiffTag::toFloatMatrix() const
+inline Eigen::Map<const Eigen::MatrixXf> FiffTag::toFloatMatrixView() const
 {
     if(!this->isMatrix() || this->getType() != FIFFT_FLOAT || this->data() == NULL)
-        return Eigen::MatrixXf();//NULL;
+        return Eigen::Map<const Eigen::MatrixXf>(NULL, 0, 0);
 
     if (fiff_type_matrix_coding(this->type) != FIFFTS_MC_DENSE)
     {
         printf("Error in FiffTag::toFloatMatrix(): Matrix is not dense!\n");
-        return Eigen::MatrixXf();//NULL;
+        return Eigen::Map<const Eigen::MatrixXf>(NULL, 0, 0);
     }
 
     qint32 ndim;
@@ -933,13 +994,10 @@ inline Eigen::MatrixXf FiffTag::toFloatMatrix() const
     if (ndim != 2)
     {
         printf("Only two-dimensional matrices are supported at this time");
-        return Eigen::MatrixXf();//NULL;
+        return Eigen::Map<const Eigen::MatrixXf>(NULL, 0, 0);
     }
 
-    // --> Use copy constructor instead --> slower performance but higher memory management reliability
-    Eigen::MatrixXf p_Matrix((Eigen::Map<Eigen::MatrixXf>( (float*)this->data(),dims[0], dims[1])));
-
-    return p_Matrix;
+    return Eigen::Map<const Eigen::MatrixXf>((const float*)this->constData(), dims[0], dims[1]);
 }
 
 //=============================================================================================================
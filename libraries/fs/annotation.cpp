@@ -42,6 +42,8 @@
 #include "label.h"
 #include "surface.h"
 
+#include <utils/ioutils.h>
+
 #include <iostream>
 
 //=============================================================================================================
@@ -57,6 +59,7 @@
 // USED NAMESPACES
 //=============================================================================================================
 
+using namespace UTILSLIB;
 using namespace FSLIB;
 using namespace Eigen;
 
@@ -166,14 +169,18 @@ bool Annotation::read(const QString& p_sFileName, Annotation &p_Annotation)
     qint32 numEl;
     t_Stream >> numEl;
 
-    p_Annotation.m_Vertices = VectorXi(numEl);
-    p_Annotation.m_LabelIds = VectorXi(numEl);
-
-    for(qint32 i = 0; i < numEl; ++i)
+    //Vertices and label ids are stored in pairs, read them at once
+    Matrix<qint32,Dynamic,2,RowMajor> matVertLabel(numEl, 2);
+    const int iNumBytes = numEl*2*sizeof(qint32);
+    if(t_Stream.readRawData((char *)matVertLabel.data(), iNumBytes) != iNumBytes)
     {
-        t_Stream >> p_Annotation.m_Vertices[i];
-        t_Stream >> p_Annotation.m_LabelIds[i];
+        printf("\tError: Unexpected end of the vertices in the annotation file\n");
+        return false;
     }
+    IOUtils::swap_array(matVertLabel.data(), qint64(numEl)*2);
+
+    p_Annotation.m_Vertices = matVertLabel.col(0);
+    p_Annotation.m_LabelIds = matVertLabel.col(1);
 
     qint32 hasColortable;
     t_Stream >> hasColortable;
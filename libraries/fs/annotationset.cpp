@@ -43,6 +43,8 @@
 
 #include <QFile>
 #include <QDebug>
+#include <QtConcurrent>
+#include <QFuture>
 
 //=============================================================================================================
 // USED NAMESPACES
@@ -71,10 +73,16 @@ AnnotationSet::AnnotationSet(const QString &subject_id, qint32 hemi, const QStri
     }
     else if(hemi == 2)
     {
+        //Read the right hemisphere concurrently
+        Annotation t_AnnotationRH;
+        QFuture<bool> futureRH = QtConcurrent::run([&]() {
+            return Annotation::read(subject_id, 1, atlas, subjects_dir, t_AnnotationRH);
+        });
+
         if(Annotation::read(subject_id, 0, atlas, subjects_dir, t_Annotation))
             insert(t_Annotation);
-        if(Annotation::read(subject_id, 1, atlas, subjects_dir, t_Annotation))
-            insert(t_Annotation);
+        if(futureRH.result())
+            insert(t_AnnotationRH);
     }
 }
 
@@ -90,10 +98,16 @@ AnnotationSet::AnnotationSet(const QString &path, qint32 hemi, const QString &at
     }
     else if(hemi == 2)
     {
+        //Read the right hemisphere concurrently
+        Annotation t_AnnotationRH;
+        QFuture<bool> futureRH = QtConcurrent::run([&]() {
+            return Annotation::read(path, 1, atlas, t_AnnotationRH);
+        });
+
         if(Annotation::read(path, 0, atlas, t_Annotation))
             insert(t_Annotation);
-        if(Annotation::read(path, 1, atlas, t_Annotation))
-            insert(t_Annotation);
+        if(futureRH.result())
+            insert(t_AnnotationRH);
     }
 }
 
@@ -150,10 +164,19 @@ bool AnnotationSet::read(const QString& p_sLHFileName, const QString& p_sRHFileN
     QStringList t_qListFileName;
     t_qListFileName << p_sLHFileName << p_sRHFileName;
 
+    //Read both hemispheres concurrently
+    Annotation t_Annotations[2];
+    bool t_bRead[2];
+    QFuture<void> futureRH = QtConcurrent::run([&]() {
+        t_bRead[1] = Annotation::read(t_qListFileName.at(1), t_Annotations[1]);
+    });
+    t_bRead[0] = Annotation::read(t_qListFileName.at(0), t_Annotations[0]);
+    futureRH.waitForFinished();
+
     for(qint32 i = 0; i < t_qListFileName.size(); ++i)
     {
-        Annotation t_Annotation;
-        if(Annotation::read(t_qListFileName[i], t_Annotation))
+        const Annotation& t_Annotation = t_Annotations[i];
+        if(t_bRead[i])
         {
             if(t_qListFileName[i].contains("lh."))
                 p_AnnotationSet.m_qMapAnnots.insert(0, t_Annotation);
@@ -40,6 +40,7 @@ TEMPLATE = lib
 
 CONFIG += skip_target_version_ext
 
+QT += concurrent
 QT -= gui
 
 DEFINES += FS_LIBRARY
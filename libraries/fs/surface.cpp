@@ -51,6 +51,12 @@
 #include <QDataStream>
 #include <QTextStream>
 
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Geometry>
+
 //=============================================================================================================
 // USED NAMESPACES
 //=============================================================================================================
@@ -133,44 +139,33 @@ void Surface::clear()
 MatrixX3f Surface::compute_normals(const MatrixX3f& rr, const MatrixX3i& tris)
 {
     printf("\tcomputing normals\n");
-    // first, compute triangle normals
-    MatrixX3f r1(tris.rows(),3); MatrixX3f r2(tris.rows(),3); MatrixX3f r3(tris.rows(),3);
-
-    for(qint32 i = 0; i < tris.rows(); ++i)
-    {
-        r1.row(i) = rr.row(tris(i, 0));
-        r2.row(i) = rr.row(tris(i, 1));
-        r3.row(i) = rr.row(tris(i, 2));
-    }
 
-    MatrixX3f x = r2 - r1;
-    MatrixX3f y = r3 - r1;
-    MatrixX3f tri_nn(x.rows(),y.cols());
-    tri_nn.col(0) = x.col(1).cwiseProduct(y.col(2)) - x.col(2).cwiseProduct(y.col(1));
-    tri_nn.col(1) = x.col(2).cwiseProduct(y.col(0)) - x.col(0).cwiseProduct(y.col(2));
-    tri_nn.col(2) = x.col(0).cwiseProduct(y.col(1)) - x.col(1).cwiseProduct(y.col(0));
+    // Row major copies keep the coordinates of a vertex and the vertices of a triangle next to each other
+    typedef Matrix<float,Dynamic,3,RowMajor> MatrixX3fR;
+    typedef Matrix<int,Dynamic,3,RowMajor> MatrixX3iR;
 
-    //   Triangle normals and areas
-    MatrixX3f tmp = tri_nn.cwiseProduct(tri_nn);
-    VectorXf normSize = tmp.rowwise().sum();
-    normSize = normSize.cwiseSqrt();
+    const MatrixX3fR matRR = rr;
+    const MatrixX3iR matTris = tris;
+    MatrixX3fR nn = MatrixX3fR::Zero(rr.rows(), 3);
 
-    for(qint32 i = 0; i < normSize.size(); ++i)
-        if(normSize(i) != 0)
-            tri_nn.row(i) /= normSize(i);
+    // Triangle normals of unit length, summed up at their vertices
+    for(qint32 p = 0; p < matTris.rows(); ++p)
+    {
+        const Vector3f r1 = matRR.row(matTris(p, 0));
+        const Vector3f x = matRR.row(matTris(p, 1)).transpose() - r1;
+        const Vector3f y = matRR.row(matTris(p, 2)).transpose() - r1;
 
-    MatrixX3f nn = MatrixX3f::Zero(rr.rows(), 3);
+        Vector3f tri_nn = x.cross(y);
+        float size = tri_nn.norm();
+        if(size != 0)
+            tri_nn /= size;
 
-    for(qint32 p = 0; p < tris.rows(); ++p)
-    {
-        Vector3i verts = tris.row(p);
-        for(qint32 j = 0; j < verts.size(); ++j)
-            nn.row(verts(j)) = tri_nn.row(p);
+        for(qint32 j = 0; j < 3; ++j)
+            nn.row(matTris(p, j)) += tri_nn.transpose();
     }
 
-    tmp = nn.cwiseProduct(nn);
-    normSize = tmp.rowwise().sum();
-    normSize = normSize.cwiseSqrt();
+    // Vertex normals of unit length
+    VectorXf normSize = nn.rowwise().norm();
 
     for(qint32 i = 0; i < normSize.size(); ++i)
         if(normSize(i) != 0)
@@ -261,41 +256,34 @@ bool Surface::read(const QString &p_sFile, Surface &p_Surface, bool p_bLoadCurva
         else
             printf("\t%s is a new quad file (nvert = %d nquad = %d)\n", p_sFile.toUtf8().constData(),nvert,nquad);
 
-        //vertices
-        verts.resize(nvert, 3);
+        //vertices, stored as x y z per vertex, i.e. one column per vertex
+        verts.resize(3, nvert);
         if(magic == QUAD_FILE_MAGIC_NUMBER)
         {
-            qint16 iVal;
-            for(qint32 i = 0; i < nvert; ++i)
+            Matrix<qint16,Dynamic,1> iVals(3*nvert);
+            const int iNumBytes = nvert*3*sizeof(qint16);
+            if(t_DataStream.readRawData((char *)iVals.data(), iNumBytes) != iNumBytes)
             {
-                for(qint32 j = 0; j < 3; ++j)
-                {
-                    t_DataStream >> iVal;
-                    IOUtils::swap_short(iVal);
-                    verts(i,j) = ((float)iVal) / 100;
-                }
+                qWarning("Unexpected end of the vertices in surface file %s",p_sFile.toUtf8().constData());
+                return false;
             }
+            IOUtils::swap_array(iVals.data(), qint64(nvert)*3);
+            verts = Map<Matrix<qint16,Dynamic,Dynamic> >(iVals.data(), 3, nvert).cast<float>() / 100;
         }
         else
         {
-            t_DataStream.readRawData((char *)verts.data(), nvert*3*sizeof(float));
-            for(qint32 i = 0; i < nvert; ++i)
-                for(qint32 j = 0; j < 3; ++j)
-                    IOUtils::swap_floatp(&verts(i,j));
-        }
-
-        MatrixXi quads = IOUtils::fread3_many(t_DataStream, nquad*4);
-        MatrixXi quads_new(4, nquad);
-        qint32 count = 0;
-        for(qint32 j = 0; j < quads.cols(); ++j)
-        {
-            for(qint32 i = 0; i < quads.rows(); ++i)
+            const int iNumBytes = nvert*3*sizeof(float);
+            if(t_DataStream.readRawData((char *)verts.data(), iNumBytes) != iNumBytes)
             {
-                quads_new(i,j) = quads(count, 0);
-                ++count;
+                qWarning("Unexpected end of the vertices in surface file %s",p_sFile.toUtf8().constData());
+                return false;
             }
+            IOUtils::swap_array(verts.data(), qint64(nvert)*3);
         }
-        quads = quads_new.transpose();
+
+        //quads, stored as four vertices per quad
+        VectorXi quadVerts = IOUtils::fread3_many(t_DataStream, nquad*4);
+        MatrixXi quads = Map<Matrix<int,Dynamic,4,RowMajor> >(quadVerts.data(), nquad, 4);
         //
         //  Face splitting follows
         //
@@ -344,23 +332,24 @@ bool Surface::read(const QString &p_sFile, Surface &p_Surface, bool p_bLoadCurva
 
         //vertices
         verts.resize(3, nvert);
-        t_DataStream.readRawData((char *)verts.data(), nvert*3*sizeof(float));
-        for(qint32 i = 0; i < 3; ++i)
-            for(qint32 j = 0; j < nvert; ++j)
-                IOUtils::swap_floatp(&verts(i,j));
-
-        //faces
-        faces.resize(nface, 3);
-        qint32 iVal;
-        for(qint32 i = 0; i < nface; ++i)
+        const int iNumVertBytes = nvert*3*sizeof(float);
+        if(t_DataStream.readRawData((char *)verts.data(), iNumVertBytes) != iNumVertBytes)
         {
-            for(qint32 j = 0; j < 3; ++j)
-            {
-                t_DataStream >> iVal;
-                IOUtils::swap_int(iVal);
-                faces(i,j) = iVal;
-            }
+            qWarning("Unexpected end of the vertices in surface file %s",p_sFile.toUtf8().constData());
+            return false;
         }
+        IOUtils::swap_array(verts.data(), qint64(nvert)*3);
+
+        //faces, stored as three vertices per face
+        Matrix<qint32,Dynamic,3,RowMajor> tris(nface, 3);
+        const int iNumTriBytes = nface*3*sizeof(qint32);
+        if(t_DataStream.readRawData((char *)tris.data(), iNumTriBytes) != iNumTriBytes)
+        {
+            qWarning("Unexpected end of the faces in surface file %s",p_sFile.toUtf8().constData());
+            return false;
+        }
+        IOUtils::swap_array(tris.data(), qint64(nface)*3);
+        faces = tris;
     }
     else
     {
@@ -435,22 +424,27 @@ VectorXf Surface::read_curv(const QString &p_sFileName)
         t_DataStream >> vals_per_vertex;
 
         curv.resize(vnum, 1);
-        t_DataStream.readRawData((char *)curv.data(), vnum*sizeof(float));
-        for(qint32 i = 0; i < vnum; ++i)
-           IOUtils::swap_floatp(&curv(i));
+        const int iNumBytes = vnum*sizeof(float);
+        if(t_DataStream.readRawData((char *)curv.data(), iNumBytes) != iNumBytes)
+        {
+            printf("\tError: Unexpected end of the curvature file\n");
+            return VectorXf();
+        }
+        IOUtils::swap_array(curv.data(), vnum);
     }
     else
     {
         qint32 fnum = IOUtils::fread3(t_DataStream);
         Q_UNUSED(fnum)
-        qint16 iVal;
-        curv.resize(vnum, 1);
-        for(qint32 i = 0; i < vnum; ++i)
+        Matrix<qint16,Dynamic,1> iVals(vnum);
+        const int iNumBytes = vnum*sizeof(qint16);
+        if(t_DataStream.readRawData((char *)iVals.data(), iNumBytes) != iNumBytes)
         {
-            t_DataStream >> iVal;
-            IOUtils::swap_short(iVal);
-            curv(i) = ((float)iVal) / 100;
+            printf("\tError: Unexpected end of the curvature file\n");
+            return VectorXf();
         }
+        IOUtils::swap_array(iVals.data(), vnum);
+        curv = iVals.cast<float>() / 100;
     }
     t_File.close();
 
@@ -45,6 +45,8 @@
 //=============================================================================================================
 
 #include <QStringList>
+#include <QtConcurrent>
+#include <QFuture>
 
 //=============================================================================================================
 // USED NAMESPACES
@@ -73,10 +75,16 @@ SurfaceSet::SurfaceSet(const QString &subject_id, qint32 hemi, const QString &su
     }
     else if(hemi == 2)
     {
+        //Read the right hemisphere concurrently
+        Surface t_SurfaceRH;
+        QFuture<bool> futureRH = QtConcurrent::run([&]() {
+            return Surface::read(subject_id, 1, surf, subjects_dir, t_SurfaceRH);
+        });
+
         if(Surface::read(subject_id, 0, surf, subjects_dir, t_Surface))
             insert(t_Surface);
-        if(Surface::read(subject_id, 1, surf, subjects_dir, t_Surface))
-            insert(t_Surface);
+        if(futureRH.result())
+            insert(t_SurfaceRH);
     }
 
     calcOffset();
@@ -94,10 +102,16 @@ SurfaceSet::SurfaceSet(const QString &path, qint32 hemi, const QString &surf)
     }
     else if(hemi == 2)
     {
+        //Read the right hemisphere concurrently
+        Surface t_SurfaceRH;
+        QFuture<bool> futureRH = QtConcurrent::run([&]() {
+            return Surface::read(path, 1, surf, t_SurfaceRH);
+        });
+
         if(Surface::read(path, 0, surf, t_Surface))
             insert(t_Surface);
-        if(Surface::read(path, 1, surf, t_Surface))
-            insert(t_Surface);
+        if(futureRH.result())
+            insert(t_SurfaceRH);
     }
 
     calcOffset();
@@ -164,10 +178,19 @@ bool SurfaceSet::read(const QString& p_sLHFileName, const QString& p_sRHFileName
     QStringList t_qListFileName;
     t_qListFileName << p_sLHFileName << p_sRHFileName;
 
+    //Read both hemispheres concurrently
+    Surface t_Surfaces[2];
+    bool t_bRead[2];
+    QFuture<void> futureRH = QtConcurrent::run([&]() {
+        t_bRead[1] = Surface::read(t_qListFileName.at(1), t_Surfaces[1]);
+    });
+    t_bRead[0] = Surface::read(t_qListFileName.at(0), t_Surfaces[0]);
+    futureRH.waitForFinished();
+
     for(qint32 i = 0; i < t_qListFileName.size(); ++i)
     {
-        Surface t_Surface;
-        if(Surface::read(t_qListFileName[i], t_Surface))
+        const Surface& t_Surface = t_Surfaces[i];
+        if(t_bRead[i])
         {
             if(t_qListFileName[i].contains("lh."))
                 p_SurfaceSet.m_qMapSurfs.insert(0, t_Surface);
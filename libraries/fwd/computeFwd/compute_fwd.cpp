@@ -1845,6 +1845,10 @@ ComputeFwd::~ComputeFwd()
         delete m_meg_head_t;
     if(m_megcoils)
         delete m_megcoils;
+    if(m_megcoilsDevice)
+        delete m_megcoilsDevice;
+    if(m_compcoilsDevice)
+        delete m_compcoilsDevice;
     if(m_eegels)
         delete m_eegels;
     if(m_eegModel)
@@ -1879,6 +1883,8 @@ void ComputeFwd::initFwd()
     m_templates             = Q_NULLPTR;
     m_megcoils              = Q_NULLPTR;
     m_compcoils             = Q_NULLPTR;
+    m_megcoilsDevice        = Q_NULLPTR;
+    m_compcoilsDevice       = Q_NULLPTR;
     m_compData              = Q_NULLPTR;
     m_eegels                = Q_NULLPTR;
     m_eegModels             = Q_NULLPTR;
@@ -2373,43 +2379,49 @@ void ComputeFwd::updateHeadPos(FiffCoordTransOld* transDevHeadOld)
 //
 //    FwdCoilSet* megcoilsNew = m_megcoils->dup_coil_set(transHeadHeadOld);
 
-    // create new coilset with updated head position
-    if (m_pSettings->coord_frame == FIFFV_COORD_MRI) {
-        FiffCoordTransOld* head_mri_t = m_mri_head_t->fiff_invert_transform();
-        FiffCoordTransOld* meg_mri_t = FiffCoordTransOld::fiff_combine_transforms(FIFFV_COORD_DEVICE,FIFFV_COORD_MRI,transDevHeadOld,head_mri_t);
-        if (meg_mri_t == Q_NULLPTR) {
-            return;
-        }
-        if ((m_megcoils = m_templates->create_meg_coils(m_listMegChs,
-                                                        iNMeg,
-                                                        m_pSettings->accurate ? FWD_COIL_ACCURACY_ACCURATE : FWD_COIL_ACCURACY_NORMAL,
-                                                        meg_mri_t)) == Q_NULLPTR) {
+    // The coils in device coordinates are created from the templates only once
+    if (!m_megcoilsDevice) {
+        if ((m_megcoilsDevice = m_templates->create_meg_coils(m_listMegChs,
+                                                              iNMeg,
+                                                              m_pSettings->accurate ? FWD_COIL_ACCURACY_ACCURATE : FWD_COIL_ACCURACY_NORMAL,
+                                                              Q_NULLPTR)) == Q_NULLPTR) {
             return;
         }
         if (iNComp > 0) {
-            if ((m_compcoils = m_templates->create_meg_coils(m_listCompChs,
-                                                             iNComp,
-                                                             FWD_COIL_ACCURACY_NORMAL,
-                                                             meg_mri_t)) == Q_NULLPTR) {
+            if ((m_compcoilsDevice = m_templates->create_meg_coils(m_listCompChs,
+                                                                   iNComp,
+                                                                   FWD_COIL_ACCURACY_NORMAL,
+                                                                   Q_NULLPTR)) == Q_NULLPTR) {
                 return;
             }
         }
-    } else {
-        if ((m_megcoils = m_templates->create_meg_coils(m_listMegChs,
-                                                        iNMeg,
-                                                        m_pSettings->accurate ? FWD_COIL_ACCURACY_ACCURATE : FWD_COIL_ACCURACY_NORMAL,
-                                                        transDevHeadOld)) == Q_NULLPTR) {
+    }
+
+    // create new coilset with updated head position by transforming all integration points at once
+    FiffCoordTransOld* meg_t = transDevHeadOld;
+    FiffCoordTransOld* meg_mri_t = Q_NULLPTR;
+    if (m_pSettings->coord_frame == FIFFV_COORD_MRI) {
+        FiffCoordTransOld* head_mri_t = m_mri_head_t->fiff_invert_transform();
+        meg_mri_t = FiffCoordTransOld::fiff_combine_transforms(FIFFV_COORD_DEVICE,FIFFV_COORD_MRI,transDevHeadOld,head_mri_t);
+        delete head_mri_t;
+        if (meg_mri_t == Q_NULLPTR) {
             return;
         }
+        meg_t = meg_mri_t;
+    }
 
-        if (iNComp > 0) {
-            if ((m_compcoils = m_templates->create_meg_coils(m_listCompChs,
-                                                             iNComp,
-                                                             FWD_COIL_ACCURACY_NORMAL,transDevHeadOld)) == Q_NULLPTR) {
-                return;
-            }
-        }
+    FwdCoilSet* megcoils = m_megcoilsDevice->dup_coil_set(meg_t);
+    FwdCoilSet* compcoils = m_compcoilsDevice ? m_compcoilsDevice->dup_coil_set(meg_t) : Q_NULLPTR;
+    delete meg_mri_t;
+    if (!megcoils || (m_compcoilsDevice && !compcoils)) {
+        delete megcoils;
+        delete compcoils;
+        return;
     }
+    delete m_megcoils;
+    delete m_compcoils;
+    m_megcoils = megcoils;
+    m_compcoils = compcoils;
 
     // check if source spaces are still in head space
     if(m_spaces[0]->coord_frame != FIFFV_COORD_HEAD) {
@@ -2419,7 +2431,31 @@ void ComputeFwd::updateHeadPos(FiffCoordTransOld* transDevHeadOld)
     }
 
     // recompute meg forward
-    if ((FwdBemModel::compute_forward_meg(m_spaces,
+    if (m_bemModel && m_bemModel->bem_method == FWD_BEM_LINEAR_COLL && !m_pSettings->compute_grad) {
+        // The source potentials on the BEM surfaces do not depend on the head position, compute them only once
+        if (m_matBemSourcePots.cols() == 0) {
+            if (FwdBemModel::fwd_bem_lin_source_pots(m_spaces,
+                                                     m_iNSpace,
+                                                     m_pSettings->fixed_ori,
+                                                     m_bemModel,
+                                                     m_matBemSourcePots) == FAIL) {
+                return;
+            }
+        }
+
+        if ((FwdBemModel::compute_forward_meg_lin(m_spaces,
+                                                  m_iNSpace,
+                                                  m_megcoils,
+                                                  m_compcoils,
+                                                  m_compData,
+                                                  m_pSettings->fixed_ori,
+                                                  m_bemModel,
+                                                  m_matBemSourcePots,
+                                                  m_pSettings->use_threads,
+                                                  *m_meg_forward.data())) == FAIL) {
+            return;
+        }
+    } else if ((FwdBemModel::compute_forward_meg(m_spaces,
                                           m_iNSpace,
                                           m_megcoils,
                                           m_compcoils,
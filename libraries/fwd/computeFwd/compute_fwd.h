@@ -165,12 +165,15 @@ private:
     FwdCoilSet* m_templates;                        /**< The template coil set. */
     FwdCoilSet* m_megcoils;                         /**< The MEG coil set. */
     FwdCoilSet* m_compcoils;                        /**< The compensator coil set. */
+    FwdCoilSet* m_megcoilsDevice;                   /**< The MEG coil set in device coordinates, used for head position updates. */
+    FwdCoilSet* m_compcoilsDevice;                  /**< The compensator coil set in device coordinates. */
     FwdCoilSet* m_eegels;                           /**< The EEG eceltrode set. */
     MNELIB::MneCTFCompDataSet *m_compData;          /**< The compensator data. */
     FwdEegSphereModelSet* m_eegModels;              /**< The EEG model set. */
     FwdEegSphereModel* m_eegModel;                  /**< The EEG model. */
     FwdBemModel *m_bemModel;                        /**< BEM model definition. */
     Eigen::Vector3f *m_r0;                          /**< The Sphere model origin. */
+    Eigen::MatrixXf m_matBemSourcePots;             /**< The cached source potentials on the BEM surfaces for head position updates. */
 
     QList<FIFFLIB::FiffChInfo> m_listMegChs;        /**< The MEG channel information. */
     QList<FIFFLIB::FiffChInfo> m_listEegChs;        /**< The EEG channel information. */
@@ -46,6 +46,7 @@
 #include <mne/c/mne_source_space_old.h>
 
 #include "fwd_comp_data.h"
+#include <mne/c/mne_ctf_comp_data_set.h>
 #include "fwd_bem_model.h"
 
 #include "fwd_thread_arg.h"
@@ -3361,6 +3362,240 @@ bad : {
 
 //=============================================================================================================
 
+int FwdBemModel::fwd_bem_lin_source_pots(MneSourceSpaceOld **spaces,
+                                         int nspace,
+                                         bool fixed_ori,
+                                         FwdBemModel *bem_model,
+                                         MatrixXf& matPots)
+/*
+ * Compute the infinite-medium potentials of all source components at the BEM vertices
+ * These only depend on the source space and the BEM model, not on the sensors
+ */
+{
+    MatrixXf matRd, matQ;
+    float    my_rd[3],my_Q[3];
+    int      s,k,p,c;
+
+    if (!bem_model || bem_model->bem_method != FWD_BEM_LINEAR_COLL) {
+        printf("BEM method should be linear collocation for fwd_bem_lin_source_pots");
+        return FAIL;
+    }
+
+    fwd_source_components(spaces,nspace,fixed_ori,matRd,matQ);
+
+    matPots.resize(bem_model->nsol,matRd.cols());
+
+    for (c = 0; c < matRd.cols(); c++) {
+        /*
+         * The dipole location and orientation must be transformed
+         */
+        VEC_COPY_40(my_rd,matRd.col(c).data());
+        VEC_COPY_40(my_Q,matQ.col(c).data());
+        if (bem_model->head_mri_t) {
+            FiffCoordTransOld::fiff_coord_trans(my_rd,bem_model->head_mri_t,FIFFV_MOVE);
+            FiffCoordTransOld::fiff_coord_trans(my_Q,bem_model->head_mri_t,FIFFV_NO_MOVE);
+        }
+        float *v0 = matPots.col(c).data();
+        for (s = 0, p = 0; s < bem_model->nsurf; s++) {
+            float **rr  = bem_model->surfs[s]->rr;
+            float mult  = bem_model->source_mult[s];
+            for (k = 0; k < bem_model->surfs[s]->np; k++)
+                v0[p++] = mult*fwd_bem_inf_pot(my_rd,my_Q,rr[k]);
+        }
+    }
+    return OK;
+}
+
+//=============================================================================================================
+
+int FwdBemModel::compute_forward_meg_lin(MneSourceSpaceOld **spaces,
+                                         int nspace,
+                                         FwdCoilSet *coils,
+                                         FwdCoilSet *comp_coils,
+                                         MneCTFCompDataSet *comp_data,
+                                         bool fixed_ori,
+                                         FwdBemModel *bem_model,
+                                         const MatrixXf& matPots,
+                                         bool use_threads,
+                                         FiffNamedMatrix& resp)
+/*
+ * Compute the MEG forward solution from the cached source potentials
+ * Only the coil dependent part is computed here
+ */
+{
+    FwdCompData *comp = NULL;
+    MatrixXf    matRd, matQ;
+    MatrixXf    matB, matBComp;
+    QStringList names;
+    int         k;
+
+    if (!bem_model || bem_model->bem_method != FWD_BEM_LINEAR_COLL || bem_model->nsol != matPots.rows()) {
+        printf("Source potentials do not match the BEM model in compute_forward_meg_lin");
+        return FAIL;
+    }
+
+    fwd_source_components(spaces,nspace,fixed_ori,matRd,matQ);
+    if (matRd.cols() != matPots.cols()) {
+        printf("Source potentials do not match the source spaces in compute_forward_meg_lin");
+        return FAIL;
+    }
+    /*
+     * The compensation is set up the same way as in compute_forward_meg
+     */
+    comp = FwdCompData::fwd_make_comp_data(comp_data,
+                                           coils,
+                                           comp_coils,
+                                           FwdBemModel::fwd_bem_field,
+                                           NULL,
+                                           FwdBemModel::fwd_bem_field_grad,
+                                           bem_model,
+                                           NULL);
+    if (!comp)
+        goto bad;
+
+    printf("Computing MEG at %d source locations from the cached source potentials...",int(matRd.cols())/(fixed_ori ? 1 : 3));
+    if (fwd_bem_lin_field_sources(coils,bem_model,matRd,matQ,matPots,use_threads,matB) == FAIL)
+        goto bad;
+
+    if (comp->comp_coils && comp->comp_coils->ncoil > 0 && comp->set && comp->set->current) {
+        if (fwd_bem_lin_field_sources(comp->comp_coils,bem_model,matRd,matQ,matPots,use_threads,matBComp) == FAIL)
+            goto bad;
+        for (k = 0; k < matB.cols(); k++)
+            if (MneCTFCompDataSet::mne_apply_ctf_comp(comp->set,
+                                                      TRUE,
+                                                      matB.col(k).data(),
+                                                      matB.rows(),
+                                                      matBComp.col(k).data(),
+                                                      matBComp.rows()) != OK)
+                goto bad;
+    }
+    printf("done.\n");
+
+    delete comp;
+
+    for (k = 0; k < coils->ncoil; k++)
+        names.append(coils->coils[k]->chname);
+
+    resp.nrow = matB.rows();
+    resp.ncol = matB.cols();
+    resp.row_names = names;
+    resp.col_names = QStringList();
+    resp.data = matB.cast<double>();
+
+    return OK;
+
+bad : {
+        if(comp)
+            delete comp;
+        return FAIL;
+    }
+}
+
+//=============================================================================================================
+
+void FwdBemModel::fwd_source_components(MneSourceSpaceOld **spaces,
+                                        int nspace,
+                                        bool fixed_ori,
+                                        MatrixXf& matRd,
+                                        MatrixXf& matQ)
+{
+    int k,j,c,ncomp = 0;
+
+    for (k = 0; k < nspace; k++)
+        ncomp += fixed_ori ? spaces[k]->nuse : 3*spaces[k]->nuse;
+
+    matRd.resize(3,ncomp);
+    matQ.resize(3,ncomp);
+
+    for (k = 0, c = 0; k < nspace; k++) {
+        MneSourceSpaceOld* s = spaces[k];
+        for (j = 0; j < s->np; j++) {
+            if (!s->inuse[j])
+                continue;
+            if (fixed_ori) {
+                matRd.col(c) = Map<Vector3f>(s->rr[j]);
+                matQ.col(c++) = Map<Vector3f>(s->nn[j]);
+            }
+            else {
+                matRd.col(c) = Map<Vector3f>(s->rr[j]);
+                matQ.col(c++) = Map<Vector3f>(Qx);
+                matRd.col(c) = Map<Vector3f>(s->rr[j]);
+                matQ.col(c++) = Map<Vector3f>(Qy);
+                matRd.col(c) = Map<Vector3f>(s->rr[j]);
+                matQ.col(c++) = Map<Vector3f>(Qz);
+            }
+        }
+    }
+}
+
+//=============================================================================================================
+
+int FwdBemModel::fwd_bem_lin_field_sources(FwdCoilSet *coils,
+                                           FwdBemModel *bem_model,
+                                           const MatrixXf& matRd,
+                                           const MatrixXf& matQ,
+                                           const MatrixXf& matPots,
+                                           bool use_threads,
+                                           MatrixXf& matB)
+/*
+ * Calculate the magnetic field of all source components in a set of coils
+ */
+{
+    typedef Matrix<float,Dynamic,Dynamic,RowMajor> MatrixXfR;
+
+    float **coeff = fwd_bem_lin_field_coeff(bem_model,coils,FWD_BEM_LIN_FIELD_SIMPLE);
+    if (!coeff)
+        return FAIL;
+    /*
+     * Coil coefficients combined with the BEM solution, this replaces fwd_bem_specify_coils
+     */
+    MatrixXf matCoilSol = Map<MatrixXfR>(coeff[0],coils->ncoil,bem_model->nsol) *
+                          Map<MatrixXfR>(bem_model->solution[0],bem_model->nsol,bem_model->nsol);
+    FREE_CMATRIX_40(coeff);
+
+    matB.resize(coils->ncoil,matPots.cols());
+    /*
+     * Split the source components into one block per thread
+     */
+    int nblock = use_threads ? std::max(QThread::idealThreadCount(),1) : 1;
+    int blocksize = (matPots.cols() + nblock - 1) / nblock;
+    QVector<QPair<int,int> > blocks;
+    for (int from = 0; from < matPots.cols(); from += blocksize)
+        blocks.append(qMakePair(from,std::min(blocksize,int(matPots.cols()) - from)));
+
+    auto computeBlock = [&](const QPair<int,int>& block) {
+        /*
+         * Volume current contribution
+         */
+        matB.middleCols(block.first,block.second).noalias() = matCoilSol * matPots.middleCols(block.first,block.second);
+        /*
+         * Primary current contribution
+         * (can be calculated in the coil/dipole coordinates)
+         */
+        float my_rd[3],my_Q[3];
+        for (int c = block.first; c < block.first + block.second; c++) {
+            VEC_COPY_40(my_rd,matRd.col(c).data());
+            VEC_COPY_40(my_Q,matQ.col(c).data());
+            for (int k = 0; k < coils->ncoil; k++) {
+                FwdCoil* coil = coils->coils[k];
+                float    B    = 0.0;
+                for (int p = 0; p < coil->np; p++)
+                    B = B + coil->w[p]*fwd_bem_inf_field(my_rd,my_Q,coil->rmag[p],coil->cosmag[p]);
+                matB(k,c) = MAG_FACTOR*(matB(k,c) + B);
+            }
+        }
+    };
+
+    if (blocks.size() > 1)
+        QtConcurrent::blockingMap(blocks,computeBlock);
+    else if (!blocks.isEmpty())
+        computeBlock(blocks.first());
+
+    return OK;
+}
+
+//=============================================================================================================
+
 int FwdBemModel::compute_forward_eeg(MneSourceSpaceOld **spaces,
                                      int nspace,
                                      FwdCoilSet *els,
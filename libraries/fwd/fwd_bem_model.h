@@ -448,6 +448,97 @@ public:
                                     FIFFLIB::FiffNamedMatrix&   resp_grad,
                                     bool bDoGRad);                              /**< calculate gradient solution. */
 
+    //=========================================================================================================
+    /**
+     * Computes the infinite-medium potentials of all source components at the BEM vertices, multiplied by the
+     * source multipliers of the surfaces (linear collocation only). They do not depend on the sensor positions,
+     * so they are computed once and passed to compute_forward_meg_lin for every new head position. The matrix
+     * takes nsol x (number of source components) floats.
+     *
+     * @param[in] spaces         The source spaces.
+     * @param[in] nspace         The number of source spaces.
+     * @param[in] fixed_ori      Whether to use the surface normals only. Otherwise x, y and z per source.
+     * @param[in] bem_model      The BEM model.
+     * @param[out] matPots       The potentials (nsol x source components).
+     *
+     * @return OK or FAIL.
+     */
+    static int fwd_bem_lin_source_pots(MNELIB::MneSourceSpaceOld **spaces,
+                                       int nspace,
+                                       bool fixed_ori,
+                                       FwdBemModel *bem_model,
+                                       Eigen::MatrixXf& matPots);
+
+    //=========================================================================================================
+    /**
+     * Computes the MEG forward solution with a linear collocation BEM from the cached source potentials of
+     * fwd_bem_lin_source_pots. Only the coil dependent part is recomputed: the coil coefficients are combined
+     * with the BEM solution once and then with all source potentials in a single matrix product. The
+     * infinite-medium field is added per source. The result is the same as the one of compute_forward_meg.
+     *
+     * @param[in] spaces         The source spaces.
+     * @param[in] nspace         The number of source spaces.
+     * @param[in] coils          The MEG coils.
+     * @param[in] comp_coils     The compensator coils.
+     * @param[in] comp_data      The compensator data.
+     * @param[in] fixed_ori      Whether the potentials were computed for fixed orientations.
+     * @param[in] bem_model      The BEM model.
+     * @param[in] matPots        The source potentials as returned by fwd_bem_lin_source_pots.
+     * @param[in] use_threads    Whether to split the sources across threads.
+     * @param[out] resp          The results (channels x source components).
+     *
+     * @return OK or FAIL.
+     */
+    static int compute_forward_meg_lin(MNELIB::MneSourceSpaceOld **spaces,
+                                       int nspace,
+                                       FwdCoilSet *coils,
+                                       FwdCoilSet *comp_coils,
+                                       MNELIB::MneCTFCompDataSet *comp_data,
+                                       bool fixed_ori,
+                                       FwdBemModel *bem_model,
+                                       const Eigen::MatrixXf& matPots,
+                                       bool use_threads,
+                                       FIFFLIB::FiffNamedMatrix& resp);
+
+    //=========================================================================================================
+    /**
+     * Collects the locations and orientations of all source components in the order of the forward solution.
+     *
+     * @param[in] spaces         The source spaces.
+     * @param[in] nspace         The number of source spaces.
+     * @param[in] fixed_ori      Whether to use the surface normals only. Otherwise x, y and z per source.
+     * @param[out] matRd         The locations (3 x source components).
+     * @param[out] matQ          The orientations (3 x source components).
+     */
+    static void fwd_source_components(MNELIB::MneSourceSpaceOld **spaces,
+                                      int nspace,
+                                      bool fixed_ori,
+                                      Eigen::MatrixXf& matRd,
+                                      Eigen::MatrixXf& matQ);
+
+    //=========================================================================================================
+    /**
+     * Computes the (uncompensated) field of all source components in one coil set from the cached source
+     * potentials.
+     *
+     * @param[in] coils          The coils.
+     * @param[in] bem_model      The BEM model.
+     * @param[in] matRd          The source locations (3 x source components).
+     * @param[in] matQ           The source orientations (3 x source components).
+     * @param[in] matPots        The source potentials (nsol x source components).
+     * @param[in] use_threads    Whether to split the sources across threads.
+     * @param[out] matB          The field (coils x source components).
+     *
+     * @return OK or FAIL.
+     */
+    static int fwd_bem_lin_field_sources(FwdCoilSet *coils,
+                                         FwdBemModel *bem_model,
+                                         const Eigen::MatrixXf& matRd,
+                                         const Eigen::MatrixXf& matQ,
+                                         const Eigen::MatrixXf& matPots,
+                                         bool use_threads,
+                                         Eigen::MatrixXf& matB);
+
     static int compute_forward_eeg( MNELIB::MneSourceSpaceOld*  *spaces,        /**< Source spaces. */
                                     int                         nspace,         /**< How many?. */
                                     FwdCoilSet*                 els,            /**< Electrode locations. */
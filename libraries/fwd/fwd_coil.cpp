@@ -147,6 +147,7 @@ FwdCoil::FwdCoil(int p_np)
     rmag       = ALLOC_CMATRIX_5(np,3);
     cosmag     = ALLOC_CMATRIX_5(np,3);
     w          = MALLOC_5(np,float);
+    owns_points = true;
     /*
    * Reasonable defaults
    */
@@ -179,6 +180,7 @@ FwdCoil::FwdCoil(const FwdCoil& p_FwdCoil)
     rmag       = ALLOC_CMATRIX_5(this->np,3);
     cosmag     = ALLOC_CMATRIX_5(this->np,3);
     w          = MALLOC_5(this->np,float);
+    owns_points = true;
 
     VEC_COPY_5(this->r0,p_FwdCoil.r0);
     VEC_COPY_5(this->ex,p_FwdCoil.ex);
@@ -197,9 +199,15 @@ FwdCoil::FwdCoil(const FwdCoil& p_FwdCoil)
 
 FwdCoil::~FwdCoil()
 {
-    FREE_CMATRIX_5(rmag);
-    FREE_CMATRIX_5(cosmag);
-    FREE_5(w);
+    if (owns_points) {
+        FREE_CMATRIX_5(rmag);
+        FREE_CMATRIX_5(cosmag);
+        FREE_5(w);
+    }
+    else {
+        FREE_5(rmag);
+        FREE_5(cosmag);
+    }
 }
 
 //=============================================================================================================
@@ -292,3 +300,22 @@ bool FwdCoil::is_eeg_electrode() const
 {
     return this->coil_class == FWD_COILC_EEG;
 }
+
+//=============================================================================================================
+
+void FwdCoil::attach_points(float *p_rmag, float *p_cosmag, float *p_w)
+{
+    if (owns_points) {
+        if (np > 0) {
+            FREE_5(rmag[0]);
+            FREE_5(cosmag[0]);
+        }
+        FREE_5(w);
+        owns_points = false;
+    }
+    for (int p = 0; p < np; p++) {
+        rmag[p]   = p_rmag + 3*p;
+        cosmag[p] = p_cosmag + 3*p;
+    }
+    w = p_w;
+}
@@ -163,6 +163,17 @@ public:
      */
     bool is_eeg_electrode() const;
 
+    //=========================================================================================================
+    /**
+     * Lets rmag, cosmag and w refer to external storage, e.g. the packed integration points of a coil set.
+     * The current values are not copied. The coil does not free the external storage.
+     *
+     * @param[in] p_rmag     np x 3 field point locations.
+     * @param[in] p_cosmag   np x 3 direction cosines.
+     * @param[in] p_w        np weighting coefficients.
+     */
+    void attach_points(float *p_rmag, float *p_cosmag, float *p_w);
+
 public:
     QString chname;         /**< Name of this channel. */
     int     coord_frame;    /**< Which coordinate frame are we in?. */
@@ -180,6 +191,7 @@ public:
     float   **rmag;         /**< The field point locations. */
     float   **cosmag;       /**< The corresponding direction cosines. */
     float   *w;             /**< The weighting coefficients. */
+    bool    owns_points;    /**< Whether rmag, cosmag and w are allocated by this coil. */
 
 // ### OLD STRUCT ###
 //    typedef struct {
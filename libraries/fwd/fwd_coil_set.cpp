@@ -377,6 +377,9 @@ FwdCoilSet *FwdCoilSet::create_meg_coils(const QList<FIFFLIB::FiffChInfo>& chs,
     }
     if (t)
         res->coord_frame = t->to;
+    else
+        res->coord_frame = FIFFV_COORD_DEVICE;
+    res->pack_points();
     return res;
 
 bad : {
@@ -403,6 +406,7 @@ FwdCoilSet *FwdCoilSet::create_eeg_els(const QList<FIFFLIB::FiffChInfo>& chs,
     }
     if (t)
         res->coord_frame = t->to;
+    res->pack_points();
     return res;
 
 bad : {
@@ -506,7 +510,6 @@ bad : {
 FwdCoilSet* FwdCoilSet::dup_coil_set(const FiffCoordTransOld* t) const
 {
     FwdCoilSet* res;
-    FwdCoil*    coil;
 
     if (t) {
         if (this->coord_frame != t->from) {
@@ -515,33 +518,87 @@ FwdCoilSet* FwdCoilSet::dup_coil_set(const FiffCoordTransOld* t) const
         }
     }
     res = new FwdCoilSet();
-    if (t)
-        res->coord_frame = t->to;
-    else
-        res->coord_frame = this->coord_frame;
+    res->coord_frame = this->coord_frame;
 
     res->coils = MALLOC_6(this->ncoil,FwdCoil*);
     res->ncoil = this->ncoil;
 
-    for (int k = 0; k < this->ncoil; k++) {
-        coil = res->coils[k] = new FwdCoil(*(this->coils[k]));
-        /*
+    for (int k = 0; k < this->ncoil; k++)
+        res->coils[k] = new FwdCoil(*(this->coils[k]));
+    res->pack_points();
+    /*
      * Optional coordinate transformation
      */
-        if (t) {
-            FiffCoordTransOld::fiff_coord_trans(coil->r0,t,FIFFV_MOVE);
-            FiffCoordTransOld::fiff_coord_trans(coil->ex,t,FIFFV_NO_MOVE);
-            FiffCoordTransOld::fiff_coord_trans(coil->ey,t,FIFFV_NO_MOVE);
-            FiffCoordTransOld::fiff_coord_trans(coil->ez,t,FIFFV_NO_MOVE);
-
-            for (int p = 0; p < coil->np; p++) {
-                FiffCoordTransOld::fiff_coord_trans(coil->rmag[p],t,FIFFV_MOVE);
-                FiffCoordTransOld::fiff_coord_trans(coil->cosmag[p],t,FIFFV_NO_MOVE);
-            }
-            coil->coord_frame = t->to;
+    if (t)
+        res->transform_points(t);
+    return res;
+}
+
+//=============================================================================================================
+
+void FwdCoilSet::pack_points()
+{
+    FwdCoil* coil;
+    int      np,k,p;
+
+    for (k = 0, np = 0; k < this->ncoil; k++)
+        np += this->coils[k]->np;
+
+    Matrix3Xf rmag(3,np);
+    Matrix3Xf cosmag(3,np);
+    VectorXf  w(np);
+
+    for (k = 0, np = 0; k < this->ncoil; k++) {
+        coil = this->coils[k];
+        for (p = 0; p < coil->np; p++, np++) {
+            rmag.col(np)   = Map<const Vector3f>(coil->rmag[p]);
+            cosmag.col(np) = Map<const Vector3f>(coil->cosmag[p]);
+            w[np]          = coil->w[p];
         }
     }
-    return res;
+    this->rmag_all.swap(rmag);
+    this->cosmag_all.swap(cosmag);
+    this->w_all.swap(w);
+
+    for (k = 0, np = 0; k < this->ncoil; k++) {
+        coil = this->coils[k];
+        coil->attach_points(this->rmag_all.data()+3*np,this->cosmag_all.data()+3*np,this->w_all.data()+np);
+        np += coil->np;
+    }
+}
+
+//=============================================================================================================
+
+int FwdCoilSet::transform_points(const FiffCoordTransOld* t)
+{
+    FwdCoil* coil;
+
+    if (this->coord_frame != t->from) {
+        qWarning("Coordinate frame of the transformation does not match the coil set in FwdCoilSet::transform_points");
+        return FAIL;
+    }
+    for (int k = 0; k < this->ncoil; k++) {
+        if (this->coils[k]->owns_points) {
+            this->pack_points();
+            break;
+        }
+    }
+    for (int k = 0; k < this->ncoil; k++) {
+        coil = this->coils[k];
+        FiffCoordTransOld::fiff_coord_trans(coil->r0,t,FIFFV_MOVE);
+        FiffCoordTransOld::fiff_coord_trans(coil->ex,t,FIFFV_NO_MOVE);
+        FiffCoordTransOld::fiff_coord_trans(coil->ey,t,FIFFV_NO_MOVE);
+        FiffCoordTransOld::fiff_coord_trans(coil->ez,t,FIFFV_NO_MOVE);
+        coil->coord_frame = t->to;
+    }
+    /*
+     * One transformation for all integration points. Write through a map so that the coils keep pointing to
+     * the same storage.
+     */
+    Map<Matrix3Xf>(this->rmag_all.data(),3,this->rmag_all.cols()) = (t->rot*this->rmag_all).colwise() + t->move;
+    Map<Matrix3Xf>(this->cosmag_all.data(),3,this->cosmag_all.cols()) = t->rot*this->cosmag_all;
+    this->coord_frame = t->to;
+    return OK;
 }
 
 //=============================================================================================================
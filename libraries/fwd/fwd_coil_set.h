@@ -221,6 +221,23 @@ public:
      */
     bool is_eeg_electrode_type(int type) const;
 
+    //=========================================================================================================
+    /**
+     * Copies the integration points of all coils into the contiguous arrays rmag_all, cosmag_all and w_all
+     * and lets the coils refer to them. Coordinate transformations then act on all points of the set at once.
+     */
+    void pack_points();
+
+    //=========================================================================================================
+    /**
+     * Applies a coordinate transformation to all packed integration points and to the coil coordinate systems.
+     *
+     * @param[in] t      The transformation. Its source frame has to match the coil set.
+     *
+     * @return   OK on success, FAIL otherwise.
+     */
+    int transform_points(const FIFFLIB::FiffCoordTransOld* t);
+
 public:
     FwdCoil **coils;                /*< The coil or electrode positions >*/
     int     ncoil;                  /*< Number of coils >*/
@@ -228,6 +245,10 @@ public:
     void    *user_data;             /*< We can put whatever in here >*/
     fwdUserFreeFunc user_data_free;
 
+    Eigen::Matrix3Xf rmag_all;      /*< Packed field point locations of all coils, one column per point >*/
+    Eigen::Matrix3Xf cosmag_all;    /*< Packed direction cosines of all coils >*/
+    Eigen::VectorXf  w_all;         /*< Packed weighting coefficients of all coils >*/
+
 // ### OLD STRUCT ###
 //    typedef struct {
 //      fwdCoil *coils;		/* The coil or electrode positions */
@@ -44,6 +44,7 @@
 #include "fwd_eeg_sphere_model_set.h"
 
 #include <QtAlgorithms>
+#include <QVector>
 
 #include <qmath.h>
 
@@ -197,6 +198,104 @@ void mne_free_dcmatrix_1 (double **m)
 static int         terms = 0;       /* These statistics may be useful */
 static int         eval = 0;
 
+#define MAX_BERG_SCHERG_RV 0.01     /* Fall back to the series expansion if the equivalent model is worse than this */
+
+namespace
+{
+
+/*
+ * Factors of the Legendre recurrences for P0(n) and P1(n), these only depend on n
+ */
+struct LegendreRecurrence
+{
+    explicit LegendreRecurrence(int nterms)
+    : a0(nterms+1), b0(nterms+1), a1(nterms+1), b1(nterms+1), n_inv(nterms+1)
+    {
+        a0[0] = b0[0] = a1[0] = b1[0] = n_inv[0] = 0.0;
+        a1[1] = b1[1] = 0.0;
+        for (int n = 1; n <= nterms; n++) {
+            a0[n]    = (2.0*n-1.0)/n;
+            b0[n]    = (n-1.0)/n;
+            if (n > 1) {
+                a1[n] = (2.0*n-1.0)/(n-1.0);
+                b1[n] = n/(n-1.0);
+            }
+            n_inv[n] = 1.0/n;
+        }
+    }
+
+    ArrayXd a0,b0;      /* P0(n) = a0(n)*x*P0(n-1) - b0(n)*P0(n-2) */
+    ArrayXd a1,b1;      /* P1(n) = a1(n)*x*P1(n-1) - b1(n)*P1(n-2) */
+    ArrayXd n_inv;
+};
+
+const LegendreRecurrence& legendre_recurrence()
+{
+    static const LegendreRecurrence rec(MAXTERMS);
+    return rec;
+}
+
+/*
+ * Collect the electrode positions into the sphere model coordinates, scaled onto the surface if requested
+ */
+void sphere_electrode_positions(const FwdEegSphereModel* m, float **el, int neeg, Matrix3Xf& pos)
+{
+    pos.resize(3,neeg);
+    for (int k = 0; k < neeg; k++)
+        pos.col(k) = Map<const Vector3f>(el[k]) - m->r0;
+    if (m->scale_pos && neeg > 0) {
+        ArrayXf scale = m->layers[m->nlayer()-1].rad/pos.colwise().norm().array();
+        pos.array().rowwise() *= scale.transpose();
+    }
+}
+
+/*
+ * Sum up the Berg-Scherg equivalent dipoles for all electrodes at once. The potential of a dipole Q at orig_rd is
+ * then V = M1*(orig_rd.Q) + M2*(pos.Q), before scaling with 1/(4*M_PI)
+ */
+void berg_scherg_weights(const FwdEegSphereModel* m, const Vector3f& orig_rd, const Matrix3Xf& pos, ArrayXf& M1, ArrayXf& M2)
+{
+    ArrayXf r2 = pos.colwise().squaredNorm().transpose();
+    ArrayXf r  = r2.sqrt();
+
+    M1.setZero(pos.cols());
+    M2.setZero(pos.cols());
+    for (int eq = 0; eq < m->nfit; eq++) {
+        Vector3f rd  = m->mu[eq]*orig_rd;
+        float    rd2 = rd.squaredNorm();
+
+        ArrayXf rrd = (pos.transpose()*rd).array();
+        ArrayXf a2  = (pos.colwise() - rd).colwise().squaredNorm().transpose();
+        ArrayXf a   = a2.sqrt();
+        ArrayXf a3  = 2.0f/(a2*a);
+        ArrayXf F   = a*(r*a + (r2 - rrd));
+        ArrayXf c1  = a3*(rrd - rd2) + a.inverse() - r.inverse();
+        ArrayXf c2  = a3 + (a + r)/(r*F);
+        /*
+         * The scaled dipole position is mu*orig_rd and the factor rd2 of the second term cancels
+         */
+        M1 += (m->lambda[eq]*m->mu[eq]/rd2)*(c1 - c2*rrd);
+        M2 += m->lambda[eq]*c2;
+    }
+}
+
+/*
+ * Gather all integration points of the EEG electrodes in a coil set
+ */
+int eeg_coil_points(FwdCoilSet* els, QVector<float*>& points)
+{
+    points.clear();
+    for (int k = 0; k < els->ncoil; k++) {
+        FwdCoil* el = els->coils[k];
+        if (el->coil_class == FWD_COILC_EEG)
+            for (int c = 0; c < el->np; c++)
+                points.append(el->rmag[c]);
+    }
+    return points.size();
+}
+
+} // Anonymous namespace
+
 //=============================================================================================================
 // DEFINE MEMBER METHODS
 //=============================================================================================================
@@ -506,6 +605,46 @@ void FwdEegSphereModel::calc_pot_components(double beta, double cgamma, double *
     return;
 }
 
+//=============================================================================================================
+
+void FwdEegSphereModel::calc_pot_components_vec(const ArrayXd& beta, const ArrayXd& cgamma, ArrayXd& Vr, ArrayXd& Vt, const Eigen::VectorXd& fn, int nterms)
+{
+    const LegendreRecurrence& rec = legendre_recurrence();
+    int    n;
+
+    nterms = MIN_1(nterms,MAXTERMS);
+
+    ArrayXd betan = ArrayXd::Ones(beta.size());
+    ArrayXd p0    = cgamma;
+    ArrayXd p01   = ArrayXd::Ones(beta.size());
+    ArrayXd p1    = (1.0 - cgamma.square()).max(0.0).sqrt();
+    ArrayXd p11   = ArrayXd::Zero(beta.size());
+    ArrayXd help,multn;
+
+    Vr.setZero(beta.size());
+    Vt.setZero(beta.size());
+    for (n = 1; n <= nterms; n++) {
+        /*
+         * Stop when the series has converged for all field points,
+         * the points which converged earlier do not get any more terms
+         */
+        if (beta.size() == 0 || betan.maxCoeff() < EPS)
+            break;
+        if (n > 1) {
+            help = p0;
+            p0   = rec.a0[n]*cgamma*p0 - rec.b0[n]*p01;
+            p01  = help;
+            help = p1;
+            p1   = rec.a1[n]*cgamma*p1 - rec.b1[n]*p11;
+            p11  = help;
+        }
+        multn = (betan < EPS).select(0.0,fn[n-1]*betan);	/* The 2*n + 1 factor is included in fn */
+        Vr += multn*p0;
+        Vt += rec.n_inv[n]*multn*p1;
+        betan *= beta;
+    }
+}
+
 //=============================================================================================================
 // fwd_multi_spherepot.c
 int FwdEegSphereModel::fwd_eeg_multi_spherepot(float *rd, float *Q, float **el, int neeg, float *Vval, void *client)	  /* The model definition */
@@ -531,12 +670,11 @@ int FwdEegSphereModel::fwd_eeg_multi_spherepot(float *rd, float *Q, float **el,
  */
 {
     FwdEegSphereModel* m = (FwdEegSphereModel*)client;
-    float  my_rd[3],pos[3];
-    int    k,p;
-    float  pos2,rd_len,pos_len;
-    double beta,cos_gamma,Vr,Vt;
-    float  vec1[3],vec2[3],v1,v2;
-    float  cos_beta,Qr,Qt,Q2,c;
+    Vector3f my_rd,vec1;
+    Matrix3Xf pos;
+    int    k;
+    float  rd_len;
+    float  v1,Qr,Qt,Q2,c;
     float  pi4_inv = 0.25/M_PI;
     float  sigmaM_inv;
     /*
@@ -551,11 +689,10 @@ int FwdEegSphereModel::fwd_eeg_multi_spherepot(float *rd, float *Q, float **el,
     /*
        * Move to the sphere coordinates
        */
-    for (p = 0; p < 3; p++)
-        my_rd[p] = rd[p] - m->r0[p];
-    rd = my_rd;
-    rd_len = VEC_LEN_1(rd);
-    Q2     = VEC_DOT_1(Q,Q);
+    my_rd  = Map<const Vector3f>(rd) - m->r0;
+    rd_len = my_rd.norm();
+    Map<const Vector3f> my_Q(Q);
+    Q2     = my_Q.squaredNorm();
     /*
        * Ignore dipoles outside the innermost sphere
        */
@@ -567,69 +704,54 @@ int FwdEegSphereModel::fwd_eeg_multi_spherepot(float *rd, float *Q, float **el,
     /*
        * Special case: rd and Q are parallel
        */
-    c = VEC_DOT_1(rd,Q)/(rd_len*sqrt(Q2));
+    c = my_rd.dot(my_Q)/(rd_len*sqrt(Q2));
     if ((1.0-c*c) < SIN_EPS)	{	/* Almost parallel:
                          * Q is purely radial */
         Qr = sqrt(Q2);
         Qt = 0.0;
-        cos_beta = 0.0;
         v1 = 0.0;
-        vec1[0] = vec1[1] = vec1[2] = 0.0;
+        vec1.setZero();
     }
     else {
-        CROSS_PRODUCT_1(rd,Q,vec1);
-        v1 = VEC_LEN_1(vec1);
-        cos_beta = 0.0;
-        Qr = Qt = 0.0;
+        vec1 = my_rd.cross(my_Q);
+        v1 = vec1.norm();
+        Qr = my_Q.dot(my_rd)/rd_len;
+        Qt = sqrt(Q2 - Qr*Qr);
     }
-    for (k = 0; k < neeg; k++) {
-        for (p = 0; p < 3; p++)
-            pos[p] = el[k][p] - m->r0[p];
-        /*
-         * Should the position be scaled or not?
-         */
-        if (m->scale_pos) {
-            pos_len = m->layers[m->nlayer()-1].rad/VEC_LEN_1(pos);
-#ifdef DEBUG
-            printf("%10.4f %10.4f %10.4f %10.4f\n",pos_len,1000*pos[0],1000*pos[1],1000*pos[2]);
-#endif
-            for (p = 0; p < 3; p++)
-                pos[p] = pos_len*pos[p];
-        }
-        pos2 = VEC_DOT_1(pos,pos);
-        pos_len = sqrt(pos2);
-        /*
-         * Calculate the two ingredients for the final result
-         */
-        cos_gamma = VEC_DOT_1(pos,rd)/(rd_len*pos_len);
-        beta = rd_len/pos_len;
-        calc_pot_components(beta,cos_gamma,&Vr,&Vt,m->fn,m->nterms);
-        /*
-         * Then compute the combined result
-         */
-        if (v1 > 0.0) {
-            CROSS_PRODUCT_1(rd,pos,vec2);
-            v2 = VEC_LEN_1(vec2);
-
-            if (v2  > 0.0)
-                cos_beta = VEC_DOT_1(vec1,vec2)/(v1*v2);
-            else
-                cos_beta = 0.0;
+    /*
+       * All electrodes are handled at once
+       */
+    sphere_electrode_positions(m,el,neeg,pos);
 
-            Qr = VEC_DOT_1(Q,rd)/rd_len;
-            Qt = sqrt(Q2 - Qr*Qr);
-        }
-        Vval[k] = pi4_inv*(Qr*Vr + Qt*cos_beta*Vt)/pos2;
+    ArrayXd pos2    = pos.colwise().squaredNorm().transpose().cast<double>();
+    ArrayXd pos_len = pos2.sqrt();
+    ArrayXd rd_pos  = (pos.transpose()*my_rd).cast<double>().array();
+    ArrayXd Vr,Vt;
+    /*
+       * Calculate the two ingredients for the final result
+       */
+    calc_pot_components_vec(rd_len/pos_len,rd_pos/(rd_len*pos_len),Vr,Vt,m->fn,m->nterms);
+    /*
+       * Then compute the combined result. With vec2 = rd x pos we have
+       * vec1.vec2 = pos.(vec1 x rd) and |vec2|^2 = |rd|^2|pos|^2 - (rd.pos)^2
+       */
+    ArrayXd V = Qr*Vr;
+    if (v1 > 0.0) {
+        Vector3f u  = vec1.cross(my_rd);
+        ArrayXd  v2 = (rd_len*rd_len*pos2 - rd_pos.square()).max(0.0).sqrt();
+        ArrayXd  cos_beta = (v2 > 0.0).select((pos.transpose()*u).cast<double>().array()/(v1*v2),0.0);
+        V += Qt*cos_beta*Vt;
     }
+    V = pi4_inv*V/pos2;
     /*
        * Scale by the conductivity if we have the layers
        * defined
        */
     if (m->nlayer() > 0) {
         sigmaM_inv = 1.0/m->layers[m->nlayer()-1].sigma;
-        for (k = 0; k < neeg; k++)
-            Vval[k] = Vval[k]*sigmaM_inv;
+        V *= sigmaM_inv;
     }
+    Map<VectorXf>(Vval,neeg) = V.cast<float>().matrix();
     return OK;
 }
 
@@ -644,29 +766,27 @@ int FwdEegSphereModel::fwd_eeg_multi_spherepot_coil1(float *rd, float *Q, FwdCoi
  *
  */
 {
-    float *vval_one = NULL,val;
-    int   nvval = 0;
-    int   k,c;
+    QVector<float*> points;
+    VectorXf vval_all;
+    float val;
+    int   k,c,q;
     FwdCoil* el;
+    /*
+     * Evaluate all integration points in one go
+     */
+    vval_all.resize(eeg_coil_points(els,points));
+    if (fwd_eeg_multi_spherepot(rd,Q,points.data(),points.size(),vval_all.data(),client) != OK)
+        return FAIL;
 
-    for (k = 0; k < els->ncoil; k++, el++) {
+    for (k = 0, q = 0; k < els->ncoil; k++) {
         el = els->coils[k];
         if (el->coil_class == FWD_COILC_EEG) {
-            if (el->np > nvval) {
-                vval_one = REALLOC_1(vval_one,el->np,float);
-                nvval = el->np;
-            }
-            if (fwd_eeg_multi_spherepot(rd,Q,el->rmag,el->np,vval_one,client) != OK) {
-                FREE(vval_one);
-                return FAIL;
-            }
-            for (c = 0, val = 0.0; c < el->np; c++)
-                val += el->w[c]*vval_one[c];
+            for (c = 0, val = 0.0; c < el->np; c++, q++)
+                val += el->w[c]*vval_all[q];
             *Vval = val;
         }
         Vval++;
     }
-    FREE(vval_one);
     return OK;
 }
 
@@ -676,21 +796,14 @@ bool FwdEegSphereModel::fwd_eeg_spherepot_vec( float   *rd, float   **el, int ne
 {
     FwdEegSphereModel* m = (FwdEegSphereModel*)client;
     float fact = 0.25f/(float)M_PI;
-    float a_vec[3];
-    float a,a2,a3;
-    float rrd,rd2,rd2_inv,r,r2,ra,rda;
-    float F;
-    float c1,c2,m1,m2;
-    int   k,p,eq;
-    float *this_pos;
-    float orig_rd[3],scaled_rd[3];
-    float pos[3],pos_len;
+    Vector3f orig_rd;
+    Matrix3Xf pos;
+    ArrayXf M1,M2;
+    int   k,p;
     /*
    * Shift to the sphere model coordinates
    */
-    for (p = 0; p < 3; p++)
-        orig_rd[p] = rd[p] - m->r0[p];
-    rd = scaled_rd;
+    orig_rd = Map<const Vector3f>(rd) - m->r0;
     /*
    * Initialize the arrays
    */
@@ -702,83 +815,18 @@ bool FwdEegSphereModel::fwd_eeg_spherepot_vec( float   *rd, float   **el, int ne
     /*
    * Ignore dipoles outside the innermost sphere
    */
-    if (VEC_LEN_1(orig_rd) >= m->layers[0].rad)
+    if (orig_rd.norm() >= m->layers[0].rad)
         return true;
     /*
-   * Default to homogeneous model if no model was previously set
+   * Make a weighted sum over the equivalence parameters for all electrodes at once
    */
-#ifdef FOO
-    if (nequiv == 0) /* what to do */
-        eeg_set_homog_sphere_model();
-#endif
-    /*
-   * Make a weighted sum over the equivalence parameters
-   */
-    for (eq = 0; eq < m->nfit; eq++) {
-        /*
-     * Scale the dipole position
-     */
-        for (p = 0; p < 3; p++)
-            rd[p] = m->mu[eq]*orig_rd[p];
-
-        rd2     = VEC_DOT_1(rd,rd);
-        rd2_inv = 1.0/rd2;
-
-        /*
-     * Go over all electrodes
-     */
-        for (k = 0; k < neeg ; k++) {
-            this_pos = el[k];
-
-            for (p = 0; p < 3; p++)
-                pos[p] = this_pos[p] - m->r0[p];
-            /*
-       * Scale location onto the surface of the sphere
-       */
-            if (m->scale_pos) {
-                pos_len = m->layers[m->nlayer()-1].rad/VEC_LEN_1(pos);
-                for (p = 0; p < 3; p++)
-                    pos[p] = pos_len*pos[p];
-            }
-            this_pos = pos;
-
-            /* Vector from dipole to the field point */
-
-            VEC_DIFF_1 (rd,this_pos,a_vec);
-
-            /* Compute the dot products needed */
-
-            a2  = VEC_DOT_1(a_vec,a_vec);       a = sqrt(a2);
-            a3  = 2.0/(a2*a);
-            r2  = VEC_DOT_1(this_pos,this_pos); r = sqrt(r2);
-            rrd = VEC_DOT_1(this_pos,rd);
-            ra  = r2 - rrd;
-            rda = rrd - rd2;
-
-            /* The main ingredients */
-
-            F  = a*(r*a + ra);
-            c1 = a3*rda + 1.0/a - 1.0/r;
-            c2 = a3 + (a+r)/(r*F);
-
-            /* Mix them together and scale by lambda/(rd*rd) */
-
-            m1 = (c1 - c2*rrd);
-            m2 = c2*rd2;
-
-            Vval_vec[X_1][k] = Vval_vec[X_1][k] + m->lambda[eq]*rd2_inv*(m1*rd[X_1] + m2*this_pos[X_1]);
-            Vval_vec[Y_1][k] = Vval_vec[Y_1][k] + m->lambda[eq]*rd2_inv*(m1*rd[Y_1] + m2*this_pos[Y_1]);
-            Vval_vec[Z_1][k] = Vval_vec[Z_1][k] + m->lambda[eq]*rd2_inv*(m1*rd[Z_1] + m2*this_pos[Z_1]);
-        }             /* All electrodes done */
-    }               /* All equivalent dipoles done */
+    sphere_electrode_positions(m,el,neeg,pos);
+    berg_scherg_weights(m,orig_rd,pos,M1,M2);
     /*
    * Finish by scaling by 1/(4*M_PI);
    */
-    for (k = 0; k  < neeg; k++) {
-        Vval_vec[X_1][k] = fact*Vval_vec[X_1][k];
-        Vval_vec[Y_1][k] = fact*Vval_vec[Y_1][k];
-        Vval_vec[Z_1][k] = fact*Vval_vec[Z_1][k];
-    }
+    for (p = 0; p < 3; p++)
+        Map<ArrayXf>(Vval_vec[p],neeg) = fact*(M1*orig_rd[p] + M2*pos.row(p).transpose().array());
     return true;
 }
 
@@ -786,32 +834,33 @@ bool FwdEegSphereModel::fwd_eeg_spherepot_vec( float   *rd, float   **el, int ne
 // fwd_multi_spherepot.c
 int FwdEegSphereModel::fwd_eeg_spherepot_coil_vec(float *rd, FwdCoilSet* els, float **Vval_vec, void *client)
 {
-    float **vval_one = NULL;
+    QVector<float*> points;
+    float **vval_all = NULL;
     float val;
-    int   nvval = 0;
-    int   k,c,p;
+    int   k,c,p,q;
     FwdCoil* el;
-
-    for (k = 0; k < els->ncoil; k++, el++) {
+    /*
+     * Evaluate all integration points in one go
+     */
+    if (eeg_coil_points(els,points) == 0)
+        return OK;
+    vval_all = ALLOC_CMATRIX_1(3,points.size());
+    if (!fwd_eeg_spherepot_vec(rd,points.data(),points.size(),vval_all,client)) {
+        FREE_CMATRIX_1(vval_all);
+        return FAIL;
+    }
+    for (k = 0, q = 0; k < els->ncoil; k++) {
         el = els->coils[k];
         if (el->coil_class == FWD_COILC_EEG) {
-            if (el->np > nvval) {
-                FREE_CMATRIX_1(vval_one);
-                vval_one = ALLOC_CMATRIX_1(3,el->np);
-                nvval = el->np;
-            }
-            if (!fwd_eeg_spherepot_vec(rd,el->rmag,el->np,vval_one,client)) {
-                FREE_CMATRIX_1(vval_one);
-                return FAIL;
-            }
             for (p = 0; p < 3; p++) {
                 for (c = 0, val = 0.0; c < el->np; c++)
-                    val += el->w[c]*vval_one[p][c];
+                    val += el->w[c]*vval_all[p][q+c];
                 Vval_vec[p][k] = val;
             }
+            q += el->np;
         }
     }
-    FREE_CMATRIX_1(vval_one);
+    FREE_CMATRIX_1(vval_all);
     return OK;
 }
 
@@ -872,103 +921,32 @@ int FwdEegSphereModel::fwd_eeg_spherepot(   float   *rd,       /* Dipole positio
 {
     FwdEegSphereModel* m = (FwdEegSphereModel*)client;
     float fact = 0.25f/M_PI;
-    float a_vec[3];
-    float a,a2,a3;
-    float rrd,rd2,rd2_inv,r,r2,ra,rda;
-    float F;
-    float c1,c2,m1,m2,f1,f2;
-    int   k,p,eq;
-    float *this_pos;
-    float orig_rd[3],scaled_rd[3];
-    float pos[3],pos_len;
+    Vector3f orig_rd;
+    Matrix3Xf pos;
+    ArrayXf M1,M2;
     /*
    * Shift to the sphere model coordinates
    */
-    for (p = 0; p < 3; p++)
-        orig_rd[p] = rd[p] - m->r0[p];
-    rd = scaled_rd;
+    orig_rd = Map<const Vector3f>(rd) - m->r0;
     /*
    * Initialize the arrays
    */
-    for (k = 0 ; k < neeg ; k++)
-        Vval[k] = 0.0;
+    Vval.setZero(neeg);
     /*
    * Ignore dipoles outside the innermost sphere
    */
-    if (VEC_LEN_1(orig_rd) >= m->layers[0].rad)
-        return true;
-    /*
-   * Default to homogeneous model if no model was previously set
-   */
-#ifdef FOO
-    if (nequiv == 0) /* what to do */
-        eeg_set_homog_sphere_model();
-#endif
+    if (orig_rd.norm() >= m->layers[0].rad)
+        return OK;
     /*
-   * Make a weighted sum over the equivalence parameters
+   * Make a weighted sum over the equivalence parameters for all electrodes at once
    */
-    for (eq = 0; eq < m->nfit; eq++) {
-        /*
-     * Scale the dipole position
-     */
-        for (p = 0; p < 3; p++)
-            rd[p] = m->mu[eq]*orig_rd[p];
-
-        rd2     = VEC_DOT_1(rd,rd);
-        rd2_inv = 1.0/rd2;
-
-        f1 = VEC_DOT_1(rd,Q);
-        /*
-     * Go over all electrodes
-     */
-        for (k = 0; k < neeg ; k++) {
-            this_pos = el[k];
-
-            for (p = 0; p < 3; p++)
-                pos[p] = this_pos[p] - m->r0[p];
-            /*
-       * Scale location onto the surface of the sphere
-       */
-            if (m->scale_pos) {
-                pos_len = m->layers[m->nlayer()-1].rad/VEC_LEN_1(pos);
-                for (p = 0; p < 3; p++)
-                    pos[p] = pos_len*pos[p];
-            }
-            this_pos = pos;
-
-            /* Vector from dipole to the field point */
-
-            VEC_DIFF_1 (rd,this_pos,a_vec);
-
-            /* Compute the dot products needed */
-
-            a2  = VEC_DOT_1(a_vec,a_vec);       a = sqrt(a2);
-            a3  = 2.0/(a2*a);
-            r2  = VEC_DOT_1(this_pos,this_pos); r = sqrt(r2);
-            rrd = VEC_DOT_1(this_pos,rd);
-            ra  = r2 - rrd;
-            rda = rrd - rd2;
-
-            /* The main ingredients */
-
-            F  = a*(r*a + ra);
-            c1 = a3*rda + 1.0/a - 1.0/r;
-            c2 = a3 + (a+r)/(r*F);
-
-            /* Mix them together and scale by lambda/(rd*rd) */
-
-            m1 = (c1 - c2*rrd);
-            m2 = c2*rd2;
-
-            f2 = VEC_DOT_1(this_pos,Q);
-            Vval[k] = Vval[k] + m->lambda[eq]*rd2_inv*(m1*f1 + m2*f2);
-        }             /* All electrodes done */
-    }               /* All equivalent dipoles done */
+    Map<const Vector3f> my_Q(Q);
+    sphere_electrode_positions(m,el,neeg,pos);
+    berg_scherg_weights(m,orig_rd,pos,M1,M2);
     /*
    * Finish by scaling by 1/(4*M_PI);
    */
-    for (k = 0; k  < neeg; k++)
-        Vval[k] = fact*Vval[k];
+    Vval = fact*(M1*orig_rd.dot(my_Q) + M2*(pos.transpose()*my_Q).array()).matrix();
     return OK;
 }
 
@@ -976,24 +954,23 @@ int FwdEegSphereModel::fwd_eeg_spherepot(   float   *rd,       /* Dipole positio
 // fwd_multi_spherepot.c
 int FwdEegSphereModel::fwd_eeg_spherepot_coil(  float *rd, float *Q, FwdCoilSet* els, float *Vval, void *client)
 {
-    VectorXf vval_one;
+    QVector<float*> points;
+    VectorXf vval_all;
     float val;
-    int   nvval = 0;
-    int   k,c;
+    int   k,c,q;
     FwdCoil* el;
+    /*
+     * Evaluate all integration points in one go
+     */
+    eeg_coil_points(els,points);
+    if (fwd_eeg_spherepot(rd,Q,points.data(),points.size(),vval_all,client) != OK)
+        return FAIL;
 
-    for (k = 0; k < els->ncoil; k++, el++) {
+    for (k = 0, q = 0; k < els->ncoil; k++) {
         el = els->coils[k];
         if (el->coil_class == FWD_COILC_EEG) {
-            if (el->np > nvval) {
-                vval_one.resize(el->np);
-                nvval = el->np;
-            }
-            if (fwd_eeg_spherepot(rd,Q,el->rmag,el->np,vval_one,client) != OK) {
-                return FAIL;
-            }
-            for (c = 0, val = 0.0; c < el->np; c++)
-                val += el->w[c]*vval_one[c];
+            for (c = 0, val = 0.0; c < el->np; c++, q++)
+                val += el->w[c]*vval_all[q];
             *Vval = val;
         }
         Vval++;
@@ -1006,7 +983,7 @@ int FwdEegSphereModel::fwd_eeg_spherepot_coil(  float *rd, float *Q, FwdCoilSet*
 bool FwdEegSphereModel::fwd_setup_eeg_sphere_model(float rad, bool fit_berg_scherg, int nfit)
 {
     int nterms = 200;
-    float  rv;
+    float  rv = 1.0;
 
     /*
      * Scale the relative radiuses
@@ -1015,14 +992,22 @@ bool FwdEegSphereModel::fwd_setup_eeg_sphere_model(float rad, bool fit_berg_sche
         this->layers[k].rad = rad*this->layers[k].rel_rad;
 
     if (fit_berg_scherg) {
-        if (this->fwd_eeg_fit_berg_scherg(nterms,nfit,rv)) {
+        bool fitted = this->fwd_eeg_fit_berg_scherg(nterms,nfit,rv);
+        if (fitted) {
             printf("Equiv. model fitting -> ");
             printf("RV = %g %%\n",100*rv);
             for (int k = 0; k < nfit; k++)
                 printf("mu%d = %g\tlambda%d = %g\n", k+1,this->mu[k],k+1,this->layers[this->nlayer()-1].sigma*this->lambda[k]);
         }
-        else
-            return false;
+        /*
+         * The equivalent dipoles are only a speedup, use the exact series expansion if they do not fit well
+         */
+        if (!fitted || !(rv <= MAX_BERG_SCHERG_RV)) {
+            printf("Equiv. model fitting not accurate enough. Using the series expansion instead.\n");
+            this->mu.resize(0);
+            this->lambda.resize(0);
+            this->nfit = 0;
+        }
     }
 
     printf("Defined EEG sphere model with rad = %7.2f mm\n", 1000.0*rad);
@@ -168,6 +168,25 @@ public:
                     const Eigen::VectorXd& fn,
                     int    nterms);
 
+    //=========================================================================================================
+    /**
+     * Vectorized version of calc_pot_components: evaluates the series for many field points at once. The
+     * Legendre recurrences run over all points in parallel until the series has converged everywhere.
+     *
+     * @param[in] beta       rd/r for each field point.
+     * @param[in] cgamma     Cosine of the angle between the source and each field point.
+     * @param[out] Vr        Potential components for the radial dipole.
+     * @param[out] Vt        Potential components for the tangential dipole.
+     * @param[in] fn         The model coefficients, including the 2*n + 1 factor.
+     * @param[in] nterms     The maximum number of terms.
+     */
+    static void calc_pot_components_vec(const Eigen::ArrayXd& beta,
+                                        const Eigen::ArrayXd& cgamma,
+                                        Eigen::ArrayXd& Vr,
+                                        Eigen::ArrayXd& Vt,
+                                        const Eigen::VectorXd& fn,
+                                        int nterms);
+
     static int fwd_eeg_multi_spherepot(float   *rd,	          /* Dipole position */
                        float   *Q,	          /* Dipole moment */
                        float   **el,	  /* Electrode positions */
@@ -278,7 +297,8 @@ public:
     /**
      * fwd_eeg_sphere_models.c
      *
-     * Setup the EEG sphere model calculations
+     * Setup the EEG sphere model calculations. If the Berg-Scherg fit fails or its relative residual variance
+     * exceeds 1 %, nfit is left at zero and the exact series expansion is used instead.
      *
      * @param[in] rad.
      * @param[in] fit_berg_scherg    If Fit Berg Scherg should be performed.
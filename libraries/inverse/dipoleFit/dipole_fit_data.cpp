@@ -3502,8 +3502,17 @@ int DipoleFitData::setup_forward_model(DipoleFitData *d, MneCTFCompDataSet* comp
     d->sphere_funcs = f = new_dipole_fit_funcs();
     if (d->neeg > 0) {
         VEC_COPY_3(d->eeg_model->r0,d->r0);
-        f->eeg_pot     = FwdEegSphereModel::fwd_eeg_spherepot_coil;
-        f->eeg_vec_pot = FwdEegSphereModel::fwd_eeg_spherepot_coil_vec;
+        if (d->eeg_model->nfit == 0) {
+            /*
+             * No equivalent dipoles available, use the series expansion
+             */
+            f->eeg_pot     = FwdEegSphereModel::fwd_eeg_multi_spherepot_coil1;
+            f->eeg_vec_pot = NULL;
+        }
+        else {
+            f->eeg_pot     = FwdEegSphereModel::fwd_eeg_spherepot_coil;
+            f->eeg_vec_pot = FwdEegSphereModel::fwd_eeg_spherepot_coil_vec;
+        }
         f->eeg_client  = d->eeg_model;
     }
     if (d->nmeg > 0) {
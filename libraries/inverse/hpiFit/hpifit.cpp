@@ -82,8 +82,10 @@ using namespace FWDLIB;
 //=============================================================================================================
 
 HPIFit::HPIFit(FiffInfo::SPtr pFiffInfo,
-               bool bDoFastFit)
+               bool bDoFastFit,
+               bool bDoGradientFit)
     : m_bDoFastFit(bDoFastFit)
+    , m_bDoGradientFit(bDoGradientFit)
 {
     // init member variables
     m_lChannels = QList<FIFFLIB::FiffChInfo>();
@@ -444,6 +446,7 @@ CoilParam HPIFit::dipfit(struct CoilParam coil,
         coilData.m_matProjector = t_matProjectors;
         coilData.m_iMaxIterations = iMaxIterations;
         coilData.m_fAbortError = fAbortError;
+        coilData.m_bDoGradientFit = m_bDoGradientFit;
 
         lCoilData.append(coilData);
     }
@@ -550,34 +553,22 @@ void HPIFit::createSensorSet(SensorSet& sensors,
 
     // init sensor struct
     int iNp = coils->coils[0]->np;
-    sensors.w = RowVectorXd(iNchan*iNp);
     sensors.r0 = MatrixXd(iNchan,3);
-    sensors.cosmag = MatrixXd(iNchan*iNp,3);
-    sensors.rmag = MatrixXd(iNchan*iNp,3);
     sensors.ncoils = iNchan;
     sensors.tra = MatrixXd::Identity(iNchan,iNchan);
     sensors.np = iNp;
 
+    // The integration points of all coils are packed contiguously in the coil set
+    sensors.w = coils->w_all.transpose().cast<double>();
+    sensors.cosmag = coils->cosmag_all.transpose().cast<double>();
+    sensors.rmag = coils->rmag_all.transpose().cast<double>();
+
     for(int i = 0; i < iNchan; i++){
         FwdCoil* coil = (coils->coils[i]);
-        MatrixXd matRmag = MatrixXd::Zero(iNp,3);
-        MatrixXd matCosmag = MatrixXd::Zero(iNp,3);
-        RowVectorXd vecW(iNp);
 
         sensors.r0(i,0) = coil->r0[0];
         sensors.r0(i,1) = coil->r0[1];
         sensors.r0(i,2) = coil->r0[2];
-
-        for (int p = 0; p < iNp; p++){
-            sensors.w(i*iNp+p) = coil->w[p];
-            for (int c = 0; c < 3; c++) {
-                matRmag(p,c)   = coil->rmag[p][c];
-                matCosmag(p,c) = coil->cosmag[p][c];
-            }
-        }
-
-        sensors.cosmag.block(i*iNp,0,iNp,3) = matCosmag;
-        sensors.rmag.block(i*iNp,0,iNp,3) = matRmag;
     }
 }
 
@@ -146,9 +146,11 @@ public:
      *
      * @param[in] pFiffInfo        Associated Fiff Information.
      * @param[in] bDoFastFit       Do the fast fit by fitting to the more basic Model.
+     * @param[in] bDoGradientFit   Fit the dipoles with the gradient based Levenberg-Marquardt optimizer instead of the simplex.
      */
     explicit HPIFit(QSharedPointer<FIFFLIB::FiffInfo> pFiffInfo,
-                    bool bDoFastFit = false);
+                    bool bDoFastFit = false,
+                    bool bDoGradientFit = false);
 
     //=========================================================================================================
     /**
@@ -308,6 +310,7 @@ private:
 
     Eigen::MatrixXd     m_matModel;         /**< The model that contains the sines/cosines for the hpi fit*/
     bool                m_bDoFastFit;       /**< Do fast fit. */
+    bool                m_bDoGradientFit;   /**< Use the gradient based optimizer for the dipole fit. */
     QSharedPointer<FWDLIB::FwdCoilSet>  m_pCoilTemplate;    /**< */
     QSharedPointer<FWDLIB::FwdCoilSet>  m_pCoilMeg;         /**< */
     QVector<int>        m_vecFreqs;         /**< The frequencies for each coil in unknown order. */
@@ -49,6 +49,8 @@
 // EIGEN INCLUDES
 //=============================================================================================================
 
+#include <Eigen/Dense>
+
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
@@ -70,6 +72,9 @@ using namespace INVERSELIB;
 //=============================================================================================================
 
 HPIFitData::HPIFitData()
+: m_iMaxIterations(500)
+, m_fAbortError(1e-9f)
+, m_bDoGradientFit(false)
 {
 }
 
@@ -80,96 +85,121 @@ void HPIFitData::doDipfitConcurrent()
     // Initialize variables
     Eigen::RowVectorXd vecCurrentCoil = this->m_coilPos;
     Eigen::VectorXd vecCurrentData = this->m_sensorData;
-    SensorSet currentSensors = this->m_sensors;
 
     int iDisplay = 0;
     int iMaxiter = m_iMaxIterations;
     int iSimplexNumitr = 0;
 
-    this->m_coilPos = fminsearch(vecCurrentCoil,
-                               iMaxiter,
-                               2 * iMaxiter * vecCurrentCoil.cols(),
-                               iDisplay,
-                               vecCurrentData,
-                               this->m_matProjector,
-                               currentSensors,
-                               iSimplexNumitr);
+    if(m_bDoGradientFit) {
+        this->m_coilPos = levenbergMarquardt(vecCurrentCoil,
+                                             iMaxiter,
+                                             vecCurrentData,
+                                             this->m_matProjector,
+                                             this->m_sensors,
+                                             iSimplexNumitr);
+    } else {
+        this->m_coilPos = fminsearch(vecCurrentCoil,
+                                     iMaxiter,
+                                     2 * iMaxiter * vecCurrentCoil.cols(),
+                                     iDisplay,
+                                     vecCurrentData,
+                                     this->m_matProjector,
+                                     this->m_sensors,
+                                     iSimplexNumitr);
+    }
 
     this->m_errorInfo = dipfitError(vecCurrentCoil,
-                                  vecCurrentData,
-                                  currentSensors,
-                                  this->m_matProjector);
+                                    vecCurrentData,
+                                    this->m_sensors,
+                                    this->m_matProjector);
 
     this->m_errorInfo.numIterations = iSimplexNumitr;
 }
 
 //=============================================================================================================
 
-Eigen::MatrixXd HPIFitData::magnetic_dipole(Eigen::MatrixXd matPos,
-                                            Eigen::MatrixXd matPnt,
-                                            Eigen::MatrixXd matOri)
+Eigen::MatrixXd HPIFitData::magnetic_dipole(const Eigen::MatrixXd& matPos,
+                                            const Eigen::MatrixXd& matPnt,
+                                            const Eigen::MatrixXd& matOri)
 {
     double u0 = 1e-7;
-    int iNchan;
-    Eigen::MatrixXd r, r2, r5, x, y, z, mx, my, mz, Tx, Ty, Tz, lf;
-
-    iNchan = matPnt.rows();
 
     // Shift the magnetometers so that the dipole is in the origin
-    matPnt.array().col(0) -=matPos(0);
-    matPnt.array().col(1) -=matPos(1);
-    matPnt.array().col(2) -=matPos(2);
+    Eigen::ArrayXd x = matPnt.col(0).array() - matPos(0);
+    Eigen::ArrayXd y = matPnt.col(1).array() - matPos(1);
+    Eigen::ArrayXd z = matPnt.col(2).array() - matPos(2);
 
-    r = matPnt.array().square().rowwise().sum().sqrt();
+    Eigen::ArrayXd r2 = x.square() + y.square() + z.square();
+    Eigen::ArrayXd scale = u0 / (4 * M_PI * r2.square() * r2.sqrt());
+    Eigen::ArrayXd rDotOri = x * matOri.col(0).array() + y * matOri.col(1).array() + z * matOri.col(2).array();
 
-    r2 = r5 = x = y = z = mx = my = mz = Tx = Ty = Tz = lf = Eigen::MatrixXd::Zero(iNchan,3);
+    // lf = (3 * r * (r . ori) - ori * r^2) / r^5
+    Eigen::MatrixXd lf(matPnt.rows(), 3);
+    lf.col(0) = ((3 * x * rDotOri - matOri.col(0).array() * r2) * scale).matrix();
+    lf.col(1) = ((3 * y * rDotOri - matOri.col(1).array() * r2) * scale).matrix();
+    lf.col(2) = ((3 * z * rDotOri - matOri.col(2).array() * r2) * scale).matrix();
 
-    for(int i = 0;i < iNchan;i++) {
-        r2.row(i).array().fill(pow(r(i),2));
-        r5.row(i).array().fill(pow(r(i),5));
-    }
+    return lf;
+}
 
-    for(int i = 0;i < iNchan;i++) {
-        x.row(i).array().fill(matPnt(i,0));
-        y.row(i).array().fill(matPnt(i,1));
-        z.row(i).array().fill(matPnt(i,2));
-    }
+//=============================================================================================================
 
-    mx.col(0).array().fill(1);
-    my.col(1).array().fill(1);
-    mz.col(2).array().fill(1);
+Eigen::MatrixXd HPIFitData::magnetic_dipole_gradient(const Eigen::MatrixXd& matPos,
+                                                     const Eigen::Vector3d& vecMoment,
+                                                     const Eigen::MatrixXd& matPnt,
+                                                     const Eigen::MatrixXd& matOri)
+{
+    double u0 = 1e-7;
 
-    Tx = 3 * x.cwiseProduct(matPnt) - mx.cwiseProduct(r2);
-    Ty = 3 * y.cwiseProduct(matPnt) - my.cwiseProduct(r2);
-    Tz = 3 * z.cwiseProduct(matPnt) - mz.cwiseProduct(r2);
+    Eigen::ArrayXd x = matPnt.col(0).array() - matPos(0);
+    Eigen::ArrayXd y = matPnt.col(1).array() - matPos(1);
+    Eigen::ArrayXd z = matPnt.col(2).array() - matPos(2);
+
+    Eigen::ArrayXd r2 = x.square() + y.square() + z.square();
+    Eigen::ArrayXd scale = u0 / (4 * M_PI * r2.square() * r2.sqrt());
+    Eigen::ArrayXd rDotOri = x * matOri.col(0).array() + y * matOri.col(1).array() + z * matOri.col(2).array();
+    Eigen::ArrayXd rDotMom = x * vecMoment(0) + y * vecMoment(1) + z * vecMoment(2);
+    Eigen::ArrayXd momDotOri = matOri.col(0).array() * vecMoment(0)
+                               + matOri.col(1).array() * vecMoment(1)
+                               + matOri.col(2).array() * vecMoment(2);
+
+    // B = (3 (r.m)(r.n) - (m.n) r^2) / r^5
+    // dB/dr = (3 (m (r.n) + n (r.m)) + (3 (m.n) - 15 (r.m)(r.n) / r^2) r) / r^5
+    // The dipole position enters with a negative sign, r = pnt - pos.
+    Eigen::ArrayXd radial = 3 * momDotOri - 15 * rDotMom * rDotOri / r2;
+
+    Eigen::MatrixXd grad(matPnt.rows(), 3);
+    grad.col(0) = (-(3 * (vecMoment(0) * rDotOri + matOri.col(0).array() * rDotMom) + radial * x) * scale).matrix();
+    grad.col(1) = (-(3 * (vecMoment(1) * rDotOri + matOri.col(1).array() * rDotMom) + radial * y) * scale).matrix();
+    grad.col(2) = (-(3 * (vecMoment(2) * rDotOri + matOri.col(2).array() * rDotMom) + radial * z) * scale).matrix();
+
+    return grad;
+}
 
-    for(int i = 0;i < iNchan;i++) {
-        lf(i,0) = Tx.row(i).dot(matOri.row(i));
-        lf(i,1) = Ty.row(i).dot(matOri.row(i));
-        lf(i,2) = Tz.row(i).dot(matOri.row(i));
-    }
+//=============================================================================================================
 
-    for(int i = 0;i < iNchan;i++) {
-        for(int j = 0;j < 3;j++) {
-            lf(i,j) = u0 * lf(i,j)/(4 * M_PI * r5(i,j));
-        }
+Eigen::MatrixXd HPIFitData::integrate_coils(const Eigen::MatrixXd& matPoints,
+                                            const SensorSet& sensors)
+{
+    int iNp = sensors.np;
+    Eigen::MatrixXd matCoils(sensors.ncoils, matPoints.cols());
+
+    // Integration points of one coil are stored contiguously, which allows to view each column as a np x ncoils matrix
+    for(int j = 0; j < matPoints.cols(); ++j) {
+        Eigen::Map<const Eigen::MatrixXd> matColumn(matPoints.col(j).data(), iNp, sensors.ncoils);
+        Eigen::Map<const Eigen::MatrixXd> matWeights(sensors.w.data(), iNp, sensors.ncoils);
+        matCoils.col(j) = matColumn.cwiseProduct(matWeights).colwise().sum().transpose();
     }
 
-    return lf;
+    return matCoils;
 }
 
 //=============================================================================================================
 
 Eigen::MatrixXd HPIFitData::compute_leadfield(const Eigen::MatrixXd& matPos, const SensorSet& sensors)
 {
-
-    Eigen::MatrixXd matPnt, matOri, matLf;
-    matPnt = sensors.rmag; // position of each integrationpoint
-    matOri = sensors.cosmag; // mOrientation of each coil
-
-    matLf = magnetic_dipole(matPos, matPnt, matOri);
-
-    return matLf;
+    // position of each integrationpoint and orientation of each coil
+    return magnetic_dipole(matPos, sensors.rmag, sensors.cosmag);
 }
 
 //=============================================================================================================
@@ -181,24 +211,15 @@ DipFitError HPIFitData::dipfitError(const Eigen::MatrixXd& matPos,
 {
     // Variable Declaration
     struct DipFitError e;
-    Eigen::MatrixXd matLfSensor, matDif;
-    Eigen::MatrixXd matLf(matData.size(),3);
-    int iNp = sensors.np;
+    Eigen::MatrixXd matLf, matDif;
 
-    // calculate lf for all sensorpoints
-    matLfSensor = compute_leadfield(matPos, sensors);
-
-    // apply averaging per coil
-    for(int i = 0; i < sensors.ncoils; i++){
-        matLf.row(i) = sensors.w.segment(i*iNp,iNp) * matLfSensor.block(i*iNp,0,iNp,matLfSensor.cols());
-    }
-    //matLf = sensors.tra * matLf;
+    // calculate lf for all sensorpoints and apply averaging per coil
+    matLf = integrate_coils(compute_leadfield(matPos, sensors), sensors);
 
     // Compute lead field for a magnetic dipole in infinite vacuum
     e.moment = UTILSLIB::MNEMath::pinv(matLf) * matData;
 
-    //matDif = matData - matLf * e.moment;
-    matDif = matData - matProjectors * matLf * e.moment;
+    matDif = matData - matProjectors * (matLf * e.moment);
 
     e.error = matDif.array().square().sum()/matData.array().square().sum();
 
@@ -458,3 +479,79 @@ Eigen::MatrixXd HPIFitData::fminsearch(const Eigen::MatrixXd& matPos,
     return x;
 }
 
+//=============================================================================================================
+
+Eigen::MatrixXd HPIFitData::levenbergMarquardt(const Eigen::MatrixXd& matPos,
+                                               int iMaxiter,
+                                               const Eigen::MatrixXd& matData,
+                                               const Eigen::MatrixXd& matProjectors,
+                                               const struct SensorSet& sensors,
+                                               int &iNumItr)
+{
+    // The parameter vector holds the dipole position followed by the dipole moment
+    Eigen::Vector3d vecPos = matPos.row(0).transpose();
+    Eigen::Vector3d vecMom = dipfitError(matPos, matData, sensors, matProjectors).moment.col(0);
+    Eigen::VectorXd vecData = matData.col(0);
+
+    double dDataNorm = vecData.squaredNorm();
+    double dLambda = 1e-3;
+
+    Eigen::MatrixXd matLf = integrate_coils(compute_leadfield(vecPos.transpose(), sensors), sensors);
+    Eigen::VectorXd vecRes = vecData - matProjectors * (matLf * vecMom);
+    double dCost = vecRes.squaredNorm();
+
+    Eigen::MatrixXd matJ(vecData.size(), 6);
+
+    iNumItr = 0;
+
+    while(iNumItr < iMaxiter) {
+        ++iNumItr;
+
+        // Residual is r = d - P * L(pos) * m, hence J = -P * [dL(pos)m/dpos, L(pos)]
+        matJ.leftCols(3) = -matProjectors * integrate_coils(magnetic_dipole_gradient(vecPos.transpose(), vecMom, sensors.rmag, sensors.cosmag), sensors);
+        matJ.rightCols(3) = -matProjectors * matLf;
+
+        Eigen::Matrix<double,6,6> matJtJ = matJ.transpose() * matJ;
+        Eigen::Matrix<double,6,1> vecJtr = matJ.transpose() * vecRes;
+
+        bool bImproved = false;
+
+        while(!bImproved && dLambda < 1e10) {
+            Eigen::Matrix<double,6,6> matA = matJtJ;
+            matA.diagonal() += dLambda * matJtJ.diagonal();
+            Eigen::Matrix<double,6,1> vecStep = matA.ldlt().solve(-vecJtr);
+
+            Eigen::Vector3d vecPosNew = vecPos + vecStep.head(3);
+            Eigen::Vector3d vecMomNew = vecMom + vecStep.tail(3);
+            Eigen::MatrixXd matLfNew = integrate_coils(compute_leadfield(vecPosNew.transpose(), sensors), sensors);
+            Eigen::VectorXd vecResNew = vecData - matProjectors * (matLfNew * vecMomNew);
+            double dCostNew = vecResNew.squaredNorm();
+
+            if(dCostNew < dCost) {
+                bImproved = true;
+                double dCostChange = (dCost - dCostNew) / dDataNorm;
+                double dPosChange = vecStep.head(3).cwiseAbs().maxCoeff();
+
+                vecPos = vecPosNew;
+                vecMom = vecMomNew;
+                matLf = matLfNew;
+                vecRes = vecResNew;
+                dCost = dCostNew;
+                dLambda = std::max(dLambda / 10.0, 1e-12);
+
+                if((dCostChange <= m_fAbortError) && (dPosChange <= m_fAbortError)) {
+                    return vecPos.transpose();
+                }
+            } else {
+                dLambda *= 10.0;
+            }
+        }
+
+        if(!bImproved) {
+            // No descent direction left, we are at a minimum
+            break;
+        }
+    }
+
+    return vecPos.transpose();
+}
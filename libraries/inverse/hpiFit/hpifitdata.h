@@ -131,16 +131,41 @@ public:
 
     int                     m_iMaxIterations;
     float                   m_fAbortError;
+    bool                    m_bDoGradientFit;
 
 protected:
     //=========================================================================================================
     /**
      * magnetic_dipole leadfield for a magnetic dipole in an infinite medium.
      * The function has been compared with matlab magnetic_dipole and it gives same output.
+     * The integration points are processed column-wise (x, y and z are stored contiguously), which lets Eigen
+     * vectorize the whole sensor vector in one go.
      */
-    Eigen::MatrixXd magnetic_dipole(Eigen::MatrixXd matPos,
-                                    Eigen::MatrixXd matPnt,
-                                    Eigen::MatrixXd matOri);
+    Eigen::MatrixXd magnetic_dipole(const Eigen::MatrixXd& matPos,
+                                    const Eigen::MatrixXd& matPnt,
+                                    const Eigen::MatrixXd& matOri);
+
+    //=========================================================================================================
+    /**
+     * magnetic_dipole_gradient computes the analytic derivative of the field of a magnetic dipole with moment
+     * vecMoment with respect to the dipole position. Each row holds d(B)/d(x,y,z) for one integration point.
+     */
+    Eigen::MatrixXd magnetic_dipole_gradient(const Eigen::MatrixXd& matPos,
+                                             const Eigen::Vector3d& vecMoment,
+                                             const Eigen::MatrixXd& matPnt,
+                                             const Eigen::MatrixXd& matOri);
+
+    //=========================================================================================================
+    /**
+     * Weights the values of all integration points and sums them up per coil.
+     *
+     * @param[in] matPoints     The values per integration point (ncoils*np x n).
+     * @param[in] sensors       The sensor information holding the integration weights.
+     *
+     * @return The values per coil (ncoils x n).
+     */
+    Eigen::MatrixXd integrate_coils(const Eigen::MatrixXd& matPoints,
+                                    const struct SensorSet& sensors);
 
     //=========================================================================================================
     /**
@@ -186,6 +211,28 @@ protected:
                                const Eigen::MatrixXd& matProjectors,
                                const struct SensorSet& sensors,
                                int &iSimplexNumitr);
+
+    //=========================================================================================================
+    /**
+     * Gradient based alternative to fminsearch. Fits dipole position and moment with a Levenberg-Marquardt
+     * scheme using the analytic leadfield gradient, which needs far fewer cost function evaluations than
+     * the simplex.
+     *
+     * @param[in] matPos            The initial dipole position (1x3).
+     * @param[in] iMaxiter          The maximum number of iterations.
+     * @param[in] matData           The measured data per coil.
+     * @param[in] matProjectors     The projectors to apply.
+     * @param[in] sensors           The sensor information.
+     * @param[out] iNumItr          The number of performed iterations.
+     *
+     * @return The fitted dipole position (1x3).
+     */
+    Eigen::MatrixXd levenbergMarquardt(const Eigen::MatrixXd& matPos,
+                                       int iMaxiter,
+                                       const Eigen::MatrixXd& matData,
+                                       const Eigen::MatrixXd& matProjectors,
+                                       const struct SensorSet& sensors,
+                                       int &iNumItr);
 };
 
 //=============================================================================================================
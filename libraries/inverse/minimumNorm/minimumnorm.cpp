@@ -45,6 +45,14 @@
 
 #include <iostream>
 
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QFile>
+#include <QMap>
+#include <QtConcurrent>
+
 //=============================================================================================================
 // EIGEN INCLUDES
 //=============================================================================================================
@@ -68,6 +76,11 @@ using namespace FIFFLIB;
 MinimumNorm::MinimumNorm(const MNEInverseOperator &p_inverseOperator, float lambda, const QString method)
 : m_inverseOperator(p_inverseOperator)
 , inverseSetup(false)
+, m_iSetupNave(-1)
+, m_fSetupLambda(0.0f)
+, m_bSetupdSPM(false)
+, m_bSetupsLORETA(false)
+, m_bSetupPickNormal(false)
 {
     this->setRegularization(lambda);
     this->setMethod(method);
@@ -78,6 +91,11 @@ MinimumNorm::MinimumNorm(const MNEInverseOperator &p_inverseOperator, float lamb
 MinimumNorm::MinimumNorm(const MNEInverseOperator &p_inverseOperator, float lambda, bool dSPM, bool sLORETA)
 : m_inverseOperator(p_inverseOperator)
 , inverseSetup(false)
+, m_iSetupNave(-1)
+, m_fSetupLambda(0.0f)
+, m_bSetupdSPM(false)
+, m_bSetupsLORETA(false)
+, m_bSetupPickNormal(false)
 {
     this->setRegularization(lambda);
     this->setMethod(dSPM, sLORETA);
@@ -193,50 +211,240 @@ MNESourceEstimate MinimumNorm::calculateInverse(const MatrixXd &data, float tmin
         return MNESourceEstimate();
     }
 
-    MatrixXd sol = K * data; //apply imaging kernel
+    MatrixXd sol = applyKernel(data, pick_normal);
 
-    if (inv.source_ori == FIFFV_MNE_FREE_ORI && pick_normal == false)
-    {
-        printf("combining the current components...\n");
+    //Results
+    VectorXi p_vecVertices(inv.src[0].vertno.size() + inv.src[1].vertno.size());
+    p_vecVertices << inv.src[0].vertno, inv.src[1].vertno;
+
+//    VectorXi p_vecVertices();
+//    for(qint32 h = 0; h < inv.src.size(); ++h)
+//        t_qListVertices.push_back(inv.src[h].vertno);
 
-        MatrixXd sol1(sol.rows()/3,sol.cols());
-        for(qint32 i = 0; i < sol.cols(); ++i)
-        {
-            VectorXd* tmp = MNEMath::combine_xyz(sol.col(i));
-            sol1.block(0,i,sol.rows()/3,1) = tmp->cwiseSqrt();
-            delete tmp;
+    return MNESourceEstimate(sol, p_vecVertices, tmin, tstep);
+}
+
+//=============================================================================================================
+
+QList<MNESourceEstimate> MinimumNorm::calculateInverse(const QList<FiffEvoked> &lEvoked, bool pick_normal)
+{
+    QList<MNESourceEstimate> lStc;
+
+    //
+    //   Group the data sets by the number of averages, these share the kernel
+    //
+    QMap<qint32, QList<int> > mapNave;
+    for(int i = 0; i < lEvoked.size(); ++i) {
+        if(!m_inverseOperator.check_ch_names(lEvoked[i].info)) {
+            qWarning("MinimumNorm::calculateInverse - Channel name check failed.");
+            return lStc;
         }
-        sol.resize(sol1.rows(),sol1.cols());
-        sol = sol1;
+        mapNave[lEvoked[i].nave].append(i);
     }
 
-    if (m_bdSPM)
-    {
-        printf("(dSPM)...");
-        sol = inv.noisenorm*sol;
+    for(int i = 0; i < lEvoked.size(); ++i) {
+        lStc.append(MNESourceEstimate());
     }
-    else if (m_bsLORETA)
+
+    QMap<qint32, QList<int> >::const_iterator it;
+    for(it = mapNave.constBegin(); it != mapNave.constEnd(); ++it) {
+        doInverseSetup(it.key(), pick_normal);
+
+        //
+        //   Pick the correct channels and stack all data sets of this group
+        //
+        QList<MatrixXd> lData;
+        int iNumSamples = 0;
+        for(int i : it.value()) {
+            lData.append(lEvoked[i].pick_channels(inv.noise_cov->names).data);
+
+            if(K.cols() != lData.last().rows()) {
+                qWarning() << "MinimumNorm::calculateInverse - Dimension mismatch between K.cols() and data.rows() -" << K.cols() << "and" << lData.last().rows();
+                return QList<MNESourceEstimate>();
+            }
+
+            iNumSamples += lData.last().cols();
+        }
+
+        MatrixXd matData(K.cols(), iNumSamples);
+        int iCol = 0;
+        for(const MatrixXd& matEvoked : lData) {
+            matData.middleCols(iCol, matEvoked.cols()) = matEvoked;
+            iCol += matEvoked.cols();
+        }
+        lData.clear();
+
+        MatrixXd sol = applyKernel(matData, pick_normal);
+
+        VectorXi vecVertices(inv.src[0].vertno.size() + inv.src[1].vertno.size());
+        vecVertices << inv.src[0].vertno, inv.src[1].vertno;
+
+        iCol = 0;
+        for(int i : it.value()) {
+            const FiffEvoked& evoked = lEvoked[i];
+            lStc[i] = MNESourceEstimate(sol.middleCols(iCol, evoked.data.cols()),
+                                        vecVertices,
+                                        evoked.times[0],
+                                        1/evoked.info.sfreq);
+            iCol += evoked.data.cols();
+        }
+    }
+
+    return lStc;
+}
+
+//=============================================================================================================
+
+QList<MNESourceEstimate> MinimumNorm::calculateInverse(const QList<MatrixXd> &lData, float tmin, float tstep, bool pick_normal) const
+{
+    QList<MNESourceEstimate> lStc;
+
+    if(!inverseSetup)
     {
+        qWarning("MinimumNorm::calculateInverse - Inverse not setup -> call doInverseSetup first!");
+        return lStc;
+    }
+
+    int iNumSamples = 0;
+    for(const MatrixXd& data : lData) {
+        if(K.cols() != data.rows()) {
+            qWarning() << "MinimumNorm::calculateInverse - Dimension mismatch between K.cols() and data.rows() -" << K.cols() << "and" << data.rows();
+            return lStc;
+        }
+        iNumSamples += data.cols();
+    }
+
+    MatrixXd matData(K.cols(), iNumSamples);
+    int iCol = 0;
+    for(const MatrixXd& data : lData) {
+        matData.middleCols(iCol, data.cols()) = data;
+        iCol += data.cols();
+    }
+
+    MatrixXd sol = applyKernel(matData, pick_normal);
+    matData.resize(0,0);
+
+    VectorXi vecVertices(inv.src[0].vertno.size() + inv.src[1].vertno.size());
+    vecVertices << inv.src[0].vertno, inv.src[1].vertno;
+
+    iCol = 0;
+    for(const MatrixXd& data : lData) {
+        lStc.append(MNESourceEstimate(sol.middleCols(iCol, data.cols()), vecVertices, tmin, tstep));
+        iCol += data.cols();
+    }
+
+    return lStc;
+}
+
+//=============================================================================================================
+
+bool MinimumNorm::writeInverse(const QList<FiffEvoked> &lEvoked, const QStringList &lFileNames, bool pick_normal, int iBatchSize)
+{
+    if(lEvoked.size() != lFileNames.size()) {
+        qWarning() << "MinimumNorm::writeInverse - Number of data sets and file names do not match -" << lEvoked.size() << "and" << lFileNames.size();
+        return false;
+    }
+
+    iBatchSize = qMax(iBatchSize, 1);
+
+    for(int iFirst = 0; iFirst < lEvoked.size(); iFirst += iBatchSize) {
+        QList<MNESourceEstimate> lStc = calculateInverse(lEvoked.mid(iFirst, iBatchSize), pick_normal);
+
+        if(lStc.isEmpty()) {
+            return false;
+        }
+
+        for(int i = 0; i < lStc.size(); ++i) {
+            QFile file(lFileNames[iFirst + i]);
+            if(!lStc[i].write(file)) {
+                qWarning() << "MinimumNorm::writeInverse - Could not write" << lFileNames[iFirst + i];
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+//=============================================================================================================
+
+MatrixXd MinimumNorm::applyKernel(const MatrixXd &data, bool pick_normal) const
+{
+    MatrixXd sol = K * data; //apply imaging kernel
+
+    bool bCombine = inv.source_ori == FIFFV_MNE_FREE_ORI && pick_normal == false;
+    bool bNoiseNorm = m_bdSPM || m_bsLORETA;
+
+    if(!bCombine && !bNoiseNorm) {
+        printf("[done]\n");
+        return sol;
+    }
+
+    if(bCombine) {
+        printf("combining the current components...\n");
+    }
+    if (m_bdSPM) {
+        printf("(dSPM)...");
+    } else if (m_bsLORETA) {
         printf("(sLORETA)...");
-        sol = inv.noisenorm*sol;
     }
-    printf("[done]\n");
 
-    //Results
-    VectorXi p_vecVertices(inv.src[0].vertno.size() + inv.src[1].vertno.size());
-    p_vecVertices << inv.src[0].vertno, inv.src[1].vertno;
+    //
+    //   Combine the components and normalize in blocks of time points
+    //
+    const int iNumSources = bCombine ? sol.rows()/3 : sol.rows();
+    const int iBlockSize = 256;
+    MatrixXd solOut(iNumSources, sol.cols());
 
-//    VectorXi p_vecVertices();
-//    for(qint32 h = 0; h < inv.src.size(); ++h)
-//        t_qListVertices.push_back(inv.src[h].vertno);
+    QList<QPair<int,int> > lBlocks;
+    for(int iFirst = 0; iFirst < sol.cols(); iFirst += iBlockSize) {
+        lBlocks.append(QPair<int,int>(iFirst, qMin(iBlockSize, int(sol.cols()) - iFirst)));
+    }
 
-    return MNESourceEstimate(sol, p_vecVertices, tmin, tstep);
+    auto processBlock = [&](const QPair<int,int>& block) {
+        MatrixXd matBlock;
+        if(bCombine) {
+            matBlock.resize(iNumSources, block.second);
+            for(int c = 0; c < block.second; ++c) {
+                const double* pSol = sol.col(block.first + c).data();
+                for(int k = 0; k < iNumSources; ++k) {
+                    matBlock(k,c) = std::sqrt(pSol[3*k]*pSol[3*k] + pSol[3*k+1]*pSol[3*k+1] + pSol[3*k+2]*pSol[3*k+2]);
+                }
+            }
+        } else {
+            matBlock = sol.middleCols(block.first, block.second);
+        }
+
+        if(bNoiseNorm) {
+            solOut.middleCols(block.first, block.second) = inv.noisenorm * matBlock;
+        } else {
+            solOut.middleCols(block.first, block.second) = matBlock;
+        }
+    };
+
+    QtConcurrent::blockingMap(lBlocks, processBlock);
+
+    printf("[done]\n");
+
+    return solOut;
 }
 
 //=============================================================================================================
 
 void MinimumNorm::doInverseSetup(qint32 nave, bool pick_normal)
 {
+    //
+    //   Reuse the kernel if nothing changed
+    //
+    if(inverseSetup &&
+       m_iSetupNave == nave &&
+       m_fSetupLambda == m_fLambda &&
+       m_bSetupdSPM == m_bdSPM &&
+       m_bSetupsLORETA == m_bsLORETA &&
+       m_bSetupPickNormal == pick_normal) {
+        return;
+    }
+
     //
     //   Set up the inverse according to the parameters
     //
@@ -247,6 +455,11 @@ void MinimumNorm::doInverseSetup(qint32 nave, bool pick_normal)
 
     std::cout << "K " << K.rows() << " x " << K.cols() << std::endl;
 
+    m_iSetupNave = nave;
+    m_fSetupLambda = m_fLambda;
+    m_bSetupdSPM = m_bdSPM;
+    m_bSetupsLORETA = m_bsLORETA;
+    m_bSetupPickNormal = pick_normal;
     inverseSetup = true;
 }
 
@@ -293,6 +506,7 @@ void MinimumNorm::setMethod(bool dSPM, bool sLORETA)
         qWarning("Cant activate dSPM and sLORETA at the same time! - Activating dSPM");
         m_bdSPM = true;
         m_bsLORETA = false;
+        m_sMethod = QString("dSPM");
     }
     else
     {
@@ -48,6 +48,7 @@
 #include <fs/label.h>
 
 #include <QSharedPointer>
+#include <QStringList>
 
 //=============================================================================================================
 // DEFINE NAMESPACE INVERSELIB
@@ -116,7 +117,51 @@ public:
 
     //=========================================================================================================
     /**
-     * Perform the inverse setup: Prepares this inverse operator and assembles the kernel.
+     * Computes the inverse solutions of many evoked data sets. The kernel is assembled once per number of
+     * averages and applied to all data sets sharing it in a single matrix product.
+     *
+     * @param[in] lEvoked        The evoked data sets.
+     * @param[in] pick_normal    If True, rather than pooling the orientations by taking the norm, only the.
+     *                           radial component is kept. This is only applied when working with loose orientations.
+     *
+     * @return the calculated source estimates, in the order of lEvoked. Empty if a channel name check failed.
+     */
+    QList<MNELIB::MNESourceEstimate> calculateInverse(const QList<FIFFLIB::FiffEvoked> &lEvoked, bool pick_normal = false);
+
+    //=========================================================================================================
+    /**
+     * Applies the current kernel to many data matrices, e.g. epochs, in a single matrix product. The data need
+     * to be picked to the channels of the inverse operator. Call doInverseSetup first.
+     *
+     * @param[in] lData          The data matrices (channels x samples).
+     * @param[in] tmin           The time of the first sample.
+     * @param[in] tstep          The time between two samples.
+     * @param[in] pick_normal    If True, rather than pooling the orientations by taking the norm, only the.
+     *                           radial component is kept. This is only applied when working with loose orientations.
+     *
+     * @return the calculated source estimates, in the order of lData.
+     */
+    QList<MNELIB::MNESourceEstimate> calculateInverse(const QList<Eigen::MatrixXd> &lData, float tmin, float tstep, bool pick_normal = false) const;
+
+    //=========================================================================================================
+    /**
+     * Computes the inverse solutions of many evoked data sets and writes each of them to an stc file. The data
+     * sets are processed in batches so that only one batch of source estimates is held in memory.
+     *
+     * @param[in] lEvoked        The evoked data sets.
+     * @param[in] lFileNames     The stc file name for each evoked data set.
+     * @param[in] pick_normal    If True, rather than pooling the orientations by taking the norm, only the.
+     *                           radial component is kept. This is only applied when working with loose orientations.
+     * @param[in] iBatchSize     The number of data sets to process at once.
+     *
+     * @return true if all source estimates were written, false otherwise.
+     */
+    bool writeInverse(const QList<FIFFLIB::FiffEvoked> &lEvoked, const QStringList &lFileNames, bool pick_normal = false, int iBatchSize = 32);
+
+    //=========================================================================================================
+    /**
+     * Perform the inverse setup: Prepares this inverse operator and assembles the kernel. Nothing is done if the
+     * kernel was already assembled for the same number of averages, regularization, method and pick_normal.
      *
      * @param[in] nave           Number of averages to use.
      * @param[in] pick_normal    If True, rather than pooling the orientations by taking the norm, only the.
@@ -182,6 +227,18 @@ public:
     inline Eigen::MatrixXd& getKernel();
 
 private:
+    //=========================================================================================================
+    /**
+     * Applies the kernel, combines the current components and applies the noise normalization. The post
+     * processing is split into blocks of time points which are processed in parallel.
+     *
+     * @param[in] data           The data (channels x samples).
+     * @param[in] pick_normal    Whether only the radial component is kept.
+     *
+     * @return the source time courses.
+     */
+    Eigen::MatrixXd applyKernel(const Eigen::MatrixXd &data, bool pick_normal) const;
+
     MNELIB::MNEInverseOperator m_inverseOperator;   /**< The inverse operator. */
     float m_fLambda;                                /**< Regularization parameter. */
     QString m_sMethod;                              /**< Selected method. */
@@ -189,6 +246,11 @@ private:
     bool m_bdSPM;                                   /**< Do dSPM method. */
 
     bool inverseSetup;                              /**< Inverse Setup Calcluated. */
+    qint32 m_iSetupNave;                            /**< Number of averages the kernel was assembled for. */
+    float m_fSetupLambda;                           /**< Regularization the kernel was assembled for. */
+    bool m_bSetupdSPM;                              /**< Whether the kernel was assembled for dSPM. */
+    bool m_bSetupsLORETA;                           /**< Whether the kernel was assembled for sLORETA. */
+    bool m_bSetupPickNormal;                        /**< Whether the kernel was assembled with pick_normal. */
     MNELIB::MNEInverseOperator inv;                 /**< The setup inverse operator. */
     Eigen::SparseMatrix<double> noise_norm;         /**< The noise normalization. */
     QList<Eigen::VectorXi> vertno;                  /**< The vertices numbers. */
@@ -63,6 +63,7 @@ FilterThreadArg::FilterThreadArg()
 :s          (NULL)
 ,mri_head_t (NULL)
 ,surf       (NULL)
+,surf_index (NULL)
 ,limit      (-1)
 ,filtered   (NULL)
 ,stat       (FAIL)
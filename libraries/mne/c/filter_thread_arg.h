@@ -47,6 +47,7 @@
 
 #include "mne_source_space_old.h"
 #include "mne_surface_old.h"
+#include "mne_surface_index.h"
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -97,6 +98,7 @@ public:
     MneSourceSpaceOld* s;           /* The source space to process */
     FIFFLIB::FiffCoordTransOld* mri_head_t;  /* Coordinate transformation */
     MneSurfaceOld*   surf;          /* The inner skull surface */
+    MneSurfaceIndex* surf_index;    /* Spatial index of surf, built on demand if NULL */
     float          limit;           /* Distance limit */
     FILE           *filtered;       /* Log omitted point locations here */
     int            stat;            /* How was it? */
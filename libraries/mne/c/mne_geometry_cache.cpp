@@ -0,0 +1,315 @@
+//=============================================================================================================
+/**
+ * @file     mne_geometry_cache.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Definition of the MneGeometryCache Class.
+ *
+ */
+
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "mne_geometry_cache.h"
+#include "mne_source_space_old.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace MNELIB;
+
+//=============================================================================================================
+// DEFINE LOCAL FUNCTIONS
+//=============================================================================================================
+
+namespace
+{
+
+const qint32 CACHE_MAGIC   = 0x4D4E4547;   /* 'MNEG' */
+const qint32 CACHE_VERSION = 1;
+
+/*
+ * The entry starts with this header. The vertex normals (np x 3), the number of neighboring triangles (np), the
+ * neighboring triangles (ntot_tri), the number of neighboring vertices (np), the neighboring vertices (ntot_vert)
+ * and the distances to them (ntot_vert) follow in native byte order.
+ */
+struct CacheHeader {
+    qint32 magic;
+    qint32 version;
+    qint32 np;
+    qint32 ntri;
+    qint32 ntot_tri;
+    qint32 ntot_vert;
+    char   key[20];
+};
+
+qint64 entry_size(const CacheHeader& header)
+{
+    return sizeof(CacheHeader)
+            + sizeof(float)*3*qint64(header.np)
+            + sizeof(int)*(2*qint64(header.np) + header.ntot_tri + header.ntot_vert)
+            + sizeof(float)*qint64(header.ntot_vert);
+}
+
+template<typename T>
+void free_rows(T** rows, int n)
+{
+    if (!rows)
+        return;
+    for (int k = 0; k < n; k++)
+        free(rows[k]);
+    free(rows);
+}
+
+/*
+ * Splits the consecutive rows starting at src into separately allocated rows as used by the source space
+ */
+template<typename T>
+T** copy_rows(const uchar* &src, const int* counts, int n)
+{
+    T** rows = (T**)malloc(n*sizeof(T*));
+    for (int k = 0; k < n; k++) {
+        if (counts[k] > 0) {
+            rows[k] = (T*)malloc(counts[k]*sizeof(T));
+            memcpy(rows[k],src,counts[k]*sizeof(T));
+            src += counts[k]*sizeof(T);
+        }
+        else
+            rows[k] = NULL;
+    }
+    return rows;
+}
+
+int* copy_counts(const uchar* &src, int n)
+{
+    int* counts = (int*)malloc(n*sizeof(int));
+    memcpy(counts,src,n*sizeof(int));
+    src += n*sizeof(int);
+    return counts;
+}
+
+qint64 sum_counts(const uchar* src, int n)
+{
+    qint64 sum = 0;
+    int    count;
+    for (int k = 0; k < n; k++) {
+        memcpy(&count,src+k*sizeof(int),sizeof(int));
+        if (count < 0)
+            return -1;
+        sum += count;
+    }
+    return sum;
+}
+
+}
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+QByteArray MneGeometryCache::key(const MneSourceSpaceOld* s,
+                                 int do_normals,
+                                 int check_too_many_neighbors)
+{
+    if (!s || !s->rr || !s->itris || s->np <= 0 || cacheDir().isEmpty())
+        return QByteArray();
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    qint32 info[4] = { CACHE_VERSION, s->np, s->ntri, (do_normals ? 1 : 0) | (check_too_many_neighbors ? 2 : 0) };
+    hash.addData(reinterpret_cast<const char*>(info),sizeof(info));
+
+    for (int k = 0; k < s->np; k++)
+        hash.addData(reinterpret_cast<const char*>(s->rr[k]),3*sizeof(float));
+    for (int k = 0; k < s->ntri; k++)
+        hash.addData(reinterpret_cast<const char*>(s->itris[k]),3*sizeof(int));
+    /*
+     * Given normals are only scaled to unit length, they are part of the input then
+     */
+    if (!do_normals && s->nn)
+        for (int k = 0; k < s->np; k++)
+            hash.addData(reinterpret_cast<const char*>(s->nn[k]),3*sizeof(float));
+
+    return hash.result();
+}
+
+//=============================================================================================================
+
+bool MneGeometryCache::read(const QByteArray& key,
+                            MneSourceSpaceOld* s)
+{
+    if (key.size() != int(sizeof(CacheHeader::key)) || !s || !s->nn)
+        return false;
+
+    QFile file(entryFile(key));
+    if (!file.open(QIODevice::ReadOnly) || file.size() < qint64(sizeof(CacheHeader)))
+        return false;
+
+    const qint64 size = file.size();
+    const uchar* data = file.map(0,size);
+    if (!data)
+        return false;
+
+    CacheHeader header;
+    memcpy(&header,data,sizeof(CacheHeader));
+
+    if (header.magic != CACHE_MAGIC || header.version != CACHE_VERSION ||
+        header.np != s->np || header.ntri != s->ntri ||
+        header.ntot_tri < 0 || header.ntot_vert < 0 ||
+        memcmp(header.key,key.constData(),sizeof(header.key)) != 0 ||
+        entry_size(header) != size) {
+        file.unmap(const_cast<uchar*>(data));
+        return false;
+    }
+
+    const uchar* nn_data    = data + sizeof(CacheHeader);
+    const uchar* ntri_data  = nn_data + sizeof(float)*3*qint64(header.np);
+    const uchar* nvert_data = ntri_data + sizeof(int)*(qint64(header.np) + header.ntot_tri);
+
+    if (sum_counts(ntri_data,header.np) != header.ntot_tri || sum_counts(nvert_data,header.np) != header.ntot_vert) {
+        file.unmap(const_cast<uchar*>(data));
+        return false;
+    }
+    /*
+     * Replace the neighborhood information
+     */
+    free_rows(s->neighbor_tri,s->np);
+    free(s->nneighbor_tri);
+    free_rows(s->neighbor_vert,s->np);
+    free(s->nneighbor_vert);
+    free_rows(s->vert_dist,s->np);
+
+    const uchar* src = nn_data;
+    for (int k = 0; k < s->np; k++, src += 3*sizeof(float))
+        memcpy(s->nn[k],src,3*sizeof(float));
+
+    s->nneighbor_tri  = copy_counts(src,s->np);
+    s->neighbor_tri   = copy_rows<int>(src,s->nneighbor_tri,s->np);
+    s->nneighbor_vert = copy_counts(src,s->np);
+    s->neighbor_vert  = copy_rows<int>(src,s->nneighbor_vert,s->np);
+    s->vert_dist      = copy_rows<float>(src,s->nneighbor_vert,s->np);
+
+    file.unmap(const_cast<uchar*>(data));
+    return true;
+}
+
+//=============================================================================================================
+
+bool MneGeometryCache::write(const QByteArray& key,
+                             const MneSourceSpaceOld* s)
+{
+    if (key.size() != int(sizeof(CacheHeader::key)) || !s || !s->nn ||
+        !s->nneighbor_tri || !s->neighbor_tri || !s->nneighbor_vert || !s->neighbor_vert || !s->vert_dist)
+        return false;
+
+    if (!QDir().mkpath(cacheDir()))
+        return false;
+
+    CacheHeader header;
+    header.magic     = CACHE_MAGIC;
+    header.version   = CACHE_VERSION;
+    header.np        = s->np;
+    header.ntri      = s->ntri;
+    header.ntot_tri  = 0;
+    header.ntot_vert = 0;
+    memcpy(header.key,key.constData(),sizeof(header.key));
+    for (int k = 0; k < s->np; k++) {
+        header.ntot_tri  += s->nneighbor_tri[k];
+        header.ntot_vert += s->nneighbor_vert[k];
+    }
+
+    QByteArray buffer;
+    buffer.reserve(int(entry_size(header)));
+    buffer.append(reinterpret_cast<const char*>(&header),sizeof(CacheHeader));
+    for (int k = 0; k < s->np; k++)
+        buffer.append(reinterpret_cast<const char*>(s->nn[k]),3*sizeof(float));
+    buffer.append(reinterpret_cast<const char*>(s->nneighbor_tri),s->np*sizeof(int));
+    for (int k = 0; k < s->np; k++)
+        if (s->nneighbor_tri[k] > 0)
+            buffer.append(reinterpret_cast<const char*>(s->neighbor_tri[k]),s->nneighbor_tri[k]*sizeof(int));
+    buffer.append(reinterpret_cast<const char*>(s->nneighbor_vert),s->np*sizeof(int));
+    for (int k = 0; k < s->np; k++)
+        if (s->nneighbor_vert[k] > 0)
+            buffer.append(reinterpret_cast<const char*>(s->neighbor_vert[k]),s->nneighbor_vert[k]*sizeof(int));
+    for (int k = 0; k < s->np; k++)
+        if (s->nneighbor_vert[k] > 0)
+            buffer.append(reinterpret_cast<const char*>(s->vert_dist[k]),s->nneighbor_vert[k]*sizeof(float));
+
+    /*
+     * Write to a temporary file first, so concurrent runs never see a partial entry
+     */
+    QSaveFile file(entryFile(key));
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    if (file.write(buffer) != buffer.size()) {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
+
+//=============================================================================================================
+
+QString MneGeometryCache::cacheDir()
+{
+    QString sDir = QString::fromLocal8Bit(qgetenv("MNE_GEOMETRY_CACHE_DIR"));
+
+    if (sDir == QLatin1String("off"))
+        return QString();
+
+    if (sDir.isEmpty()) {
+        QString sBase = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+        if (sBase.isEmpty())
+            return QString();
+        sDir = sBase + QLatin1String("/mne-cpp/geometry");
+    }
+
+    return sDir;
+}
+
+//=============================================================================================================
+
+QString MneGeometryCache::entryFile(const QByteArray& key)
+{
+    return cacheDir() + QLatin1Char('/') + QString::fromLatin1(key.toHex()) + QLatin1String(".geom");
+}
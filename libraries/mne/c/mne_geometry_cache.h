@@ -0,0 +1,143 @@
+//=============================================================================================================
+/**
+ * @file     mne_geometry_cache.h
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Declaration of the MneGeometryCache Class.
+ *
+ */
+
+
+#ifndef MNEGEOMETRYCACHE_H
+#define MNEGEOMETRYCACHE_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "../mne_global.h"
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QByteArray>
+#include <QString>
+
+//=============================================================================================================
+// DEFINE NAMESPACE MNELIB
+//=============================================================================================================
+
+namespace MNELIB
+{
+
+//=============================================================================================================
+// FORWARD DECLARATIONS
+//=============================================================================================================
+
+class MneSourceSpaceOld;
+
+//=============================================================================================================
+/**
+ * Binary cache of the derived geometry of a triangulated source space: the vertex normals, the neighboring
+ * triangles and vertices of each vertex and the distances to the neighboring vertices. Entries are keyed by a
+ * hash of the vertex locations and the triangulation, so repeated runs on the same surfaces reuse the neighborhood
+ * information instead of recomputing it. An entry is memory mapped when read.
+ *
+ * The cache directory is taken from the environment variable MNE_GEOMETRY_CACHE_DIR. If it is not set, the
+ * generic cache location of the user is used. Setting it to "off" disables the cache.
+ *
+ * @brief Geometry cache for source spaces.
+ */
+class MNESHARED_EXPORT MneGeometryCache
+{
+public:
+    //=========================================================================================================
+    /**
+     * Computes the cache key of a source space.
+     *
+     * @param[in] s                          The source space.
+     * @param[in] do_normals                 Whether the vertex normals are recomputed from the triangles.
+     * @param[in] check_too_many_neighbors   Whether too many neighbors of a vertex are an error.
+     *
+     * @return The key, empty if the cache is disabled.
+     */
+    static QByteArray key(const MneSourceSpaceOld* s,
+                          int do_normals,
+                          int check_too_many_neighbors);
+
+    //=========================================================================================================
+    /**
+     * Reads the entry for key into the source space. The vertex normals have to be allocated already.
+     *
+     * @param[in] key    The cache key.
+     * @param[in] s      The source space to complete.
+     *
+     * @return True if the entry was found and read.
+     */
+    static bool read(const QByteArray& key,
+                     MneSourceSpaceOld* s);
+
+    //=========================================================================================================
+    /**
+     * Writes the geometry of the source space as entry for key.
+     *
+     * @param[in] key    The cache key.
+     * @param[in] s      The source space with the computed geometry.
+     *
+     * @return True if the entry was written.
+     */
+    static bool write(const QByteArray& key,
+                      const MneSourceSpaceOld* s);
+
+private:
+    //=========================================================================================================
+    /**
+     * Returns the cache directory, empty if the cache is disabled.
+     *
+     * @return The cache directory.
+     */
+    static QString cacheDir();
+
+    //=========================================================================================================
+    /**
+     * Returns the file of the entry for key.
+     *
+     * @param[in] key    The cache key.
+     *
+     * @return The file name.
+     */
+    static QString entryFile(const QByteArray& key);
+};
+
+//=============================================================================================================
+// INLINE DEFINITIONS
+//=============================================================================================================
+} // NAMESPACE MNELIB
+
+#endif // MNEGEOMETRYCACHE_H
@@ -0,0 +1,254 @@
+//=============================================================================================================
+/**
+ * @file     mne_surface_index.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Definition of the MneSurfaceIndex Class.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "mne_surface_index.h"
+#include "mne_surface_old.h"
+#include "mne_triangle.h"
+
+#include <algorithm>
+#include <cmath>
+
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace MNELIB;
+
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+namespace
+{
+
+const double BARY_EPS = 1e-9;   /* Rays closer to an edge than this (in barycentric coordinates) are ambiguous */
+const double SURF_EPS = 1e-7;   /* Points closer to the surface along the ray than this (in m) are ambiguous */
+
+//=============================================================================================================
+/**
+ * Twice the signed area of the triangle (a, b, p) projected to the xy plane.
+ */
+inline double edgeFunction(const float *a, const float *b, const float *p)
+{
+    return (static_cast<double>(b[0]) - a[0]) * (static_cast<double>(p[1]) - a[1])
+         - (static_cast<double>(b[1]) - a[1]) * (static_cast<double>(p[0]) - a[0]);
+}
+
+//=============================================================================================================
+/**
+ * The reference test: the solid angle of a closed surface seen from inside is 4*pi.
+ */
+inline bool insideBySolidAngle(float *r, MneSurfaceOld* surf)
+{
+    return std::fabs(MneSurfaceOrVolume::sum_solids(r, surf) / (4 * M_PI) - 1.0) <= 1e-5;
+}
+
+} // NAMESPACE
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+MneSurfaceIndex::MneSurfaceIndex(MneSurfaceOld* surf)
+: m_pSurf(surf)
+, m_cellSize(1.0)
+{
+    for (int c = 0; c < 3; c++) {
+        m_min[c] = m_max[c] = 0.0;
+        m_n[c] = 1;
+    }
+    m_triStart.assign(2, 0);
+    m_vertStart.assign(2, 0);
+
+    if (!surf || surf->np <= 0)
+        return;
+    /*
+     * Bounding box and cubic cells, about 2 * ntri^(1/3) along the longest axis
+     */
+    for (int c = 0; c < 3; c++)
+        m_min[c] = m_max[c] = surf->rr[0][c];
+    for (int k = 1; k < surf->np; k++) {
+        for (int c = 0; c < 3; c++) {
+            m_min[c] = std::min(m_min[c], static_cast<double>(surf->rr[k][c]));
+            m_max[c] = std::max(m_max[c], static_cast<double>(surf->rr[k][c]));
+        }
+    }
+    double extent = std::max(m_max[0] - m_min[0], std::max(m_max[1] - m_min[1], m_max[2] - m_min[2]));
+    int    nmax   = std::max(1, std::min(128, static_cast<int>(2.0 * std::cbrt(static_cast<double>(std::max(surf->ntri, 1))))));
+
+    if (extent > 0.0)
+        m_cellSize = extent / nmax;
+    for (int c = 0; c < 3; c++)
+        m_n[c] = std::max(1, static_cast<int>(std::ceil((m_max[c] - m_min[c]) / m_cellSize)));
+
+    const int ncell = m_n[0] * m_n[1] * m_n[2];
+    /*
+     * Triangles go to all cells overlapping their bounding box, two passes to fill the compressed lists
+     */
+    m_triStart.assign(ncell + 1, 0);
+    for (int pass = 0; pass < 2; pass++) {
+        std::vector<int> fill;
+        if (pass == 1) {
+            for (int k = 0; k < ncell; k++)
+                m_triStart[k + 1] += m_triStart[k];
+            m_tris.resize(m_triStart[ncell]);
+            fill.assign(m_triStart.begin(), m_triStart.end() - 1);
+        }
+        for (int t = 0; t < surf->ntri; t++) {
+            MneTriangle* tri = surf->tris + t;
+            int lo[3], hi[3];
+            for (int c = 0; c < 3; c++) {
+                lo[c] = cellCoord(std::min(tri->r1[c], std::min(tri->r2[c], tri->r3[c])), c);
+                hi[c] = cellCoord(std::max(tri->r1[c], std::max(tri->r2[c], tri->r3[c])), c);
+            }
+            for (int iz = lo[2]; iz <= hi[2]; iz++)
+                for (int iy = lo[1]; iy <= hi[1]; iy++)
+                    for (int ix = lo[0]; ix <= hi[0]; ix++) {
+                        int cell = cellIndex(ix, iy, iz);
+                        if (pass == 0)
+                            m_triStart[cell + 1]++;
+                        else
+                            m_tris[fill[cell]++] = t;
+                    }
+        }
+    }
+    /*
+     * Vertices go to the cell they are in
+     */
+    std::vector<int> vertCell(surf->np);
+    m_vertStart.assign(ncell + 1, 0);
+    for (int k = 0; k < surf->np; k++) {
+        vertCell[k] = cellIndex(cellCoord(surf->rr[k][0], 0), cellCoord(surf->rr[k][1], 1), cellCoord(surf->rr[k][2], 2));
+        m_vertStart[vertCell[k] + 1]++;
+    }
+    for (int k = 0; k < ncell; k++)
+        m_vertStart[k + 1] += m_vertStart[k];
+    m_verts.resize(surf->np);
+    std::vector<int> fill(m_vertStart.begin(), m_vertStart.end() - 1);
+    for (int k = 0; k < surf->np; k++)
+        m_verts[fill[vertCell[k]]++] = k;
+}
+
+//=============================================================================================================
+
+bool MneSurfaceIndex::isInside(float *r) const
+{
+    if (!m_pSurf || m_pSurf->np <= 0)
+        return false;
+    /*
+     * Nothing outside of the bounding box is enclosed
+     */
+    if (r[0] < m_min[0] || r[0] > m_max[0] ||
+        r[1] < m_min[1] || r[1] > m_max[1] ||
+        r[2] > m_max[2])
+        return false;
+
+    const int ix = cellCoord(r[0], 0);
+    const int iy = cellCoord(r[1], 1);
+    int crossings = 0;
+    /*
+     * Walk up the column. A triangle is listed in every cell it overlaps, its crossing is only counted in the
+     * cell which contains it
+     */
+    for (int iz = cellCoord(r[2], 2); iz < m_n[2]; iz++) {
+        const int cell = cellIndex(ix, iy, iz);
+        for (int j = m_triStart[cell]; j < m_triStart[cell + 1]; j++) {
+            const MneTriangle* tri = m_pSurf->tris + m_tris[j];
+
+            double w1 = edgeFunction(tri->r2, tri->r3, r);
+            double w2 = edgeFunction(tri->r3, tri->r1, r);
+            double w3 = edgeFunction(tri->r1, tri->r2, r);
+            double area = w1 + w2 + w3;
+
+            if (area == 0.0)            /* Vertical, its outline is shared with the neighbors */
+                continue;
+            w1 /= area;
+            w2 /= area;
+            w3 /= area;
+            if (w1 < -BARY_EPS || w2 < -BARY_EPS || w3 < -BARY_EPS)
+                continue;
+            if (w1 < BARY_EPS || w2 < BARY_EPS || w3 < BARY_EPS)
+                return insideBySolidAngle(r, m_pSurf);
+
+            double z = w1 * tri->r1[2] + w2 * tri->r2[2] + w3 * tri->r3[2];
+            if (std::fabs(z - r[2]) < SURF_EPS)
+                return insideBySolidAngle(r, m_pSurf);
+            if (z > r[2] && cellCoord(z, 2) == iz)
+                crossings++;
+        }
+    }
+    return crossings % 2 == 1;
+}
+
+//=============================================================================================================
+
+float MneSurfaceIndex::minDistance(const float *r,
+                                   float maxdist,
+                                   int *nearest) const
+{
+    float mindist = maxdist;
+    int   minnode = -1;
+
+    if (m_pSurf && m_pSurf->np > 0) {
+        int lo[3], hi[3];
+        for (int c = 0; c < 3; c++) {
+            lo[c] = cellCoord(r[c] - maxdist, c);
+            hi[c] = cellCoord(r[c] + maxdist, c);
+        }
+        for (int iz = lo[2]; iz <= hi[2]; iz++)
+            for (int iy = lo[1]; iy <= hi[1]; iy++)
+                for (int ix = lo[0]; ix <= hi[0]; ix++) {
+                    const int cell = cellIndex(ix, iy, iz);
+                    for (int j = m_vertStart[cell]; j < m_vertStart[cell + 1]; j++) {
+                        const float *rr = m_pSurf->rr[m_verts[j]];
+                        float diff[3] = { r[0] - rr[0], r[1] - rr[1], r[2] - rr[2] };
+                        float dist = std::sqrt(diff[0] * diff[0] + diff[1] * diff[1] + diff[2] * diff[2]);
+                        if (dist < mindist) {
+                            mindist = dist;
+                            minnode = m_verts[j];
+                        }
+                    }
+                }
+    }
+    if (nearest)
+        *nearest = minnode;
+    return mindist;
+}
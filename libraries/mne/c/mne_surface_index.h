@@ -0,0 +1,147 @@
+//=============================================================================================================
+/**
+ * @file     mne_surface_index.h
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    MneSurfaceIndex class declaration.
+ *
+ */
+
+#ifndef MNESURFACEINDEX_H
+#define MNESURFACEINDEX_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "../mne_global.h"
+
+#include <vector>
+
+//=============================================================================================================
+// DEFINE NAMESPACE MNELIB
+//=============================================================================================================
+
+namespace MNELIB
+{
+
+//=============================================================================================================
+// FORWARD DECLARATIONS
+//=============================================================================================================
+
+class MneSurfaceOld;
+
+//=============================================================================================================
+/**
+ * Uniform grid over the bounding box of a closed triangulated surface. Each cell lists the triangles whose bounding
+ * box overlaps it and the vertices inside it. Whether a point is inside the surface is decided by the parity of the
+ * crossings of a ray in +z direction, which only visits the cells of one column. Points whose ray grazes an edge,
+ * a vertex or which lie on the surface fall back to the solid angle sum. Vertex distance queries only visit the
+ * cells within the search radius. All queries are const and may run concurrently.
+ *
+ * @brief Spatial index for inside and distance tests against a surface.
+ */
+class MNESHARED_EXPORT MneSurfaceIndex
+{
+public:
+    //=========================================================================================================
+    /**
+     * Builds the index. The surface must outlive the index.
+     *
+     * @param[in] surf   The closed surface, e.g. the inner skull.
+     */
+    explicit MneSurfaceIndex(MneSurfaceOld* surf);
+
+    //=========================================================================================================
+    /**
+     * Tests whether a point is inside the surface, with the same result as requiring the solid angle sum to be
+     * 4*pi up to a relative error of 1e-5.
+     *
+     * @param[in] r      The point.
+     *
+     * @return true if the point is inside.
+     */
+    bool isInside(float *r) const;
+
+    //=========================================================================================================
+    /**
+     * Computes the distance from a point to the nearest surface vertex, if it is closer than maxdist.
+     *
+     * @param[in] r          The point.
+     * @param[in] maxdist    The search radius.
+     * @param[out] nearest   The nearest vertex, -1 if none is closer than maxdist. Can be NULL.
+     *
+     * @return The distance to the nearest vertex, maxdist if none is closer.
+     */
+    float minDistance(const float *r,
+                      float maxdist,
+                      int *nearest = NULL) const;
+
+private:
+    //=========================================================================================================
+    /**
+     * Returns the cell coordinate of x along axis c, clamped to the grid.
+     */
+    inline int cellCoord(double x, int c) const;
+
+    //=========================================================================================================
+    /**
+     * Returns the cell number of the cell coordinates.
+     */
+    inline int cellIndex(int ix, int iy, int iz) const;
+
+    MneSurfaceOld*      m_pSurf;            /**< The indexed surface. */
+    double              m_min[3];           /**< The lower corner of the grid. */
+    double              m_max[3];           /**< The upper corner of the grid. */
+    double              m_cellSize;         /**< The edge length of the cubic cells. */
+    int                 m_n[3];             /**< The number of cells along each axis. */
+    std::vector<int>    m_triStart;         /**< Start of the triangles of each cell in m_tris, one extra entry at the end. */
+    std::vector<int>    m_tris;             /**< The triangles per cell. */
+    std::vector<int>    m_vertStart;        /**< Start of the vertices of each cell in m_verts, one extra entry at the end. */
+    std::vector<int>    m_verts;            /**< The vertices per cell. */
+};
+
+//=============================================================================================================
+// INLINE DEFINITIONS
+//=============================================================================================================
+
+inline int MneSurfaceIndex::cellCoord(double x, int c) const
+{
+    int i = static_cast<int>((x - m_min[c]) / m_cellSize);
+    return i < 0 ? 0 : (i >= m_n[c] ? m_n[c] - 1 : i);
+}
+
+//=============================================================================================================
+
+inline int MneSurfaceIndex::cellIndex(int ix, int iy, int iz) const
+{
+    return (iz * m_n[1] + iy) * m_n[0] + ix;
+}
+} // NAMESPACE MNELIB
+
+#endif // MNESURFACEINDEX_H
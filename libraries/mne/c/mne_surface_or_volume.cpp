@@ -45,6 +45,8 @@
 //#include "fwd_bem_model.h"
 #include "mne_nearest.h"
 #include "filter_thread_arg.h"
+#include "mne_surface_index.h"
+#include "mne_geometry_cache.h"
 #include "mne_triangle.h"
 #include "mne_msh_display_surface.h"
 #include "mne_proj_data.h"
@@ -446,12 +448,11 @@ int MneSurfaceOrVolume::mne_filter_source_spaces(MneSurfaceOld* surf, float limi
      */
 {
     MneSourceSpaceOld* s;
-    int k,p1,p2;
+    int k,p1;
     float r1[3];
-    float mindist,dist,diff[3];
+    float mindist;
     int   minnode;
     int   omit,omit_outside;
-    double tot_angle;
 
     if (surf == NULL)
         return OK;
@@ -475,6 +476,7 @@ int MneSurfaceOrVolume::mne_filter_source_spaces(MneSurfaceOld* surf, float limi
     printf(" (will take a few...)\n");
     omit         = 0;
     omit_outside = 0;
+    MneSurfaceIndex surf_index(surf);
     for (k = 0; k < nspace; k++) {
         s = spaces[k];
         for (p1 = 0; p1 < s->np; p1++)
@@ -485,8 +487,7 @@ int MneSurfaceOrVolume::mne_filter_source_spaces(MneSurfaceOld* surf, float limi
                 /*
                 * Check that the source is inside the inner skull surface
                 */
-                tot_angle = sum_solids(r1,surf)/(4*M_PI);
-                if (std::fabs(tot_angle-1.0) > 1e-5) {
+                if (!surf_index.isInside(r1)) {
                     omit_outside++;
                     s->inuse[p1] = FALSE;
                     s->nuse--;
@@ -498,16 +499,7 @@ int MneSurfaceOrVolume::mne_filter_source_spaces(MneSurfaceOld* surf, float limi
                     /*
                         * Check the distance limit
                         */
-                    mindist = 1.0;
-                    minnode = 0;
-                    for (p2 = 0; p2 < surf->np; p2++) {
-                        VEC_DIFF_17(r1,surf->rr[p2],diff);
-                        dist = VEC_LEN_17(diff);
-                        if (dist < mindist) {
-                            mindist = dist;
-                            minnode = p2;
-                        }
-                    }
+                    mindist = surf_index.minDistance(r1,std::min(limit,1.0f),&minnode);
                     if (mindist < limit) {
                         omit++;
                         s->inuse[p1] = FALSE;
@@ -651,12 +643,16 @@ void MneSurfaceOrVolume::rearrange_source_space(MneSourceSpaceOld* s)
 void *MneSurfaceOrVolume::filter_source_space(void *arg)
 {
     FilterThreadArg* a = (FilterThreadArg*)arg;
-    int    p1,p2;
-    double tot_angle;
+    int    p1;
     int    omit,omit_outside;
     float  r1[3];
-    float  mindist,dist,diff[3];
+    float  mindist;
     int    minnode;
+    MneSurfaceIndex* own_index = NULL;
+    MneSurfaceIndex* surf_index = a->surf_index;
+
+    if (!surf_index)
+        surf_index = own_index = new MneSurfaceIndex(a->surf);
 
     omit         = 0;
     omit_outside = 0;
@@ -669,8 +665,7 @@ void *MneSurfaceOrVolume::filter_source_space(void *arg)
             /*
            * Check that the source is inside the inner skull surface
            */
-            tot_angle = sum_solids(r1,a->surf)/(4*M_PI);
-            if (std::fabs(tot_angle-1.0) > 1e-5) {
+            if (!surf_index->isInside(r1)) {
                 omit_outside++;
                 a->s->inuse[p1] = FALSE;
                 a->s->nuse--;
@@ -682,16 +677,7 @@ void *MneSurfaceOrVolume::filter_source_space(void *arg)
                 /*
          * Check the distance limit
          */
-                mindist = 1.0;
-                minnode = 0;
-                for (p2 = 0; p2 < a->surf->np; p2++) {
-                    VEC_DIFF_17(r1,a->surf->rr[p2],diff);
-                    dist = VEC_LEN_17(diff);
-                    if (dist < mindist) {
-                        mindist = dist;
-                        minnode = p2;
-                    }
-                }
+                mindist = surf_index->minDistance(r1,std::min(a->limit,1.0f),&minnode);
                 if (mindist < a->limit) {
                     omit++;
                     a->s->inuse[p1] = FALSE;
@@ -709,6 +695,7 @@ void *MneSurfaceOrVolume::filter_source_space(void *arg)
     if (omit > 0)
         printf("%d source space points omitted because of the %6.1f-mm distance limit.\n",
                 omit,1000*a->limit);
+    delete own_index;
     a->stat = OK;
     return NULL;
 }
@@ -746,6 +733,10 @@ int MneSurfaceOrVolume::filter_source_spaces(float limit, char *bemfile, FiffCoo
     if (limit > 0.0)
         printf("and at least %6.1f mm away",1000*limit);
     printf(" (will take a few...)\n");
+    /*
+     * One spatial index of the surface is shared by all source spaces
+     */
+    MneSurfaceIndex surf_index(surf);
     if (nproc < 2 || nspace == 1 || !use_threads) {
         /*
         * This is the conventional calculation
@@ -755,6 +746,7 @@ int MneSurfaceOrVolume::filter_source_spaces(float limit, char *bemfile, FiffCoo
             a->s = spaces[k];
             a->mri_head_t = mri_head_t;
             a->surf = surf;
+            a->surf_index = &surf_index;
             a->limit = limit;
             a->filtered = filtered;
             filter_source_space(a);
@@ -774,6 +766,7 @@ int MneSurfaceOrVolume::filter_source_spaces(float limit, char *bemfile, FiffCoo
             a->s = spaces[k];
             a->mri_head_t = mri_head_t;
             a->surf = surf;
+            a->surf_index = &surf_index;
             a->limit = limit;
             a->filtered = filtered;
             args.append(a);
@@ -2586,6 +2579,19 @@ int MneSurfaceOrVolume::add_geometry_info(MneSourceSpaceOld* s, int do_normals,
         FREE_CMATRIX_17(s->nn);
         s->nn = ALLOC_CMATRIX_17(s->np,3);
     }
+    /*
+       * Reuse the neighborhood information of a previous run on the same surface
+       */
+    QByteArray cache_key;
+    if (!border) {
+        cache_key = MneGeometryCache::key(s,do_normals,check_too_many_neighbors);
+        if (MneGeometryCache::read(cache_key,s)) {
+            mne_add_triangle_data(s);
+            mne_compute_surface_cm((MneSurfaceOld*)s);
+            printf("\tNormals, neighbors and distances read from the geometry cache.\n");
+            return OK;
+        }
+    }
     if (s->neighbor_tri) {
         for (k = 0; k < s->np; k++)
             FREE_17(s->neighbor_tri[k]);
@@ -2770,6 +2776,8 @@ int MneSurfaceOrVolume::add_geometry_info(MneSourceSpaceOld* s, int do_normals,
         printf("\tWarning: %d vertices had incorrect number of distinct neighbors (fixed).\n",nfix_distinct);
     if (nfix_no_neighbors > 0)
         printf("\tWarning: %d vertices did not have any neighboring triangles (fixed)\n",nfix_no_neighbors);
+    if (!cache_key.isEmpty())
+        MneGeometryCache::write(cache_key,s);
 #ifdef DEBUG
     for (k = 0; k < s->np; k++) {
         if (s->nneighbor_vert[k] <= 0)
@@ -77,6 +77,7 @@ SOURCES += \
     mne_sourcespace.cpp \
     mne_forwardsolution.cpp \
     mne_sourceestimate.cpp \
+    mne_stc_file.cpp \
     mne_hemisphere.cpp \
     mne_inverse_operator.cpp \
     mne_epoch_data.cpp \
@@ -108,6 +109,8 @@ SOURCES += \
     c/mne_surface_old.cpp \
     c/mne_surface_or_volume.cpp \
     c/filter_thread_arg.cpp \
+    c/mne_surface_index.cpp \
+    c/mne_geometry_cache.cpp \
     c/mne_msh_display_surface.cpp \
     c/mne_msh_display_surface_set.cpp \
     c/mne_msh_picked.cpp \
@@ -128,6 +131,7 @@ HEADERS += \
     mne_hemisphere.h \
     mne_forwardsolution.h \
     mne_sourceestimate.h \
+    mne_stc_file.h \
     mne_inverse_operator.h \
     mne_epoch_data.h \
     mne_epoch_data_list.h \
@@ -160,6 +164,8 @@ HEADERS += \
     c/mne_surface_old.h \
     c/mne_surface_or_volume.h \
     c/filter_thread_arg.h \
+    c/mne_surface_index.h \
+    c/mne_geometry_cache.h \
     c/mne_msh_display_surface.h \
     c/mne_msh_display_surface_set.h \
     c/mne_msh_picked.h \
@@ -43,13 +43,16 @@
 
 #include <utils/mnemath.h>
 
+#include <algorithm>
+#include <cmath>
+
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
 
 #include <QPointer>
-#include <QtConcurrent>
 #include <QDebug>
+#include <QVector>
 
 //=============================================================================================================
 // USED NAMESPACES
@@ -60,6 +63,371 @@ using namespace MNELIB;
 using namespace UTILSLIB;
 using namespace Eigen;
 
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+namespace
+{
+
+//=============================================================================================================
+/**
+ * A channel which is scanned for artifacts.
+ */
+struct RejectionChannel
+{
+    int     iRow;           /**< The row of the channel in the epoch data. */
+    double  dThreshold;     /**< The peak to peak threshold. */
+    QString sChName;        /**< The channel name. */
+};
+
+//=============================================================================================================
+/**
+ * The window of one epoch in the raw data.
+ */
+struct EpochWindow
+{
+    qint32      iEpoch;     /**< The position of the epoch in event order. */
+    fiff_int_t  iFrom;      /**< The first sample. */
+    fiff_int_t  iTo;        /**< The last sample. */
+};
+
+//=============================================================================================================
+/**
+ * Collects the channels to scan for artifacts once, instead of for every epoch. Channel types without a threshold
+ * in mapReject are not scanned.
+ *
+ * @param[in] info          The measurement info.
+ * @param[in] mapReject     The peak to peak thresholds per channel type (grad, mag, eeg, eog).
+ * @param[in] lExcludeChs   The channels to leave out.
+ * @param[in] picks         The channels which make up the rows of the epoch data. All channels if empty.
+ *
+ * @return The channels to scan.
+ */
+QVector<RejectionChannel> rejectionChannels(const FiffInfo& info,
+                                            const QMap<QString,double>& mapReject,
+                                            const QStringList& lExcludeChs,
+                                            const RowVectorXi& picks)
+{
+    QVector<RejectionChannel> lChannels;
+
+    if(mapReject.isEmpty()) {
+        return lChannels;
+    }
+
+    const int iNumRows = picks.size() > 0 ? picks.size() : info.chs.size();
+
+    for(int r = 0; r < iNumRows; ++r) {
+        const int i = picks.size() > 0 ? picks(r) : r;
+
+        if(i < 0 || i >= info.chs.size()) {
+            continue;
+        }
+
+        const FiffChInfo& chInfo = info.chs.at(i);
+
+        if(lExcludeChs.contains(chInfo.ch_name)
+           || info.bads.contains(chInfo.ch_name)
+           || chInfo.chpos.coil_type == FIFFV_COIL_BABY_REF_MAG
+           || chInfo.chpos.coil_type == FIFFV_COIL_BABY_REF_MAG2) {
+            continue;
+        }
+
+        QString sType;
+
+        switch (chInfo.kind) {
+        case FIFFV_MEG_CH:
+            if(chInfo.unit == FIFF_UNIT_T) {
+                sType = "mag";
+            } else if(chInfo.unit == FIFF_UNIT_T_M) {
+                sType = "grad";
+            }
+        break;
+
+        case FIFFV_EEG_CH:
+            sType = "eeg";
+        break;
+
+        case FIFFV_EOG_CH:
+            sType = "eog";
+        break;
+        }
+
+        if(!sType.isEmpty() && mapReject.contains(sType)) {
+            lChannels.append({r, mapReject.value(sType), chInfo.ch_name});
+        }
+    }
+
+    return lChannels;
+}
+
+//=============================================================================================================
+/**
+ * Checks the peak to peak amplitude of the scanned channels against their thresholds.
+ *
+ * @param[in] matData       The epoch data (channels x samples).
+ * @param[in] lChannels     The channels to scan.
+ *
+ * @return Whether a threshold was exceeded.
+ */
+bool exceedsThreshold(const Ref<const MatrixXd>& matData,
+                      const QVector<RejectionChannel>& lChannels)
+{
+    if(lChannels.isEmpty()) {
+        return false;
+    }
+
+    // Column wise reductions run over contiguous memory
+    const VectorXd vecPeakToPeak = matData.rowwise().maxCoeff() - matData.rowwise().minCoeff();
+
+    for(const RejectionChannel& channel : lChannels) {
+        if(channel.iRow < vecPeakToPeak.size() && std::fabs(vecPeakToPeak[channel.iRow]) > channel.dThreshold) {
+            qInfo().noquote() << "[MNEEpochDataList::checkForArtifact] Reject trial because of channel" << channel.sChName;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//=============================================================================================================
+/**
+ * Computes the baseline samples [iFrom, iTo) of an epoch, see MNEMath::baselineRange.
+ *
+ * @param[in] iNumSamples   The number of samples per epoch.
+ * @param[in] tmin          The start time of the epoch in seconds.
+ * @param[in] tmax          The end time of the epoch in seconds.
+ * @param[in] baseline      The baseline window in seconds.
+ * @param[out] iFrom        The first baseline sample.
+ * @param[out] iTo          One past the last baseline sample.
+ *
+ * @return Whether the baseline window is valid.
+ */
+bool baselineRange(qint32 iNumSamples,
+                   float tmin,
+                   float tmax,
+                   const QPair<float,float>& baseline,
+                   qint32& iFrom,
+                   qint32& iTo)
+{
+    const RowVectorXf times = RowVectorXf::LinSpaced(iNumSamples, tmin, tmax);
+
+    if(!MNEMath::baselineRange(times, baseline, iFrom, iTo)) {
+        qWarning() << "[MNEEpochDataList] Empty baseline window. Baseline correction is not applied.";
+        return false;
+    }
+
+    return true;
+}
+
+//=============================================================================================================
+/**
+ * Subtracts the mean of the baseline samples [iFrom, iTo) from each channel.
+ *
+ * @param[in, out] matData  The epoch data (channels x samples).
+ * @param[in] iFrom         The first baseline sample.
+ * @param[in] iTo           One past the last baseline sample.
+ */
+void subtractBaseline(Ref<MatrixXd> matData,
+                      qint32 iFrom,
+                      qint32 iTo)
+{
+    const VectorXd vecMean = matData.middleCols(iFrom, iTo - iFrom).rowwise().mean();
+    matData.colwise() -= vecMean;
+}
+
+//=============================================================================================================
+/**
+ * Selects the windows of the matching events. Windows which reach outside of the raw data or differ in length
+ * from the first one are left out.
+ *
+ * @param[in] raw           The raw data.
+ * @param[in] events        The events provided in samples and event kind.
+ * @param[in] tmin          The start time relative to the event in seconds.
+ * @param[in] tmax          The end time relative to the event in seconds.
+ * @param[in] event         The event kind.
+ * @param[out] lWindows     The windows in event order.
+ *
+ * @return The number of samples per window.
+ */
+qint32 selectEpochWindows(const FiffRawData& raw,
+                          const MatrixXi& events,
+                          float tmin,
+                          float tmax,
+                          qint32 event,
+                          QVector<EpochWindow>& lWindows)
+{
+    lWindows.clear();
+
+    qint32 iNumSamples = 0;
+    qint32 count = 0;
+
+    for(qint32 p = 0; p < events.rows(); ++p) {
+        if(events(p,1) != 0 || events(p,2) != event) {
+            continue;
+        }
+
+        ++count;
+
+        fiff_int_t event_samp = events(p,0);
+        fiff_int_t from = event_samp + tmin*raw.info.sfreq;
+        fiff_int_t to   = event_samp + floor(tmax*raw.info.sfreq + 0.5);
+
+        if(from > to || from < raw.first_samp || to > raw.last_samp) {
+            qWarning("[MNEEpochDataList::readEpochs] Can't read the event data segments.");
+            continue;
+        }
+
+        if(iNumSamples == 0) {
+            iNumSamples = to - from + 1;
+        } else if(to - from + 1 != iNumSamples) {
+            continue;
+        }
+
+        lWindows.append({lWindows.size(), from, to});
+    }
+
+    if (count > 0) {
+        qInfo("[MNEEpochDataList::readEpochs] %d matching events found",count);
+    } else {
+        qWarning("[MNEEpochDataList::readEpochs] No desired events found.");
+    }
+
+    return iNumSamples;
+}
+
+//=============================================================================================================
+/**
+ * Reads the windows in a single pass over the raw data. The windows are sorted by position and grouped into chunks
+ * of at most ten seconds, each read with one call to read_raw_segment. Windows which are further apart than one
+ * window length start a new chunk, so no large gaps are read. The visitor is called with the epoch position and a
+ * view into the chunk, which is only valid during the call.
+ *
+ * @param[in] raw           The raw data.
+ * @param[in] lWindows      The windows.
+ * @param[in] iNumSamples   The number of samples per window.
+ * @param[in] picks         Which channels to read.
+ * @param[in] visitor       Called with (qint32 iEpoch, const Ref<const MatrixXd>& matEpoch) per window.
+ */
+template<typename Visitor>
+void readEpochWindows(const FiffRawData& raw,
+                      QVector<EpochWindow> lWindows,
+                      qint32 iNumSamples,
+                      const RowVectorXi& picks,
+                      Visitor visitor)
+{
+    std::stable_sort(lWindows.begin(), lWindows.end(), [](const EpochWindow& a, const EpochWindow& b) {
+        return a.iFrom < b.iFrom;
+    });
+
+    const fiff_int_t iMaxChunk = std::max(iNumSamples, static_cast<qint32>(10.0f * raw.info.sfreq));
+
+    MatrixXd matChunk, timesDummy;
+    int iFirst = 0;
+
+    while(iFirst < lWindows.size()) {
+        const fiff_int_t iChunkFrom = lWindows[iFirst].iFrom;
+        fiff_int_t iChunkTo = lWindows[iFirst].iTo;
+        int iLast = iFirst + 1;
+
+        while(iLast < lWindows.size()
+              && lWindows[iLast].iTo - iChunkFrom < iMaxChunk
+              && lWindows[iLast].iFrom <= iChunkTo + iNumSamples) {
+            iChunkTo = lWindows[iLast].iTo;
+            ++iLast;
+        }
+
+        if(raw.read_raw_segment(matChunk, timesDummy, iChunkFrom, iChunkTo, picks)) {
+            for(int w = iFirst; w < iLast; ++w) {
+                visitor(lWindows[w].iEpoch, matChunk.middleCols(lWindows[w].iFrom - iChunkFrom, iNumSamples));
+            }
+        } else {
+            qWarning("[MNEEpochDataList::readEpochs] Can't read the event data segments.");
+        }
+
+        iFirst = iLast;
+    }
+}
+
+//=============================================================================================================
+/**
+ * Puts an average into a FiffEvoked.
+ *
+ * @param[in] info          The measurement info.
+ * @param[in] matAverage    The average (channels x samples).
+ * @param[in] nave          The number of averaged epochs.
+ * @param[in] first         First time sample.
+ * @param[in] last          Last time sample.
+ * @param[in] tmin          The start time of the epochs in seconds.
+ * @param[in] tmax          The end time of the epochs in seconds.
+ * @param[in] event         The event kind.
+ * @param[in] proj          Apply SSPs.
+ *
+ * @return The evoked data.
+ */
+FiffEvoked toEvoked(const FiffInfo& info,
+                    MatrixXd matAverage,
+                    fiff_int_t nave,
+                    fiff_int_t first,
+                    fiff_int_t last,
+                    float tmin,
+                    float tmax,
+                    qint32 event,
+                    bool proj)
+{
+    FiffEvoked p_evoked;
+
+    p_evoked.nave = nave;
+
+    qInfo("[MNEEpochDataList::average] %d averages used [done]", p_evoked.nave);
+
+    p_evoked.setInfo(info, proj);
+
+    p_evoked.aspect_kind = FIFFV_ASPECT_AVERAGE;
+
+    p_evoked.first = first;
+    p_evoked.last = last;
+
+    p_evoked.times = RowVectorXf::LinSpaced(matAverage.cols(), tmin, tmax);
+
+    const int iZero = static_cast<int>(tmin * -1 * info.sfreq);
+    if(iZero >= 0 && iZero < p_evoked.times.size()) {
+        p_evoked.times[iZero] = 0;
+    }
+
+    p_evoked.comment = QString::number(event);
+
+    if(p_evoked.proj.rows() > 0) {
+        matAverage = p_evoked.proj * matAverage;
+        qInfo("[MNEEpochDataList::average] SSP projectors applied to the evoked data");
+    }
+
+    p_evoked.data = matAverage;
+
+    return p_evoked;
+}
+
+//=============================================================================================================
+/**
+ * Returns the picks, or all channels if there are none.
+ *
+ * @param[in] raw       The raw data.
+ * @param[in] picks     Which channels to pick.
+ *
+ * @return The picks.
+ */
+RowVectorXi allPicks(const FiffRawData& raw,
+                     const RowVectorXi& picks)
+{
+    if(picks.cols() > 0) {
+        return picks;
+    }
+
+    return RowVectorXi::LinSpaced(raw.info.chs.size(), 0, raw.info.chs.size() - 1);
+}
+
+} // NAMESPACE
+
 //=============================================================================================================
 // DEFINE MEMBER METHODS
 //=============================================================================================================
@@ -93,85 +461,109 @@ MNEEpochDataList MNEEpochDataList::readEpochs(const FiffRawData& raw,
     MNEEpochDataList data;
 
     // Select the desired events
-    qint32 count = 0;
-    qint32 p;
-    MatrixXi selected = MatrixXi::Zero(1, events.rows());
-    for (p = 0; p < events.rows(); ++p)
-    {
-        if (events(p,1) == 0 && events(p,2) == event)
-        {
-            selected(0,count) = p;
-            ++count;
-        }
-    }
-    selected.conservativeResize(1, count);
-    if (count > 0) {
-        qInfo("[MNEEpochDataList::readEpochs] %d matching events found",count);
-    } else {
-        qWarning("[MNEEpochDataList::readEpochs] No desired events found.");
-        return MNEEpochDataList();
+    QVector<EpochWindow> lWindows;
+    qint32 iNumSamples = selectEpochWindows(raw, events, tmin, tmax, event, lWindows);
+
+    if(lWindows.isEmpty()) {
+        return data;
     }
 
     // If picks are empty, pick all
-    RowVectorXi picksNew = picks;
-    if(picks.cols() <= 0) {
-        picksNew.resize(raw.info.chs.size());
-        for(int i = 0; i < raw.info.chs.size(); ++i) {
-            picksNew(i) = i;
+    RowVectorXi picksNew = allPicks(raw, picks);
+    QVector<RejectionChannel> lRejectionChannels = rejectionChannels(raw.info, mapReject, lExcludeChs, picksNew);
+
+    fiff_int_t dropCount = 0;
+    QVector<MNEEpochData::SPtr> lEpochs(lWindows.size());
+
+    readEpochWindows(raw, lWindows, iNumSamples, picksNew, [&](qint32 iEpoch, const Ref<const MatrixXd>& matEpoch) {
+        MNEEpochData::SPtr pEpoch(new MNEEpochData());
+
+        pEpoch->epoch = matEpoch;
+        pEpoch->event = event;
+        pEpoch->tmin = tmin;
+        pEpoch->tmax = tmax;
+        pEpoch->bReject = exceedsThreshold(pEpoch->epoch, lRejectionChannels);
+
+        if (pEpoch->bReject) {
+            dropCount++;
+        }
+
+        lEpochs[iEpoch] = pEpoch;
+    });
+
+    for(const MNEEpochData::SPtr& pEpoch : lEpochs) {
+        if(pEpoch) {
+            data.append(pEpoch);
         }
     }
 
-    fiff_int_t event_samp, from, to;
-    fiff_int_t dropCount = 0;
-    MatrixXd timesDummy;
-    MatrixXd times;
+    qInfo().noquote() << "[MNEEpochDataList::readEpochs] Read a total of"<< data.size() <<"epochs of type" << event << "and marked"<< dropCount <<"for rejection.";
 
-    QScopedPointer<MNEEpochData> epoch(Q_NULLPTR);
+    return data;
+}
 
-    for (p = 0; p < count; ++p) {
-        // Read a data segment
-        event_samp = events(selected(p),0);
-        from = event_samp + tmin*raw.info.sfreq;
-        to   = event_samp + floor(tmax*raw.info.sfreq + 0.5);
+//=============================================================================================================
 
-        epoch.reset(new MNEEpochData());
+FiffEvoked MNEEpochDataList::averageEpochs(const FiffRawData& raw,
+                                           const MatrixXi& events,
+                                           float tmin,
+                                           float tmax,
+                                           qint32 event,
+                                           const QMap<QString,double>& mapReject,
+                                           const QStringList& lExcludeChs,
+                                           const RowVectorXi& picks,
+                                           bool bApplyBaseline,
+                                           const QPair<float,float>& baseline)
+{
+    QVector<EpochWindow> lWindows;
+    qint32 iNumSamples = selectEpochWindows(raw, events, tmin, tmax, event, lWindows);
 
-        if(raw.read_raw_segment(epoch->epoch, timesDummy, from, to, picksNew)) {
-            if (p == 0) {
-                times.resize(1, to-from+1);
-                for (qint32 i = 0; i < times.cols(); ++i)
-                    times(0, i) = ((float)(from-event_samp+i)) / raw.info.sfreq;
-            }
+    if(lWindows.isEmpty()) {
+        FiffEvoked p_evoked;
+        p_evoked.nave = 0;
+        return p_evoked;
+    }
 
-            epoch->event = event;
-            epoch->tmin = tmin;
-            epoch->tmax = tmax;
+    RowVectorXi picksNew = allPicks(raw, picks);
+    QVector<RejectionChannel> lRejectionChannels = rejectionChannels(raw.info, mapReject, lExcludeChs, picksNew);
 
-            epoch->bReject = checkForArtifact(epoch->epoch,
-                                              raw.info,
-                                              mapReject,
-                                              lExcludeChs);
+    qint32 iBaselineFrom = 0, iBaselineTo = 0;
+    bApplyBaseline = bApplyBaseline && baselineRange(iNumSamples, tmin, tmax, baseline, iBaselineFrom, iBaselineTo);
 
-            if (epoch->bReject) {
-                dropCount++;
-            }
+    MatrixXd matSum = MatrixXd::Zero(picksNew.size(), iNumSamples);
+    MatrixXd matCorrected;
+    fiff_int_t nave = 0;
+    fiff_int_t dropCount = 0;
 
-            //Check if data block has the same size as the previous one
-            if(!data.isEmpty()) {
-                if(epoch->epoch.size() == data.last()->epoch.size()) {
-                    data.append(MNEEpochData::SPtr(epoch.take()));//List takes ownwership of the pointer - no delete need
-                }
-            } else {
-                data.append(MNEEpochData::SPtr(epoch.take()));//List takes ownwership of the pointer - no delete need
-            }
+    readEpochWindows(raw, lWindows, iNumSamples, picksNew, [&](qint32, const Ref<const MatrixXd>& matEpoch) {
+        if(exceedsThreshold(matEpoch, lRejectionChannels)) {
+            dropCount++;
+            return;
+        }
+
+        if(bApplyBaseline) {
+            matCorrected = matEpoch;
+            subtractBaseline(matCorrected, iBaselineFrom, iBaselineTo);
+            matSum += matCorrected;
         } else {
-            qWarning("[MNEEpochDataList::readEpochs] Can't read the event data segments.");
+            matSum += matEpoch;
         }
+
+        ++nave;
+    });
+
+    qInfo().noquote() << "[MNEEpochDataList::averageEpochs] Read a total of"<< lWindows.size() <<"epochs of type" << event << "and rejected"<< dropCount;
+
+    if(nave == 0) {
+        qWarning("[MNEEpochDataList::averageEpochs] All epochs were rejected.");
+        FiffEvoked p_evoked;
+        p_evoked.nave = 0;
+        return p_evoked;
     }
 
-    qInfo().noquote() << "[MNEEpochDataList::readEpochs] Read a total of"<< data.size() <<"epochs of type" << event << "and marked"<< dropCount <<"for rejection.";
+    matSum /= nave;
 
-    return data;
+    return toEvoked(raw.info, matSum, nave, 0, iNumSamples, tmin, tmax, event, false);
 }
 
 //=============================================================================================================
@@ -182,57 +574,43 @@ FiffEvoked MNEEpochDataList::average(const FiffInfo& info,
                                      VectorXi sel,
                                      bool proj)
 {
-    FiffEvoked p_evoked;
-
     qInfo("[MNEEpochDataList::average] Calculate evoked. ");
 
     MatrixXd matAverage;
+    fiff_int_t nave;
 
     if(this->size() > 0) {
         matAverage = MatrixXd::Zero(this->at(0)->epoch.rows(), this->at(0)->epoch.cols());
     } else {
+        FiffEvoked p_evoked;
         p_evoked.aspect_kind = FIFFV_ASPECT_STD_ERR;
         return p_evoked;
     }
 
     if(sel.size() > 0) {
-        p_evoked.nave = sel.size();
+        nave = sel.size();
 
         for(qint32 i = 0; i < sel.size(); ++i) {
             matAverage.array() += this->at(sel(i))->epoch.array();
         }
     } else {
-        p_evoked.nave = this->size();
+        nave = this->size();
 
         for(qint32 i = 0; i < this->size(); ++i) {
             matAverage.array() += this->at(i)->epoch.array();
         }
     }
-    matAverage.array() /= p_evoked.nave;
-
-    qInfo("[MNEEpochDataList::average] %d averages used [done]", p_evoked.nave);
-
-    p_evoked.setInfo(info, proj);
-
-    p_evoked.aspect_kind = FIFFV_ASPECT_AVERAGE;
-
-    p_evoked.first = first;
-    p_evoked.last = last;
-
-    p_evoked.times = RowVectorXf::LinSpaced(this->first()->epoch.cols(), this->first()->tmin, this->first()->tmax);
-
-    p_evoked.times[static_cast<int>(this->first()->tmin * -1 * info.sfreq)] = 0;
-
-    p_evoked.comment = QString::number(this->at(0)->event);
-
-    if(p_evoked.proj.rows() > 0) {
-        matAverage = p_evoked.proj * matAverage;
-        qInfo("[MNEEpochDataList::average] SSP projectors applied to the evoked data");
-    }
-
-    p_evoked.data = matAverage;
-
-    return p_evoked;
+    matAverage.array() /= nave;
+
+    return toEvoked(info,
+                    matAverage,
+                    nave,
+                    first,
+                    last,
+                    this->first()->tmin,
+                    this->first()->tmax,
+                    this->at(0)->event,
+                    proj);
 }
 
 //=============================================================================================================
@@ -277,82 +655,22 @@ bool MNEEpochDataList::checkForArtifact(const MatrixXd& data,
 {
     //qDebug() << "MNEEpochDataList::checkForArtifact - Doing artifact reduction for" << mapReject;
 
-    bool bReject = false;
-
-    //Prepare concurrent data handling
-    QList<ArtifactRejectionData> lchData;
-    QList<int> lChTypes;
-
-    if(mapReject.contains("grad") ||
-       mapReject.contains("mag") ) {
-        lChTypes << FIFFV_MEG_CH;
+    if(!mapReject.contains("grad")
+       && !mapReject.contains("mag")
+       && !mapReject.contains("eeg")
+       && !mapReject.contains("eog")) {
+        return false;
     }
 
-    if(mapReject.contains("eeg")) {
-        lChTypes << FIFFV_EEG_CH;
-    }
-
-    if(mapReject.contains("eog")) {
-        lChTypes << FIFFV_EOG_CH;
-    }
-
-    if(lChTypes.isEmpty()) {
-        return bReject;
-    }
-
-    for(int i = 0; i < pFiffInfo.chs.size(); ++i) {
-        if(lChTypes.contains(pFiffInfo.chs.at(i).kind)
-           && !lExcludeChs.contains(pFiffInfo.chs.at(i).ch_name)
-           && !pFiffInfo.bads.contains(pFiffInfo.chs.at(i).ch_name)
-           && pFiffInfo.chs.at(i).chpos.coil_type != FIFFV_COIL_BABY_REF_MAG
-           && pFiffInfo.chs.at(i).chpos.coil_type != FIFFV_COIL_BABY_REF_MAG2) {
-            ArtifactRejectionData tempData;
-            tempData.data = data.row(i);
-
-            switch (pFiffInfo.chs.at(i).kind) {
-            case FIFFV_MEG_CH:
-                if(pFiffInfo.chs.at(i).unit == FIFF_UNIT_T) {
-                    tempData.dThreshold = mapReject["mag"];
-                } else if(pFiffInfo.chs.at(i).unit == FIFF_UNIT_T_M) {
-                    tempData.dThreshold = mapReject["grad"];
-                }
-            break;
-
-            case FIFFV_EEG_CH:
-                tempData.dThreshold = mapReject["eeg"];
-            break;
-
-            case FIFFV_EOG_CH:
-                tempData.dThreshold = mapReject["eog"];
-            break;
-            }
+    QVector<RejectionChannel> lChannels = rejectionChannels(pFiffInfo, mapReject, lExcludeChs, RowVectorXi());
 
-            tempData.sChName = pFiffInfo.chs.at(i).ch_name;
-            lchData.append(tempData);
-        }
-    }
-
-    if(lchData.isEmpty()) {
+    if(lChannels.isEmpty()) {
         qWarning() << "[MNEEpochDataList::checkForArtifact] No channels found to scan for artifacts. Do not reject. Returning.";
 
-        return bReject;
-    }
-
-    //qDebug() << "MNEEpochDataList::checkForArtifact - lchData.size()" << lchData.size();
-
-    //Start the concurrent processing
-    QFuture<void> future = QtConcurrent::map(lchData, checkChThreshold);
-    future.waitForFinished();
-
-    for(int i = 0; i < lchData.size(); ++i) {
-        if(lchData.at(i).bRejected) {
-            bReject = true;
-            qInfo().noquote() << "[MNEEpochDataList::checkForArtifact] Reject trial because of channel"<<lchData.at(i).sChName;
-            break;
-        }
+        return false;
     }
 
-    return bReject;
+    return exceedsThreshold(data, lChannels);
 }
 
 //=============================================================================================================
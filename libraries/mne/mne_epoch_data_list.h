@@ -53,6 +53,8 @@
 //=============================================================================================================
 
 #include <QList>
+#include <QMap>
+#include <QPair>
 #include <QSharedPointer>
 
 //=============================================================================================================
@@ -96,7 +98,9 @@ public:
 
     //=========================================================================================================
     /**
-     * Read the epochs from a raw file based on provided events.
+     * Read the epochs from a raw file based on provided events. The windows are sorted by their position in the file
+     * and read in a single pass of chunks spanning several windows, so that overlapping and neighbouring windows share
+     * the raw buffers they are read and calibrated from.
      *
      * @param[in] raw            The raw data.
      * @param[in] events         The events provided in samples and event kind.
@@ -115,6 +119,35 @@ public:
                                        const QStringList &lExcludeChs = QStringList(),
                                        const Eigen::RowVectorXi& picks = Eigen::RowVectorXi());
 
+    //=========================================================================================================
+    /**
+     * Averages the epochs of one event kind in a single pass over the raw data without storing them. Rejected epochs
+     * are left out of the average.
+     *
+     * @param[in] raw               The raw data.
+     * @param[in] events            The events provided in samples and event kind.
+     * @param[in] tmin              The start time relative to the event in seconds.
+     * @param[in] tmax              The end time relative to the event in seconds.
+     * @param[in] event             The event kind.
+     * @param[in] mapReject         The peak to peak rejection thresholds per channel type (grad, mag, eeg, eog).
+     * @param[in] lExcludeChs       List of channel names to exclude from the artifact rejection.
+     * @param[in] picks             Which channels to pick.
+     * @param[in] bApplyBaseline    Whether to subtract the mean of the baseline window from each epoch.
+     * @param[in] baseline          The baseline window [from, to] in seconds.
+     *
+     * @return The evoked data. Its nave is 0 if no epoch was averaged.
+     */
+    static FIFFLIB::FiffEvoked averageEpochs(const FIFFLIB::FiffRawData& raw,
+                                             const Eigen::MatrixXi& events,
+                                             float tmin,
+                                             float tmax,
+                                             qint32 event,
+                                             const QMap<QString,double>& mapReject,
+                                             const QStringList &lExcludeChs = QStringList(),
+                                             const Eigen::RowVectorXi& picks = Eigen::RowVectorXi(),
+                                             bool bApplyBaseline = false,
+                                             const QPair<float, float>& baseline = QPair<float, float>(0.0f, 0.0f));
+
     //=========================================================================================================
     /**
      * Averages epoch list. Note that no baseline correction performed.
@@ -0,0 +1,415 @@
+//=============================================================================================================
+/**
+ * @file     mne_stc_file.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Definition of the MNEStcFile Class.
+ *
+ */
+
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "mne_stc_file.h"
+
+#include <cstring>
+#include <limits>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QByteArray>
+#include <QtEndian>
+#include <QDebug>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace MNELIB;
+using namespace Eigen;
+
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+namespace
+{
+
+inline float readFloat(const uchar* pData)
+{
+    quint32 iValue = qFromBigEndian<quint32>(pData);
+    float fValue;
+    std::memcpy(&fValue, &iValue, sizeof(float));
+    return fValue;
+}
+
+//=============================================================================================================
+
+inline void writeFloat(float fValue, uchar* pData)
+{
+    quint32 iValue;
+    std::memcpy(&iValue, &fValue, sizeof(float));
+    qToBigEndian<quint32>(iValue, pData);
+}
+
+//=============================================================================================================
+
+template<typename T>
+bool appendData(QFile& file, const Matrix<T,Dynamic,Dynamic>& matData)
+{
+    QByteArray buffer(int(matData.size() * 4), Qt::Uninitialized);
+    uchar* pData = reinterpret_cast<uchar*>(buffer.data());
+
+    // Column major, i.e. time point by time point as in the stc format
+    for(int i = 0; i < matData.size(); ++i) {
+        writeFloat(float(matData.data()[i]), pData + 4 * i);
+    }
+
+    return file.write(buffer) == buffer.size();
+}
+
+} // anonymous namespace
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+MNEStcFile::MNEStcFile()
+: m_pMap(NULL)
+, m_iDataOffset(0)
+, m_bWriting(false)
+, m_fTmin(0.0f)
+, m_fTstep(-1.0f)
+, m_iNumSamples(0)
+, m_iTileSize(1000)
+{
+}
+
+//=============================================================================================================
+
+MNEStcFile::~MNEStcFile()
+{
+    close();
+}
+
+//=============================================================================================================
+
+bool MNEStcFile::open(const QString& sFileName,
+                      int iTileSize,
+                      bool bComputeRanges)
+{
+    close();
+
+    m_file.setFileName(sFileName);
+    if(!m_file.open(QIODevice::ReadOnly)) {
+        qWarning() << "MNEStcFile::open - Could not open" << sFileName;
+        return false;
+    }
+
+    qint64 iSize = m_file.size();
+    if(iSize < 16 || (m_pMap = m_file.map(0, iSize)) == NULL) {
+        qWarning() << "MNEStcFile::open - Could not map" << sFileName;
+        m_file.close();
+        return false;
+    }
+
+    // Header: tmin [ms], tstep [ms], number of vertices, vertices, number of time points
+    m_fTmin = readFloat(m_pMap) / 1000.0f;
+    m_fTstep = readFloat(m_pMap + 4) / 1000.0f;
+    quint32 iNumVertices = qFromBigEndian<quint32>(m_pMap + 8);
+
+    if(16 + 4 * qint64(iNumVertices) > iSize) {
+        qWarning() << "MNEStcFile::open - Corrupt header in" << sFileName;
+        close();
+        return false;
+    }
+
+    m_vecVertices.resize(iNumVertices);
+    for(quint32 i = 0; i < iNumVertices; ++i) {
+        m_vecVertices[i] = qFromBigEndian<quint32>(m_pMap + 12 + 4 * i);
+    }
+
+    quint32 iNumSamples = qFromBigEndian<quint32>(m_pMap + 12 + 4 * iNumVertices);
+    m_iDataOffset = 16 + 4 * qint64(iNumVertices);
+
+    if(iNumSamples > quint32(std::numeric_limits<int>::max())) {
+        qWarning() << "MNEStcFile::open - Too many time points" << iNumSamples << "in" << sFileName;
+        close();
+        return false;
+    }
+
+    m_iNumSamples = int(iNumSamples);
+
+    // Compare by division, the product of vertices and time points can overflow
+    if(iNumVertices > 0 && m_iNumSamples > (iSize - m_iDataOffset) / (4 * qint64(iNumVertices))) {
+        qWarning() << "MNEStcFile::open - File is shorter than announced in its header" << sFileName;
+        close();
+        return false;
+    }
+
+    m_iTileSize = qMax(iTileSize, 1);
+
+    if(bComputeRanges) {
+        computeRanges();
+    }
+
+    return true;
+}
+
+//=============================================================================================================
+
+bool MNEStcFile::create(const QString& sFileName,
+                        const VectorXi& vecVertices,
+                        float fTmin,
+                        float fTstep)
+{
+    close();
+
+    m_file.setFileName(sFileName);
+    if(!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "MNEStcFile::create - Could not open" << sFileName;
+        return false;
+    }
+
+    m_vecVertices = vecVertices;
+    m_fTmin = fTmin;
+    m_fTstep = fTstep;
+    m_iNumSamples = 0;
+    m_iDataOffset = 16 + 4 * qint64(vecVertices.size());
+
+    // The number of time points is written when closing the file
+    QByteArray header(int(m_iDataOffset), Qt::Uninitialized);
+    uchar* pHeader = reinterpret_cast<uchar*>(header.data());
+    writeFloat(1000.0f * fTmin, pHeader);
+    writeFloat(1000.0f * fTstep, pHeader + 4);
+    qToBigEndian<quint32>(quint32(vecVertices.size()), pHeader + 8);
+    for(int i = 0; i < vecVertices.size(); ++i) {
+        qToBigEndian<quint32>(quint32(vecVertices[i]), pHeader + 12 + 4 * i);
+    }
+    qToBigEndian<quint32>(0, pHeader + m_iDataOffset - 4);
+
+    if(m_file.write(header) != header.size()) {
+        qWarning() << "MNEStcFile::create - Could not write header to" << sFileName;
+        m_file.close();
+        return false;
+    }
+
+    m_bWriting = true;
+
+    return true;
+}
+
+//=============================================================================================================
+
+bool MNEStcFile::append(const MatrixXd& matData)
+{
+    if(!m_bWriting || matData.rows() != m_vecVertices.size()) {
+        qWarning() << "MNEStcFile::append - File not created or dimension mismatch";
+        return false;
+    }
+
+    if(!appendData(m_file, matData)) {
+        return false;
+    }
+
+    m_iNumSamples += matData.cols();
+
+    return true;
+}
+
+//=============================================================================================================
+
+bool MNEStcFile::append(const MatrixXf& matData)
+{
+    if(!m_bWriting || matData.rows() != m_vecVertices.size()) {
+        qWarning() << "MNEStcFile::append - File not created or dimension mismatch";
+        return false;
+    }
+
+    if(!appendData(m_file, matData)) {
+        return false;
+    }
+
+    m_iNumSamples += matData.cols();
+
+    return true;
+}
+
+//=============================================================================================================
+
+bool MNEStcFile::close()
+{
+    bool bResult = true;
+
+    if(m_bWriting) {
+        uchar count[4];
+        qToBigEndian<quint32>(quint32(m_iNumSamples), count);
+        bResult = m_file.seek(m_iDataOffset - 4) && m_file.write(reinterpret_cast<const char*>(count), 4) == 4;
+        m_bWriting = false;
+    }
+
+    if(m_pMap) {
+        m_file.unmap(m_pMap);
+        m_pMap = NULL;
+    }
+
+    if(m_file.isOpen()) {
+        m_file.close();
+    }
+
+    m_vecTileMin.resize(0);
+    m_vecTileMax.resize(0);
+    m_iNumSamples = 0;
+
+    return bResult;
+}
+
+//=============================================================================================================
+
+bool MNEStcFile::readWindow(int iFrom,
+                            int iNum,
+                            MatrixXf& matData) const
+{
+    if(!isOpen()) {
+        return false;
+    }
+
+    iFrom = qBound(0, iFrom, m_iNumSamples);
+    iNum = qBound(0, iNum, m_iNumSamples - iFrom);
+
+    const int iNumSources = m_vecVertices.size();
+    matData.resize(iNumSources, iNum);
+
+    for(int c = 0; c < iNum; ++c) {
+        const uchar* pData = sampleData(iFrom + c);
+        float* pOut = matData.col(c).data();
+        for(int k = 0; k < iNumSources; ++k) {
+            pOut[k] = readFloat(pData + 4 * k);
+        }
+    }
+
+    return true;
+}
+
+//=============================================================================================================
+
+bool MNEStcFile::readWindow(int iFrom,
+                            int iNum,
+                            MatrixXd& matData) const
+{
+    MatrixXf matDataFloat;
+
+    if(!readWindow(iFrom, iNum, matDataFloat)) {
+        return false;
+    }
+
+    matData = matDataFloat.cast<double>();
+
+    return true;
+}
+
+//=============================================================================================================
+
+MNESourceEstimate MNEStcFile::read(int iFrom,
+                                   int iNum) const
+{
+    MatrixXd matData;
+
+    if(!readWindow(iFrom, iNum, matData)) {
+        return MNESourceEstimate();
+    }
+
+    iFrom = qBound(0, iFrom, m_iNumSamples);
+
+    return MNESourceEstimate(matData, m_vecVertices, m_fTmin + iFrom * m_fTstep, m_fTstep);
+}
+
+//=============================================================================================================
+
+void MNEStcFile::computeRanges()
+{
+    if(!isOpen()) {
+        return;
+    }
+
+    m_vecTileMin.setConstant(tiles(), std::numeric_limits<float>::max());
+    m_vecTileMax.setConstant(tiles(), -std::numeric_limits<float>::max());
+
+    const int iNumSources = m_vecVertices.size();
+
+    for(int s = 0; s < m_iNumSamples; ++s) {
+        const int t = s / m_iTileSize;
+        const uchar* pData = sampleData(s);
+        float fMin = m_vecTileMin[t];
+        float fMax = m_vecTileMax[t];
+
+        for(int k = 0; k < iNumSources; ++k) {
+            float fValue = readFloat(pData + 4 * k);
+            fMin = qMin(fMin, fValue);
+            fMax = qMax(fMax, fValue);
+        }
+
+        m_vecTileMin[t] = fMin;
+        m_vecTileMax[t] = fMax;
+    }
+}
+
+//=============================================================================================================
+
+bool MNEStcFile::range(int iFrom,
+                       int iNum,
+                       float& fMin,
+                       float& fMax)
+{
+    if(!isOpen()) {
+        return false;
+    }
+
+    iFrom = qBound(0, iFrom, m_iNumSamples);
+    iNum = qBound(0, iNum, m_iNumSamples - iFrom);
+
+    if(iNum == 0 || m_vecVertices.size() == 0) {
+        return false;
+    }
+
+    if(m_vecTileMin.size() != tiles()) {
+        computeRanges();
+    }
+
+    const int iFirstTile = iFrom / m_iTileSize;
+    const int iLastTile = (iFrom + iNum - 1) / m_iTileSize;
+
+    fMin = m_vecTileMin.segment(iFirstTile, iLastTile - iFirstTile + 1).minCoeff();
+    fMax = m_vecTileMax.segment(iFirstTile, iLastTile - iFirstTile + 1).maxCoeff();
+
+    return true;
+}
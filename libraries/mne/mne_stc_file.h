@@ -0,0 +1,356 @@
+//=============================================================================================================
+/**
+ * @file     mne_stc_file.h
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Declaration of the MNEStcFile Class.
+ *
+ */
+
+
+#ifndef MNESTCFILE_H
+#define MNESTCFILE_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "mne_global.h"
+#include "mne_sourceestimate.h"
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QFile>
+#include <QSharedPointer>
+#include <QString>
+
+//=============================================================================================================
+// DEFINE NAMESPACE MNELIB
+//=============================================================================================================
+
+namespace MNELIB
+{
+
+//=============================================================================================================
+/**
+ * Chunked access to stc files. The stc format stores the float32 samples time point by time point, i.e. a run of
+ * consecutive time points (a tile) is one contiguous block of the file. For reading, the file is memory mapped and
+ * only the requested time windows are decoded, so arbitrarily long source time courses can be played back with
+ * bounded memory. Optionally, the minimum and maximum of each tile are computed once for fast colormap scaling.
+ * For writing, blocks of time points are appended and the number of time points is written when finishing the
+ * file. Files written this way can be read with MNESourceEstimate::read and vice versa.
+ *
+ * @brief Memory mapped, chunked stc file access.
+ */
+class MNESHARED_EXPORT MNEStcFile
+{
+
+public:
+    typedef QSharedPointer<MNEStcFile> SPtr;             /**< Shared pointer type for MNEStcFile. */
+    typedef QSharedPointer<const MNEStcFile> ConstSPtr;  /**< Const shared pointer type for MNEStcFile. */
+
+    //=========================================================================================================
+    /**
+     * Constructs a closed MNEStcFile.
+     */
+    MNEStcFile();
+
+    //=========================================================================================================
+    /**
+     * Closes the file. A file which is being written is finished first.
+     */
+    ~MNEStcFile();
+
+    //=========================================================================================================
+    /**
+     * Opens and memory maps an stc file for reading.
+     *
+     * @param[in] sFileName          The stc file.
+     * @param[in] iTileSize          The number of time points per tile.
+     * @param[in] bComputeRanges     Whether to compute the minimum and maximum of each tile right away.
+     *
+     * @return true if successful, false otherwise.
+     */
+    bool open(const QString& sFileName,
+              int iTileSize = 1000,
+              bool bComputeRanges = false);
+
+    //=========================================================================================================
+    /**
+     * Creates an stc file for writing. Data is added with append.
+     *
+     * @param[in] sFileName      The stc file.
+     * @param[in] vecVertices    The vertex indices of the sources.
+     * @param[in] fTmin          The time of the first sample in seconds.
+     * @param[in] fTstep         The time between two samples in seconds.
+     *
+     * @return true if successful, false otherwise.
+     */
+    bool create(const QString& sFileName,
+                const Eigen::VectorXi& vecVertices,
+                float fTmin,
+                float fTstep);
+
+    //=========================================================================================================
+    /**
+     * Appends time points to a file opened with create.
+     *
+     * @param[in] matData    The data (sources x time points).
+     *
+     * @return true if successful, false otherwise.
+     */
+    bool append(const Eigen::MatrixXd& matData);
+    bool append(const Eigen::MatrixXf& matData);
+
+    //=========================================================================================================
+    /**
+     * Writes the number of time points to a file opened with create and closes it. Closes a file opened for
+     * reading.
+     *
+     * @return true if successful, false otherwise.
+     */
+    bool close();
+
+    //=========================================================================================================
+    /**
+     * Returns whether a file is open for reading.
+     *
+     * @return true if open for reading.
+     */
+    inline bool isOpen() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the number of sources.
+     *
+     * @return The number of sources.
+     */
+    inline int sources() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the number of time points.
+     *
+     * @return The number of time points.
+     */
+    inline int samples() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the number of tiles.
+     *
+     * @return The number of tiles.
+     */
+    inline int tiles() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the number of time points per tile.
+     *
+     * @return The tile size.
+     */
+    inline int tileSize() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the time of the first sample in seconds.
+     *
+     * @return The start time.
+     */
+    inline float tmin() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the time between two samples in seconds.
+     *
+     * @return The time step.
+     */
+    inline float tstep() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the vertex indices of the sources.
+     *
+     * @return The vertices.
+     */
+    inline const Eigen::VectorXi& vertices() const;
+
+    //=========================================================================================================
+    /**
+     * Decodes a time window. The window is clipped to the available time points.
+     *
+     * @param[in] iFrom      The first time point.
+     * @param[in] iNum       The number of time points.
+     * @param[out] matData   The data (sources x time points).
+     *
+     * @return true if successful, false otherwise.
+     */
+    bool readWindow(int iFrom,
+                    int iNum,
+                    Eigen::MatrixXf& matData) const;
+    bool readWindow(int iFrom,
+                    int iNum,
+                    Eigen::MatrixXd& matData) const;
+
+    //=========================================================================================================
+    /**
+     * Decodes a time window into a source estimate.
+     *
+     * @param[in] iFrom      The first time point.
+     * @param[in] iNum       The number of time points.
+     *
+     * @return The source estimate of the window, empty if the file is not open.
+     */
+    MNESourceEstimate read(int iFrom,
+                           int iNum) const;
+
+    //=========================================================================================================
+    /**
+     * Computes the minimum and maximum of every tile with one pass over the file.
+     */
+    void computeRanges();
+
+    //=========================================================================================================
+    /**
+     * Returns the minimum and maximum of a time window based on the tile ranges. All tiles touched by the window
+     * are taken into account, so the range can be slightly wider than the exact one. computeRanges is called if
+     * the ranges are not available yet.
+     *
+     * @param[in] iFrom      The first time point.
+     * @param[in] iNum       The number of time points.
+     * @param[out] fMin      The minimum.
+     * @param[out] fMax      The maximum.
+     *
+     * @return true if successful, false otherwise.
+     */
+    bool range(int iFrom,
+               int iNum,
+               float& fMin,
+               float& fMax);
+
+private:
+    //=========================================================================================================
+    /**
+     * Returns the big endian samples of time point iSample.
+     *
+     * @param[in] iSample    The time point.
+     *
+     * @return Pointer to the first source.
+     */
+    inline const uchar* sampleData(int iSample) const;
+
+    QFile               m_file;             /**< The stc file. */
+    uchar*              m_pMap;             /**< The mapped file, NULL if not open for reading. */
+    qint64              m_iDataOffset;      /**< Offset of the first sample in the file. */
+    bool                m_bWriting;         /**< Whether the file was created for writing. */
+
+    Eigen::VectorXi     m_vecVertices;      /**< The vertex indices. */
+    float               m_fTmin;            /**< The time of the first sample in seconds. */
+    float               m_fTstep;           /**< The time between two samples in seconds. */
+    int                 m_iNumSamples;      /**< The number of time points. */
+    int                 m_iTileSize;        /**< The number of time points per tile. */
+
+    Eigen::VectorXf     m_vecTileMin;       /**< The minimum of each tile. */
+    Eigen::VectorXf     m_vecTileMax;       /**< The maximum of each tile. */
+};
+
+//=============================================================================================================
+// INLINE DEFINITIONS
+//=============================================================================================================
+
+inline bool MNEStcFile::isOpen() const
+{
+    return m_pMap != NULL;
+}
+
+//=============================================================================================================
+
+inline int MNEStcFile::sources() const
+{
+    return m_vecVertices.size();
+}
+
+//=============================================================================================================
+
+inline int MNEStcFile::samples() const
+{
+    return m_iNumSamples;
+}
+
+//=============================================================================================================
+
+inline int MNEStcFile::tiles() const
+{
+    return (m_iNumSamples + m_iTileSize - 1) / m_iTileSize;
+}
+
+//=============================================================================================================
+
+inline int MNEStcFile::tileSize() const
+{
+    return m_iTileSize;
+}
+
+//=============================================================================================================
+
+inline float MNEStcFile::tmin() const
+{
+    return m_fTmin;
+}
+
+//=============================================================================================================
+
+inline float MNEStcFile::tstep() const
+{
+    return m_fTstep;
+}
+
+//=============================================================================================================
+
+inline const Eigen::VectorXi& MNEStcFile::vertices() const
+{
+    return m_vecVertices;
+}
+
+//=============================================================================================================
+
+inline const uchar* MNEStcFile::sampleData(int iSample) const
+{
+    return m_pMap + m_iDataOffset + qint64(iSample) * m_vecVertices.size() * 4;
+}
+} // NAMESPACE MNELIB
+
+#endif // MNESTCFILE_H
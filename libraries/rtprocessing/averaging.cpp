@@ -76,27 +76,16 @@ FiffEvoked RTPROCESSINGLIB::computeAverage(const FiffRawData& raw,
                                            const RowVectorXi& picks)
 {
 
-    MNEEpochDataList lstEpochDataList = MNEEpochDataList::readEpochs(raw,
-                                                                     matEvents,
-                                                                     fTMinS,
-                                                                     fTMaxS,
-                                                                     eventType,
-                                                                     mapReject,
-                                                                     lExcludeChs,
-                                                                     picks);
-
-    if(bApplyBaseline){
-        QPair<float, float> baselinePair(fTBaselineFromS, fTBaselineToS);
-        lstEpochDataList.applyBaselineCorrection(baselinePair);
-    }
-
-    if(!mapReject.isEmpty()){
-        lstEpochDataList.dropRejected();
-    }
-
-    return lstEpochDataList.average(raw.info,
-                                    0,
-                                    lstEpochDataList.first()->epoch.cols());
+    return MNEEpochDataList::averageEpochs(raw,
+                                           matEvents,
+                                           fTMinS,
+                                           fTMaxS,
+                                           eventType,
+                                           mapReject,
+                                           lExcludeChs,
+                                           picks,
+                                           bApplyBaseline,
+                                           QPair<float, float>(fTBaselineFromS, fTBaselineToS));
 }
 
 //=============================================================================================================
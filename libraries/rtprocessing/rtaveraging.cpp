@@ -126,20 +126,8 @@ void RtAveragingWorker::setAverageNumber(qint32 numAve)
     }
 
     if(numAve < m_iNumAverages) {
-        int iDiff = m_iNumAverages - numAve;
-
-        //Do averaging for each trigger type
-        QMutableMapIterator<double,QList<Eigen::MatrixXd> > idx(m_mapStimAve);
-
-        while(idx.hasNext()) {
-            idx.next();
-
-            if(idx.value().size() > iDiff) {
-                //Pop data from buffer
-                for(int i = 0; i < iDiff; ++i) {
-                    idx.value().pop_front();
-                }
-            }
+        for(double dTriggerType : m_mapStimAve.keys()) {
+            dropOldestEpochs(dTriggerType, numAve);
         }
     }
 
@@ -418,14 +406,17 @@ void RtAveragingWorker::fillFrontBuffer(const MatrixXd &data, double dTriggerTyp
 
 void RtAveragingWorker::mergeData(double dTriggerType)
 {
-    if(m_mapDataPre[dTriggerType].rows() != m_mapDataPost[dTriggerType].rows()) {
-        qDebug() << "[RtAveragingWorker::mergeData] Rows of m_mapDataPre (" << m_mapDataPre[dTriggerType].rows() << ") and m_mapDataPost (" << m_mapDataPost[dTriggerType].rows() << ") are not the same. Returning.";
+    const MatrixXd& matPre = m_mapDataPre[dTriggerType];
+    const MatrixXd& matPost = m_mapDataPost[dTriggerType];
+
+    if(matPre.rows() != matPost.rows()) {
+        qDebug() << "[RtAveragingWorker::mergeData] Rows of m_mapDataPre (" << matPre.rows() << ") and m_mapDataPost (" << matPost.rows() << ") are not the same. Returning.";
         return;
     }
 
-    MatrixXd mergedData(m_mapDataPre[dTriggerType].rows(), m_mapDataPre[dTriggerType].cols() + m_mapDataPost[dTriggerType].cols());
-
-    mergedData << m_mapDataPre[dTriggerType], m_mapDataPost[dTriggerType];
+    m_matEpoch.resize(matPre.rows(), matPre.cols() + matPost.cols());
+    m_matEpoch.leftCols(matPre.cols()) = matPre;
+    m_matEpoch.rightCols(matPost.cols()) = matPost;
 
     //Perform artifact threshold
     bool bArtifactDetected = false;
@@ -433,22 +424,60 @@ void RtAveragingWorker::mergeData(double dTriggerType)
     if(m_bActivateThreshold && m_pFiffInfo) {
         qDebug() << "[RtAveragingWorker::mergeData] Doing artifact reduction for" << m_mapThresholds;
 
-        bArtifactDetected = MNEEpochDataList::checkForArtifact(mergedData,
+        bArtifactDetected = MNEEpochDataList::checkForArtifact(m_matEpoch,
                                                                *m_pFiffInfo,
                                                                m_mapThresholds);
     }
 
-    if(!bArtifactDetected) {
-        //Add cut data to average buffer
-        m_mapStimAve[dTriggerType].append(mergedData);
+    if(bArtifactDetected) {
+        return;
+    }
+
+    QList<MatrixXd>& lEpochs = m_mapStimAve[dTriggerType];
+    MatrixXd& matSum = m_mapStimSum[dTriggerType];
 
-        //Pop data from buffer
-        int iDiff =  m_mapStimAve[dTriggerType].size() - m_iNumAverages;
-        if(iDiff > 0) {
-            for(int i = 0; i < iDiff; ++i) {
-                m_mapStimAve[dTriggerType].pop_front();
-            }
+    if(matSum.rows() != m_matEpoch.rows() || matSum.cols() != m_matEpoch.cols()) {
+        lEpochs.clear();
+        matSum = MatrixXd::Zero(m_matEpoch.rows(), m_matEpoch.cols());
+        m_mapStimSumUpdates[dTriggerType] = 0;
+    }
+
+    //The oldest epoch leaves the sum and its storage is reused for the next epoch
+    MatrixXd matRecycled;
+    while(lEpochs.size() >= m_iNumAverages) {
+        matSum -= lEpochs.first();
+        matRecycled.swap(lEpochs.first());
+        lEpochs.removeFirst();
+    }
+
+    matSum += m_matEpoch;
+    lEpochs.append(MatrixXd());
+    lEpochs.last().swap(m_matEpoch);
+    m_matEpoch.swap(matRecycled);
+
+    //Sum up from scratch once per cycle so that rounding errors of the running sum do not accumulate
+    if(++m_mapStimSumUpdates[dTriggerType] >= m_iNumAverages) {
+        matSum = lEpochs.first();
+        for(int i = 1; i < lEpochs.size(); ++i) {
+            matSum += lEpochs.at(i);
+        }
+        m_mapStimSumUpdates[dTriggerType] = 0;
+    }
+}
+
+//=============================================================================================================
+
+void RtAveragingWorker::dropOldestEpochs(double dTriggerType,
+                                         int iNumEpochs)
+{
+    QList<MatrixXd>& lEpochs = m_mapStimAve[dTriggerType];
+    MatrixXd& matSum = m_mapStimSum[dTriggerType];
+
+    while(lEpochs.size() > std::max(iNumEpochs, 0)) {
+        if(matSum.rows() == lEpochs.first().rows() && matSum.cols() == lEpochs.first().cols()) {
+            matSum -= lEpochs.first();
         }
+        lEpochs.removeFirst();
     }
 }
 
@@ -456,20 +485,17 @@ void RtAveragingWorker::mergeData(double dTriggerType)
 
 void RtAveragingWorker::generateEvoked(double dTriggerType)
 {
-    if(m_mapStimAve[dTriggerType].isEmpty()) {
+    const QList<MatrixXd>& lEpochs = m_mapStimAve[dTriggerType];
+
+    if(lEpochs.isEmpty()) {
         qDebug() << "[RtAveragingWorker::generateEvoked] m_mapStimAve is empty for type" << dTriggerType << "Returning.";
         return;
     }
 
-    //Init evoked
-    m_stimEvokedSet.info = *m_pFiffInfo.data();
-    FiffEvoked evoked;
-    evoked.setInfo(*m_pFiffInfo.data());
     int iEvokedIdx = -1;
 
     for(int i = 0; i < m_stimEvokedSet.evoked.size(); ++i) {
         if(m_stimEvokedSet.evoked.at(i).comment == QString::number(dTriggerType)) {
-            evoked = m_stimEvokedSet.evoked.at(i);
             iEvokedIdx = i;
             break;
         }
@@ -477,6 +503,8 @@ void RtAveragingWorker::generateEvoked(double dTriggerType)
 
     //If the evoked is not yet present add it here
     if(iEvokedIdx == -1) {
+        FiffEvoked evoked;
+        evoked.setInfo(*m_pFiffInfo.data());
         evoked.baseline = m_pairBaselineSec;
         evoked.times.resize(m_iPreStimSamples + m_iPostStimSamples);
         evoked.times = RowVectorXf::LinSpaced(m_iPreStimSamples + m_iPostStimSamples,
@@ -486,35 +514,23 @@ void RtAveragingWorker::generateEvoked(double dTriggerType)
         evoked.first = 0;
         evoked.last = m_iPreStimSamples + m_iPostStimSamples;
         evoked.comment = QString::number(dTriggerType);
-    }
 
-    // Generate final evoked
-    MatrixXd finalAverage = MatrixXd::Zero(m_mapStimAve[dTriggerType].first().rows(), m_iPreStimSamples+m_iPostStimSamples);
-
-    for(int i = 0; i < m_mapStimAve[dTriggerType].size(); ++i) {
-        finalAverage += m_mapStimAve[dTriggerType].at(i);
-    }
-
-    if(!m_mapStimAve[dTriggerType].isEmpty()) {
-        finalAverage = finalAverage/m_mapStimAve[dTriggerType].size();
-    }
-
-    if(m_bDoBaselineCorrection) {
-        finalAverage = MNEMath::rescale(finalAverage, evoked.times, m_pairBaselineSec, QString("mean"));
+        m_stimEvokedSet.evoked.append(evoked);
+        iEvokedIdx = m_stimEvokedSet.evoked.size() - 1;
     }
 
-    evoked.data = finalAverage;
+    //Update the evoked in place from the running sum
+    FiffEvoked& evoked = m_stimEvokedSet.evoked[iEvokedIdx];
 
-    evoked.nave = m_mapStimAve[dTriggerType].size();
+    evoked.data = m_mapStimSum[dTriggerType] / double(lEpochs.size());
 
-    //Add new data to evoked data set
-    if(iEvokedIdx != -1) {
-        //Evoked data is already present
-        m_stimEvokedSet.evoked[iEvokedIdx] = evoked;
-    } else {
-        //Evoked data is not present yet
-        m_stimEvokedSet.evoked.append(evoked);
+    qint32 iFrom, iTo;
+    if(m_bDoBaselineCorrection && MNEMath::baselineRange(evoked.times, m_pairBaselineSec, iFrom, iTo)) {
+        VectorXd vecBaseline = evoked.data.middleCols(iFrom, iTo - iFrom).rowwise().mean();
+        evoked.data.colwise() -= vecBaseline;
     }
+
+    evoked.nave = lEpochs.size();
 }
 
 //=============================================================================================================
@@ -531,6 +547,8 @@ void RtAveragingWorker::reset()
 
     //Clear all maps
     m_mapStimAve.clear();
+    m_mapStimSum.clear();
+    m_mapStimSumUpdates.clear();
     m_mapDataPre.clear();
     m_mapDataPre[-1.0] = MatrixXd::Zero(m_pFiffInfo->chs.size(), m_iPreStimSamples);
     m_mapDataPost.clear();
@@ -217,10 +217,21 @@ protected:
 
     //=========================================================================================================
     /**
-     * Packs the buffers togehter as one and calcualtes the current running average and emits the result if number of averages has been reached.
+     * Packs the buffers togehter as one epoch and adds it to the running sum of the trigger type. If the number of
+     * averages has been reached, the oldest epoch is subtracted from the sum and its slot is reused.
      */
     void mergeData(double dTriggerType);
 
+    //=========================================================================================================
+    /**
+     * Removes the oldest epochs of a trigger type until at most iNumEpochs are left.
+     *
+     * @param[in] dTriggerType   The trigger type.
+     * @param[in] iNumEpochs     The number of epochs to keep.
+     */
+    void dropOldestEpochs(double dTriggerType,
+                          int iNumEpochs);
+
     //=========================================================================================================
     /**
      * Generates the final evoke variable.
@@ -258,6 +269,9 @@ protected:
 
     QMap<QString,double>                            m_mapThresholds;            /**< Holds the current thresholds for artifact rejection. */
     QMap<double,QList<Eigen::MatrixXd> >            m_mapStimAve;               /**< the current stimulus average buffer. Holds m_iNumAverages vectors. */
+    QMap<double,Eigen::MatrixXd>                    m_mapStimSum;               /**< The running sum of the epochs in m_mapStimAve. */
+    QMap<double,qint32>                             m_mapStimSumUpdates;        /**< Number of incremental updates of m_mapStimSum since it was last summed up from scratch. */
+    Eigen::MatrixXd                                 m_matEpoch;                 /**< Work buffer for the next epoch, swapped with recycled epoch slots. */
     QMap<double,Eigen::MatrixXd>                    m_mapDataPre;               /**< The matrix holding pre stim data. */
     QMap<double,Eigen::MatrixXd>                    m_mapDataPost;              /**< The matrix holding post stim data. */
     QMap<double,qint32>                             m_mapMatDataPostIdx;        /**< Current index inside of the matrix m_matDataPost. */
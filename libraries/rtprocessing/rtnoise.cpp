@@ -73,7 +73,7 @@ RtNoise::RtNoise(qint32 p_iMaxSamples,
 , m_iNumOfBlocks(0)
 , m_iBlockSize(0)
 , m_iSensors(0)
-, m_iBlockIndex(0)
+, m_iNumTapers(1)
 {
     qRegisterMetaType<Eigen::MatrixXd>("Eigen::MatrixXd");
     //qRegisterMetaType<QVector<double> >("QVector<double>");
@@ -81,13 +81,6 @@ RtNoise::RtNoise(qint32 p_iMaxSamples,
     m_Fs = m_pFiffInfo->sfreq;
 
     m_bSendDataToBuffer = true;
-
-    m_fWin.clear();
-
-    //create a hanning window
-    m_fWin = hanning(m_iFftLength,0);
-
-    qDebug()<<"Hanning window is created.";
 }
 
 //=============================================================================================================
@@ -101,52 +94,6 @@ RtNoise::~RtNoise()
 
 //=============================================================================================================
 
-QVector <float> RtNoise::hanning(int N, short itype)
-{
-    int half, i, idx, n;
-    QVector <float> w(N,0.0);
-
-    if(itype==1)    //periodic function
-        n = N-1;
-    else
-        n = N;
-
-    if(n%2==0)
-    {
-        half = n/2;
-        for(i=0; i<half; i++) //CALC_HANNING   Calculates Hanning window samples.
-            w[i] = 0.5 * (1 - cos(2*3.14159265*(i+1) / (n+1)));
-
-        idx = half-1;
-        for(i=half; i<n; i++) {
-            w[i] = w[idx];
-            idx--;
-        }
-    }
-    else
-    {
-        half = (n+1)/2;
-        for(i=0; i<half; i++) //CALC_HANNING   Calculates Hanning window samples.
-            w[i] = 0.5 * (1 - cos(23.14159265*(i+1) / (n+1)));
-
-        idx = half-2;
-        for(i=half; i<n; i++) {
-            w[i] = w[idx];
-            idx--;
-        }
-    }
-
-    if(itype==1)    //periodic function
-    {
-        for(i=N-1; i>=1; i--)
-            w[i] = w[i-1];
-        w[0] = 0.0;
-    }
-    return(w);
-}
-
-//=============================================================================================================
-
 void RtNoise::append(const MatrixXd &p_DataSegment)
 {
     if(!m_pCircularBuffer)
@@ -185,114 +132,51 @@ bool RtNoise::stop()
 
 //=============================================================================================================
 
+void RtNoise::setNumTapers(int iNumTapers)
+{
+    m_iNumTapers = std::max(iNumTapers, 1);
+}
+
+//=============================================================================================================
+
 void RtNoise::run()
 {
     #ifdef EIGEN_FFTW_DEFAULT
         fftw_make_planner_thread_safe();
     #endif
 
-    bool FirstStart = true;
+    m_pSpectrum.clear();
+
     MatrixXd block;
 
     while(m_bIsRunning) {
         if(m_pCircularBuffer) {
             if(m_pCircularBuffer->pop(block)) {
-                if(FirstStart){
-                    //init the circ buffer and parameters
+                if(!m_pSpectrum || block.rows() != m_iSensors) {
                     if(m_dataLength < 0) m_dataLength = 10;
-                    m_iNumOfBlocks = m_dataLength;//60;
-                    m_iBlockSize =  block.cols();
-                    m_iSensors =  block.rows();
-
-                    m_matCircBuf.resize(m_iSensors,m_iNumOfBlocks*m_iBlockSize);
-
-                    m_iBlockIndex = 0;
-                    FirstStart = false;
+                    m_iNumOfBlocks = m_dataLength;
+                    m_iBlockSize = block.cols();
+                    m_iSensors = block.rows();
+
+                    // Average the half overlapping windows which fit into m_iNumOfBlocks blocks
+                    int iHop = std::max(m_iFftLength / 2, 1);
+                    int iNumAverages = std::max((m_iNumOfBlocks * m_iBlockSize - m_iFftLength) / iHop + 1, 1);
+
+                    m_pSpectrum = SlidingSpectrum::SPtr(new SlidingSpectrum(m_iSensors,
+                                                                            m_iFftLength,
+                                                                            m_Fs,
+                                                                            iHop,
+                                                                            m_iNumTapers,
+                                                                            iNumAverages));
                 }
-                //concate blocks
-                for (int i=0; i< m_iSensors; i++)
-                    for (int j=0; j< m_iBlockSize; j++)
-                        m_matCircBuf(i,j+m_iBlockIndex*m_iBlockSize) = block(i,j);
-
-                m_iBlockIndex ++;
-                if (m_iBlockIndex >= m_iNumOfBlocks){
-
-                    //m_pCircularBuffer.clear(); //empty the buffer
-
-                    m_bSendDataToBuffer = false;
-                    //stop collect block and start to calculate the spectrum
-                    m_iBlockIndex = 0;
-
-                    MatrixXd sum_psdx = MatrixXd::Zero(m_iSensors,m_iFftLength/2+1);
-
-                    int nb = floor(m_iNumOfBlocks*m_iBlockSize/m_iFftLength)+1;
-                    qDebug()<<"nb"<<nb<<"NumOfBlocks"<<m_iNumOfBlocks<<"BlockSize"<<m_iBlockSize;
-                    MatrixXd t_mat(m_iSensors,m_iFftLength);
-                    MatrixXd t_psdx(m_iSensors,m_iFftLength/2+1);
-                    for (int n = 0; n<nb; n++){
-                        //collect a data block with data length of m_iFftLength;
-                        if(n==nb-1)
-                        {
-                            for(qint32 ii=0; ii<m_iSensors; ii++)
-                            for(qint32 jj=0; jj<m_iFftLength; jj++)
-                                if(jj+n*m_iFftLength<m_iNumOfBlocks*m_iBlockSize)
-                                    t_mat(ii,jj) = m_matCircBuf(ii,jj+n*m_iFftLength);
-                                else
-                                    t_mat(ii,jj) = 0.0;
-
-                        }
-                        else
-                        {
-                            for(qint32 ii=0; ii<m_iSensors; ii++)
-                            for(qint32 jj=0; jj<m_iFftLength; jj++)
-                                t_mat(ii,jj) = m_matCircBuf(ii,jj+n*m_iFftLength);
-                        }
-
-                        //FFT calculation by row
-                        for(qint32 i = 0; i < t_mat.rows(); i++){
-                            RowVectorXd data;
-
-                            data = t_mat.row(i);
-
-                            //zero-pad data to m_iFftLength
-                            RowVectorXd vecDataZeroPad = RowVectorXd::Zero(m_iFftLength);
-                            vecDataZeroPad.head(data.cols()) = data;
-
-                            for (qint32 lk = 0; lk<m_iFftLength; lk++)
-                                vecDataZeroPad[lk] = vecDataZeroPad[lk]*m_fWin[lk];
-
-                            //generate fft object
-                            Eigen::FFT<double> fft;
-                            fft.SetFlag(fft.HalfSpectrum);
-
-                            //fft-transform data sequence
-                            RowVectorXcd vecFreqData(m_iFftLength/2+1);
-                            fft.fwd(vecFreqData,vecDataZeroPad);
-
-                            // calculate spectrum from FFT
-                            for(qint32 j=0; j<m_iFftLength/2+1;j++)
-                            {
-                                double mag_abs = sqrt(vecFreqData(j).real()* vecFreqData(j).real() +  vecFreqData(j).imag()*vecFreqData(j).imag());
-                                double spower = (1.0/(m_Fs*m_iFftLength))* mag_abs;
-                                if (j>0&&j<m_iFftLength/2) spower = 2.0*spower;
-                                sum_psdx(i,j) = sum_psdx(i,j) + spower;
-                            }
-                         }//row computing is done
-                    }//nb
 
+                if(m_pSpectrum->append(block) > 0) {
                     //DB-calculation
-                    for(qint32 ii=0; ii<m_iSensors; ii++)
-                        for(qint32 jj=0; jj<m_iFftLength/2+1; jj++)
-                            t_psdx(ii,jj) = 10.0*log10(sum_psdx(ii,jj)/nb);
+                    MatrixXd t_psdx = 10.0 * m_pSpectrum->psd().array().log10();
 
-                    qDebug()<<"Send spectrum to Noise Estimator";
                     emit SpecCalculated(t_psdx); //send back the spectrum result
-
-                    m_bSendDataToBuffer = true;
                 }
             }
         }
-
     }
 }
-
@@ -45,6 +45,7 @@
 #include <fiff/fiff_cov.h>
 #include <fiff/fiff_info.h>
 #include <utils/generics/circularbuffer.h>
+#include <utils/slidingspectrum.h>
 
 //=============================================================================================================
 // QT INCLUDES
@@ -60,7 +61,6 @@
 //=============================================================================================================
 
 #include <Eigen/Core>
-#include <unsupported/Eigen/FFT>
 
 //=============================================================================================================
 // DEFINE NAMESPACE RTPROCESSINGLIB
@@ -71,7 +71,9 @@ namespace RTPROCESSINGLIB
 
 //=============================================================================================================
 /**
- * Real-time noise Spectrum estimation
+ * Real-time noise Spectrum estimation. The PSD is estimated with half overlapping windows of p_iMaxSamples samples and
+ * averaged over the windows which cover the last p_dataLen blocks. It is emitted in dB whenever a block completed a
+ * new window.
  *
  * @brief Real-time Noise estimation
  */
@@ -134,6 +136,15 @@ public:
      */
     virtual bool stop();
 
+    //=========================================================================================================
+    /**
+     * Sets the number of tapers. 1 selects a Hanning window (Welch), more select a sine multitaper estimate.
+     * Takes effect with the next start.
+     *
+     * @param[in] iNumTapers     The number of tapers.
+     */
+    void setNumTapers(int iNumTapers);
+
     QMutex ReadMutex;
 
     Eigen::MatrixXd m_matSpecData;
@@ -148,14 +159,12 @@ protected:
      */
     virtual void run();
 
-    QVector <float> hanning(int N, short itype);
-
     int m_iNumOfBlocks;
     int m_iBlockSize;
     int m_iSensors;
-    int m_iBlockIndex;
+    int m_iNumTapers;
 
-    Eigen::MatrixXd m_matCircBuf;
+    UTILSLIB::SlidingSpectrum::SPtr m_pSpectrum;    /**< The streaming PSD estimator, set up with the first block. */
 
 private:
     QMutex      mutex;                              /**< Provides access serialization between threads*/
@@ -166,8 +175,6 @@ private:
 
     QSharedPointer<UTILSLIB::CircularBuffer_Matrix_double>       m_pCircularBuffer;      /**< Holds incoming raw data. */
 
-    QVector <float> m_fWin;
-
     double m_Fs;
 
     qint32 m_iFftLength;
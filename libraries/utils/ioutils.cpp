@@ -77,8 +77,16 @@ VectorXi IOUtils::fread3_many(QDataStream &p_qStream, qint32 count)
 {
     VectorXi res(count);
 
-    for(qint32 i = 0; i < count; ++i)
-        res[i] = IOUtils::fread3(p_qStream);
+    if(count <= 0)
+        return res;
+
+    //Read all bytes at once and decode them afterwards
+    QByteArray bytes(3*count, 0);
+    p_qStream.readRawData(bytes.data(), 3*count);
+    const unsigned char* pBytes = reinterpret_cast<const unsigned char*>(bytes.constData());
+
+    for(qint32 i = 0; i < count; ++i, pBytes += 3)
+        res[i] = (pBytes[0] << 16) + (pBytes[1] << 8) + pBytes[2];
 
     return res;
 }
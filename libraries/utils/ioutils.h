@@ -41,6 +41,9 @@
 
 #include "utils_global.h"
 
+#include <cstring>
+#include <type_traits>
+
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
@@ -50,6 +53,7 @@
 #include <QFile>
 #include <QDebug>
 #include <QStringList>
+#include <QtEndian>
 
 //=============================================================================================================
 // QT INCLUDES
@@ -193,6 +197,17 @@ public:
      */
     static void swap_doublep(double *source);
 
+    //=========================================================================================================
+    /**
+     * Swaps the byte order of count consecutive elements in place. The loop works on whole words and is inlined,
+     * so that the compiler can vectorize it, instead of calling one of the element wise swap functions per value.
+     *
+     * @param[in, out] data      The elements to swap (2, 4 or 8 bytes each).
+     * @param[in] count          The number of elements.
+     */
+    template<typename T>
+    static void swap_array(T* data, qint64 count);
+
     //=========================================================================================================
     /**
      * Write Eigen Matrix to file
@@ -258,6 +273,25 @@ public:
 // INLINE DEFINITIONS
 //=============================================================================================================
 
+template<typename T>
+inline void IOUtils::swap_array(T* data, qint64 count)
+{
+    typedef typename std::conditional<sizeof(T) == 2, quint16,
+            typename std::conditional<sizeof(T) == 4, quint32, quint64>::type>::type Word;
+    static_assert(sizeof(T) == sizeof(Word), "swap_array supports 2, 4 and 8 byte types only");
+
+    char* pData = reinterpret_cast<char*>(data);
+
+    for(qint64 i = 0; i < count; ++i, pData += sizeof(Word)) {
+        Word word;
+        std::memcpy(&word, pData, sizeof(Word));
+        word = qbswap(word);
+        std::memcpy(pData, &word, sizeof(Word));
+    }
+}
+
+//=============================================================================================================
+
 template<typename T>
 bool IOUtils::write_eigen_matrix(const Eigen::Matrix<T, 1, Eigen::Dynamic>& in, const QString& sPath, const QString& sDescription)
 {
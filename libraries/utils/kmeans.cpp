@@ -43,13 +43,15 @@
 #include <iostream>
 #include <algorithm>
 #include <vector>
-#include <time.h>
+#include <limits>
 
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
 
 #include <QDebug>
+#include <QVector>
+#include <QtConcurrent>
 
 //=============================================================================================================
 // USED NAMESPACES
@@ -67,13 +69,16 @@ KMeans::KMeans(QString distance,
                qint32 replicates,
                QString emptyact,
                bool online,
-               qint32 maxit)
+               qint32 maxit,
+               quint32 seed)
 : m_sDistance(distance)
 , m_sStart(start)
 , m_iReps(replicates)
 , m_sEmptyact(emptyact)
 , m_iMaxit(maxit)
 , m_bOnline(online)
+, m_iSeed(seed)
+, m_bPruning(true)
 , emptyErrCnt(0)
 , iter(0)
 , k(0)
@@ -89,24 +94,24 @@ KMeans::KMeans(QString distance,
 
 //=============================================================================================================
 
-bool KMeans::calculate(MatrixXd X,
+bool KMeans::calculate(const MatrixXd& X,
                        qint32 kClusters,
                        VectorXi& idx,
                        MatrixXd& C,
                        VectorXd& sumD,
                        MatrixXd& D)
 {
-    if (kClusters < 1)
+    if (kClusters < 1 || X.rows() < 1)
         return false;
 
-    //Init random generator
-    srand ( time(NULL) );
-
 // n points in p dimensional space
     k = kClusters;
     n = X.rows();
     p = X.cols();
 
+    // Only the normalized distances need a modified copy of the points
+    MatrixXd Xnormalized;
+
     if(m_sDistance.compare("cosine") == 0)
     {
 //        Xnorm = sqrt(sum(X.^2, 2));
@@ -119,14 +124,15 @@ bool KMeans::calculate(MatrixXd X,
     }
     else if(m_sDistance.compare("correlation")==0)
     {
-        X.array() -= (X.rowwise().sum().array() / (double)p).replicate(1,p); //X - X.rowwise().sum();//.repmat(mean(X,2),1,p);
-        MatrixXd Xnorm = (X.array().pow(2).rowwise().sum()).sqrt();//sqrt(sum(X.^2, 2));
+        Xnormalized = X;
+        Xnormalized.array() -= (Xnormalized.rowwise().sum().array() / (double)p).replicate(1,p); //X - X.rowwise().sum();//.repmat(mean(X,2),1,p);
+        MatrixXd Xnorm = (Xnormalized.array().pow(2).rowwise().sum()).sqrt();//sqrt(sum(X.^2, 2));
 //        if any(min(Xnorm) <= eps(max(Xnorm)))
 //            error(['Some points have small relative standard deviations, making them ', ...
 //                   'effectively constant.\nEither remove those points, or choose a ', ...
 //                   'distance other than ''correlation''.']);
 //        end
-        X.array() /= Xnorm.replicate(1,p).array();
+        Xnormalized.array() /= Xnorm.replicate(1,p).array();
     }
 //    else if(m_sDistance.compare('hamming')==0)
 //    {
@@ -135,6 +141,8 @@ bool KMeans::calculate(MatrixXd X,
 //        end
 //    }
 
+    const MatrixXd& Xd = Xnormalized.size() > 0 ? Xnormalized : X;
+
     // Start
     RowVectorXd Xmins;
     RowVectorXd Xmaxs;
@@ -145,8 +153,8 @@ bool KMeans::calculate(MatrixXd X,
             printf("Error: Uniform Start For Hamming\n");
             return false;
         }
-        Xmins = X.colwise().minCoeff();
-        Xmaxs = X.colwise().maxCoeff();
+        Xmins = Xd.colwise().minCoeff();
+        Xmaxs = Xd.colwise().maxCoeff();
     }
 
     //
@@ -158,173 +166,266 @@ bool KMeans::calculate(MatrixXd X,
         Del.fill(std::numeric_limits<double>::quiet_NaN());// reassignment criterion
     }
 
+    // Every replicate works on its own copy of the state, so that the replicates can run in parallel. The
+    // replicates are seeded by their number, which makes the result independent of the scheduling.
+    std::vector<VectorXi> lIdx(m_iReps);
+    std::vector<MatrixXd> lC(m_iReps);
+    std::vector<VectorXd> lSumD(m_iReps);
+    std::vector<MatrixXd> lD(m_iReps);
+    std::vector<double> lTotSumD(m_iReps, std::numeric_limits<double>::max());
+    std::vector<char> lFinished(m_iReps, 0);
+
+    auto computeReplicate = [&](const qint32& rep) {
+        KMeans worker(*this);
+        if(worker.replicate(Xd, rep, Xmins, Xmaxs, lIdx[rep], lC[rep], lSumD[rep], lD[rep])) {
+            lFinished[rep] = 1;
+            lTotSumD[rep] = worker.totsumD;
+        }
+    };
+
+    QVector<qint32> lReps(m_iReps);
+    for(qint32 rep = 0; rep < m_iReps; ++rep)
+        lReps[rep] = rep;
+
+    if(m_iReps > 1)
+        QtConcurrent::blockingMap(lReps, computeReplicate);
+    else
+        computeReplicate(lReps[0]);
+
     double totsumDBest = std::numeric_limits<double>::max();
+    qint32 repBest = -1;
     emptyErrCnt = 0;
 
-    VectorXi idxBest;
-    MatrixXd Cbest;
-    VectorXd sumDBest;
-    MatrixXd Dbest;
-
     for(qint32 rep = 0; rep < m_iReps; ++rep)
     {
-        if (m_sStart.compare("uniform") == 0)
-        {
-            C = MatrixXd::Zero(k,p);
-            for(qint32 i = 0; i < k; ++i)
-                for(qint32 j = 0; j < p; ++j)
-                    C(i,j) = unifrnd(Xmins[j], Xmaxs[j]);
-            // For 'cosine' and 'correlation', these are uniform inside a subset
-            // of the unit hypersphere.  Still need to center them for
-            // 'correlation'.  (Re)normalization for 'cosine'/'correlation' is
-            // done at each iteration.
-            if (m_sDistance.compare("correlation") == 0)
-                C.array() -= (C.array().rowwise().sum()/p).replicate(1, p).array();
-        }
-        else if (m_sStart.compare("sample") == 0)
-        {
-            C = MatrixXd::Zero(k,p);
-            for(qint32 i = 0; i < k; ++i)
-                C.block(i,0,1,p) = X.block(rand() % n, 0, 1, p);
-            // DEBUG
-//            C.block(0,0,1,p) = X.block(2, 0, 1, p);
-//            C.block(1,0,1,p) = X.block(7, 0, 1, p);
-//            C.block(2,0,1,p) = X.block(17, 0, 1, p);
-        }
-    //    else if (start.compare("cluster") == 0)
-    //    {
-    //        Xsubset = X(randsample(n,floor(.1*n)),:);
-    //        [dum, C] = kmeans(Xsubset, k, varargin{:}, 'start','sample', 'replicates',1);
-    //    }
-    //    else if (start.compare("numeric") == 0)
-    //    {
-    //        C = CC(:,:,rep);
-    //    }
-
-        // Compute the distance from every point to each cluster centroid and the
-        // initial assignment of points to clusters
-        D = distfun(X, C);//, 0);
-        idx = VectorXi::Zero(D.rows());
-        d = VectorXd::Zero(D.rows());
+        if(!lFinished[rep])
+        {
+            // If an empty cluster error occurred in one of multiple replicates, move on to the next
+            // replicate. Error only when all replicates fail.
+            ++emptyErrCnt;
+            continue;
+        }
 
-        for(qint32 i = 0; i < D.rows(); ++i)
-            d[i] = D.row(i).minCoeff(&idx[i]);
+        // Save the best solution so far
+        if (lTotSumD[rep] < totsumDBest)
+        {
+            totsumDBest = lTotSumD[rep];
+            repBest = rep;
+        }
+    }
+
+    if (emptyErrCnt == m_iReps)
+        return false;
+
+    // Return the best solution
+    if(repBest >= 0)
+    {
+        idx = lIdx[repBest];
+        C = lC[repBest];
+        sumD = lSumD[repBest];
+        D = lD[repBest];
+        totsumD = totsumDBest;
+    }
+    else
+    {
+        idx = VectorXi();
+        C = MatrixXd();
+        sumD = VectorXd();
+        D = MatrixXd();
+    }
+
+//if hadNaNs
+//    idx = statinsertnan(wasnan, idx);
+//end
+    return true;
+}
+
+//=============================================================================================================
+
+void KMeans::setPruning(bool bPruning)
+{
+    m_bPruning = bPruning;
+}
+
+//=============================================================================================================
+
+bool KMeans::replicate(const MatrixXd& X,
+                       qint32 rep,
+                       const RowVectorXd& Xmins,
+                       const RowVectorXd& Xmaxs,
+                       VectorXi& idx,
+                       MatrixXd& C,
+                       VectorXd& sumD,
+                       MatrixXd& D)
+{
+    m_generator.seed(m_iSeed + rep);
 
-        m = VectorXi::Zero(k);
+    if (m_sStart.compare("uniform") == 0)
+    {
+        C = MatrixXd::Zero(k,p);
+        for(qint32 i = 0; i < k; ++i)
+            for(qint32 j = 0; j < p; ++j)
+                C(i,j) = unifrnd(Xmins[j], Xmaxs[j]);
+        // For 'cosine' and 'correlation', these are uniform inside a subset
+        // of the unit hypersphere.  Still need to center them for
+        // 'correlation'.  (Re)normalization for 'cosine'/'correlation' is
+        // done at each iteration.
+        if (m_sDistance.compare("correlation") == 0)
+            C.array() -= (C.array().rowwise().sum()/p).replicate(1, p).array();
+    }
+    else if (m_sStart.compare("sample") == 0)
+    {
+        std::uniform_int_distribution<qint32> uniform(0, n - 1);
+        C = MatrixXd::Zero(k,p);
         for(qint32 i = 0; i < k; ++i)
-            for (qint32 j = 0; j < idx.rows(); ++j)
-                if(idx[j] == i)
-                    ++ m[i];
+            C.row(i) = X.row(uniform(m_generator));
+    }
+    else if (m_sStart.compare("plus") == 0)
+    {
+        C = plusplusStart(X);
+    }
+//    else if (start.compare("cluster") == 0)
+//    {
+//        Xsubset = X(randsample(n,floor(.1*n)),:);
+//        [dum, C] = kmeans(Xsubset, k, varargin{:}, 'start','sample', 'replicates',1);
+//    }
+//    else if (start.compare("numeric") == 0)
+//    {
+//        C = CC(:,:,rep);
+//    }
 
-        try // catch empty cluster errors and move on to next rep
-        {
-            // Begin phase one:  batch reassignments
-            bool converged = batchUpdate(X, C, idx);
+    // Compute the distance from every point to each cluster centroid and the
+    // initial assignment of points to clusters
+    D = distfun(X, C);//, 0);
+    idx = VectorXi::Zero(D.rows());
+    d = VectorXd::Zero(D.rows());
 
-            // Begin phase two:  single reassignments
-            if (m_bOnline)
-                converged = onlineUpdate(X, C, idx);
+    for(qint32 i = 0; i < D.rows(); ++i)
+        d[i] = D.row(i).minCoeff(&idx[i]);
 
-            if (!converged)
-                printf("Failed To Converge during replicate %d\n", rep);
+    m = VectorXi::Zero(k);
+    for (qint32 j = 0; j < idx.rows(); ++j)
+        ++ m[idx[j]];
 
-            // Calculate cluster-wise sums of distances
-            VectorXi nonempties = VectorXi::Zero(m.rows());
-            quint32 count = 0;
-            for(qint32 i = 0; i < m.rows(); ++i)
+    try // catch empty cluster errors and move on to next rep
+    {
+        // Begin phase one:  batch reassignments
+        bool converged;
+        if (m_bPruning && (m_sDistance.compare("sqeuclidean") == 0 || m_sDistance.compare("cityblock") == 0))
+            converged = batchUpdatePruned(X, C, idx);
+        else
+            converged = batchUpdate(X, C, idx);
+
+        // Begin phase two:  single reassignments
+        if (m_bOnline)
+            converged = onlineUpdate(X, C, idx);
+
+        if (!converged)
+            printf("Failed To Converge during replicate %d\n", rep);
+
+        // Calculate cluster-wise sums of distances
+        VectorXi nonempties = VectorXi::Zero(m.rows());
+        quint32 count = 0;
+        for(qint32 i = 0; i < m.rows(); ++i)
+        {
+            if(m[i] > 0)
             {
-                if(m[i] > 0)
-                {
-                    nonempties[i] = 1;
-                    ++count;
-                }
+                nonempties[i] = 1;
+                ++count;
             }
-            MatrixXd C_tmp(count,C.cols());
-            count = 0;
-            for(qint32 i = 0; i < nonempties.rows(); ++i)
+        }
+        MatrixXd C_tmp(count,C.cols());
+        count = 0;
+        for(qint32 i = 0; i < nonempties.rows(); ++i)
+        {
+            if(nonempties[i])
             {
-                if(nonempties[i])
-                {
-                    C_tmp.row(count) = C.row(i);
-                    ++count;
-                }
+                C_tmp.row(count) = C.row(i);
+                ++count;
             }
+        }
 
-            MatrixXd D_tmp = distfun(X, C_tmp);//, iter);
-            count = 0;
-            for(qint32 i = 0; i < nonempties.rows(); ++i)
+        MatrixXd D_tmp = distfun(X, C_tmp);//, iter);
+        count = 0;
+        for(qint32 i = 0; i < nonempties.rows(); ++i)
+        {
+            if(nonempties[i])
             {
-                if(nonempties[i])
-                {
-                    D.col(i) = D_tmp.col(count);
-                    C.row(i) = C_tmp.row(count);
-                    ++count;
-                }
+                D.col(i) = D_tmp.col(count);
+                C.row(i) = C_tmp.row(count);
+                ++count;
             }
+        }
 
-            d = VectorXd::Zero(n);
-            for(qint32 i = 0; i < n; ++i)
-                d[i] += D.array()(idx[i]*n+i);//Colum Major
-
-            sumD = VectorXd::Zero(k);
-            for(qint32 i = 0; i < k; ++i)
-                for (qint32 j = 0; j < idx.rows(); ++j)
-                    if(idx[j] == i)
-                        sumD[i] += d[j];
+        d = VectorXd::Zero(n);
+        for(qint32 i = 0; i < n; ++i)
+            d[i] += D.array()(idx[i]*n+i);//Colum Major
 
-            totsumD = sumD.array().sum();
+        sumD = VectorXd::Zero(k);
+        for (qint32 j = 0; j < idx.rows(); ++j)
+            sumD[idx[j]] += d[j];
 
-//            printf("%d iterations, total sum of distances = %f\n", iter, totsumD);
+        totsumD = sumD.array().sum();
 
-            // Save the best solution so far
-            if (totsumD < totsumDBest)
-            {
-                totsumDBest = totsumD;
-                idxBest = idx;
-                Cbest = C;
-                sumDBest = sumD;
-                Dbest = D;
-            }
+//        printf("%d iterations, total sum of distances = %f\n", iter, totsumD);
+    }
+    catch (int e)
+    {
+        if(e == 0)
+        {
+//            printf("Replicate %d terminated: empty cluster created at iteration %d.\n", rep, iter);
+            return false;
         }
-        catch (int e)
+    } // catch
+
+    return true;
+}
+
+//=============================================================================================================
+
+MatrixXd KMeans::plusplusStart(const MatrixXd& X)
+{
+    std::uniform_int_distribution<qint32> uniform(0, n - 1);
+
+    MatrixXd C = MatrixXd::Zero(k,p);
+    C.row(0) = X.row(uniform(m_generator));
+
+    // Distance of every point to its nearest centroid chosen so far
+    VectorXd minD = distfun(X, C.topRows(1)).col(0);
+
+    for(qint32 i = 1; i < k; ++i)
+    {
+        double sum = minD.sum();
+        qint32 next = n - 1;
+
+        if(sum > 0.0 && std::isfinite(sum))
         {
-            if(e == 0)
+            double r = std::uniform_real_distribution<double>(0.0, sum)(m_generator);
+            double cumsum = 0.0;
+            for(qint32 j = 0; j < n; ++j)
             {
-                // If an empty cluster error occurred in one of multiple replicates, catch
-                // it, warn, and move on to next replicate.  Error only when all replicates
-                // fail.  Rethrow an other kind of error.
-                if (m_iReps == 1)
-                    return false;
-                else
+                cumsum += minD[j];
+                if(r < cumsum)
                 {
-                    emptyErrCnt = emptyErrCnt + 1;
-//                    printf("Replicate %d terminated: empty cluster created at iteration %d.\n", rep, iter);
-                    if (emptyErrCnt == m_iReps)
-                    {
-//                        error(message('EmptyClusterAllReps'));
-                        return false;
-                    }
-
+                    next = j;
+                    break;
                 }
             }
-        } // catch
-
-    } // replicates
+        }
+        else
+        {
+            // All points coincide with a centroid
+            next = uniform(m_generator);
+        }
 
-    // Return the best solution
-    idx = idxBest;
-    C = Cbest;
-    sumD = sumDBest;
-    D = Dbest;
+        C.row(i) = X.row(next);
+        minD = minD.cwiseMin(distfun(X, C.row(i)).col(0));
+    }
 
-//if hadNaNs
-//    idx = statinsertnan(wasnan, idx);
-//end
-    return true;
+    return C;
 }
 
 //=============================================================================================================
-
 bool KMeans::batchUpdate(const MatrixXd& X, MatrixXd& C, VectorXi& idx)
 {
     // Every point moved, every cluster will need an update
@@ -369,7 +470,7 @@ bool KMeans::batchUpdate(const MatrixXd& X, MatrixXd& C, VectorXi& idx)
         // Deal with clusters that have just lost all their members
         VectorXi empties = VectorXi::Zero(changed.rows());
         for(qint32 i = 0; i < changed.rows(); ++i)
-            if(m(i) == 0)
+            if(m[changed[i]] == 0)
                 empties[i] = 1;
 
         if (empties.sum() > 0)
@@ -429,8 +530,11 @@ bool KMeans::batchUpdate(const MatrixXd& X, MatrixXd& C, VectorXi& idx)
             MatrixXd C_new;
             VectorXi m_new;
             gcentroids(X, idx, changed, C_new, m_new);
-            C.block(0,0,k,C.cols()) = C_new;
-            m.block(0,0,k,1) = m_new;
+            for(qint32 i = 0; i < changed.rows(); ++i)
+            {
+                C.row(changed[i]) = C_new.row(i);
+                m[changed[i]] = m_new[i];
+            }
             --iter;
             break;
         }
@@ -510,6 +614,170 @@ bool KMeans::batchUpdate(const MatrixXd& X, MatrixXd& C, VectorXi& idx)
 
 //=============================================================================================================
 
+bool KMeans::batchUpdatePruned(const MatrixXd& X, MatrixXd& C, VectorXi& idx)
+{
+    // Every cluster will need an update
+    VectorXi changed(k);
+    for(qint32 i = 0; i < k; ++i)
+        changed[i] = i;
+
+    previdx = VectorXi::Zero(n);
+
+    prevtotsumD = std::numeric_limits<double>::max();//max double
+
+    // Exact distance of each point to its own centroid and lower bound (in the metric) on the distance to all
+    // other centroids. The lower bounds start unknown, so every point is compared against all centroids first.
+    VectorXd dAssigned = VectorXd::Zero(n);
+    ArrayXd lower = ArrayXd::Constant(n, -std::numeric_limits<double>::infinity());
+
+    iter = 0;
+    bool converged = false;
+    while(true)
+    {
+        ++iter;
+
+        // Calculate the new cluster centroids and counts and how far the centroids moved
+        MatrixXd C_new;
+        VectorXi m_new;
+        KMeans::gcentroids(X, idx, changed, C_new, m_new);
+
+        VectorXd shift = VectorXd::Zero(k);
+        for(qint32 i = 0; i < changed.rows(); ++i)
+        {
+            RowVectorXd diff = C_new.row(i) - C.row(changed[i]);
+            shift[changed[i]] = m_sDistance.compare("sqeuclidean") == 0 ? diff.norm() : diff.lpNorm<1>();
+            if(!std::isfinite(shift[changed[i]]))
+                shift[changed[i]] = std::numeric_limits<double>::infinity();
+
+            C.row(changed[i]) = C_new.row(i);
+            m[changed[i]] = m_new[i];
+        }
+
+        // Deal with clusters that have just lost all their members
+        for(qint32 i = 0; i < changed.rows(); ++i)
+            if(m[changed[i]] == 0 && m_sEmptyact.compare("error") == 0)
+                return converged;
+
+        // Update the distance of every point to its own centroid, if that one moved
+        std::vector<std::vector<qint32> > members(k);
+        for(qint32 i = 0; i < n; ++i)
+            if(shift[idx[i]] != 0.0 || iter == 1)
+                members[idx[i]].push_back(i);
+
+        for(qint32 c = 0; c < k; ++c)
+        {
+            if(members[c].empty())
+                continue;
+
+            MatrixXd Xc(members[c].size(), p);
+            for(size_t j = 0; j < members[c].size(); ++j)
+                Xc.row(j) = X.row(members[c][j]);
+
+            VectorXd Dc = distfun(Xc, C.row(c));
+            for(size_t j = 0; j < members[c].size(); ++j)
+                dAssigned[members[c][j]] = Dc[j];
+        }
+
+        // Every other centroid came at most by the largest shift of the other clusters closer
+        qint32 maxShiftIdx = 0;
+        double maxShift = shift.maxCoeff(&maxShiftIdx);
+        double secondShift = 0.0;
+        for(qint32 c = 0; c < k; ++c)
+            if(c != maxShiftIdx)
+                secondShift = std::max(secondShift, shift[c]);
+
+        for(qint32 i = 0; i < n; ++i)
+            lower[i] -= idx[i] == maxShiftIdx ? secondShift : maxShift;
+
+        // Compute the total sum of distances for the current configuration.
+        totsumD = dAssigned.sum();
+        // Test for a cycle: if objective is not decreased, back out
+        // the last step and move on to the single update phase
+        if(prevtotsumD <= totsumD)
+        {
+            idx = previdx;
+            gcentroids(X, idx, changed, C_new, m_new);
+            for(qint32 i = 0; i < changed.rows(); ++i)
+            {
+                C.row(changed[i]) = C_new.row(i);
+                m[changed[i]] = m_new[i];
+            }
+            --iter;
+            break;
+        }
+
+        if (iter >= m_iMaxit)
+            break;
+
+        previdx = idx;
+        prevtotsumD = totsumD;
+
+        // Only points whose bounds overlap can have a closer centroid. Compare those against all centroids.
+        ArrayXd upper = toMetric(dAssigned.array());
+        std::vector<qint32> candidates;
+        for(qint32 i = 0; i < n; ++i)
+            if(upper[i] >= lower[i] - 1e-10 * std::abs(lower[i]))
+                candidates.push_back(i);
+
+        std::vector<qint32> moved;
+        if(!candidates.empty())
+        {
+            MatrixXd Xc(candidates.size(), p);
+            for(size_t j = 0; j < candidates.size(); ++j)
+                Xc.row(j) = X.row(candidates[j]);
+
+            MatrixXd Dc = distfun(Xc, C);
+            ArrayXXd Mc = toMetric(Dc.array());
+
+            for(size_t j = 0; j < candidates.size(); ++j)
+            {
+                qint32 i = candidates[j];
+                qint32 nidx;
+                double dmin = Dc.row(j).minCoeff(&nidx);
+
+                // Resolve ties in favor of not moving
+                if(nidx != idx[i] && Dc(j, idx[i]) > dmin)
+                {
+                    moved.push_back(i);
+                    idx[i] = nidx;
+                }
+
+                dAssigned[i] = Dc(j, idx[i]);
+
+                double second = std::numeric_limits<double>::infinity();
+                for(qint32 c = 0; c < k; ++c)
+                    if(c != idx[i])
+                        second = std::min(second, Mc(j, c));
+                lower[i] = second;
+            }
+        }
+
+        if (moved.empty())
+        {
+            converged = true;
+            break;
+        }
+
+        // Find clusters that gained or lost members
+        std::vector<int> tmp;
+        for(size_t i = 0; i < moved.size(); ++i)
+        {
+            tmp.push_back(idx[moved[i]]);
+            tmp.push_back(previdx[moved[i]]);
+        }
+
+        std::sort(tmp.begin(),tmp.end());
+        tmp.erase(std::unique(tmp.begin(),tmp.end()), tmp.end());
+
+        changed.resize(tmp.size());
+        for(size_t i = 0; i < tmp.size(); ++i)
+            changed[i] = tmp[i];
+    } // phase one
+    return converged;
+}
+
+//=============================================================================================================
+
 bool KMeans::onlineUpdate(const MatrixXd& X, MatrixXd& C, VectorXi& idx)
 {
     // Initialize some cluster information prior to phase two
@@ -525,34 +793,28 @@ bool KMeans::onlineUpdate(const MatrixXd& X, MatrixXd& C, VectorXi& idx)
             {
                 // Separate out sorted coords for points in i'th cluster,
                 // and save values above and below median, component-wise
-                MatrixXd Xsorted(m[i],p);
-                qint32 c = 0;
+                std::vector<qint32> members;
                 for(qint32 j = 0; j < idx.rows(); ++j)
-                {
                     if(idx[j] == i)
-                    {
-                        Xsorted.row(c) = X.row(j);
-                        ++c;
-                    }
-                }
-                for(qint32 j = 0; j < Xsorted.cols(); ++j)
-                    std::sort(Xsorted.col(j).data(),Xsorted.col(j).data()+Xsorted.rows());
+                        members.push_back(j);
 
-                qint32 nn = floor(0.5*m[i])-1;
+                qint32 nn = m[i]/2 - 1;
                 if ((m[i] % 2) == 0)
                 {
-                    Xmid1.row(i) = Xsorted.row(nn);
-                    Xmid2.row(i) = Xsorted.row(nn+1);
+                    MatrixXd Xsorted = sortedRanks(X, members, nn, nn+1);
+                    Xmid1.row(i) = Xsorted.row(0);
+                    Xmid2.row(i) = Xsorted.row(1);
                 }
                 else if (m[i] > 1)
                 {
-                    Xmid1.row(i) = Xsorted.row(nn);
-                    Xmid2.row(i) = Xsorted.row(nn+2);
+                    MatrixXd Xsorted = sortedRanks(X, members, nn, nn+2);
+                    Xmid1.row(i) = Xsorted.row(0);
+                    Xmid2.row(i) = Xsorted.row(2);
                 }
                 else
                 {
-                    Xmid1.row(i) = Xsorted.row(0);
-                    Xmid2.row(i) = Xsorted.row(0);
+                    Xmid1.row(i) = X.row(members[0]);
+                    Xmid2.row(i) = X.row(members[0]);
                 }
             }
         }
@@ -605,21 +867,13 @@ bool KMeans::onlineUpdate(const MatrixXd& X, MatrixXd& C, VectorXi& idx)
             for(qint32 j = 0; j < changed.rows(); ++j)
             {
                 qint32 i = changed[j];
-                VectorXi mbrs = VectorXi::Zero(idx.rows());
-                for(qint32 l = 0; l < idx.rows(); ++l)
-                    if(idx[l] == i)
-                        mbrs[l] = 1;
-
-                VectorXi sgn = 1 - 2 * mbrs.array(); // -1 for members, 1 for nonmembers
+                ArrayXd mbrs = (idx.array() == i).cast<double>();
+                ArrayXd sgn = 1.0 - 2.0 * mbrs; // -1 for members, 1 for nonmembers
 
                 if (m[i] == 1)
-                    for(qint32 l = 0; l < mbrs.rows(); ++l)
-                        if(mbrs[l])
-                            sgn[l] = 0; // prevent divide-by-zero for singleton mbrs
+                    sgn *= 1.0 - mbrs; // prevent divide-by-zero for singleton mbrs
 
-                Del.col(i) = ((double)m[i] / ((double)m[i] + sgn.cast<double>().array()));
-
-                Del.col(i).array() *= (X - C.row(i).replicate(n,1)).array().pow(2).rowwise().sum().array();
+                Del.col(i) = ((double)m[i] / ((double)m[i] + sgn)) * (X.rowwise() - C.row(i)).rowwise().squaredNorm().array();
             }
         }
         else if (m_sDistance.compare("cityblock") == 0)
@@ -629,26 +883,14 @@ bool KMeans::onlineUpdate(const MatrixXd& X, MatrixXd& C, VectorXi& idx)
                 qint32 i = changed[j];
                 if (m(i) % 2 == 0) // this will never catch singleton clusters
                 {
-                    MatrixXd ldist = Xmid1.row(i).replicate(n,1) - X;
-                    MatrixXd rdist = X - Xmid2.row(i).replicate(n,1);
-                    VectorXd mbrs = VectorXd::Zero(idx.rows());
-
-                    for(qint32 l = 0; l < idx.rows(); ++l)
-                        if(idx[l] == i)
-                            mbrs[l] = 1;
-                    MatrixXd sgn = ((-2*mbrs).array() + 1).replicate(1, p); // -1 for members, 1 for nonmembers
-                    rdist = sgn.array()*rdist.array(); ldist = sgn.array()*ldist.array();
-
-                    for(qint32 l = 0; l < idx.rows(); ++l)
-                    {
-                        double sum = 0;
-                        for(qint32 h = 0; h < rdist.cols(); ++h)
-                            sum += rdist(l,h) > ldist(l,h) ? rdist(l,h) < 0 ? 0 : rdist(l,h) : ldist(l,h) < 0 ? 0 : ldist(l,h);
-                        Del(l,i) = sum;
-                    }
+                    ArrayXd sgn = 1.0 - 2.0 * (idx.array() == i).cast<double>(); // -1 for members, 1 for nonmembers
+                    ArrayXXd ldist = (-(X.rowwise() - Xmid1.row(i))).array().colwise() * sgn;
+                    ArrayXXd rdist = (X.rowwise() - Xmid2.row(i)).array().colwise() * sgn;
+
+                    Del.col(i) = rdist.max(ldist).max(0.0).rowwise().sum().matrix();
                 }
                 else
-                    Del.col(i) = ((X - C.row(i).replicate(n,1)).array().abs()).rowwise().sum();
+                    Del.col(i) = (X.rowwise() - C.row(i)).cwiseAbs().rowwise().sum();
             }
         }
         else if (m_sDistance.compare("cosine") == 0 || m_sDistance.compare("correlation") == 0)
@@ -666,20 +908,13 @@ bool KMeans::onlineUpdate(const MatrixXd& X, MatrixXd& C, VectorXi& idx)
                 i = changed[j];
                 XCi = X * C.row(i).transpose();
 
-                VectorXi mbrs = VectorXi::Zero(idx.rows());
-                for(qint32 l = 0; l < idx.rows(); ++l)
-                    if(idx[l] == i)
-                        mbrs[l] = 1;
-
-                VectorXi sgn = 1 - 2 * mbrs.array(); // -1 for members, 1 for nonmembers
+                ArrayXd sgn = 1.0 - 2.0 * (idx.array() == i).cast<double>(); // -1 for members, 1 for nonmembers
 
                 double A = (double)m[i] * normC(i,0);
                 double B = pow(((double)m[i] * normC(i,0)),2);
 
-                Del.col(i) = 1 + sgn.cast<double>().array()*
-                        (A - (B + 2 * sgn.cast<double>().array() * m[i] * XCi.array() + 1).sqrt());
-
-                std::cout << "Del.col(i)\n" << Del.col(i) << std::endl;
+                Del.col(i) = 1 + sgn*
+                        (A - (B + 2 * sgn * m[i] * XCi.array() + 1).sqrt());
 
 //                Del(:,i) = 1 + sgn .*...
 //                      (m(i).*normC(i) - sqrt((m(i).*normC(i)).^2 + 2.*sgn.*m(i).*XCi + 1));
@@ -802,42 +1037,37 @@ bool KMeans::onlineUpdate(const MatrixXd& X, MatrixXd& C, VectorXi& idx)
             for(qint32 h = 0; h < 2; ++h)
             {
                 i = onidx[h];
+                if (m[i] <= 0)
+                    continue;
+
                 // Separate out sorted coords for points in each cluster.
                 // New centroid is the coord median, save values above and
                 // below median.  All done component-wise.
-                MatrixXd Xsorted(m[i],p);
-                qint32 c = 0;
+                std::vector<qint32> members;
                 for(qint32 j = 0; j < idx.rows(); ++j)
-                {
                     if(idx[j] == i)
-                    {
-                        Xsorted.row(c) = X.row(j);
-                        ++c;
-                    }
-                }
-                for(qint32 j = 0; j < Xsorted.cols(); ++j)
-                    std::sort(Xsorted.col(j).data(),Xsorted.col(j).data()+Xsorted.rows());
+                        members.push_back(j);
 
-                qint32 nn = floor(0.5*m[i])-1;
+                qint32 nn = m[i]/2 - 1;
                 if ((m[i] % 2) == 0)
                 {
-                    C.row(i) = 0.5 * (Xsorted.row(nn) + Xsorted.row(nn+1));
-                    Xmid1.row(i) = Xsorted.row(nn);
-                    Xmid2.row(i) = Xsorted.row(nn+1);
+                    MatrixXd Xsorted = sortedRanks(X, members, nn, nn+1);
+                    C.row(i) = 0.5 * (Xsorted.row(0) + Xsorted.row(1));
+                    Xmid1.row(i) = Xsorted.row(0);
+                    Xmid2.row(i) = Xsorted.row(1);
+                }
+                else if (m(i) > 1)
+                {
+                    MatrixXd Xsorted = sortedRanks(X, members, nn, nn+2);
+                    C.row(i) = Xsorted.row(1);
+                    Xmid1.row(i) = Xsorted.row(0);
+                    Xmid2.row(i) = Xsorted.row(2);
                 }
                 else
                 {
-                    C.row(i) = Xsorted.row(nn+1);
-                    if (m(i) > 1)
-                    {
-                        Xmid1.row(i) = Xsorted.row(nn);
-                        Xmid2.row(i) = Xsorted.row(nn+2);
-                    }
-                    else
-                    {
-                        Xmid1.row(i) = Xsorted.row(0);
-                        Xmid2.row(i) = Xsorted.row(0);
-                    }
+                    C.row(i) = X.row(members[0]);
+                    Xmid1.row(i) = X.row(members[0]);
+                    Xmid2.row(i) = X.row(members[0]);
                 }
             }
         }
@@ -867,31 +1097,23 @@ bool KMeans::onlineUpdate(const MatrixXd& X, MatrixXd& C, VectorXi& idx)
 
 //=============================================================================================================
 //DISTFUN Calculate point to cluster centroid distances.
-MatrixXd KMeans::distfun(const MatrixXd& X, MatrixXd& C)//, qint32 iter)
+MatrixXd KMeans::distfun(const MatrixXd& X, const MatrixXd& C)//, qint32 iter)
 {
-    MatrixXd D = MatrixXd::Zero(n,C.rows());
+    MatrixXd D = MatrixXd::Zero(X.rows(),C.rows());
     qint32 nclusts = C.rows();
 
     if (m_sDistance.compare("sqeuclidean") == 0)
     {
-        for(qint32 i = 0; i < nclusts; ++i)
-        {
-            D.col(i) = (X.col(0).array() - C(i,0)).pow(2);
-
-            for(qint32 j = 1; j < p; ++j)
-                D.col(i) = D.col(i).array() + (X.col(j).array() - C(i,j)).pow(2);
-        }
+        // |x-c|^2 = |x|^2 - 2 x'c + |c|^2, the cross terms are one matrix product
+        D.noalias() = -2.0 * X * C.transpose();
+        D.colwise() += X.rowwise().squaredNorm();
+        D.rowwise() += C.rowwise().squaredNorm().transpose();
+        D = D.cwiseMax(0.0);
     }
     else if (m_sDistance.compare("cityblock") == 0)
     {
         for(qint32 i = 0; i < nclusts; ++i)
-        {
-            D.col(i) = (X.col(0).array() - C(i,0)).array().abs();
-            for(qint32 j = 1; j < p; ++j)
-            {
-                D.col(i).array() += (X.col(j).array() - C(i,j)).array().abs();
-            }
-        }
+            D.col(i) = (X.rowwise() - C.row(i)).cwiseAbs().rowwise().sum();
     }
     else if (m_sDistance.compare("cosine") == 0 || m_sDistance.compare("correlation") == 0)
     {
@@ -931,64 +1153,44 @@ void KMeans::gcentroids(const MatrixXd& X, const VectorXi& index, const VectorXi
     centroids.fill(std::numeric_limits<double>::quiet_NaN());
     counts = VectorXi::Zero(num);
 
-    VectorXi members;
+    // Group the members of all requested clusters in one pass
+    std::vector<qint32> pos(k, -1);
+    for(qint32 i = 0; i < num; ++i)
+        pos[clusts[i]] = i;
 
-    qint32 c;
+    std::vector<std::vector<qint32> > members(num);
+    for(qint32 j = 0; j < index.rows(); ++j)
+        if(pos[index[j]] >= 0)
+            members[pos[index[j]]].push_back(j);
 
     for(qint32 i = 0; i < num; ++i)
     {
-        c = 0;
-        members = VectorXi::Zero(index.rows());
-        for(qint32 j = 0; j < index.rows(); ++j)
-        {
-            if(index[j] == clusts[i])
-            {
-                members[c] = j;
-                ++c;
-            }
-        }
-        members.conservativeResize(c);
+        qint32 c = members[i].size();
         if (c > 0)
         {
             counts[i] = c;
-            if(m_sDistance.compare("sqeuclidean") == 0)
+            if(m_sDistance.compare("sqeuclidean") == 0 || m_sDistance.compare("cosine") == 0 || m_sDistance.compare("correlation") == 0)
             {
-                //Initialize
-                if(members.rows() > 0)
-                    centroids.row(i) = RowVectorXd::Zero(centroids.cols());
-
-                for(qint32 j = 0; j < members.rows(); ++j)
-                    centroids.row(i).array() += X.row(members[j]).array() / counts[i];
+                // Mean, unnormalized for cosine and correlation
+                RowVectorXd sum = RowVectorXd::Zero(p);
+                for(qint32 j = 0; j < c; ++j)
+                    sum += X.row(members[i][j]);
+                centroids.row(i) = sum / counts[i];
             }
             else if(m_sDistance.compare("cityblock") == 0)
             {
                 // Separate out sorted coords for points in i'th cluster,
                 // and use to compute a fast median, component-wise
-                MatrixXd Xsorted(counts[i],p);
-                c = 0;
-
-                for(qint32 j = 0; j < index.rows(); ++j)
+                qint32 nn = counts[i]/2 - 1;
+                if (counts[i] % 2 == 0)
                 {
-                    if(index[j] == clusts[i])
-                    {
-                        Xsorted.row(c) = X.row(j);
-                        ++c;
-                    }
+                    MatrixXd Xsorted = sortedRanks(X, members[i], nn, nn+1);
+                    centroids.row(i) = .5 * (Xsorted.row(0) + Xsorted.row(1));
                 }
-
-                for(qint32 j = 0; j < Xsorted.cols(); ++j)
-                    std::sort(Xsorted.col(j).data(),Xsorted.col(j).data()+Xsorted.rows());
-
-                qint32 nn = floor(0.5*(counts(i)))-1;
-                if (counts[i] % 2 == 0)
-                    centroids.row(i) = .5 * (Xsorted.row(nn) + Xsorted.row(nn+1));
                 else
-                    centroids.row(i) = Xsorted.row(nn+1);
-            }
-            else if(m_sDistance.compare("cosine") == 0 || m_sDistance.compare("correlation") == 0)
-            {
-                for(qint32 j = 0; j < members.rows(); ++j)
-                    centroids.row(i).array() += X.row(members[j]).array() / counts[i]; // unnormalized
+                {
+                    centroids.row(i) = sortedRanks(X, members[i], nn+1, nn+1);
+                }
             }
 //            else if(m_sDistance.compare("hamming") == 0)
 //            {
@@ -1006,12 +1208,40 @@ double KMeans::unifrnd(double a, double b)
     if (a > b)
         return std::numeric_limits<double>::quiet_NaN();
 
-    double a2 = a/2.0;
-    double b2 = b/2.0;
-    double mu = a2+b2;
-    double sig = b2-a2;
+    return std::uniform_real_distribution<double>(a, b)(m_generator);
+}
+
+//=============================================================================================================
+
+ArrayXXd KMeans::toMetric(const ArrayXXd& dist) const
+{
+    if (m_sDistance.compare("sqeuclidean") == 0)
+        return dist.max(0.0).sqrt();
+
+    return dist;
+}
 
-    double r = mu + sig * (2.0* (rand() % 1000)/1000 -1.0);
+//=============================================================================================================
+
+MatrixXd KMeans::sortedRanks(const MatrixXd& X,
+                             const std::vector<qint32>& members,
+                             qint32 iFirst,
+                             qint32 iLast) const
+{
+    MatrixXd Xsorted(iLast - iFirst + 1, X.cols());
+    std::vector<double> values(members.size());
+
+    for(qint32 j = 0; j < X.cols(); ++j)
+    {
+        for(size_t i = 0; i < members.size(); ++i)
+            values[i] = X(members[i], j);
+
+        std::nth_element(values.begin(), values.begin() + iFirst, values.end());
+        std::partial_sort(values.begin() + iFirst, values.begin() + iLast + 1, values.end());
+
+        for(qint32 i = iFirst; i <= iLast; ++i)
+            Xsorted(i - iFirst, j) = values[i];
+    }
 
-    return r;
+    return Xsorted;
 }
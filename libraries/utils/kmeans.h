@@ -49,6 +49,8 @@
 #include <QString>
 #include <QSharedPointer>
 
+#include <random>
+
 //=============================================================================================================
 // EIGEN INCLUDES
 //=============================================================================================================
@@ -75,7 +77,7 @@ public:
     typedef QSharedPointer<const KMeans> ConstSPtr; /**< Const shared pointer type for KMeans. */
 
     //distance {'sqeuclidean','cityblock','cosine','correlation','hamming'};
-    //startNames = {'uniform','sample','cluster'};
+    //startNames = {'uniform','sample','plus','cluster'};
     //emptyactNames = {'error','drop','singleton'};
 
     //=========================================================================================================
@@ -83,22 +85,25 @@ public:
      * Constructs a KMeans algorithm object.
      *
      * @param[in] distance   (optional) K-Means distance measure: "sqeuclidean" (default), "cityblock" , "cosine", "correlation", "hamming".
-     * @param[in] start      (optional) Cluster initialization: "sample" (default), "uniform", "cluster".
+     * @param[in] start      (optional) Cluster initialization: "sample" (default), "uniform", "plus" (k-means++), "cluster".
      * @param[in] replicates (optional) Number of K-Means replicates, which are generated. Best is returned.
      * @param[in] emptyact   (optional) What happens if a cluster wents empty: "error" (default), "drop", "singleton".
      * @param[in] online     (optional) If centroids should be updated during iterations: true (default), false.
      * @param[in] maxit      (optional) maximal number of iterations per replicate; 100 by default.
+     * @param[in] seed       (optional) Seed of the random number generator. Results are reproducible for a fixed seed; 0 by default.
      */
     explicit KMeans(QString distance = QString("sqeuclidean") ,
                     QString start = QString("sample"),
                     qint32 replicates = 1,
                     QString emptyact = QString("error"),
                     bool online = true,
-                    qint32 maxit = 100);
+                    qint32 maxit = 100,
+                    quint32 seed = 0);
 
     //=========================================================================================================
     /**
-     * Clusters input data X
+     * Clusters input data X. Multiple replicates are computed in parallel, each one with its own random number
+     * generator seeded by the seed and the replicate number.
      *
      * @param[in] X          Input data (rows = points; cols = p dimensional space).
      * @param[in] kClusters  Number of k clusters.
@@ -107,14 +112,58 @@ public:
      * @param[out] sumD      Summation of the distances to the centroid within one cluster.
      * @param[out] D         Cluster distances to the centroid.
      */
-    bool calculate( Eigen::MatrixXd X,
+    bool calculate( const Eigen::MatrixXd& X,
                     qint32 kClusters,
                     Eigen::VectorXi& idx,
                     Eigen::MatrixXd& C,
                     Eigen::VectorXd& sumD,
                     Eigen::MatrixXd& D);
 
+    //=========================================================================================================
+    /**
+     * Sets whether the batch phase of the metric distances skips points whose bounds show that they cannot move.
+     * Enabled by default. The assignments are the same either way, disabling it only costs time.
+     *
+     * @param[in] bPruning   Whether the batch phase is pruned.
+     */
+    void setPruning(bool bPruning);
+
 private:
+    //=========================================================================================================
+    /**
+     * Computes one replicate: initialization, batch and online phase.
+     *
+     * @param[in] X          Input data (rows = points; cols = p dimensional space).
+     * @param[in] rep        The replicate number.
+     * @param[in] Xmins      Minimum of each dimension, used for the "uniform" start.
+     * @param[in] Xmaxs      Maximum of each dimension, used for the "uniform" start.
+     * @param[out] idx       The cluster indeces to which cluster the input points belong to.
+     * @param[out] C         Cluster centroids k x p.
+     * @param[out] sumD      Summation of the distances to the centroid within one cluster.
+     * @param[out] D         Cluster distances to the centroid.
+     *
+     * @return true if the replicate finished, false if it was terminated by an empty cluster.
+     */
+    bool replicate(const Eigen::MatrixXd& X,
+                   qint32 rep,
+                   const Eigen::RowVectorXd& Xmins,
+                   const Eigen::RowVectorXd& Xmaxs,
+                   Eigen::VectorXi& idx,
+                   Eigen::MatrixXd& C,
+                   Eigen::VectorXd& sumD,
+                   Eigen::MatrixXd& D);
+
+    //=========================================================================================================
+    /**
+     * Chooses the initial centroids with k-means++ seeding: every further centroid is drawn from the points
+     * with a probability proportional to the distance to the nearest centroid chosen so far.
+     *
+     * @param[in] X          Input data.
+     *
+     * @return The initial centroids.
+     */
+    Eigen::MatrixXd plusplusStart(const Eigen::MatrixXd& X);
+
     //=========================================================================================================
     /**
      * Calculate point to cluster centroid distances.
@@ -125,7 +174,7 @@ private:
      * @return Cluster centroid distances.
      */
     Eigen::MatrixXd distfun(const Eigen::MatrixXd& X,
-                            Eigen::MatrixXd& C);//, qint32 iter);
+                            const Eigen::MatrixXd& C);//, qint32 iter);
 
     //=========================================================================================================
     /**
@@ -141,6 +190,50 @@ private:
                      Eigen::MatrixXd& C,
                      Eigen::VectorXi& idx);
 
+    //=========================================================================================================
+    /**
+     * Batch phase for the metric distances "sqeuclidean" (pruned in the euclidean metric) and "cityblock". Keeps an
+     * upper bound on the distance of each point to its centroid and a lower bound on the distance to all other
+     * centroids (Hamerly). Points whose bounds show that they cannot move are skipped, all others are compared
+     * against all centroids at once. The assignments equal the ones of batchUpdate up to rounding.
+     *
+     * @param[in] X          Input data.
+     * @param[in, out] C     Cluster centroids.
+     * @param[in, out] idx   The cluster indeces to which cluster the input points belong to.
+     *
+     * @return true if converged, false otherwise.
+     */
+    bool batchUpdatePruned(const Eigen::MatrixXd& X,
+                           Eigen::MatrixXd& C,
+                           Eigen::VectorXi& idx);
+
+    //=========================================================================================================
+    /**
+     * Converts values of distfun to the metric used for the bounds of batchUpdatePruned.
+     *
+     * @param[in] dist       Values as returned by distfun.
+     *
+     * @return The metric distances.
+     */
+    Eigen::ArrayXXd toMetric(const Eigen::ArrayXXd& dist) const;
+
+    //=========================================================================================================
+    /**
+     * Returns the ranks [iFirst, iLast] of the component-wise sorted coordinates of the given points. Only the
+     * requested ranks are brought into order.
+     *
+     * @param[in] X          Input data.
+     * @param[in] members    The points.
+     * @param[in] iFirst     The first rank.
+     * @param[in] iLast      The last rank.
+     *
+     * @return The sorted coordinates (iLast - iFirst + 1) x p.
+     */
+    Eigen::MatrixXd sortedRanks(const Eigen::MatrixXd& X,
+                                const std::vector<qint32>& members,
+                                qint32 iFirst,
+                                qint32 iLast) const;
+
     //=========================================================================================================
     /**
      * Centroids and counts stratified by group.
@@ -183,11 +276,14 @@ private:
     double unifrnd(double a, double b);
 
     QString m_sDistance;    /**< Distance measurement to use: "sqeuclidean" (default), "cityblock" , "cosine", "correlation", "hamming". */
-    QString m_sStart;       /**< Initialization to use: "sample" (default), "uniform", "cluster". */
+    QString m_sStart;       /**< Initialization to use: "sample" (default), "uniform", "plus", "cluster". */
     qint32 m_iReps;         /**< Number of K-Means replicates, which should be generated. */
     QString m_sEmptyact;    /**< What should be done if a cluster wents empty: "error" (default), "drop", "singleton". */
     qint32 m_iMaxit;        /**< Maximal number of iterations per replicate. */
     bool m_bOnline;         /**< If online update should be performed. */
+    quint32 m_iSeed;        /**< Seed of the random number generator. */
+    bool m_bPruning;        /**< Whether the batch phase of the metric distances is pruned. */
+    std::mt19937 m_generator;   /**< Random number generator of the current replicate. */
 
     qint32 emptyErrCnt;     /**< Counts the occurence of empty errors. */
 
@@ -376,35 +376,10 @@ MatrixXd MNEMath::rescale(const MatrixXd &data,
     qInfo().noquote() << QString("[MNEMath::rescale] Applying baseline correction ... (mode: %1)").arg(mode);
 
     qint32 imin = 0;
-    qint32 imax = times.size();
+    qint32 imax = 0;
 
-    if (baseline.second == baseline.first) {
-        imin = 0;
-    } else {
-        float bmin = baseline.first;
-        for(qint32 i = 0; i < times.size(); ++i) {
-            if(times[i] >= bmin) {
-                imin = i;
-                break;
-            }
-        }
-    }
-
-    float bmax = baseline.second;
-
-    if (baseline.second == baseline.first) {
-        bmax = 0;
-    }
-
-    for(qint32 i = times.size()-1; i >= 0; --i) {
-        if(times[i] <= bmax) {
-            imax = i+1;
-            break;
-        }
-    }
-
-    if(imax < imin) {
-        qWarning() << "[MNEMath::rescale] imax < imin. Returning input data.";
+    if(!baselineRange(times, baseline, imin, imax)) {
+        qWarning() << "[MNEMath::rescale] The baseline window is empty. Returning input data.";
         return data_out;
     }
 
@@ -436,6 +411,39 @@ MatrixXd MNEMath::rescale(const MatrixXd &data,
 
 //=============================================================================================================
 
+bool MNEMath::baselineRange(const RowVectorXf &times,
+                            const QPair<float,float>& baseline,
+                            qint32 &iFrom,
+                            qint32 &iTo)
+{
+    iFrom = 0;
+    iTo = times.size();
+
+    float bmax = baseline.second;
+
+    if(baseline.second == baseline.first) {
+        bmax = 0;
+    } else {
+        for(qint32 i = 0; i < times.size(); ++i) {
+            if(times[i] >= baseline.first) {
+                iFrom = i;
+                break;
+            }
+        }
+    }
+
+    for(qint32 i = times.size() - 1; i >= 0; --i) {
+        if(times[i] <= bmax) {
+            iTo = i + 1;
+            break;
+        }
+    }
+
+    return iTo > iFrom;
+}
+
+//=============================================================================================================
+
 bool MNEMath::compareTransformation(const MatrixX4f& mDevHeadT,
                                     const MatrixX4f& mDevHeadDest,
                                     const float& fThreshRot,
@@ -266,6 +266,23 @@ public:
                                    const QPair<float, float> &baseline,
                                    QString mode);
 
+    //=========================================================================================================
+    /**
+     * Finds the samples of the baseline window. Used by rescale and the averaging code.
+     *
+     * @param[in] times          Time instants is seconds.
+     * @param[in] baseline       If baseline is (a, b) the interval is between "a (s)" and "b (s)".
+     *                           If a and b are equal use interval between the beginning of the data and the time point 0 (stimulus onset).
+     * @param[out] iFrom         The first baseline sample.
+     * @param[out] iTo           One past the last baseline sample.
+     *
+     * @return   true if the baseline window holds at least one sample, false otherwise.
+     */
+    static bool baselineRange(const Eigen::RowVectorXf &times,
+                              const QPair<float, float> &baseline,
+                              qint32 &iFrom,
+                              qint32 &iTo);
+
     //=========================================================================================================
     /**
      * Sorts a vector (ascending order) in place and returns the track of the original indeces
@@ -34,6 +34,9 @@
 
 #include "mnetracer.h"
 
+#include <cmath>
+#include <algorithm>
+
 
 using namespace UTILSLIB;
 
@@ -47,6 +50,11 @@ std::ofstream MNETracer::ms_OutputFileStream;
 bool MNETracer::ms_bIsFirstEvent(true);
 std::mutex MNETracer::ms_outFileMutex;
 long long MNETracer::ms_iZeroTime(0);
+std::map<std::string, MNETracer::LatencyHistogram> MNETracer::ms_mapLatencies;
+std::mutex MNETracer::ms_latenciesMutex;
+
+static const int latencyBinsPerDecade(10);
+static const int latencyNumBins(9 * latencyBinsPerDecade);    // up to 1000 s
 
 //=============================================================================================================
 // DEFINE MEMBER METHODS
@@ -91,8 +99,13 @@ MNETracer::~MNETracer()
 void MNETracer::enable(const std::string &jsonFileName)
 {
     ms_OutputFileStream.open(jsonFileName);
+    ms_bIsFirstEvent = true;
     writeHeader();
     setZeroTime();
+
+    ms_latenciesMutex.lock();
+    ms_mapLatencies.clear();
+    ms_latenciesMutex.unlock();
     if (ms_OutputFileStream.is_open())
     {
         ms_bIsEnabled = true;
@@ -112,6 +125,7 @@ void MNETracer::disable()
 {
     if (ms_bIsEnabled)
     {
+        writeLatencyHistograms();
         writeFooter();
         ms_OutputFileStream.flush();
         ms_OutputFileStream.close();
@@ -149,7 +163,58 @@ void MNETracer::traceQuantity(const std::string &name, long val)
     s.append("{\"name\":\"").append(name).append("\",\"ph\":\"C\",\"ts\":");
     s.append(std::to_string(timeNow)).append(",\"pid\":1,\"tid\":1");
     s.append(",\"args\":{\"").append(name).append("\":").append(std::to_string(val)).append("}}\n");
-    writeToFile(s);
+    writeEvent(s);
+}
+
+//=============================================================================================================
+
+void MNETracer::traceStage(const std::string& stage,
+                           long long beginTime,
+                           long long endTime,
+                           long long acquisitionTime,
+                           unsigned long long sequenceId)
+{
+    if (!ms_bIsEnabled)
+        return;
+
+    long long latency = endTime - acquisitionTime;
+
+    std::string s;
+    s.append("{\"name\":\"").append(stage).append("\",\"cat\":\"stage\",");
+    s.append("\"ph\":\"X\",\"ts\":").append(std::to_string(beginTime - ms_iZeroTime));
+    s.append(",\"dur\":").append(std::to_string(endTime - beginTime)).append(",\"pid\":1,\"tid\":");
+    s.append(threadId()).append(",\"args\":{\"sequence id\":").append(std::to_string(sequenceId));
+    s.append(",\"latency us\":").append(std::to_string(latency)).append("}}\n");
+    writeEvent(s);
+
+    traceLatency(stage, latency);
+}
+
+//=============================================================================================================
+
+void MNETracer::traceLatency(const std::string& stage, long long latency)
+{
+    if (!ms_bIsEnabled)
+        return;
+
+    latency = std::max(latency, 0LL);
+    int bin = latency <= 1 ? 0 : static_cast<int>(std::log10(static_cast<double>(latency)) * latencyBinsPerDecade);
+    bin = std::min(bin, latencyNumBins - 1);
+
+    std::lock_guard<std::mutex> lock(ms_latenciesMutex);
+    LatencyHistogram& histogram = ms_mapLatencies[stage];
+    if (histogram.counts.empty())
+        histogram.counts.resize(latencyNumBins, 0);
+    ++histogram.counts[bin];
+    ++histogram.count;
+    histogram.max = std::max(histogram.max, latency);
+}
+
+//=============================================================================================================
+
+bool MNETracer::isEnabled()
+{
+    return ms_bIsEnabled;
 }
 
 //=============================================================================================================
@@ -194,9 +259,16 @@ long long MNETracer::getTimeNow()
 //=============================================================================================================
 
 void MNETracer::registerThreadId()
+{
+    m_iThreadId = threadId();
+}
+
+//=============================================================================================================
+
+std::string MNETracer::threadId()
 {
     auto longId = std::hash<std::thread::id>{}(std::this_thread::get_id());
-    m_iThreadId = std::to_string(longId).substr(0, 5);
+    return std::to_string(longId).substr(0, 5);
 }
 
 //=============================================================================================================
@@ -267,18 +339,77 @@ void MNETracer::writeToFile(const std::string& str)
 
 //=============================================================================================================
 
+void MNETracer::writeEvent(const std::string& event)
+{
+    ms_outFileMutex.lock();
+    if(ms_OutputFileStream.is_open()) {
+        if (!ms_bIsFirstEvent)
+            ms_OutputFileStream << ",";
+        ms_OutputFileStream << event;
+        ms_bIsFirstEvent = false;
+    }
+    ms_outFileMutex.unlock();
+}
+
+//=============================================================================================================
+
+void MNETracer::writeLatencyHistograms()
+{
+    std::lock_guard<std::mutex> lock(ms_latenciesMutex);
+    long long timeNow = getTimeNow() - ms_iZeroTime;
+
+    for (const auto& stage : ms_mapLatencies)
+    {
+        const LatencyHistogram& histogram = stage.second;
+
+        // Percentiles are reported as the upper edge of the bin they fall into
+        auto percentile = [&histogram](double q) {
+            long long target = static_cast<long long>(std::ceil(q * histogram.count));
+            long long cumulative = 0;
+            for (int bin = 0; bin < latencyNumBins; ++bin)
+            {
+                cumulative += histogram.counts[bin];
+                if (cumulative >= target && cumulative > 0)
+                    return std::min(histogram.max, static_cast<long long>(std::pow(10.0, (bin + 1.0) / latencyBinsPerDecade)));
+            }
+            return histogram.max;
+        };
+
+        std::string s;
+        s.append("{\"name\":\"").append(stage.first).append(" latency\",\"cat\":\"latency\",");
+        s.append("\"ph\":\"i\",\"s\":\"g\",\"ts\":").append(std::to_string(timeNow)).append(",\"pid\":1,\"tid\":1");
+        s.append(",\"args\":{\"count\":").append(std::to_string(histogram.count));
+        s.append(",\"p50 us\":").append(std::to_string(percentile(0.5)));
+        s.append(",\"p90 us\":").append(std::to_string(percentile(0.9)));
+        s.append(",\"p99 us\":").append(std::to_string(percentile(0.99)));
+        s.append(",\"max us\":").append(std::to_string(histogram.max));
+        s.append(",\"histogram us\":{");
+        bool first = true;
+        for (int bin = 0; bin < latencyNumBins; ++bin)
+        {
+            if (histogram.counts[bin] == 0)
+                continue;
+            if (!first)
+                s.append(",");
+            s.append("\"").append(std::to_string(static_cast<long long>(std::pow(10.0, (bin + 1.0) / latencyBinsPerDecade)))).append("\":");
+            s.append(std::to_string(histogram.counts[bin]));
+            first = false;
+        }
+        s.append("}}}\n");
+        writeEvent(s);
+    }
+}
+
+//=============================================================================================================
+
 void MNETracer::writeBeginEvent()
 {
     std::string s;
-    if (!ms_bIsFirstEvent)
-        s.append(",");
-
     s.append("{\"name\":\"").append(m_sFunctionName).append("\",\"cat\":\"bst\",");
     s.append("\"ph\":\"B\",\"ts\":").append(std::to_string(m_iBeginTime)).append(",\"pid\":1,\"tid\":");
     s.append(m_iThreadId).append(",\"args\":{\"file path\":\"").append(m_sFileName).append("\",\"line number\":");
     s.append(std::to_string(m_iLineNumber)).append("}}\n");
-    writeToFile(s);
-    ms_bIsFirstEvent = false;
+    writeEvent(s);
 }
 
 //=============================================================================================================
@@ -286,11 +417,11 @@ void MNETracer::writeBeginEvent()
 void MNETracer::writeEndEvent()
 {
     std::string s;
-    s.append(",{\"name\":\"").append(m_sFunctionName).append("\",\"cat\":\"bst\",");
+    s.append("{\"name\":\"").append(m_sFunctionName).append("\",\"cat\":\"bst\",");
     s.append("\"ph\":\"E\",\"ts\":").append(std::to_string(m_iEndTime)).append(",\"pid\":1,\"tid\":");
     s.append(m_iThreadId).append(",\"args\":{\"file path\":\"").append(m_sFileName).append("\",\"line number\":");
     s.append(std::to_string(m_iLineNumber)).append("}}\n");
-    writeToFile(s);
+    writeEvent(s);
 }
 
 //=============================================================================================================
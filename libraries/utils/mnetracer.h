@@ -44,11 +44,13 @@
 #define MNE_TRACER_ENABLE(FILENAME) UTILSLIB::MNETracer::enable(#FILENAME);
 #define MNE_TRACER_DISABLE UTILSLIB::MNETracer::disable();
 #define MNE_TRACE_VALUE(NAME, VALUE) UTILSLIB::MNETracer::traceQuantity(NAME, VALUE);
+#define MNE_TRACE_LATENCY(STAGE, LATENCY) UTILSLIB::MNETracer::traceLatency(STAGE, LATENCY);
 #else
 #define MNE_TRACE()
 #define MNE_TRACER_ENABLE(FILENAME)
 #define MNE_TRACER_DISABLE
-#define MNE_TRACE_VALUE()
+#define MNE_TRACE_VALUE(NAME, VALUE)
+#define MNE_TRACE_LATENCY(STAGE, LATENCY)
 #endif
 
 #ifdef MNE_TRACE_MEMORY
@@ -88,6 +90,8 @@ void operator delete(void *memory, size_t size)
 #include <chrono>
 #include <thread>
 #include <mutex>
+#include <map>
+#include <vector>
 
 //=============================================================================================================
 // DEFINE NAMESPACE MNESCAN
@@ -177,6 +181,41 @@ public:
      */
     static void traceQuantity(const std::string& name, long val);
 
+    /**
+     * @brief traceStage Records the processing of one data block by one stage of a pipeline as a complete event. The
+     * latency from the acquisition of the block until the stage finished is added to the latency histogram of the stage.
+     * @param stage Name of the stage.
+     * @param beginTime Time the stage started processing the block, see getTimeNow.
+     * @param endTime Time the stage finished processing the block, see getTimeNow.
+     * @param acquisitionTime Time the block was acquired, see getTimeNow.
+     * @param sequenceId Sequence number of the block.
+     */
+    static void traceStage(const std::string& stage,
+                           long long beginTime,
+                           long long endTime,
+                           long long acquisitionTime,
+                           unsigned long long sequenceId);
+
+    /**
+     * @brief traceLatency Adds a latency to the histogram of a stage. The percentiles of all histograms are written to the
+     * output file when the tracer is disabled.
+     * @param stage Name of the stage.
+     * @param latency Latency in microseconds.
+     */
+    static void traceLatency(const std::string& stage, long long latency);
+
+    /**
+     * @brief isEnabled Returns whether the tracer is writing events.
+     * @return bool value.
+     */
+    static bool isEnabled();
+
+    /**
+     * @brief getTimeNow Wrapper function over chronos std library functionality to get the tick of this instant (in microseconds).
+     * @return The actual time now in microseconds.
+     */
+    static long long getTimeNow();
+
     /**
      * Getter function for the member variable that defines whether the output should be printed to terminal, or only to a file.
      * @return bool value.
@@ -215,10 +254,22 @@ private:
     static void setZeroTime();
 
     /**
-     * @brief getTimeNow Wrapper function over chronos std library functionality to get the tick of this instant (in microseconds).
-     * @return The actual time now in microseconds.
+     * @brief writeEvent Writes an event to the output file, separated from the previous one.
+     * @param event The event in json format.
      */
-    static long long getTimeNow();
+    static void writeEvent(const std::string& event);
+
+    /**
+     * @brief writeLatencyHistograms Writes count, percentiles and the non empty bins of each latency histogram as one
+     * instant event per stage.
+     */
+    static void writeLatencyHistograms();
+
+    /**
+     * @brief threadId Returns a string identifying the calling thread. The same thread will always have the same id.
+     * @return The thread id.
+     */
+    static std::string threadId();
 
     /**
      * @brief initialize Formats the fileName, FunctionName and line of code text shown in each event saved to the output file.
@@ -277,6 +328,15 @@ private:
     static std::mutex ms_outFileMutex;          /**< Mutex to guard the writing to file between threads. */
     static long long ms_iZeroTime;              /**< Integer value to store the origin-time (ie the Zero time) from which all other time measurements will depend. */
 
+    struct LatencyHistogram
+    {
+        std::vector<long long> counts;          /**< Counts per bin. Bin b holds latencies up to 10^((b+1)/10) microseconds. */
+        long long count = 0;                    /**< Number of latencies. */
+        long long max = 0;                      /**< Maximal latency. */
+    };
+    static std::map<std::string, LatencyHistogram> ms_mapLatencies;   /**< Latency histograms per stage. */
+    static std::mutex ms_latenciesMutex;        /**< Mutex to guard the latency histograms between threads. */
+
     bool m_bIsInitialized;          /**< Store if this object has been initialized properly. */
     bool m_bPrintToTerminal;        /**< Store if it is needed from this MNETracer object. to print to terminal too. */
     std::string m_sFileName;        /**< String to store the code file name where the MNETracer obj is instantiated. */
@@ -0,0 +1,228 @@
+//=============================================================================================================
+/**
+ * @file     slidingspectrum.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Definition of the SlidingSpectrum Class.
+ *
+ */
+
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "slidingspectrum.h"
+#include "spectral.h"
+
+#include <cmath>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QDebug>
+#include <QtMath>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace UTILSLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+SlidingSpectrum::SlidingSpectrum(int iNumChannels,
+                                 int iNfft,
+                                 double dSampFreq,
+                                 int iHop,
+                                 int iNumTapers,
+                                 int iNumAverages)
+: m_dSampFreq(dSampFreq)
+, m_iNfft(std::max(iNfft, 2))
+, m_iHop(iHop > 0 ? iHop : std::max(iNfft / 2, 1))
+, m_iNumAverages(std::max(iNumAverages, 0))
+, m_iWritePos(0)
+, m_iNumSamples(0)
+, m_iSinceLast(0)
+, m_iNumWindows(0)
+, m_iNextSlot(0)
+{
+    m_fft.SetFlag(m_fft.HalfSpectrum);
+
+    if(iNumTapers > 1) {
+        m_matTapers = sineTapers(m_iNfft, iNumTapers);
+    } else {
+        m_matTapers = Spectral::generateTapers(m_iNfft, "hanning").first;
+    }
+
+    const int iNumBins = m_iNfft / 2 + 1;
+
+    // Unit norm tapers with equal weights, see Spectral::psdFromTaperedSpectra
+    m_vecScale = VectorXd::Constant(iNumBins, 2.0 / (m_matTapers.rows() * m_dSampFreq));
+    m_vecScale(0) /= 2.0;
+    if(m_iNfft % 2 == 0) {
+        m_vecScale(iNumBins - 1) /= 2.0;
+    }
+
+    m_matBuffer = MatrixXd::Zero(m_iNfft, iNumChannels);
+    m_vecSegment.resize(m_iNfft);
+    m_vecTapered.resize(m_iNfft);
+    m_vecSpectrum.resize(iNumBins);
+
+    if(m_iNumAverages > 0) {
+        m_lWindowPsds.fill(MatrixXd::Zero(iNumChannels, iNumBins), m_iNumAverages);
+    } else {
+        m_matWindowPsd = MatrixXd::Zero(iNumChannels, iNumBins);
+    }
+
+    m_matPsdSum = MatrixXd::Zero(iNumChannels, iNumBins);
+    m_matPsd = MatrixXd::Zero(iNumChannels, iNumBins);
+}
+
+//=============================================================================================================
+
+int SlidingSpectrum::append(const MatrixXd& matData)
+{
+    if(matData.rows() != m_matBuffer.cols()) {
+        qWarning() << "[SlidingSpectrum::append] Expected" << m_matBuffer.cols() << "channels but got" << matData.rows();
+        return 0;
+    }
+
+    int iNumNewWindows = 0;
+    int iCol = 0;
+
+    while(iCol < matData.cols()) {
+        // Samples missing until the ring is full for the first time, then until the next hop
+        const int iToNext = m_iNumSamples < m_iNfft ? m_iNfft - m_iNumSamples : m_iHop - m_iSinceLast;
+        const int iNum = std::min(std::min(iToNext, int(matData.cols()) - iCol), m_iNfft - m_iWritePos);
+
+        m_matBuffer.middleRows(m_iWritePos, iNum) = matData.middleCols(iCol, iNum).transpose();
+
+        m_iWritePos = (m_iWritePos + iNum) % m_iNfft;
+        m_iNumSamples = std::min(m_iNumSamples + iNum, m_iNfft);
+        m_iSinceLast += iNum;
+        iCol += iNum;
+
+        if(iNum == iToNext) {
+            processWindow();
+            m_iSinceLast = 0;
+            ++iNumNewWindows;
+        }
+    }
+
+    return iNumNewWindows;
+}
+
+//=============================================================================================================
+
+void SlidingSpectrum::reset()
+{
+    m_iWritePos = 0;
+    m_iNumSamples = 0;
+    m_iSinceLast = 0;
+    m_iNumWindows = 0;
+    m_iNextSlot = 0;
+
+    m_matPsdSum.setZero();
+    m_matPsd.setZero();
+}
+
+//=============================================================================================================
+
+VectorXd SlidingSpectrum::frequencies() const
+{
+    return Spectral::calculateFFTFreqs(m_iNfft, m_dSampFreq);
+}
+
+//=============================================================================================================
+
+MatrixXd SlidingSpectrum::sineTapers(int iSignalLength,
+                                     int iNumTapers)
+{
+    MatrixXd matTapers(iNumTapers, iSignalLength);
+    const double dNorm = std::sqrt(2.0 / (iSignalLength + 1.0));
+
+    for(int k = 0; k < iNumTapers; ++k) {
+        for(int n = 0; n < iSignalLength; ++n) {
+            matTapers(k, n) = dNorm * std::sin(M_PI * (k + 1) * (n + 1) / (iSignalLength + 1.0));
+        }
+    }
+
+    return matTapers;
+}
+
+//=============================================================================================================
+
+void SlidingSpectrum::processWindow()
+{
+    MatrixXd& matWindowPsd = m_iNumAverages > 0 ? m_lWindowPsds[m_iNextSlot] : m_matWindowPsd;
+
+    // The slot leaves the running mean before it is overwritten
+    if(m_iNumAverages > 0 && m_iNumWindows >= m_iNumAverages) {
+        m_matPsdSum -= matWindowPsd;
+    }
+
+    // The ring is full, so the oldest sample sits at the write position
+    const int iOldest = m_iWritePos;
+
+    for(int c = 0; c < m_matBuffer.cols(); ++c) {
+        m_vecSegment.head(m_iNfft - iOldest) = m_matBuffer.col(c).tail(m_iNfft - iOldest);
+        m_vecSegment.tail(iOldest) = m_matBuffer.col(c).head(iOldest);
+
+        matWindowPsd.row(c).setZero();
+
+        for(int k = 0; k < m_matTapers.rows(); ++k) {
+            m_vecTapered = m_vecSegment.cwiseProduct(m_matTapers.row(k).transpose());
+            m_fft.fwd(m_vecSpectrum, m_vecTapered);
+            matWindowPsd.row(c) += m_vecSpectrum.cwiseAbs2().transpose();
+        }
+
+        matWindowPsd.row(c).array() *= m_vecScale.transpose().array();
+    }
+
+    m_matPsdSum += matWindowPsd;
+    ++m_iNumWindows;
+
+    if(m_iNumAverages > 0) {
+        m_iNextSlot = (m_iNextSlot + 1) % m_iNumAverages;
+
+        // Resum once per cycle so that the rounding errors of the running sum do not accumulate
+        if(m_iNextSlot == 0) {
+            m_matPsdSum = m_lWindowPsds[0];
+            for(int i = 1; i < m_iNumAverages; ++i) {
+                m_matPsdSum += m_lWindowPsds[i];
+            }
+        }
+    }
+
+    m_matPsd = m_matPsdSum / numAveraged();
+}
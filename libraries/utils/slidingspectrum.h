@@ -0,0 +1,218 @@
+//=============================================================================================================
+/**
+ * @file     slidingspectrum.h
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Declaration of the SlidingSpectrum Class.
+ *
+ */
+
+
+#ifndef SLIDINGSPECTRUM_H
+#define SLIDINGSPECTRUM_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "utils_global.h"
+
+#include <algorithm>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QVector>
+#include <QSharedPointer>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+#include <unsupported/Eigen/FFT>
+
+//=============================================================================================================
+// DEFINE NAMESPACE UTILSLIB
+//=============================================================================================================
+
+namespace UTILSLIB
+{
+
+//=============================================================================================================
+/**
+ * Streaming power spectral density estimation for multichannel data. Incoming samples are collected in a sliding
+ * window of iNfft samples per channel. Every iHop samples the window is tapered and transformed. One Hanning taper
+ * gives a Welch estimate, several sine tapers give a multitaper estimate. The FFT plan, the tapers and all work
+ * buffers are allocated once. The averaged PSD is a running mean over the last iNumAverages windows, or over all
+ * windows since the last reset if iNumAverages is 0. Each new window only adds its own spectrum to the mean.
+ * Scaling follows Spectral::psdFromTaperedSpectra.
+ *
+ * @brief Sliding window Welch/multitaper PSD estimation.
+ */
+class UTILSSHARED_EXPORT SlidingSpectrum
+{
+
+public:
+    typedef QSharedPointer<SlidingSpectrum> SPtr;             /**< Shared pointer type for SlidingSpectrum. */
+    typedef QSharedPointer<const SlidingSpectrum> ConstSPtr;  /**< Const shared pointer type for SlidingSpectrum. */
+
+    //=========================================================================================================
+    /**
+     * Constructs a SlidingSpectrum.
+     *
+     * @param[in] iNumChannels     The number of channels.
+     * @param[in] iNfft            The window and FFT length.
+     * @param[in] dSampFreq        The sampling frequency.
+     * @param[in] iHop             The number of samples between two windows. Values <= 0 select half a window.
+     * @param[in] iNumTapers       1 for a Hanning taper (Welch), more for the given number of sine tapers.
+     * @param[in] iNumAverages     The number of windows in the running mean. 0 averages all windows.
+     */
+    SlidingSpectrum(int iNumChannels,
+                    int iNfft,
+                    double dSampFreq,
+                    int iHop = 0,
+                    int iNumTapers = 1,
+                    int iNumAverages = 0);
+
+    //=========================================================================================================
+    /**
+     * Appends new samples and updates the averaged PSD for every window which was completed by them.
+     *
+     * @param[in] matData      The new data (channels x samples).
+     *
+     * @return The number of windows which were completed.
+     */
+    int append(const Eigen::MatrixXd& matData);
+
+    //=========================================================================================================
+    /**
+     * Discards all samples and spectra.
+     */
+    void reset();
+
+    //=========================================================================================================
+    /**
+     * Returns the averaged one-sided PSD.
+     *
+     * @return The PSD (channels x iNfft/2+1). Zero until the first window was completed.
+     */
+    inline const Eigen::MatrixXd& psd() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the number of windows in the current mean.
+     *
+     * @return The number of averaged windows.
+     */
+    inline int numAveraged() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the frequencies of the PSD bins.
+     *
+     * @return The frequencies (iNfft/2+1).
+     */
+    Eigen::VectorXd frequencies() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the tapers.
+     *
+     * @return The tapers (tapers x iNfft), each with unit norm.
+     */
+    inline const Eigen::MatrixXd& tapers() const;
+
+    //=========================================================================================================
+    /**
+     * Computes orthonormal sine tapers, a closed form alternative to DPSS tapers.
+     *
+     * @param[in] iSignalLength    The taper length.
+     * @param[in] iNumTapers       The number of tapers.
+     *
+     * @return The tapers (tapers x iSignalLength).
+     */
+    static Eigen::MatrixXd sineTapers(int iSignalLength,
+                                      int iNumTapers);
+
+private:
+    //=========================================================================================================
+    /**
+     * Computes the spectrum of the window ending at the current write position and adds it to the mean.
+     */
+    void processWindow();
+
+    Eigen::FFT<double>      m_fft;              /**< The FFT object, keeps its plan between windows. */
+    Eigen::MatrixXd         m_matTapers;        /**< The tapers (tapers x iNfft). */
+    Eigen::MatrixXd         m_matBuffer;        /**< Ring buffer of the last iNfft samples (iNfft x channels). */
+    Eigen::VectorXd         m_vecSegment;       /**< The current window of one channel in time order. */
+    Eigen::VectorXd         m_vecTapered;       /**< The tapered window. */
+    Eigen::VectorXcd        m_vecSpectrum;      /**< The half spectrum of the tapered window. */
+    Eigen::VectorXd         m_vecScale;         /**< The PSD scaling per bin. */
+    QVector<Eigen::MatrixXd> m_lWindowPsds;     /**< The PSDs of the windows in the running mean (channels x bins). */
+    Eigen::MatrixXd         m_matPsdSum;        /**< The sum of the PSDs in the running mean. */
+    Eigen::MatrixXd         m_matPsd;           /**< The averaged PSD. */
+    Eigen::MatrixXd         m_matWindowPsd;     /**< The PSD of the last window when all windows are averaged. */
+
+    double      m_dSampFreq;        /**< The sampling frequency. */
+    int         m_iNfft;            /**< The window and FFT length. */
+    int         m_iHop;             /**< The number of samples between two windows. */
+    int         m_iNumAverages;     /**< The number of windows in the running mean, 0 for all. */
+    int         m_iWritePos;        /**< The next row to write in the ring buffer. */
+    int         m_iNumSamples;      /**< The number of samples received since the last reset, capped at iNfft. */
+    int         m_iSinceLast;       /**< The number of samples since the last window. */
+    int         m_iNumWindows;      /**< The number of windows since the last reset. */
+    int         m_iNextSlot;        /**< The next slot to overwrite in m_lWindowPsds. */
+};
+
+//=============================================================================================================
+// INLINE DEFINITIONS
+//=============================================================================================================
+
+inline const Eigen::MatrixXd& SlidingSpectrum::psd() const
+{
+    return m_matPsd;
+}
+
+//=============================================================================================================
+
+inline int SlidingSpectrum::numAveraged() const
+{
+    return m_iNumAverages > 0 ? std::min(m_iNumWindows, m_iNumAverages) : m_iNumWindows;
+}
+
+//=============================================================================================================
+
+inline const Eigen::MatrixXd& SlidingSpectrum::tapers() const
+{
+    return m_matTapers;
+}
+} // NAMESPACE UTILSLIB
+
+#endif // SLIDINGSPECTRUM_H
@@ -124,25 +124,24 @@ MatrixXd Spectrogram::compute(const SpectogramInputData& inputData)
         fftw_make_planner_thread_safe();
     #endif
 
-    Eigen::FFT<double> fft;
-    MatrixXd tf_matrix = MatrixXd::Zero(inputData.vecInputData.rows()/2, inputData.vecInputData.rows());
-    VectorXd envelope, windowed_sig, real_coeffs;
-    VectorXcd fft_win_sig;
-    qint32 window_size = inputData.window_size;
+    const qint32 iNumSamples = inputData.vecInputData.rows();
 
-    for(quint32 translate = inputData.iRangeLow; translate < inputData.iRangeHigh; translate++) {
-        envelope = gaussWindow(inputData.vecInputData.rows(), window_size, translate);
+    Eigen::FFT<double> fft;
+    fft.SetFlag(fft.HalfSpectrum);
+    MatrixXd tf_matrix = MatrixXd::Zero(iNumSamples/2, iNumSamples);
+    VectorXd windowed_sig(iNumSamples);
+    VectorXcd fft_win_sig(iNumSamples/2+1);
 
-        windowed_sig = VectorXd::Zero(inputData.vecInputData.rows());
-        fft_win_sig = VectorXcd::Zero(inputData.vecInputData.rows());
+    // The envelope only shifts with the translation, so it is computed once for all offsets -(N-1)..N-1
+    // and each translation takes its segment
+    const VectorXd gauss = gaussWindow(2*iNumSamples-1, inputData.window_size, iNumSamples-1);
 
-        windowed_sig = inputData.vecInputData.array() * envelope.array();\
+    for(quint32 translate = inputData.iRangeLow; translate < inputData.iRangeHigh; translate++) {
+        windowed_sig = inputData.vecInputData.cwiseProduct(gauss.segment(iNumSamples-1-translate, iNumSamples));
 
         fft.fwd(fft_win_sig, windowed_sig);
 
-        real_coeffs = fft_win_sig.segment(0,inputData.vecInputData.rows()/2).array().abs2();
-
-        tf_matrix.col(translate) = real_coeffs;
+        tf_matrix.col(translate) = fft_win_sig.head(iNumSamples/2).cwiseAbs2();
     }
 
     return tf_matrix;
@@ -70,6 +70,7 @@ SOURCES += \
     layoutloader.cpp \
     layoutmaker.cpp \
     selectionio.cpp \
+    slidingspectrum.cpp \
     spectrogram.cpp \
     utils_global.cpp \
     warp.cpp \
@@ -89,6 +90,7 @@ HEADERS += \
     layoutloader.h \
     layoutmaker.h \
     selectionio.h \
+    slidingspectrum.h \
     spectrogram.h \
     warp.h \
     sphere.h \
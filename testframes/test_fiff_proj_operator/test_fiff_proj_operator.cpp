@@ -0,0 +1,267 @@
+//=============================================================================================================
+/**
+ * @file     test_fiff_proj_operator.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief     Testframe for FiffProjOperator.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+#include <fiff/fiff_proj.h>
+#include <fiff/fiff_proj_operator.h>
+#include <fiff/fiff_named_matrix.h>
+#include <fiff/fiff_file.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtCore/QCoreApplication>
+#include <QtTest>
+
+//=============================================================================================================
+// Eigen
+//=============================================================================================================
+
+#include <Eigen/Dense>
+
+//=============================================================================================================
+// Used Namespaces
+//=============================================================================================================
+
+using namespace FIFFLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestFiffProjOperator
+ *
+ * @brief The TestFiffProjOperator class compares FiffProjOperator against the dense projector of FiffProj::make_projector
+ *
+ */
+class TestFiffProjOperator: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestFiffProjOperator();
+
+private slots:
+    void initTestCase();
+    void compareWithoutBads();
+    void compareWithBads();
+    void compareSwitches();
+    void compareIdentity();
+    void cleanupTestCase();
+
+private:
+    //=========================================================================================================
+    /**
+     * Returns the dense reference operator P_bad * C, where P_bad is the projector of FiffProj::make_projector with
+     * the columns of the bad channels set to zero.
+     */
+    MatrixXd referenceOperator(const QStringList& bads) const;
+
+    QList<FiffProj>     m_lProjs;       /**< The projectors. */
+    QStringList         m_lChNames;     /**< The channel names. */
+    MatrixXd            m_matComp;      /**< The dense compensator. */
+    MatrixXd            m_matData;      /**< The test data (channels x samples). */
+    double              m_dEpsilon;     /**< The tolerance. */
+};
+
+//=============================================================================================================
+
+TestFiffProjOperator::TestFiffProjOperator()
+: m_dEpsilon(1e-10)
+{
+}
+
+//=============================================================================================================
+
+void TestFiffProjOperator::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    std::srand(42);
+
+    // Ten MEG channels and two reference channels
+    const int iNumMeg = 10;
+    for(int i = 0; i < iNumMeg; ++i) {
+        m_lChNames << QString("MEG %1").arg(i + 1, 3, 10, QChar('0'));
+    }
+    m_lChNames << "REF 001" << "REF 002";
+
+    // One projector with two vectors on all MEG channels and one with a single vector on the first six channels
+    QStringList lRowNames;
+    lRowNames << "PCA-v1" << "PCA-v2";
+    FiffNamedMatrix namedMatA(2, iNumMeg, lRowNames, m_lChNames.mid(0, iNumMeg), MatrixXd::Random(2, iNumMeg));
+    m_lProjs.append(FiffProj(FIFFV_PROJ_ITEM_FIELD, true, "Projector A", namedMatA));
+
+    FiffNamedMatrix namedMatB(1, 6, QStringList() << "PCA-v1", m_lChNames.mid(0, 6), MatrixXd::Random(1, 6));
+    m_lProjs.append(FiffProj(FIFFV_PROJ_ITEM_FIELD, true, "Projector B", namedMatB));
+
+    // The compensator mixes the reference channels into the MEG channels
+    m_matComp = MatrixXd::Identity(m_lChNames.size(), m_lChNames.size());
+    m_matComp.block(0, iNumMeg, iNumMeg, 2) = 0.1 * MatrixXd::Random(iNumMeg, 2);
+
+    m_matData = MatrixXd::Random(m_lChNames.size(), 50);
+}
+
+//=============================================================================================================
+
+void TestFiffProjOperator::compareWithoutBads()
+{
+    FiffProjOperator projOperator;
+    QVERIFY(projOperator.setProjection(m_lProjs, m_lChNames) > 0);
+    projOperator.setCompensator(m_matComp);
+
+    QVERIFY(projOperator.isProjActive());
+    QVERIFY(projOperator.isCompActive());
+
+    MatrixXd matRef = referenceOperator(QStringList());
+
+    MatrixXd matOut(m_matData.rows(), m_matData.cols());
+    projOperator.apply(m_matData, matOut);
+
+    QVERIFY((matOut - matRef * m_matData).cwiseAbs().maxCoeff() < m_dEpsilon);
+    QVERIFY((projOperator.toDense(m_lChNames.size()) - matRef).cwiseAbs().maxCoeff() < m_dEpsilon);
+
+    // In place must give the same result
+    MatrixXd matInPlace = m_matData;
+    projOperator.applyInPlace(matInPlace);
+    QVERIFY((matInPlace - matOut).cwiseAbs().maxCoeff() < m_dEpsilon);
+}
+
+//=============================================================================================================
+
+void TestFiffProjOperator::compareWithBads()
+{
+    QStringList lBads;
+    lBads << m_lChNames.at(2) << m_lChNames.at(7);
+
+    FiffProjOperator projOperator;
+    QVERIFY(projOperator.setProjection(m_lProjs, m_lChNames, lBads) > 0);
+    projOperator.setCompensator(m_matComp);
+
+    MatrixXd matRef = referenceOperator(lBads);
+
+    MatrixXd matOut(m_matData.rows(), m_matData.cols());
+    projOperator.apply(m_matData, matOut);
+
+    QVERIFY((matOut - matRef * m_matData).cwiseAbs().maxCoeff() < m_dEpsilon);
+    QVERIFY((projOperator.toDense(m_lChNames.size()) - matRef).cwiseAbs().maxCoeff() < m_dEpsilon);
+}
+
+//=============================================================================================================
+
+void TestFiffProjOperator::compareSwitches()
+{
+    QStringList lBads;
+    lBads << m_lChNames.at(4);
+
+    FiffProjOperator projOperator;
+    projOperator.setProjection(m_lProjs, m_lChNames, lBads);
+    projOperator.setCompensator(m_matComp);
+
+    MatrixXd matProj;
+    FiffProj::make_projector(m_lProjs, m_lChNames, matProj, lBads);
+    matProj.col(4).setZero();
+
+    MatrixXd matOut(m_matData.rows(), m_matData.cols());
+
+    // Projection only
+    projOperator.apply(m_matData, matOut, true, false);
+    QVERIFY((matOut - matProj * m_matData).cwiseAbs().maxCoeff() < m_dEpsilon);
+
+    // Compensation only
+    projOperator.apply(m_matData, matOut, false, true);
+    QVERIFY((matOut - m_matComp * m_matData).cwiseAbs().maxCoeff() < m_dEpsilon);
+
+    // Neither
+    projOperator.apply(m_matData, matOut, false, false);
+    QVERIFY((matOut - m_matData).cwiseAbs().maxCoeff() < m_dEpsilon);
+}
+
+//=============================================================================================================
+
+void TestFiffProjOperator::compareIdentity()
+{
+    // Inactive projectors and an empty compensator leave the data untouched
+    QList<FiffProj> lProjs = m_lProjs;
+    for(int i = 0; i < lProjs.size(); ++i) {
+        lProjs[i].active = false;
+    }
+
+    FiffProjOperator projOperator;
+    QCOMPARE(projOperator.setProjection(lProjs, m_lChNames), 0);
+    projOperator.setCompensator(MatrixXd());
+
+    QVERIFY(!projOperator.isProjActive());
+    QVERIFY(!projOperator.isCompActive());
+
+    MatrixXd matOut(m_matData.rows(), m_matData.cols());
+    projOperator.apply(m_matData, matOut);
+
+    QVERIFY((matOut - m_matData).cwiseAbs().maxCoeff() < m_dEpsilon);
+    QVERIFY(projOperator.toDense(m_lChNames.size()).isIdentity(m_dEpsilon));
+}
+
+//=============================================================================================================
+
+void TestFiffProjOperator::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+
+MatrixXd TestFiffProjOperator::referenceOperator(const QStringList& bads) const
+{
+    MatrixXd matProj;
+    FiffProj::make_projector(m_lProjs, m_lChNames, matProj, bads);
+
+    for(int i = 0; i < bads.size(); ++i) {
+        int iIdx = m_lChNames.indexOf(bads.at(i));
+        if(iIdx >= 0) {
+            matProj.col(iIdx).setZero();
+        }
+    }
+
+    return matProj * m_matComp;
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestFiffProjOperator)
+#include "test_fiff_proj_operator.moc"
@@ -0,0 +1,256 @@
+//=============================================================================================================
+/**
+ * @file     test_fiff_raw_writer.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief     Testframe for FiffRawWriter.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+#include <fiff/fiff_raw_data.h>
+#include <fiff/fiff_raw_writer.h>
+#include <fiff/fiff_stream.h>
+#include <fiff/fiff_file.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtCore/QCoreApplication>
+#include <QtTest>
+#include <QTemporaryDir>
+
+//=============================================================================================================
+// STL INCLUDES
+//=============================================================================================================
+
+#include <cmath>
+#include <limits>
+
+//=============================================================================================================
+// Eigen
+//=============================================================================================================
+
+#include <Eigen/Dense>
+
+//=============================================================================================================
+// Used Namespaces
+//=============================================================================================================
+
+using namespace FIFFLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestFiffRawWriter
+ *
+ * @brief The TestFiffRawWriter class writes raw data with FiffRawWriter and reads it back with FiffRawData
+ *
+ */
+class TestFiffRawWriter: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestFiffRawWriter();
+
+private slots:
+    void initTestCase();
+    void compareRoundTrip_data();
+    void compareRoundTrip();
+    void cleanupTestCase();
+
+private:
+    //=========================================================================================================
+    /**
+     * Returns the value stored for dValue with the given data type, i.e. rounded and saturated for the integer types.
+     */
+    static double storedValue(double dValue,
+                              fiff_int_t iDataType);
+
+    FiffRawData         m_raw;          /**< The raw data to write. */
+    MatrixXd            m_matData;      /**< The first seconds of m_raw. */
+    fiff_int_t          m_iBlockSize;   /**< The number of samples per written block. */
+    QTemporaryDir       m_outDir;       /**< The directory of the written files. */
+};
+
+//=============================================================================================================
+
+TestFiffRawWriter::TestFiffRawWriter()
+: m_iBlockSize(0)
+{
+}
+
+//=============================================================================================================
+
+void TestFiffRawWriter::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    QFile t_fileIn(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/sample_audvis_trunc_raw.fif");
+    QVERIFY(t_fileIn.exists());
+    QVERIFY(m_outDir.isValid());
+
+    m_raw = FiffRawData(t_fileIn);
+    QVERIFY(!m_raw.isEmpty());
+
+    // Three blocks of one second
+    m_iBlockSize = static_cast<fiff_int_t>(std::ceil(m_raw.info.sfreq));
+
+    MatrixXd matTimes;
+    QVERIFY(m_raw.read_raw_segment(m_matData, matTimes, m_raw.first_samp, m_raw.first_samp + 3 * m_iBlockSize - 1));
+    QCOMPARE(m_matData.cols(), static_cast<Index>(3 * m_iBlockSize));
+}
+
+//=============================================================================================================
+
+void TestFiffRawWriter::compareRoundTrip_data()
+{
+    QTest::addColumn<int>("iDataType");
+
+    QTest::newRow("float") << static_cast<int>(FIFFT_FLOAT);
+    QTest::newRow("int32") << static_cast<int>(FIFFT_INT);
+    QTest::newRow("int16") << static_cast<int>(FIFFT_SHORT);
+}
+
+//=============================================================================================================
+
+void TestFiffRawWriter::compareRoundTrip()
+{
+    QFETCH(int, iDataType);
+
+    QFile t_fileOut(m_outDir.filePath(QString("raw_writer_%1_raw.fif").arg(iDataType)));
+
+    // The integer types keep the channel ranges, so that they keep the resolution of the acquisition
+    RowVectorXd vecCals;
+    FiffStream::SPtr pOutfid = FiffStream::start_writing_raw(t_fileOut,
+                                                             m_raw.info,
+                                                             vecCals,
+                                                             defaultMatrixXi,
+                                                             iDataType == FIFFT_FLOAT,
+                                                             iDataType);
+    QVERIFY(pOutfid);
+    QCOMPARE(vecCals.size(), static_cast<Index>(m_raw.info.nchan));
+
+    pOutfid->write_int(FIFF_FIRST_SAMPLE, &m_raw.first_samp);
+
+    // Two values beyond the range of the integer types, with either sign
+    MatrixXd matData = m_matData;
+    matData(0, 1) = 1e10 * vecCals(0);
+    matData(1, 2) = -1e10 * vecCals(1);
+
+    qint64 iBytesPerValue = iDataType == FIFFT_SHORT ? 2 : 4;
+    qint64 iBytesExpected = 0;
+
+    FiffRawWriter* pWriter = new FiffRawWriter(pOutfid, vecCals, iDataType);
+
+    for(int iFirst = 0; iFirst < matData.cols(); iFirst += m_iBlockSize) {
+        QVERIFY(pWriter->write(matData.middleCols(iFirst, m_iBlockSize)));
+        iBytesExpected += 16 + iBytesPerValue * matData.rows() * m_iBlockSize;
+    }
+
+    QVERIFY(pWriter->flush());
+    QCOMPARE(pWriter->bytesWritten(), iBytesExpected);
+    pWriter->stop();
+    QVERIFY(!pWriter->write(matData.leftCols(m_iBlockSize)));
+    delete pWriter;
+
+    pOutfid->finish_writing_raw();
+
+    // Read the file back
+    QFile t_fileIn(t_fileOut.fileName());
+    FiffRawData rawOut(t_fileIn);
+    QVERIFY(!rawOut.isEmpty());
+
+    QCOMPARE(rawOut.first_samp, m_raw.first_samp);
+    QCOMPARE(rawOut.last_samp, m_raw.first_samp + static_cast<fiff_int_t>(matData.cols()) - 1);
+    QCOMPARE(rawOut.cals.size(), vecCals.size());
+    QVERIFY(((rawOut.cals - vecCals).array().abs() <= 1e-6 * vecCals.array().abs()).all());
+
+    MatrixXd matDataOut, matTimesOut;
+    QVERIFY(rawOut.read_raw_segment(matDataOut, matTimesOut, rawOut.first_samp, rawOut.last_samp));
+    QCOMPARE(matDataOut.rows(), matData.rows());
+    QCOMPARE(matDataOut.cols(), matData.cols());
+
+    // The reference applies the inverse calibrations, rounds and saturates like the writer
+    for(int r = 0; r < matData.rows(); ++r) {
+        const double dInvCal = 1.0 / vecCals(r);
+
+        for(int c = 0; c < matData.cols(); ++c) {
+            const double dExpected = storedValue(matData(r, c) * dInvCal, iDataType) * vecCals(r);
+            const double dTolerance = 1e-6 * (std::fabs(dExpected) + std::fabs(vecCals(r)));
+
+            if(std::fabs(matDataOut(r, c) - dExpected) > dTolerance) {
+                qWarning("[TestFiffRawWriter] Channel %d, sample %d: read %g, expected %g", r, c, matDataOut(r, c), dExpected);
+                QFAIL("The read data differs from the written data");
+            }
+        }
+    }
+
+    // The saturated values have to end up at the limits of the integer types
+    if(iDataType == FIFFT_INT) {
+        QCOMPARE(matDataOut(0, 1) / vecCals(0), static_cast<double>(std::numeric_limits<qint32>::max()));
+    } else if(iDataType == FIFFT_SHORT) {
+        QCOMPARE(matDataOut(1, 2) / vecCals(1), static_cast<double>(std::numeric_limits<qint16>::min()));
+    }
+}
+
+//=============================================================================================================
+
+void TestFiffRawWriter::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+
+double TestFiffRawWriter::storedValue(double dValue,
+                                      fiff_int_t iDataType)
+{
+    switch(iDataType) {
+        case FIFFT_INT:
+            return std::min(std::max(std::round(dValue), static_cast<double>(std::numeric_limits<qint32>::min())),
+                            static_cast<double>(std::numeric_limits<qint32>::max()));
+        case FIFFT_SHORT:
+            return std::min(std::max(std::round(dValue), static_cast<double>(std::numeric_limits<qint16>::min())),
+                            static_cast<double>(std::numeric_limits<qint16>::max()));
+        default:
+            return static_cast<float>(dValue);
+    }
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestFiffRawWriter)
+#include "test_fiff_raw_writer.moc"
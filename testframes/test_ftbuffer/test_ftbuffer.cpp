@@ -0,0 +1,413 @@
+//=============================================================================================================
+/**
+ * @file     test_ftbuffer.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Streams data from a local stand-in FieldTrip buffer through the FtConnector and measures throughput
+ *           and latency.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+
+#include "ftconnector.h"
+#include "ftbuffertypes.h"
+
+#include <cmath>
+#include <cstring>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtCore/QCoreApplication>
+#include <QtTest>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QSemaphore>
+#include <QElapsedTimer>
+#include <QAtomicInteger>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FTBUFFERPLUGIN;
+using namespace UTILSLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS FtBufferStandIn
+ *
+ * @brief The FtBufferStandIn class is a minimal FieldTrip buffer server. It answers GET_HDR, GET_DAT and WAIT_DAT
+ * for one client. Samples become available in real time at the given sampling frequency after the client
+ * connected. Sample s of channel c has the value (c * 7 + s) % 100.
+ */
+class FtBufferStandIn : public QThread
+{
+public:
+    FtBufferStandIn(int iNumChannels,
+                    int iNumSamples,
+                    float fSampleFreq,
+                    int iDataType)
+    : m_iNumChannels(iNumChannels)
+    , m_iNumSamples(iNumSamples)
+    , m_fSampleFreq(fSampleFreq)
+    , m_iDataType(iDataType)
+    , m_iPort(0)
+    , m_iConnectionTime(-1)
+    {
+        m_clock.start();
+    }
+
+    ~FtBufferStandIn()
+    {
+        requestInterruption();
+        wait();
+    }
+
+    //=========================================================================================================
+    /**
+     * Starts the server and waits until it listens.
+     *
+     * @return The port the server listens on, 0 if listening failed.
+     */
+    quint16 startListening()
+    {
+        start();
+        m_semListening.acquire();
+        return m_iPort;
+    }
+
+    //=========================================================================================================
+    /**
+     * Returns the time since the client connected, which is when the first sample became available. Can be called
+     * from any thread.
+     *
+     * @return The time since the connection in milliseconds, 0 if no client connected yet.
+     */
+    qint64 msecsSinceConnection() const
+    {
+        qint64 iConnectionTime = m_iConnectionTime.loadAcquire();
+        return iConnectionTime < 0 ? 0 : m_clock.elapsed() - iConnectionTime;
+    }
+
+    static double value(int iChannel,
+                        int iSample)
+    {
+        return (iChannel * 7 + iSample) % 100;
+    }
+
+protected:
+    void run() override
+    {
+        QTcpServer server;
+        if(server.listen(QHostAddress::LocalHost)) {
+            m_iPort = server.serverPort();
+        }
+        m_semListening.release();
+
+        while(!isInterruptionRequested() && !server.waitForNewConnection(100)) {
+        }
+
+        QTcpSocket* pSocket = server.nextPendingConnection();
+        if(!pSocket) {
+            return;
+        }
+        m_iConnectionTime.storeRelease(m_clock.elapsed());
+
+        messagedef_t request;
+        while(read(pSocket, reinterpret_cast<char*>(&request), sizeof(messagedef_t))) {
+            QByteArray baPayload(request.bufsize, 0);
+            if(!read(pSocket, baPayload.data(), request.bufsize)) {
+                break;
+            }
+
+            if(request.command == GET_HDR) {
+                headerdef_t headerdef;
+                headerdef.nchans = m_iNumChannels;
+                headerdef.nsamples = available();
+                headerdef.nevents = 0;
+                headerdef.fsample = m_fSampleFreq;
+                headerdef.data_type = m_iDataType;
+                headerdef.bufsize = 0;
+                respond(pSocket, GET_OK, reinterpret_cast<const char*>(&headerdef), sizeof(headerdef_t));
+            } else if(request.command == GET_DAT) {
+                datasel_t datasel;
+                std::memcpy(&datasel, baPayload.constData(), sizeof(datasel_t));
+                respond(pSocket, GET_OK, data(datasel.begsample, datasel.endsample));
+            } else if(request.command == WAIT_DAT) {
+                samples_events_t threshold;
+                qint32 iTimeout;
+                std::memcpy(&threshold, baPayload.constData(), sizeof(samples_events_t));
+                std::memcpy(&iTimeout, baPayload.constData() + sizeof(samples_events_t), sizeof(qint32));
+
+                // Block like the real buffer until more than threshold samples are available or the timeout passed
+                qint64 iReadyMs = static_cast<qint64>(std::ceil((threshold.nsamples + 1) * 1000.0 / m_fSampleFreq));
+                if(threshold.nsamples < m_iNumSamples) {
+                    QThread::msleep(qBound(qint64(0), iReadyMs - msecsSinceConnection(), qint64(iTimeout)));
+                } else {
+                    QThread::msleep(iTimeout);
+                }
+
+                samples_events_t sampevents;
+                sampevents.nsamples = available();
+                sampevents.nevents = 0;
+                respond(pSocket, WAIT_OK, reinterpret_cast<const char*>(&sampevents), sizeof(samples_events_t));
+            } else {
+                respond(pSocket, GET_ERR, Q_NULLPTR, 0);
+            }
+        }
+
+        delete pSocket;
+    }
+
+private:
+    int available() const
+    {
+        return qMin(m_iNumSamples, static_cast<int>(msecsSinceConnection() * m_fSampleFreq / 1000.0));
+    }
+
+    QByteArray data(int iFirst,
+                    int iLast) const
+    {
+        datadef_t datadef;
+        datadef.nchans = m_iNumChannels;
+        datadef.nsamples = iLast - iFirst + 1;
+        datadef.data_type = m_iDataType;
+
+        QByteArray baData;
+        switch(m_iDataType) {
+            case DATATYPE_INT16: baData = samples<qint16>(iFirst, iLast); break;
+            case DATATYPE_INT32: baData = samples<qint32>(iFirst, iLast); break;
+            case DATATYPE_FLOAT64: baData = samples<double>(iFirst, iLast); break;
+            default: baData = samples<float>(iFirst, iLast); break;
+        }
+        datadef.bufsize = baData.size();
+
+        return QByteArray(reinterpret_cast<const char*>(&datadef), sizeof(datadef_t)) + baData;
+    }
+
+    template<typename T>
+    QByteArray samples(int iFirst,
+                       int iLast) const
+    {
+        QByteArray baData((iLast - iFirst + 1) * m_iNumChannels * static_cast<int>(sizeof(T)), 0);
+        T* pData = reinterpret_cast<T*>(baData.data());
+
+        for(int s = iFirst; s <= iLast; ++s) {
+            for(int c = 0; c < m_iNumChannels; ++c) {
+                *pData++ = static_cast<T>(value(c, s));
+            }
+        }
+
+        return baData;
+    }
+
+    static bool read(QTcpSocket* pSocket,
+                     char* pData,
+                     qint64 iNumBytes)
+    {
+        qint64 iNumRead = 0;
+        while(iNumRead < iNumBytes) {
+            if(pSocket->bytesAvailable() == 0 && !pSocket->waitForReadyRead(5000)) {
+                return false;
+            }
+            iNumRead += pSocket->read(pData + iNumRead, iNumBytes - iNumRead);
+        }
+        return true;
+    }
+
+    static void respond(QTcpSocket* pSocket,
+                        qint16 command,
+                        const char* pData,
+                        int iNumBytes)
+    {
+        respond(pSocket, command, QByteArray(pData, iNumBytes));
+    }
+
+    static void respond(QTcpSocket* pSocket,
+                        qint16 command,
+                        const QByteArray& baData)
+    {
+        messagedef_t response;
+        response.version = VERSION;
+        response.command = command;
+        response.bufsize = baData.size();
+
+        pSocket->write(reinterpret_cast<const char*>(&response), sizeof(messagedef_t));
+        pSocket->write(baData);
+        pSocket->waitForBytesWritten(1000);
+    }
+
+    int             m_iNumChannels;
+    int             m_iNumSamples;
+    float           m_fSampleFreq;
+    int             m_iDataType;
+    quint16         m_iPort;
+    QSemaphore      m_semListening;
+    QElapsedTimer   m_clock;            // Started on construction and only read afterwards.
+    QAtomicInteger<qint64> m_iConnectionTime;   // Time of m_clock at which the client connected, -1 before.
+};
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestFtBuffer
+ *
+ * @brief The TestFtBuffer class streams data of every sample type from a stand-in buffer through the FtConnector.
+ *
+ */
+class TestFtBuffer: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestFtBuffer();
+
+private slots:
+    void initTestCase();
+    void receiveData_data();
+    void receiveData();
+    void cleanupTestCase();
+
+private:
+    int     m_iNumChannels;
+    int     m_iNumSamples;
+    float   m_fSampleFreq;
+};
+
+//=============================================================================================================
+
+TestFtBuffer::TestFtBuffer()
+: m_iNumChannels(32)
+, m_iNumSamples(4000)
+, m_fSampleFreq(2000.0f)
+{
+}
+
+//=============================================================================================================
+
+void TestFtBuffer::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+}
+
+//=============================================================================================================
+
+void TestFtBuffer::receiveData_data()
+{
+    QTest::addColumn<int>("iDataType");
+
+    QTest::newRow("int16") << static_cast<int>(DATATYPE_INT16);
+    QTest::newRow("int32") << static_cast<int>(DATATYPE_INT32);
+    QTest::newRow("float32") << static_cast<int>(DATATYPE_FLOAT32);
+    QTest::newRow("float64") << static_cast<int>(DATATYPE_FLOAT64);
+}
+
+//=============================================================================================================
+
+void TestFtBuffer::receiveData()
+{
+    QFETCH(int, iDataType);
+
+    FtBufferStandIn standIn(m_iNumChannels, m_iNumSamples, m_fSampleFreq, iDataType);
+    quint16 iPort = standIn.startListening();
+    QVERIFY(iPort != 0);
+
+    FtConnector connector;
+    connector.setAddr("127.0.0.1");
+    connector.setPort(iPort);
+    QVERIFY(connector.connect());
+    QVERIFY(connector.getHeader());
+
+    MatrixXd matReceived(m_iNumChannels, m_iNumSamples);
+    int iNumReceived = 0;
+    int iNumBlocks = 0;
+    qint64 iMaxLatency = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    while(iNumReceived < m_iNumSamples && timer.elapsed() < 10000) {
+        if(!connector.getData() || !connector.newData()) {
+            continue;
+        }
+
+        const MatrixXd& matBlock = connector.getMatrix();
+        QVERIFY(matBlock.rows() == m_iNumChannels);
+        QVERIFY(iNumReceived + matBlock.cols() <= m_iNumSamples);
+
+        matReceived.middleCols(iNumReceived, matBlock.cols()) = matBlock;
+        iNumReceived += matBlock.cols();
+        ++iNumBlocks;
+
+        // Time between the newest sample becoming available and it being decoded
+        qint64 iLatency = standIn.msecsSinceConnection() - static_cast<qint64>(iNumReceived * 1000.0 / m_fSampleFreq);
+        iMaxLatency = qMax(iMaxLatency, iLatency);
+
+        connector.resetEmitData();
+    }
+
+    connector.disconnect();
+    standIn.requestInterruption();
+    standIn.wait();
+
+    qInfo() << "[TestFtBuffer::receiveData] Received" << iNumReceived << "samples in" << iNumBlocks << "blocks within" << timer.elapsed() << "ms. Maximum latency" << iMaxLatency << "ms.";
+
+    QCOMPARE(iNumReceived, m_iNumSamples);
+
+    for(int s = 0; s < m_iNumSamples; ++s) {
+        for(int c = 0; c < m_iNumChannels; ++c) {
+            QCOMPARE(matReceived(c,s), FtBufferStandIn::value(c,s));
+        }
+    }
+}
+
+//=============================================================================================================
+
+void TestFtBuffer::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestFtBuffer)
+#include "test_ftbuffer.moc"
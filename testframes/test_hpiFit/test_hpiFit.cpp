@@ -75,6 +75,20 @@ using namespace UTILSLIB;
 using namespace INVERSELIB;
 using namespace Eigen;
 
+//=============================================================================================================
+/**
+ * DECLARE CLASS HPIFitDataAccess
+ *
+ * @brief The HPIFitDataAccess class exposes the leadfield functions of HPIFitData to the tests
+ *
+ */
+class HPIFitDataAccess : public HPIFitData
+{
+public:
+    using HPIFitData::magnetic_dipole;
+    using HPIFitData::magnetic_dipole_gradient;
+};
+
 //=============================================================================================================
 /**
  * DECLARE CLASS TestHpiFit
@@ -98,9 +112,18 @@ private slots:
     void compareMove();
     void compareDetect();
     void compareTime();
+    void compareGradient();
+    void compareGradientFit();
     void cleanupTestCase();
 
 private:
+    //=========================================================================================================
+    /**
+     * Creates radially oriented point magnetometers spread evenly over a hemisphere around the origin.
+     */
+    SensorSet hemisphereSensors(int iNumCoils,
+                                double dRadius) const;
+
     double dErrorTrans;
     double dErrorQuat;
     double dErrorTime;
@@ -326,10 +349,99 @@ void TestHpiFit::compareTime()
 
 //=============================================================================================================
 
+void TestHpiFit::compareGradient()
+{
+    // The analytic derivative with respect to the dipole position against central differences of the field
+    SensorSet sensors = hemisphereSensors(100, 0.12);
+    HPIFitDataAccess data;
+
+    RowVector3d vecPos(0.01, -0.02, 0.05);
+    Vector3d vecMom(0.3, -0.5, 0.2);
+    double dStep = 1e-6;
+
+    MatrixXd matGrad = data.magnetic_dipole_gradient(vecPos, vecMom, sensors.rmag, sensors.cosmag);
+    MatrixXd matGradNum(matGrad.rows(), 3);
+
+    for(int c = 0; c < 3; ++c) {
+        RowVector3d vecPosUp = vecPos;
+        RowVector3d vecPosDown = vecPos;
+        vecPosUp(c) += dStep;
+        vecPosDown(c) -= dStep;
+        matGradNum.col(c) = (data.magnetic_dipole(vecPosUp, sensors.rmag, sensors.cosmag) * vecMom
+                             - data.magnetic_dipole(vecPosDown, sensors.rmag, sensors.cosmag) * vecMom) / (2 * dStep);
+    }
+
+    double dDiff = (matGrad - matGradNum).cwiseAbs().maxCoeff() / matGradNum.cwiseAbs().maxCoeff();
+    qDebug() << "Relative gradient difference: " << dDiff;
+    QVERIFY(dDiff < 1e-6);
+}
+
+//=============================================================================================================
+
+void TestHpiFit::compareGradientFit()
+{
+    // Both optimizers have to recover a dipole from noise free data, starting about 1.7 cm away
+    SensorSet sensors = hemisphereSensors(100, 0.12);
+    HPIFitDataAccess data;
+
+    RowVector3d vecPos(0.01, -0.02, 0.05);
+    Vector3d vecMom(0.3, -0.5, 0.2);
+
+    MatrixXd matData = data.magnetic_dipole(vecPos, sensors.rmag, sensors.cosmag) * vecMom;
+
+    HPIFitData simplexFit;
+    simplexFit.m_coilPos = RowVector3d(0.02, -0.01, 0.04);
+    simplexFit.m_sensorData = matData.col(0).transpose();
+    simplexFit.m_sensors = sensors;
+    simplexFit.m_matProjector = MatrixXd::Identity(sensors.ncoils, sensors.ncoils);
+
+    HPIFitData gradientFit = simplexFit;
+    gradientFit.m_bDoGradientFit = true;
+
+    simplexFit.doDipfitConcurrent();
+    gradientFit.doDipfitConcurrent();
+
+    double dErrorSimplex = (simplexFit.m_coilPos - vecPos).norm();
+    double dErrorGradient = (gradientFit.m_coilPos - vecPos).norm();
+    qDebug() << "Simplex error: [m]" << dErrorSimplex << "after" << simplexFit.m_errorInfo.numIterations << "iterations";
+    qDebug() << "Gradient error: [m]" << dErrorGradient << "after" << gradientFit.m_errorInfo.numIterations << "iterations";
+
+    QVERIFY(dErrorSimplex < 1e-5);
+    QVERIFY(dErrorGradient < 1e-5);
+    QVERIFY(gradientFit.m_errorInfo.numIterations < simplexFit.m_errorInfo.numIterations);
+}
+
+//=============================================================================================================
+
 void TestHpiFit::cleanupTestCase()
 {
 }
 
+//=============================================================================================================
+
+SensorSet TestHpiFit::hemisphereSensors(int iNumCoils,
+                                        double dRadius) const
+{
+    SensorSet sensors;
+    sensors.ncoils = iNumCoils;
+    sensors.np = 1;
+    sensors.w = RowVectorXd::Ones(iNumCoils);
+    sensors.rmag.resize(iNumCoils, 3);
+    sensors.cosmag.resize(iNumCoils, 3);
+
+    // Fibonacci lattice on the upper hemisphere
+    double dGoldenAngle = M_PI * (3.0 - std::sqrt(5.0));
+
+    for(int i = 0; i < iNumCoils; ++i) {
+        double z = 1.0 - (i + 0.5) / iNumCoils;
+        double r = std::sqrt(1.0 - z * z);
+        sensors.cosmag.row(i) << r * std::cos(i * dGoldenAngle), r * std::sin(i * dGoldenAngle), z;
+        sensors.rmag.row(i) = dRadius * sensors.cosmag.row(i);
+    }
+
+    return sensors;
+}
+
 //=============================================================================================================
 // MAIN
 //=============================================================================================================
@@ -0,0 +1,230 @@
+//=============================================================================================================
+/**
+ * @file     test_kmeans.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief     Testframe for KMeans.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+#include <utils/kmeans.h>
+
+#include <random>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtCore/QCoreApplication>
+#include <QtTest>
+
+//=============================================================================================================
+// Eigen
+//=============================================================================================================
+
+#include <Eigen/Dense>
+
+//=============================================================================================================
+// Used Namespaces
+//=============================================================================================================
+
+using namespace UTILSLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestKMeans
+ *
+ * @brief The TestKMeans class checks that KMeans is reproducible for a fixed seed and that pruning does not change it
+ *
+ */
+class TestKMeans: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestKMeans();
+
+private slots:
+    void initTestCase();
+    void compareReplicates();
+    void comparePruning_data();
+    void comparePruning();
+    void cleanupTestCase();
+
+private:
+    //=========================================================================================================
+    /**
+     * Returns overlapping gaussian clusters, the i-th point belongs to cluster i % kClusters.
+     */
+    MatrixXd clusteredPoints(int iNumPoints,
+                             int iDim,
+                             int kClusters,
+                             unsigned int iSeed) const;
+
+    int         m_kClusters;    /**< The number of clusters. */
+    double      m_dEpsilon;     /**< The tolerance. */
+};
+
+//=============================================================================================================
+
+TestKMeans::TestKMeans()
+: m_kClusters(5)
+, m_dEpsilon(1e-8)
+{
+}
+
+//=============================================================================================================
+
+void TestKMeans::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+}
+
+//=============================================================================================================
+
+void TestKMeans::compareReplicates()
+{
+    MatrixXd X = clusteredPoints(600, 4, m_kClusters, 7);
+    const int iReps = 8;
+    const quint32 iSeed = 42;
+
+    VectorXi idx, idxRepeat;
+    MatrixXd C, D, CRepeat, DRepeat;
+    VectorXd sumD, sumDRepeat;
+
+    // The replicates run in parallel, two runs must give exactly the same result
+    KMeans kMeans(QString("sqeuclidean"), QString("plus"), iReps, QString("drop"), true, 100, iSeed);
+    QVERIFY(kMeans.calculate(X, m_kClusters, idx, C, sumD, D));
+
+    KMeans kMeansRepeat(QString("sqeuclidean"), QString("plus"), iReps, QString("drop"), true, 100, iSeed);
+    QVERIFY(kMeansRepeat.calculate(X, m_kClusters, idxRepeat, CRepeat, sumDRepeat, DRepeat));
+
+    QVERIFY(idx == idxRepeat);
+    QVERIFY(C == CRepeat);
+    QVERIFY(sumD == sumDRepeat);
+
+    // Replicate r is seeded with seed + r, so the best of the single replicate runs is the parallel result
+    double dBestSumD = std::numeric_limits<double>::max();
+    VectorXi idxBest;
+    for(int rep = 0; rep < iReps; ++rep) {
+        KMeans kMeansSingle(QString("sqeuclidean"), QString("plus"), 1, QString("drop"), true, 100, iSeed + rep);
+
+        VectorXi idxSingle;
+        MatrixXd CSingle, DSingle;
+        VectorXd sumDSingle;
+        if(kMeansSingle.calculate(X, m_kClusters, idxSingle, CSingle, sumDSingle, DSingle) && sumDSingle.sum() < dBestSumD) {
+            dBestSumD = sumDSingle.sum();
+            idxBest = idxSingle;
+        }
+    }
+
+    QCOMPARE(sumD.sum(), dBestSumD);
+    QVERIFY(idx == idxBest);
+}
+
+//=============================================================================================================
+
+void TestKMeans::comparePruning_data()
+{
+    QTest::addColumn<QString>("distance");
+    QTest::addColumn<bool>("online");
+
+    QTest::newRow("sqeuclidean batch") << QString("sqeuclidean") << false;
+    QTest::newRow("sqeuclidean online") << QString("sqeuclidean") << true;
+    QTest::newRow("cityblock batch") << QString("cityblock") << false;
+    QTest::newRow("cityblock online") << QString("cityblock") << true;
+}
+
+//=============================================================================================================
+
+void TestKMeans::comparePruning()
+{
+    QFETCH(QString, distance);
+    QFETCH(bool, online);
+
+    for(unsigned int iSeed = 0; iSeed < 10; ++iSeed) {
+        MatrixXd X = clusteredPoints(600, 4, m_kClusters, iSeed);
+
+        VectorXi idxPruned, idx;
+        MatrixXd CPruned, DPruned, C, D;
+        VectorXd sumDPruned, sumD;
+
+        KMeans kMeansPruned(distance, QString("plus"), 1, QString("drop"), online, 100, iSeed);
+        bool bPruned = kMeansPruned.calculate(X, m_kClusters, idxPruned, CPruned, sumDPruned, DPruned);
+
+        KMeans kMeans(distance, QString("plus"), 1, QString("drop"), online, 100, iSeed);
+        kMeans.setPruning(false);
+        bool bUnpruned = kMeans.calculate(X, m_kClusters, idx, C, sumD, D);
+
+        QCOMPARE(bPruned, bUnpruned);
+        QVERIFY(idxPruned == idx);
+        QVERIFY((CPruned - C).cwiseAbs().maxCoeff() < m_dEpsilon);
+        QVERIFY(std::fabs(sumDPruned.sum() - sumD.sum()) < m_dEpsilon * sumD.sum());
+    }
+}
+
+//=============================================================================================================
+
+void TestKMeans::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+
+MatrixXd TestKMeans::clusteredPoints(int iNumPoints,
+                                     int iDim,
+                                     int kClusters,
+                                     unsigned int iSeed) const
+{
+    std::mt19937 generator(iSeed);
+    std::normal_distribution<double> normal(0.0, 1.0);
+
+    MatrixXd X(iNumPoints, iDim);
+    for(int i = 0; i < iNumPoints; ++i) {
+        // The centers lie two standard deviations apart along the diagonal
+        double dCenter = 2.0 * (i % kClusters);
+        for(int j = 0; j < iDim; ++j) {
+            X(i,j) = dCenter + normal(generator);
+        }
+    }
+
+    return X;
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestKMeans)
+#include "test_kmeans.moc"
@@ -0,0 +1,264 @@
+//=============================================================================================================
+/**
+ * @file     test_minimum_norm.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief     Testframe for MinimumNorm.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+#include <utils/mnemath.h>
+#include <fiff/fiff_evoked.h>
+#include <fiff/fiff_cov.h>
+#include <fs/label.h>
+#include <mne/mne_forwardsolution.h>
+#include <mne/mne_inverse_operator.h>
+#include <mne/mne_sourceestimate.h>
+#include <inverse/minimumNorm/minimumnorm.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtCore/QCoreApplication>
+#include <QtTest>
+
+//=============================================================================================================
+// STL INCLUDES
+//=============================================================================================================
+
+#include <limits>
+
+//=============================================================================================================
+// Eigen
+//=============================================================================================================
+
+#include <Eigen/Dense>
+#include <Eigen/SparseCore>
+
+//=============================================================================================================
+// Used Namespaces
+//=============================================================================================================
+
+using namespace INVERSELIB;
+using namespace MNELIB;
+using namespace FIFFLIB;
+using namespace FSLIB;
+using namespace UTILSLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestMinimumNorm
+ *
+ * @brief The TestMinimumNorm class checks the batched inverse against the per data set inverse and the kernel cache
+ *
+ */
+class TestMinimumNorm: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestMinimumNorm();
+
+private slots:
+    void initTestCase();
+    void compareWithCombineXyz();
+    void compareBatchWithSingle();
+    void compareMethodSwitch();
+    void cleanupTestCase();
+
+private:
+    //=========================================================================================================
+    /**
+     * Returns the largest absolute difference of two matrices relative to the largest absolute value of the reference.
+     */
+    double relativeError(const MatrixXd& matTest,
+                         const MatrixXd& matRef) const;
+
+    FiffEvoked              m_evoked;       /**< The evoked data. */
+    MNEInverseOperator      m_invOp;        /**< The inverse operator with free orientations. */
+    float                   m_fLambda;      /**< The regularization. */
+    double                  m_dEpsilon;     /**< The tolerance. */
+};
+
+//=============================================================================================================
+
+TestMinimumNorm::TestMinimumNorm()
+: m_fLambda(1.0f / 9.0f)
+, m_dEpsilon(1e-10)
+{
+}
+
+//=============================================================================================================
+
+void TestMinimumNorm::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    QFile t_fileEvoked(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/sample_audvis-ave.fif");
+    QFile t_fileFwd(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/Result/ref-sample_audvis-meg-eeg-oct-6-fwd.fif");
+    QFile t_fileCov(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/sample_audvis-cov.fif");
+    QVERIFY(t_fileEvoked.exists());
+    QVERIFY(t_fileFwd.exists());
+    QVERIFY(t_fileCov.exists());
+
+    m_evoked = FiffEvoked(t_fileEvoked, 0, QPair<float,float>(-1.0f, -1.0f));
+    QVERIFY(!m_evoked.isEmpty());
+
+    MNEForwardSolution t_fwd(t_fileFwd, false, true);
+    FiffCov noise_cov(t_fileCov);
+    noise_cov = noise_cov.regularize(m_evoked.info, 0.05, 0.05, 0.1, true);
+
+    // Loose orientations, so the components are combined
+    m_invOp = MNEInverseOperator(m_evoked.info, t_fwd, noise_cov, 0.2f, 0.8f);
+    QVERIFY(m_invOp.source_ori == FIFFV_MNE_FREE_ORI);
+}
+
+//=============================================================================================================
+
+void TestMinimumNorm::compareWithCombineXyz()
+{
+    MinimumNorm minimumNorm(m_invOp, m_fLambda, QString("dSPM"));
+    MNESourceEstimate stc = minimumNorm.calculateInverse(m_evoked);
+    QVERIFY(!stc.isEmpty());
+
+    // The previous implementation applied the kernel and combined the components column by column
+    MNEInverseOperator inv = minimumNorm.getPreparedInverseOperator();
+    MatrixXd K;
+    SparseMatrix<double> noise_norm;
+    QList<VectorXi> vertno;
+    QVERIFY(inv.assemble_kernel(Label(), QString("dSPM"), false, K, noise_norm, vertno));
+
+    MatrixXd matData = m_evoked.pick_channels(inv.noise_cov->names).data;
+    MatrixXd sol = K * matData;
+    MatrixXd sol1(sol.rows()/3, sol.cols());
+    for(qint32 i = 0; i < sol.cols(); ++i) {
+        VectorXd* tmp = MNEMath::combine_xyz(sol.col(i));
+        sol1.col(i) = tmp->cwiseSqrt();
+        delete tmp;
+    }
+    MatrixXd matRef = inv.noisenorm * sol1;
+
+    QCOMPARE(stc.data.rows(), matRef.rows());
+    QCOMPARE(stc.data.cols(), matRef.cols());
+    QVERIFY(relativeError(stc.data, matRef) < m_dEpsilon);
+}
+
+//=============================================================================================================
+
+void TestMinimumNorm::compareBatchWithSingle()
+{
+    MinimumNorm minimumNorm(m_invOp, m_fLambda, QString("sLORETA"));
+    minimumNorm.doInverseSetup(m_evoked.nave, false);
+
+    MatrixXd matData = m_evoked.pick_channels(minimumNorm.getPreparedInverseOperator().noise_cov->names).data;
+    float tmin = m_evoked.times[0];
+    float tstep = 1.0f / m_evoked.info.sfreq;
+
+    // Three epochs of different length
+    QList<MatrixXd> lData;
+    int iFirst = 0;
+    int iNumCols = matData.cols();
+    QList<int> lLengths;
+    lLengths << iNumCols / 4 << iNumCols / 2 << iNumCols - iNumCols / 4 - iNumCols / 2;
+    for(int iLength : lLengths) {
+        lData.append(matData.middleCols(iFirst, iLength));
+        iFirst += iLength;
+    }
+
+    QList<MNESourceEstimate> lStc = minimumNorm.calculateInverse(lData, tmin, tstep);
+    QCOMPARE(lStc.size(), lData.size());
+
+    for(int i = 0; i < lData.size(); ++i) {
+        MNESourceEstimate stcSingle = minimumNorm.calculateInverse(lData[i], tmin, tstep);
+        QVERIFY(!stcSingle.isEmpty());
+        QCOMPARE(lStc[i].data.cols(), lData[i].cols());
+        QVERIFY(relativeError(lStc[i].data, stcSingle.data) < m_dEpsilon);
+        QVERIFY(lStc[i].vertices == stcSingle.vertices);
+    }
+
+    // The same for the evoked list, where each data set is picked on its own
+    QList<FiffEvoked> lEvoked;
+    lEvoked << m_evoked << m_evoked;
+    QList<MNESourceEstimate> lStcEvoked = minimumNorm.calculateInverse(lEvoked);
+    QCOMPARE(lStcEvoked.size(), lEvoked.size());
+
+    MNESourceEstimate stcEvoked = minimumNorm.calculateInverse(m_evoked);
+    for(int i = 0; i < lStcEvoked.size(); ++i) {
+        QVERIFY(relativeError(lStcEvoked[i].data, stcEvoked.data) < m_dEpsilon);
+    }
+}
+
+//=============================================================================================================
+
+void TestMinimumNorm::compareMethodSwitch()
+{
+    MinimumNorm minimumNormRef(m_invOp, m_fLambda, QString("dSPM"));
+    MNESourceEstimate stcRef = minimumNormRef.calculateInverse(m_evoked);
+
+    // Asking for both falls back to dSPM, the kernel assembled for sLORETA must not be reused
+    MinimumNorm minimumNorm(m_invOp, m_fLambda, QString("sLORETA"));
+    MNESourceEstimate stcSLoreta = minimumNorm.calculateInverse(m_evoked);
+    QVERIFY(relativeError(stcSLoreta.data, stcRef.data) > 1e-3);
+
+    minimumNorm.setMethod(true, true);
+    MNESourceEstimate stc = minimumNorm.calculateInverse(m_evoked);
+
+    QVERIFY(relativeError(stc.data, stcRef.data) < m_dEpsilon);
+}
+
+//=============================================================================================================
+
+void TestMinimumNorm::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+
+double TestMinimumNorm::relativeError(const MatrixXd& matTest,
+                                      const MatrixXd& matRef) const
+{
+    if(matTest.rows() != matRef.rows() || matTest.cols() != matRef.cols()) {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    return (matTest - matRef).cwiseAbs().maxCoeff() / matRef.cwiseAbs().maxCoeff();
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestMinimumNorm)
+#include "test_minimum_norm.moc"
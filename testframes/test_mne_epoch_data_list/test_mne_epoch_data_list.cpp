@@ -0,0 +1,327 @@
+//=============================================================================================================
+/**
+ * @file     test_mne_epoch_data_list.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief     Testframe for MNEEpochDataList.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+#include <utils/mnemath.h>
+#include <fiff/fiff_raw_data.h>
+#include <fiff/fiff_evoked.h>
+#include <mne/mne_epoch_data_list.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtCore/QCoreApplication>
+#include <QtTest>
+
+//=============================================================================================================
+// Eigen
+//=============================================================================================================
+
+#include <Eigen/Dense>
+
+//=============================================================================================================
+// Used Namespaces
+//=============================================================================================================
+
+using namespace MNELIB;
+using namespace FIFFLIB;
+using namespace UTILSLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestMneEpochDataList
+ *
+ * @brief The TestMneEpochDataList class compares the single pass epoch reader with reading every event on its own
+ *
+ */
+class TestMneEpochDataList: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestMneEpochDataList();
+
+private slots:
+    void initTestCase();
+    void compareReadEpochs();
+    void compareAverage();
+    void compareAverageWithBaseline();
+    void cleanupTestCase();
+
+private:
+    //=========================================================================================================
+    /**
+     * Reads the epochs of m_iEvent one event at a time, like the reader did before epochs were read in a single
+     * pass. Rejection compares the peak to peak amplitude of every good MEG, EEG and EOG channel with its threshold.
+     */
+    void readReference(QList<MatrixXd>& lEpochs,
+                       QList<bool>& lRejected) const;
+
+    //=========================================================================================================
+    /**
+     * Averages the accepted reference epochs, optionally after the baseline correction of MNEMath::rescale.
+     */
+    MatrixXd averageReference(bool bApplyBaseline,
+                              int& nave) const;
+
+    FiffRawData             m_raw;          /**< The raw data. */
+    MatrixXi                m_events;       /**< The events. */
+    qint32                  m_iEvent;       /**< The averaged event kind. */
+    float                   m_fTMin;        /**< The start of the epochs in seconds. */
+    float                   m_fTMax;        /**< The end of the epochs in seconds. */
+    QPair<float,float>      m_baseline;     /**< The baseline window in seconds. */
+    QMap<QString,double>    m_mapReject;    /**< The rejection thresholds. */
+    double                  m_dEpsilon;     /**< The tolerance. */
+};
+
+//=============================================================================================================
+
+TestMneEpochDataList::TestMneEpochDataList()
+: m_iEvent(1)
+, m_fTMin(-0.1f)
+, m_fTMax(0.3f)
+, m_baseline(-0.1f, 0.0f)
+, m_dEpsilon(1e-10)
+{
+}
+
+//=============================================================================================================
+
+void TestMneEpochDataList::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    QFile t_fileRaw(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/sample_audvis_trunc_raw.fif");
+    QVERIFY(t_fileRaw.exists());
+
+    m_raw = FiffRawData(t_fileRaw);
+    QVERIFY(!m_raw.isEmpty());
+
+    // Overlapping epochs every 0.25 s in reverse order, every fourth one of another kind, and one beyond the data
+    int iStep = static_cast<int>(0.25 * m_raw.info.sfreq);
+    int iFirst = m_raw.first_samp + static_cast<int>(m_raw.info.sfreq);
+    int iNumEvents = (m_raw.last_samp - iFirst - static_cast<int>(m_raw.info.sfreq)) / iStep;
+    QVERIFY(iNumEvents > 8);
+
+    m_events = MatrixXi::Zero(iNumEvents + 1, 3);
+    for(int i = 0; i < iNumEvents; ++i) {
+        m_events(i,0) = iFirst + (iNumEvents - 1 - i) * iStep;
+        m_events(i,2) = i % 4 == 3 ? 2 : m_iEvent;
+    }
+    m_events(iNumEvents,0) = m_raw.last_samp;
+    m_events(iNumEvents,2) = m_iEvent;
+
+    // Reject about half of the epochs by their gradiometer amplitude, keep the other thresholds out of the way
+    m_mapReject.insert("grad", 1.0);
+    m_mapReject.insert("mag", 1.0);
+    m_mapReject.insert("eeg", 1.0);
+    m_mapReject.insert("eog", 1.0);
+
+    QList<MatrixXd> lEpochs;
+    QList<bool> lRejected;
+    readReference(lEpochs, lRejected);
+
+    QVector<double> lGradPeakToPeak;
+    for(const MatrixXd& matEpoch : lEpochs) {
+        double dMax = 0.0;
+        for(int c = 0; c < m_raw.info.chs.size(); ++c) {
+            if(m_raw.info.chs[c].kind == FIFFV_MEG_CH && m_raw.info.chs[c].unit == FIFF_UNIT_T_M && !m_raw.info.bads.contains(m_raw.info.chs[c].ch_name)) {
+                dMax = qMax(dMax, matEpoch.row(c).maxCoeff() - matEpoch.row(c).minCoeff());
+            }
+        }
+        lGradPeakToPeak.append(dMax);
+    }
+    std::sort(lGradPeakToPeak.begin(), lGradPeakToPeak.end());
+    m_mapReject["grad"] = lGradPeakToPeak[lGradPeakToPeak.size() / 2];
+}
+
+//=============================================================================================================
+
+void TestMneEpochDataList::compareReadEpochs()
+{
+    QList<MatrixXd> lEpochsRef;
+    QList<bool> lRejectedRef;
+    readReference(lEpochsRef, lRejectedRef);
+
+    MNEEpochDataList lEpochs = MNEEpochDataList::readEpochs(m_raw, m_events, m_fTMin, m_fTMax, m_iEvent, m_mapReject);
+
+    QCOMPARE(lEpochs.size(), lEpochsRef.size());
+    QVERIFY(lRejectedRef.contains(true));
+    QVERIFY(lRejectedRef.contains(false));
+
+    for(int i = 0; i < lEpochs.size(); ++i) {
+        QCOMPARE(lEpochs[i]->bReject, lRejectedRef[i]);
+        QCOMPARE(lEpochs[i]->epoch.rows(), lEpochsRef[i].rows());
+        QCOMPARE(lEpochs[i]->epoch.cols(), lEpochsRef[i].cols());
+        QVERIFY((lEpochs[i]->epoch - lEpochsRef[i]).cwiseAbs().maxCoeff() <= m_dEpsilon * lEpochsRef[i].cwiseAbs().maxCoeff());
+    }
+}
+
+//=============================================================================================================
+
+void TestMneEpochDataList::compareAverage()
+{
+    int naveRef = 0;
+    MatrixXd matRef = averageReference(false, naveRef);
+
+    FiffEvoked evoked = MNEEpochDataList::averageEpochs(m_raw, m_events, m_fTMin, m_fTMax, m_iEvent, m_mapReject);
+
+    QCOMPARE(evoked.nave, naveRef);
+    QCOMPARE(evoked.data.rows(), matRef.rows());
+    QCOMPARE(evoked.data.cols(), matRef.cols());
+    QVERIFY((evoked.data - matRef).cwiseAbs().maxCoeff() <= m_dEpsilon * matRef.cwiseAbs().maxCoeff());
+}
+
+//=============================================================================================================
+
+void TestMneEpochDataList::compareAverageWithBaseline()
+{
+    int naveRef = 0;
+    MatrixXd matRef = averageReference(true, naveRef);
+
+    FiffEvoked evoked = MNEEpochDataList::averageEpochs(m_raw, m_events, m_fTMin, m_fTMax, m_iEvent, m_mapReject,
+                                                        QStringList(), RowVectorXi(), true, m_baseline);
+
+    QCOMPARE(evoked.nave, naveRef);
+    QCOMPARE(evoked.data.rows(), matRef.rows());
+    QCOMPARE(evoked.data.cols(), matRef.cols());
+    QVERIFY((evoked.data - matRef).cwiseAbs().maxCoeff() <= m_dEpsilon * matRef.cwiseAbs().maxCoeff());
+}
+
+//=============================================================================================================
+
+void TestMneEpochDataList::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+
+void TestMneEpochDataList::readReference(QList<MatrixXd>& lEpochs,
+                                         QList<bool>& lRejected) const
+{
+    lEpochs.clear();
+    lRejected.clear();
+
+    RowVectorXi picks(m_raw.info.chs.size());
+    for(int i = 0; i < picks.size(); ++i) {
+        picks[i] = i;
+    }
+
+    MatrixXd matTimes;
+
+    for(int p = 0; p < m_events.rows(); ++p) {
+        if(m_events(p,1) != 0 || m_events(p,2) != m_iEvent) {
+            continue;
+        }
+
+        fiff_int_t event_samp = m_events(p,0);
+        fiff_int_t from = event_samp + m_fTMin*m_raw.info.sfreq;
+        fiff_int_t to   = event_samp + floor(m_fTMax*m_raw.info.sfreq + 0.5);
+
+        MatrixXd matEpoch;
+        if(from < m_raw.first_samp || to > m_raw.last_samp || !m_raw.read_raw_segment(matEpoch, matTimes, from, to, picks)) {
+            continue;
+        }
+
+        bool bReject = false;
+        for(int c = 0; c < m_raw.info.chs.size() && !bReject; ++c) {
+            const FiffChInfo& ch = m_raw.info.chs[c];
+            if(m_raw.info.bads.contains(ch.ch_name)
+               || ch.chpos.coil_type == FIFFV_COIL_BABY_REF_MAG
+               || ch.chpos.coil_type == FIFFV_COIL_BABY_REF_MAG2) {
+                continue;
+            }
+
+            double dThreshold = -1.0;
+            if(ch.kind == FIFFV_MEG_CH && ch.unit == FIFF_UNIT_T) {
+                dThreshold = m_mapReject["mag"];
+            } else if(ch.kind == FIFFV_MEG_CH && ch.unit == FIFF_UNIT_T_M) {
+                dThreshold = m_mapReject["grad"];
+            } else if(ch.kind == FIFFV_EEG_CH) {
+                dThreshold = m_mapReject["eeg"];
+            } else if(ch.kind == FIFFV_EOG_CH) {
+                dThreshold = m_mapReject["eog"];
+            }
+
+            if(dThreshold >= 0.0 && matEpoch.row(c).maxCoeff() - matEpoch.row(c).minCoeff() > dThreshold) {
+                bReject = true;
+            }
+        }
+
+        lEpochs.append(matEpoch);
+        lRejected.append(bReject);
+    }
+}
+
+//=============================================================================================================
+
+MatrixXd TestMneEpochDataList::averageReference(bool bApplyBaseline,
+                                                int& nave) const
+{
+    QList<MatrixXd> lEpochs;
+    QList<bool> lRejected;
+    readReference(lEpochs, lRejected);
+
+    MatrixXd matAverage = MatrixXd::Zero(lEpochs.first().rows(), lEpochs.first().cols());
+    RowVectorXf times = RowVectorXf::LinSpaced(lEpochs.first().cols(), m_fTMin, m_fTMax);
+    nave = 0;
+
+    for(int i = 0; i < lEpochs.size(); ++i) {
+        if(lRejected[i]) {
+            continue;
+        }
+
+        if(bApplyBaseline) {
+            matAverage += MNEMath::rescale(lEpochs[i], times, m_baseline, QString("mean"));
+        } else {
+            matAverage += lEpochs[i];
+        }
+        ++nave;
+    }
+
+    return matAverage / nave;
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestMneEpochDataList)
+#include "test_mne_epoch_data_list.moc"
@@ -0,0 +1,235 @@
+//=============================================================================================================
+/**
+ * @file     test_mne_geometry_cache.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief     Testframe for MneGeometryCache.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+#include <mne/c/mne_surface_or_volume.h>
+#include <mne/c/mne_surface_old.h>
+#include <mne/c/mne_source_space_old.h>
+#include <mne/c/mne_geometry_cache.h>
+#include <fiff/fiff_file.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtCore/QCoreApplication>
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QDir>
+#include <QFileInfo>
+#include <QDateTime>
+
+//=============================================================================================================
+// Used Namespaces
+//=============================================================================================================
+
+using namespace MNELIB;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestMneGeometryCache
+ *
+ * @brief The TestMneGeometryCache class checks that geometry read from the cache equals the computed geometry
+ *
+ */
+class TestMneGeometryCache: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestMneGeometryCache();
+
+private slots:
+    void initTestCase();
+    void compareCacheMiss();
+    void compareCacheHit();
+    void compareDirectRead();
+    void cleanupTestCase();
+
+private:
+    //=========================================================================================================
+    /**
+     * Reads the inner skull surface, with or without the geometry information.
+     */
+    MneSurfaceOld* readSurface(bool bAddGeometry) const;
+
+    //=========================================================================================================
+    /**
+     * Verifies that the normals, the neighboring triangles and vertices and the vertex distances are equal.
+     */
+    void compareGeometry(const MneSurfaceOrVolume* pSurf,
+                         const MneSurfaceOrVolume* pRef) const;
+
+    QString             m_sBemFile;     /**< The BEM file. */
+    QTemporaryDir       m_cacheDir;     /**< The cache directory of this test. */
+    MneSurfaceOld*      m_pRef;         /**< The surface with the computed geometry. */
+};
+
+//=============================================================================================================
+
+TestMneGeometryCache::TestMneGeometryCache()
+: m_pRef(Q_NULLPTR)
+{
+}
+
+//=============================================================================================================
+
+void TestMneGeometryCache::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    m_sBemFile = QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/subjects/sample/bem/sample-5120-bem.fif";
+    QVERIFY(QFile::exists(m_sBemFile));
+    QVERIFY(m_cacheDir.isValid());
+
+    // The reference is computed without the cache
+    qputenv("MNE_GEOMETRY_CACHE_DIR", "off");
+    m_pRef = readSurface(true);
+    QVERIFY(m_pRef);
+    QVERIFY(m_pRef->neighbor_tri && m_pRef->neighbor_vert && m_pRef->vert_dist);
+
+    qputenv("MNE_GEOMETRY_CACHE_DIR", QFile::encodeName(m_cacheDir.path()));
+}
+
+//=============================================================================================================
+
+void TestMneGeometryCache::compareCacheMiss()
+{
+    QVERIFY(QDir(m_cacheDir.path()).entryList(QDir::Files).isEmpty());
+
+    // The first run computes the geometry and writes the entry
+    MneSurfaceOld* pSurf = readSurface(true);
+    QVERIFY(pSurf);
+
+    QCOMPARE(QDir(m_cacheDir.path()).entryList(QDir::Files).size(), 1);
+    compareGeometry(pSurf, m_pRef);
+
+    delete pSurf;
+}
+
+//=============================================================================================================
+
+void TestMneGeometryCache::compareCacheHit()
+{
+    QStringList lEntries = QDir(m_cacheDir.path()).entryList(QDir::Files);
+    QCOMPARE(lEntries.size(), 1);
+    QDateTime lastModified = QFileInfo(m_cacheDir.filePath(lEntries.first())).lastModified();
+
+    // The second run reads the entry and does not write it again
+    MneSurfaceOld* pSurf = readSurface(true);
+    QVERIFY(pSurf);
+
+    QCOMPARE(QDir(m_cacheDir.path()).entryList(QDir::Files), lEntries);
+    QCOMPARE(QFileInfo(m_cacheDir.filePath(lEntries.first())).lastModified(), lastModified);
+    compareGeometry(pSurf, m_pRef);
+
+    delete pSurf;
+}
+
+//=============================================================================================================
+
+void TestMneGeometryCache::compareDirectRead()
+{
+    // A surface without neighborhood information is completed from the entry alone
+    MneSurfaceOld* pSurf = readSurface(false);
+    QVERIFY(pSurf);
+    QVERIFY(pSurf->nn);
+
+    // The normals are recomputed, and not part of the key, if the file does not provide them
+    MneSourceSpaceOld* pSpace = (MneSourceSpaceOld*)pSurf;
+    QByteArray keyGiven = MneGeometryCache::key(pSpace, false, true);
+    QByteArray keyComputed = MneGeometryCache::key(pSpace, true, true);
+    QVERIFY(!keyGiven.isEmpty());
+    QVERIFY(keyGiven != keyComputed);
+    QVERIFY(MneGeometryCache::read(keyGiven, pSpace) || MneGeometryCache::read(keyComputed, pSpace));
+    compareGeometry(pSurf, m_pRef);
+
+    // Entries of other options are not hit
+    QVERIFY(!MneGeometryCache::read(MneGeometryCache::key(pSpace, false, false), pSpace));
+    QVERIFY(!MneGeometryCache::read(MneGeometryCache::key(pSpace, true, false), pSpace));
+
+    delete pSurf;
+}
+
+//=============================================================================================================
+
+void TestMneGeometryCache::cleanupTestCase()
+{
+    delete m_pRef;
+    qunsetenv("MNE_GEOMETRY_CACHE_DIR");
+}
+
+//=============================================================================================================
+
+MneSurfaceOld* TestMneGeometryCache::readSurface(bool bAddGeometry) const
+{
+    return MneSurfaceOrVolume::read_bem_surface(m_sBemFile, FIFFV_BEM_SURF_ID_BRAIN, bAddGeometry ? 1 : 0, Q_NULLPTR);
+}
+
+//=============================================================================================================
+
+void TestMneGeometryCache::compareGeometry(const MneSurfaceOrVolume* pSurf,
+                                           const MneSurfaceOrVolume* pRef) const
+{
+    QCOMPARE(pSurf->np, pRef->np);
+    QCOMPARE(pSurf->ntri, pRef->ntri);
+
+    for(int k = 0; k < pRef->np; ++k) {
+        for(int j = 0; j < 3; ++j) {
+            QCOMPARE(pSurf->nn[k][j], pRef->nn[k][j]);
+        }
+
+        QCOMPARE(pSurf->nneighbor_tri[k], pRef->nneighbor_tri[k]);
+        for(int j = 0; j < pRef->nneighbor_tri[k]; ++j) {
+            QCOMPARE(pSurf->neighbor_tri[k][j], pRef->neighbor_tri[k][j]);
+        }
+
+        QCOMPARE(pSurf->nneighbor_vert[k], pRef->nneighbor_vert[k]);
+        for(int j = 0; j < pRef->nneighbor_vert[k]; ++j) {
+            QCOMPARE(pSurf->neighbor_vert[k][j], pRef->neighbor_vert[k][j]);
+            QCOMPARE(pSurf->vert_dist[k][j], pRef->vert_dist[k][j]);
+        }
+    }
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestMneGeometryCache)
+#include "test_mne_geometry_cache.moc"
@@ -0,0 +1,236 @@
+//=============================================================================================================
+/**
+ * @file     test_mne_stc_file.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief     Testframe for MNEStcFile.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+#include <mne/mne_stc_file.h>
+#include <mne/mne_sourceestimate.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtCore/QCoreApplication>
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QtEndian>
+
+//=============================================================================================================
+// Eigen
+//=============================================================================================================
+
+#include <Eigen/Dense>
+
+//=============================================================================================================
+// Used Namespaces
+//=============================================================================================================
+
+using namespace MNELIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestMneStcFile
+ *
+ * @brief The TestMneStcFile class writes an stc file in chunks and compares the chunked reads against the full data
+ *
+ */
+class TestMneStcFile: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestMneStcFile();
+
+private slots:
+    void initTestCase();
+    void compareFullRead();
+    void compareWindows();
+    void compareRanges();
+    void rejectTooManySamples();
+    void cleanupTestCase();
+
+private:
+    QTemporaryDir   m_tempDir;      /**< Holds the written files. */
+    QString         m_sFileName;    /**< The written stc file. */
+    MatrixXf        m_matData;      /**< The written data (sources x time points). */
+    VectorXi        m_vecVertices;  /**< The written vertices. */
+    float           m_fTmin;        /**< The written start time. */
+    float           m_fTstep;       /**< The written time step. */
+    int             m_iTileSize;    /**< The tile size used for reading. */
+};
+
+//=============================================================================================================
+
+TestMneStcFile::TestMneStcFile()
+: m_fTmin(-0.1f)
+, m_fTstep(0.001f)
+, m_iTileSize(1000)
+{
+}
+
+//=============================================================================================================
+
+void TestMneStcFile::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    QVERIFY(m_tempDir.isValid());
+    m_sFileName = m_tempDir.filePath("test-lh.stc");
+
+    std::srand(42);
+
+    // 2500 time points give two full tiles and a partial one
+    m_matData = MatrixXf::Random(20, 2500);
+    m_vecVertices = VectorXi::LinSpaced(20, 0, 190);
+
+    MNEStcFile stcFile;
+    QVERIFY(stcFile.create(m_sFileName, m_vecVertices, m_fTmin, m_fTstep));
+
+    // Append in chunks which do not line up with the tiles
+    QVERIFY(stcFile.append(MatrixXf(m_matData.middleCols(0, 700))));
+    QVERIFY(stcFile.append(MatrixXd(m_matData.middleCols(700, 1300).cast<double>())));
+    QVERIFY(stcFile.append(MatrixXf(m_matData.middleCols(2000, 500))));
+    QVERIFY(stcFile.close());
+}
+
+//=============================================================================================================
+
+void TestMneStcFile::compareFullRead()
+{
+    // The file has to be readable by the existing reader
+    QFile file(m_sFileName);
+    MNESourceEstimate stc;
+    QVERIFY(MNESourceEstimate::read(file, stc));
+
+    QCOMPARE(stc.data.rows(), m_matData.rows());
+    QCOMPARE(stc.data.cols(), m_matData.cols());
+    QVERIFY(stc.data.cast<float>() == m_matData);
+    QVERIFY(stc.vertices == m_vecVertices);
+    QVERIFY(qAbs(stc.tmin - m_fTmin) < 1e-6f);
+    QVERIFY(qAbs(stc.tstep - m_fTstep) < 1e-6f);
+}
+
+//=============================================================================================================
+
+void TestMneStcFile::compareWindows()
+{
+    MNEStcFile stcFile;
+    QVERIFY(stcFile.open(m_sFileName, m_iTileSize));
+
+    QCOMPARE(stcFile.sources(), int(m_matData.rows()));
+    QCOMPARE(stcFile.samples(), int(m_matData.cols()));
+    QCOMPARE(stcFile.tiles(), 3);
+
+    // A window across a tile border
+    MatrixXf matWindow;
+    QVERIFY(stcFile.readWindow(900, 400, matWindow));
+    QVERIFY(matWindow == m_matData.middleCols(900, 400));
+
+    // A window which is clipped at the end
+    QVERIFY(stcFile.readWindow(2400, 500, matWindow));
+    QVERIFY(matWindow == m_matData.middleCols(2400, 100));
+
+    // The whole file in double precision
+    MatrixXd matAll;
+    QVERIFY(stcFile.readWindow(0, stcFile.samples(), matAll));
+    QVERIFY(matAll.cast<float>() == m_matData);
+
+    // A window as source estimate
+    MNESourceEstimate stc = stcFile.read(1500, 10);
+    QVERIFY(stc.data.cast<float>() == m_matData.middleCols(1500, 10));
+    QVERIFY(stc.vertices == m_vecVertices);
+    QVERIFY(qAbs(stc.tmin - (m_fTmin + 1500 * m_fTstep)) < 1e-5f);
+}
+
+//=============================================================================================================
+
+void TestMneStcFile::compareRanges()
+{
+    MNEStcFile stcFile;
+    QVERIFY(stcFile.open(m_sFileName, m_iTileSize, true));
+
+    float fMin, fMax;
+
+    // The range covers all tiles which are touched by the window
+    QVERIFY(stcFile.range(900, 400, fMin, fMax));
+    QCOMPARE(fMin, m_matData.middleCols(0, 2 * m_iTileSize).minCoeff());
+    QCOMPARE(fMax, m_matData.middleCols(0, 2 * m_iTileSize).maxCoeff());
+
+    // The partial last tile
+    QVERIFY(stcFile.range(2100, 50, fMin, fMax));
+    QCOMPARE(fMin, m_matData.middleCols(2 * m_iTileSize, 500).minCoeff());
+    QCOMPARE(fMax, m_matData.middleCols(2 * m_iTileSize, 500).maxCoeff());
+
+    QVERIFY(stcFile.range(0, stcFile.samples(), fMin, fMax));
+    QCOMPARE(fMin, m_matData.minCoeff());
+    QCOMPARE(fMax, m_matData.maxCoeff());
+}
+
+//=============================================================================================================
+
+void TestMneStcFile::rejectTooManySamples()
+{
+    // Header of a file with one vertex which claims more time points than fit into an int
+    QByteArray header(20, 0);
+    uchar* pHeader = reinterpret_cast<uchar*>(header.data());
+    qToBigEndian<quint32>(1, pHeader + 8);
+    qToBigEndian<quint32>(0x80000000u, pHeader + 16);
+
+    QString sFileName = m_tempDir.filePath("corrupt-lh.stc");
+    QFile file(sFileName);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    QVERIFY(file.write(header) == header.size());
+    file.close();
+
+    MNEStcFile stcFile;
+    QVERIFY(!stcFile.open(sFileName));
+    QVERIFY(!stcFile.isOpen());
+}
+
+//=============================================================================================================
+
+void TestMneStcFile::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestMneStcFile)
+#include "test_mne_stc_file.moc"
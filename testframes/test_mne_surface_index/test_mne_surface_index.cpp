@@ -0,0 +1,316 @@
+//=============================================================================================================
+/**
+ * @file     test_mne_surface_index.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief     Testframe for MneSurfaceIndex.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+#include <mne/c/mne_surface_or_volume.h>
+#include <mne/c/mne_surface_old.h>
+#include <mne/c/mne_surface_index.h>
+#include <mne/c/mne_triangle.h>
+#include <fiff/fiff_file.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtCore/QCoreApplication>
+#include <QtTest>
+
+//=============================================================================================================
+// STL INCLUDES
+//=============================================================================================================
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+//=============================================================================================================
+// Used Namespaces
+//=============================================================================================================
+
+using namespace MNELIB;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestMneSurfaceIndex
+ *
+ * @brief The TestMneSurfaceIndex class compares the indexed surface queries with the exhaustive ones
+ *
+ */
+class TestMneSurfaceIndex: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestMneSurfaceIndex();
+
+private slots:
+    void initTestCase();
+    void compareInsideRandom();
+    void compareInsideOnSurface();
+    void compareInsideNearSurface();
+    void compareMinDistance();
+    void cleanupTestCase();
+
+private:
+    typedef std::array<float,3> Point;
+
+    //=========================================================================================================
+    /**
+     * The exhaustive inside test: the solid angle of the closed surface seen from inside is 4*pi.
+     */
+    bool insideBySolidAngle(Point r) const;
+
+    //=========================================================================================================
+    /**
+     * Compares the index with the solid angle sum for all points. Returns the number of inside points, -1 if any
+     * point differs.
+     */
+    int compareInside(const std::vector<Point>& lPoints) const;
+
+    //=========================================================================================================
+    /**
+     * Returns points drawn uniformly from the bounding box of the surface, enlarged by 10 % on each side.
+     */
+    std::vector<Point> randomPoints(int iNumPoints) const;
+
+    MneSurfaceOld*      m_pSurf;        /**< The inner skull surface. */
+    MneSurfaceIndex*    m_pIndex;       /**< The index of m_pSurf. */
+};
+
+//=============================================================================================================
+
+TestMneSurfaceIndex::TestMneSurfaceIndex()
+: m_pSurf(Q_NULLPTR)
+, m_pIndex(Q_NULLPTR)
+{
+}
+
+//=============================================================================================================
+
+void TestMneSurfaceIndex::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    QString sBemFile = QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/subjects/sample/bem/sample-5120-bem.fif";
+    QVERIFY(QFile::exists(sBemFile));
+
+    m_pSurf = MneSurfaceOrVolume::read_bem_surface(sBemFile, FIFFV_BEM_SURF_ID_BRAIN, 1, Q_NULLPTR);
+    QVERIFY(m_pSurf);
+    QVERIFY(m_pSurf->np > 0 && m_pSurf->ntri > 0);
+
+    m_pIndex = new MneSurfaceIndex(m_pSurf);
+}
+
+//=============================================================================================================
+
+void TestMneSurfaceIndex::compareInsideRandom()
+{
+    std::vector<Point> lPoints = randomPoints(2000);
+
+    int iNumInside = compareInside(lPoints);
+
+    QVERIFY(iNumInside >= 0);
+    QVERIFY(iNumInside > 0);
+    QVERIFY(iNumInside < static_cast<int>(lPoints.size()));
+}
+
+//=============================================================================================================
+
+void TestMneSurfaceIndex::compareInsideOnSurface()
+{
+    // Rays from the vertices and from the edge midpoints graze the triangulation, rays from the centroids start on it
+    std::vector<Point> lPoints;
+
+    for(int k = 0; k < m_pSurf->np; ++k) {
+        lPoints.push_back({m_pSurf->rr[k][0], m_pSurf->rr[k][1], m_pSurf->rr[k][2]});
+    }
+
+    for(int t = 0; t < m_pSurf->ntri; ++t) {
+        const MneTriangle* tri = m_pSurf->tris + t;
+        lPoints.push_back({tri->cent[0], tri->cent[1], tri->cent[2]});
+        lPoints.push_back({0.5f * (tri->r1[0] + tri->r2[0]), 0.5f * (tri->r1[1] + tri->r2[1]), 0.5f * (tri->r1[2] + tri->r2[2])});
+    }
+
+    QVERIFY(compareInside(lPoints) >= 0);
+
+    // From below the surface points the rays pass through the vertices and edges
+    for(Point& r : lPoints) {
+        r[2] -= 0.001f;
+    }
+
+    QVERIFY(compareInside(lPoints) >= 0);
+}
+
+//=============================================================================================================
+
+void TestMneSurfaceIndex::compareInsideNearSurface()
+{
+    // Off the centroids along the normal, further and closer than SURF_EPS
+    const float fOffsets[] = { -1e-3f, -1e-4f, -1e-8f, 1e-8f, 1e-4f, 1e-3f };
+
+    for(float fOffset : fOffsets) {
+        std::vector<Point> lPoints;
+
+        for(int t = 0; t < m_pSurf->ntri; ++t) {
+            const MneTriangle* tri = m_pSurf->tris + t;
+            lPoints.push_back({tri->cent[0] + fOffset * tri->nn[0],
+                               tri->cent[1] + fOffset * tri->nn[1],
+                               tri->cent[2] + fOffset * tri->nn[2]});
+        }
+
+        int iNumInside = compareInside(lPoints);
+        QVERIFY(iNumInside >= 0);
+
+        // The normals point outwards
+        if(std::fabs(fOffset) >= 1e-4f) {
+            QCOMPARE(iNumInside, fOffset < 0.0f ? m_pSurf->ntri : 0);
+        }
+    }
+}
+
+//=============================================================================================================
+
+void TestMneSurfaceIndex::compareMinDistance()
+{
+    std::vector<Point> lPoints = randomPoints(500);
+
+    for(int k = 0; k < m_pSurf->np; k += 7) {
+        lPoints.push_back({m_pSurf->rr[k][0], m_pSurf->rr[k][1], m_pSurf->rr[k][2]});
+    }
+
+    const float fMaxDists[] = { 0.0f, 0.005f, 0.02f, 1.0f };
+
+    for(float fMaxDist : fMaxDists) {
+        for(const Point& r : lPoints) {
+            float fMinDist = fMaxDist;
+            int iMinNode = -1;
+
+            for(int k = 0; k < m_pSurf->np; ++k) {
+                const float *rr = m_pSurf->rr[k];
+                float diff[3] = { r[0] - rr[0], r[1] - rr[1], r[2] - rr[2] };
+                float dist = std::sqrt(diff[0] * diff[0] + diff[1] * diff[1] + diff[2] * diff[2]);
+                if(dist < fMinDist) {
+                    fMinDist = dist;
+                    iMinNode = k;
+                }
+            }
+
+            int iNearest = -2;
+            QCOMPARE(m_pIndex->minDistance(r.data(), fMaxDist, &iNearest), fMinDist);
+            QCOMPARE(iNearest, iMinNode);
+            QCOMPARE(m_pIndex->minDistance(r.data(), fMaxDist), fMinDist);
+        }
+    }
+}
+
+//=============================================================================================================
+
+void TestMneSurfaceIndex::cleanupTestCase()
+{
+    delete m_pIndex;
+    delete m_pSurf;
+}
+
+//=============================================================================================================
+
+bool TestMneSurfaceIndex::insideBySolidAngle(Point r) const
+{
+    return std::fabs(MneSurfaceOrVolume::sum_solids(r.data(), m_pSurf) / (4 * M_PI) - 1.0) <= 1e-5;
+}
+
+//=============================================================================================================
+
+int TestMneSurfaceIndex::compareInside(const std::vector<Point>& lPoints) const
+{
+    int iNumInside = 0;
+
+    for(Point r : lPoints) {
+        bool bInside = insideBySolidAngle(r);
+        if(m_pIndex->isInside(r.data()) != bInside) {
+            qWarning("[TestMneSurfaceIndex] Point (%g, %g, %g) differs from the solid angle sum", r[0], r[1], r[2]);
+            return -1;
+        }
+        iNumInside += bInside ? 1 : 0;
+    }
+
+    return iNumInside;
+}
+
+//=============================================================================================================
+
+std::vector<TestMneSurfaceIndex::Point> TestMneSurfaceIndex::randomPoints(int iNumPoints) const
+{
+    float fMin[3], fMax[3];
+    for(int c = 0; c < 3; ++c) {
+        fMin[c] = fMax[c] = m_pSurf->rr[0][c];
+    }
+    for(int k = 1; k < m_pSurf->np; ++k) {
+        for(int c = 0; c < 3; ++c) {
+            fMin[c] = std::min(fMin[c], m_pSurf->rr[k][c]);
+            fMax[c] = std::max(fMax[c], m_pSurf->rr[k][c]);
+        }
+    }
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> distributions[3];
+    for(int c = 0; c < 3; ++c) {
+        float fMargin = 0.1f * (fMax[c] - fMin[c]);
+        distributions[c] = std::uniform_real_distribution<float>(fMin[c] - fMargin, fMax[c] + fMargin);
+    }
+
+    std::vector<Point> lPoints(iNumPoints);
+    for(Point& r : lPoints) {
+        for(int c = 0; c < 3; ++c) {
+            r[c] = distributions[c](generator);
+        }
+    }
+
+    return lPoints;
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestMneSurfaceIndex)
+#include "test_mne_surface_index.moc"
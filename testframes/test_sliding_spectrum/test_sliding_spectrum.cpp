@@ -0,0 +1,214 @@
+//=============================================================================================================
+/**
+ * @file     test_sliding_spectrum.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief     Testframe for SlidingSpectrum.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+#include <utils/slidingspectrum.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtCore/QCoreApplication>
+#include <QtTest>
+
+//=============================================================================================================
+// STL INCLUDES
+//=============================================================================================================
+
+#include <algorithm>
+#include <cmath>
+
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+//=============================================================================================================
+// Eigen
+//=============================================================================================================
+
+#include <Eigen/Dense>
+
+//=============================================================================================================
+// Used Namespaces
+//=============================================================================================================
+
+using namespace UTILSLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestSlidingSpectrum
+ *
+ * @brief The TestSlidingSpectrum class checks the sliding PSD estimate of sinusoids with known power
+ *
+ */
+class TestSlidingSpectrum: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestSlidingSpectrum();
+
+private slots:
+    void initTestCase();
+    void compareWelchSinusoid();
+    void compareMultitaperSinusoid();
+    void cleanupTestCase();
+
+private:
+    //=========================================================================================================
+    /**
+     * Feeds the sinusoids to the estimator in chunks of varying size and checks the number of windows, the peak
+     * frequency, the total power and the power within iHalfWidth bins around the peak.
+     */
+    void compareSinusoid(int iNumTapers,
+                         int iHalfWidth,
+                         double dMinPeakFraction);
+
+    double      m_dSampFreq;        /**< The sampling frequency. */
+    int         m_iNfft;            /**< The window length. */
+    int         m_iHop;             /**< The number of samples between two windows. */
+    int         m_iNumSamples;      /**< The number of samples of the test signal. */
+    VectorXi    m_vecBins;          /**< The frequency bin of the sinusoid per channel. */
+    VectorXd    m_vecAmplitudes;    /**< The amplitude of the sinusoid per channel. */
+    MatrixXd    m_matData;          /**< The test signal (channels x samples). */
+};
+
+//=============================================================================================================
+
+TestSlidingSpectrum::TestSlidingSpectrum()
+: m_dSampFreq(1000.0)
+, m_iNfft(256)
+, m_iHop(128)
+, m_iNumSamples(3000)
+{
+}
+
+//=============================================================================================================
+
+void TestSlidingSpectrum::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    // Sinusoids centered on a frequency bin: 156.25 Hz and 250 Hz
+    m_vecBins = Vector2i(40, 64);
+    m_vecAmplitudes = Vector2d(2.0, 0.5);
+    const Vector2d vecPhases(0.3, 1.1);
+
+    m_matData.resize(m_vecBins.size(), m_iNumSamples);
+
+    for(int c = 0; c < m_matData.rows(); ++c) {
+        const double dFreq = m_vecBins(c) * m_dSampFreq / m_iNfft;
+
+        for(int i = 0; i < m_iNumSamples; ++i) {
+            m_matData(c, i) = m_vecAmplitudes(c) * std::sin(2.0 * M_PI * dFreq * i / m_dSampFreq + vecPhases(c));
+        }
+    }
+}
+
+//=============================================================================================================
+
+void TestSlidingSpectrum::compareWelchSinusoid()
+{
+    // The Hanning taper keeps the power of a bin centered sinusoid within two bins
+    compareSinusoid(1, 2, 0.999);
+}
+
+//=============================================================================================================
+
+void TestSlidingSpectrum::compareMultitaperSinusoid()
+{
+    // Five sine tapers spread it over a band of about three bins to each side
+    compareSinusoid(5, 6, 0.998);
+}
+
+//=============================================================================================================
+
+void TestSlidingSpectrum::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+
+void TestSlidingSpectrum::compareSinusoid(int iNumTapers,
+                                          int iHalfWidth,
+                                          double dMinPeakFraction)
+{
+    SlidingSpectrum spectrum(m_matData.rows(), m_iNfft, m_dSampFreq, m_iHop, iNumTapers);
+
+    int iNumWindows = 0;
+    int iChunkSize = 1;
+
+    for(int iFirst = 0; iFirst < m_iNumSamples; iFirst += iChunkSize) {
+        iChunkSize = std::min(iChunkSize * 3 % 211 + 1, m_iNumSamples - iFirst);
+        iNumWindows += spectrum.append(m_matData.middleCols(iFirst, iChunkSize));
+    }
+
+    const int iNumExpected = (m_iNumSamples - m_iNfft) / m_iHop + 1;
+    QCOMPARE(iNumWindows, iNumExpected);
+    QCOMPARE(spectrum.numAveraged(), iNumExpected);
+
+    const MatrixXd& matPsd = spectrum.psd();
+    const VectorXd vecFreqs = spectrum.frequencies();
+    QCOMPARE(matPsd.cols(), static_cast<Index>(m_iNfft / 2 + 1));
+    QCOMPARE(vecFreqs.size(), matPsd.cols());
+
+    const double dBinWidth = m_dSampFreq / m_iNfft;
+
+    for(int c = 0; c < matPsd.rows(); ++c) {
+        Index iPeak;
+        matPsd.row(c).maxCoeff(&iPeak);
+        QCOMPARE(static_cast<int>(iPeak), m_vecBins(c));
+        QVERIFY(std::fabs(vecFreqs(iPeak) - m_vecBins(c) * dBinWidth) < 1e-9);
+
+        // The integrated PSD is the variance of the sinusoid
+        const double dPower = matPsd.row(c).sum() * dBinWidth;
+        const double dVariance = m_vecAmplitudes(c) * m_vecAmplitudes(c) / 2.0;
+        qDebug() << "Channel" << c << "power" << dPower << "expected" << dVariance;
+        QVERIFY(std::fabs(dPower / dVariance - 1.0) < 1e-3);
+
+        const double dPeakPower = matPsd.row(c).segment(iPeak - iHalfWidth, 2 * iHalfWidth + 1).sum() * dBinWidth;
+        QVERIFY(dPeakPower / dPower > dMinPeakFraction);
+    }
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestSlidingSpectrum)
+#include "test_sliding_spectrum.moc"
@@ -49,11 +49,21 @@ SUBDIRS += \
     test_coregistration \
     test_dipole_fit \
     test_fiff_coord_trans \
+    test_fiff_proj_operator \
     test_fiff_rwr \
+    test_fiff_raw_writer \
     test_fiff_mne_types_io \
     test_filtering \
+    test_ftbuffer \
     test_hpiFit \
+    test_kmeans \
+    test_sliding_spectrum \
+    test_minimum_norm \
     test_mne_forward_solution \
+    test_mne_geometry_cache \
+    test_mne_epoch_data_list \
+    test_mne_surface_index \
+    test_mne_stc_file \
     test_fiff_cov \
     test_fiff_digitizer \
     test_mne_msh_display_surface_set \